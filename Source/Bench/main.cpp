@@ -0,0 +1,224 @@
+#include "../Core/Math.h"
+#include "../Core/DSP.h"
+#include "../Core/FFTPlan.h"
+#include "../Core/Resampler.h"
+#include "../Core/SIMD.h"
+#include <chrono>
+
+using namespace Waveless;
+
+namespace BenchNS
+{
+	// The recursive radix-2 implementation the planned FFT replaced, kept as the baseline
+	void RecursiveFFT(ComplexArray& x)
+	{
+		const size_t N = x.size();
+		if (N <= 1)
+		{
+			return;
+		}
+
+		ComplexArray even = x[std::slice(0, N / 2, 2)];
+		ComplexArray odd = x[std::slice(1, N / 2, 2)];
+
+		RecursiveFFT(even);
+		RecursiveFFT(odd);
+
+		for (size_t k = 0; k < N / 2; ++k)
+		{
+			Complex t = std::polar(1.0, -2 * PI<double> * k / N) * odd[k];
+			x[k] = even[k] + t;
+			x[k + N / 2] = even[k] - t;
+		}
+	}
+
+	// Repeat the function for about 0.2 second and return the average time in microseconds
+	template<class Function>
+	double Measure(Function&& function)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		function();
+
+		size_t l_iterationCount = 0;
+		auto l_begin = Clock::now();
+		auto l_end = l_begin;
+
+		do
+		{
+			function();
+			l_iterationCount++;
+			l_end = Clock::now();
+		} while (l_end - l_begin < std::chrono::milliseconds(200));
+
+		return std::chrono::duration<double, std::micro>(l_end - l_begin).count() / (double)l_iterationCount;
+	}
+
+	template<class T>
+	double MeasurePlan(size_t N, InstructionSet instructionSet)
+	{
+		SIMD::SetInstructionSet(instructionSet);
+
+		auto l_plan = FFTPlanT<T>::Get(N);
+		std::vector<std::complex<T>> l_in(N);
+		std::vector<std::complex<T>> l_out(N);
+		std::vector<std::complex<T>> l_scratch(l_plan->GetScratchSize());
+
+		std::mt19937 l_generator(N);
+		std::uniform_real_distribution<T> l_distribution(-1, 1);
+
+		for (auto& i : l_in)
+		{
+			i = std::complex<T>(l_distribution(l_generator), l_distribution(l_generator));
+		}
+
+		return Measure([&]() { l_plan->Forward(l_in.data(), l_out.data(), l_scratch.data()); });
+	}
+
+	// Output samples per microsecond of a one second mono signal, which is millions of samples per second
+	template<class T>
+	double MeasureResampler(double sourceSampleRate, double targetSampleRate, ResamplerQuality quality, InstructionSet instructionSet)
+	{
+		SIMD::SetInstructionSet(instructionSet);
+
+		ResamplerT<T> l_resampler;
+		l_resampler.Setup(sourceSampleRate, targetSampleRate, 1, quality);
+
+		auto l_frameCount = (size_t)sourceSampleRate;
+		std::vector<T> l_in(l_frameCount);
+		std::vector<T> l_out;
+
+		for (size_t i = 0; i < l_frameCount; i++)
+		{
+			l_in[i] = T(std::sin((double)i * 0.01));
+		}
+
+		auto l_time = Measure([&]() { l_resampler.Render(l_in.data(), l_frameCount, l_out); });
+
+		return (double)l_out.size() / l_time;
+	}
+
+	// Millions of samples per second of a ten second stereo signal of the raw format
+	double MeasureStatistics(SampleFormat format, size_t sampleSize, InstructionSet instructionSet)
+	{
+		SIMD::SetInstructionSet(instructionSet);
+
+		size_t l_frameCount = 441000;
+		size_t l_channels = 2;
+		std::vector<unsigned char> l_samples(l_frameCount * l_channels * sampleSize);
+
+		std::mt19937 l_generator(1);
+
+		for (auto& i : l_samples)
+		{
+			i = (unsigned char)l_generator();
+		}
+
+		if (format == SampleFormat::Float32)
+		{
+			auto l_values = reinterpret_cast<float*>(l_samples.data());
+
+			for (size_t i = 0; i < l_frameCount * l_channels; i++)
+			{
+				l_values[i] = std::sin((float)i * 0.01f);
+			}
+		}
+
+		std::vector<SignalStatistics> l_statistics;
+		auto l_time = Measure([&]() { DSP::GetSignalStatistics(l_samples.data(), l_frameCount, l_channels, format, l_statistics); });
+
+		return (double)(l_frameCount * l_channels) / l_time;
+	}
+
+	// 5 N log2(N) is the conventional flop count of a radix-2 FFT
+	double MFlops(size_t N, double microseconds)
+	{
+		return 5.0 * (double)N * std::log2((double)N) / microseconds;
+	}
+}
+
+using namespace BenchNS;
+
+int main()
+{
+	auto l_supported = SIMD::GetSupportedInstructionSet();
+
+	std::cout << "Supported instruction set: " << SIMD::GetInstructionSetName(l_supported) << std::endl;
+	std::cout << "Forward complex FFT, microseconds per transform (MFlops)" << std::endl;
+
+	std::vector<InstructionSet> l_instructionSets;
+
+	for (auto i : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512 })
+	{
+		if (i <= l_supported)
+		{
+			l_instructionSets.emplace_back(i);
+		}
+	}
+
+	for (size_t N : { 256, 1024, 4096, 16384, 65536, 44100, 48000 })
+	{
+		std::cout << std::endl << "N = " << N << std::endl;
+
+		if (!(N & (N - 1)))
+		{
+			ComplexArray l_signal(N);
+
+			for (size_t i = 0; i < N; i++)
+			{
+				l_signal[i] = Complex(std::sin((double)i), 0.0);
+			}
+
+			auto l_time = Measure([&]() { auto l_x = l_signal; RecursiveFFT(l_x); });
+
+			std::cout << std::setw(12) << "Recursive" << std::setw(12) << std::fixed << std::setprecision(2) << l_time << " (" << MFlops(N, l_time) << ")" << std::endl;
+		}
+
+		for (auto i : l_instructionSets)
+		{
+			auto l_double = MeasurePlan<double>(N, i);
+			auto l_float = MeasurePlan<float>(N, i);
+
+			std::cout << std::setw(12) << SIMD::GetInstructionSetName(i)
+				<< std::setw(12) << l_double << " (" << MFlops(N, l_double) << ") double"
+				<< std::setw(12) << l_float << " (" << MFlops(N, l_float) << ") float" << std::endl;
+		}
+	}
+
+	std::cout << std::endl << "Resampler, millions of output samples per second" << std::endl;
+
+	// An exact polyphase ratio and a ratio off by 100 ppm with interpolated phases
+	for (auto l_targetSampleRate : { 48000.0, 48004.8 })
+	{
+		for (auto l_quality : { ResamplerQuality::Low, ResamplerQuality::Medium, ResamplerQuality::High, ResamplerQuality::Best })
+		{
+			static const char* const l_qualityNames[] = { "Low", "Medium", "High", "Best" };
+
+			std::cout << std::endl << "44100 Hz to " << l_targetSampleRate << " Hz, " << l_qualityNames[(size_t)l_quality] << std::endl;
+
+			for (auto i : l_instructionSets)
+			{
+				auto l_double = MeasureResampler<double>(44100.0, l_targetSampleRate, l_quality, i);
+				auto l_float = MeasureResampler<float>(44100.0, l_targetSampleRate, l_quality, i);
+
+				std::cout << std::setw(12) << SIMD::GetInstructionSetName(i)
+					<< std::setw(12) << l_double << " double"
+					<< std::setw(12) << l_float << " float" << std::endl;
+			}
+		}
+	}
+
+	std::cout << std::endl << "Signal statistics, millions of samples per second" << std::endl;
+
+	for (auto i : l_instructionSets)
+	{
+		std::cout << std::setw(12) << SIMD::GetInstructionSetName(i)
+			<< std::setw(12) << MeasureStatistics(SampleFormat::Int16, 2, i) << " int16"
+			<< std::setw(12) << MeasureStatistics(SampleFormat::Int24, 3, i) << " int24"
+			<< std::setw(12) << MeasureStatistics(SampleFormat::Float32, 4, i) << " float" << std::endl;
+	}
+
+	SIMD::SetInstructionSet(l_supported);
+
+	return 0;
+}
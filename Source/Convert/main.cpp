@@ -0,0 +1,504 @@
+#include "../IO/WaveParser.h"
+#include "../Core/Math.h"
+#include "../Core/Resampler.h"
+#include "../Core/Logger.h"
+#include "../Core/Timer.h"
+#include "../Core/TaskScheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+using namespace Waveless;
+
+struct ConvertDesc
+{
+	unsigned short m_BitDepth = 0; // 0 keeps the source bit depth
+	unsigned short m_FormatTag = 0; // 0 keeps the source format, 1 integer PCM, 3 IEEE float
+	unsigned long m_SampleRate = 0; // 0 keeps the source sample rate
+	unsigned short m_Channels = 0; // 0 keeps the source channel layout
+	WavContainerType m_ContainerType = WavContainerType::RIFF;
+	bool m_Normalize = false;
+	double m_NormalizeLevel = 0.0; // Peak level in dBFS
+	bool m_TrimSilence = false;
+	double m_TrimSilenceLevel = -60.0; // Threshold in dBFS
+	size_t m_JobCount = 0; // 0 means one job per hardware thread
+	size_t m_MaxInFlightMemory = 1024ull * 1024ull * 1024ull; // In bytes
+};
+
+struct ConvertStats
+{
+	std::atomic<uint64_t> m_SucceededFiles{ 0 };
+	std::atomic<uint64_t> m_FailedFiles{ 0 };
+	std::atomic<uint64_t> m_InputBytes{ 0 };
+	std::atomic<uint64_t> m_OutputBytes{ 0 };
+	std::atomic<uint64_t> m_OutputDuration{ 0 }; // In microseconds
+};
+
+///
+/// Block the producer until the in-flight jobs fit into the memory budget.
+/// A job larger than the whole budget is still admitted when nothing else is in flight.
+///
+class InFlightMemoryBudget
+{
+public:
+	explicit InFlightMemoryBudget(size_t capacity) : m_Capacity(capacity) {};
+
+	void Acquire(size_t size)
+	{
+		std::unique_lock<std::mutex> l_lock(m_Mutex);
+		m_CV.wait(l_lock, [&] { return m_InUse == 0 || m_InUse + size <= m_Capacity; });
+		m_InUse += size;
+	}
+
+	void Release(size_t size)
+	{
+		{
+			std::unique_lock<std::mutex> l_lock(m_Mutex);
+			m_InUse -= size;
+		}
+		m_CV.notify_all();
+	}
+
+private:
+	size_t m_Capacity;
+	size_t m_InUse = 0;
+	std::mutex m_Mutex;
+	std::condition_variable m_CV;
+};
+
+///
+/// Release the memory of a job when it ends, also when it throws, or the producer would wait for it forever
+///
+struct InFlightMemoryGuard
+{
+	InFlightMemoryBudget& m_Budget;
+	size_t m_Size;
+
+	~InFlightMemoryGuard()
+	{
+		m_Budget.Release(m_Size);
+	}
+};
+
+void PrintUsage()
+{
+	std::cout
+		<< "Usage: WsConvert <input directory> <output directory> [options]\n"
+		<< "  --bit-depth <8|16|24|32|32f|64f>  Output sample format\n"
+		<< "  --sample-rate <Hz>                Output sample rate\n"
+		<< "  --channels <count>                Output channel count\n"
+		<< "  --container <riff|rf64>           Output container\n"
+		<< "  --normalize <dBFS>                Normalize the peak level\n"
+		<< "  --trim-silence <dBFS>             Trim the leading and trailing silence below the threshold\n"
+		<< "  --jobs <count>                    Worker thread count\n"
+		<< "  --max-memory <MB>                 In-flight memory budget of all jobs\n";
+}
+
+bool ParseArguments(int argc, char* argv[], ConvertDesc& desc)
+{
+	for (int i = 3; i < argc; i++)
+	{
+		std::string l_option = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			std::cout << "Missing value of " << l_option << "\n";
+			return false;
+		}
+
+		std::string l_value = argv[++i];
+
+		try
+		{
+			if (l_option == "--bit-depth")
+			{
+				desc.m_FormatTag = 1;
+				if (!l_value.empty() && l_value.back() == 'f')
+				{
+					desc.m_FormatTag = 3;
+					l_value.pop_back();
+				}
+				desc.m_BitDepth = (unsigned short)std::stoul(l_value);
+			}
+			else if (l_option == "--sample-rate")
+			{
+				desc.m_SampleRate = std::stoul(l_value);
+			}
+			else if (l_option == "--channels")
+			{
+				desc.m_Channels = (unsigned short)std::stoul(l_value);
+			}
+			else if (l_option == "--container")
+			{
+				if (l_value == "rf64")
+				{
+					desc.m_ContainerType = WavContainerType::RF64;
+				}
+				else if (l_value == "riff")
+				{
+					desc.m_ContainerType = WavContainerType::RIFF;
+				}
+				else
+				{
+					std::cout << "Unknown container " << l_value << "\n";
+					return false;
+				}
+			}
+			else if (l_option == "--normalize")
+			{
+				desc.m_Normalize = true;
+				desc.m_NormalizeLevel = std::stod(l_value);
+			}
+			else if (l_option == "--trim-silence")
+			{
+				desc.m_TrimSilence = true;
+				desc.m_TrimSilenceLevel = std::stod(l_value);
+			}
+			else if (l_option == "--jobs")
+			{
+				desc.m_JobCount = std::stoul(l_value);
+			}
+			else if (l_option == "--max-memory")
+			{
+				desc.m_MaxInFlightMemory = std::stoull(l_value) * 1024ull * 1024ull;
+			}
+			else
+			{
+				std::cout << "Unknown option " << l_option << "\n";
+				return false;
+			}
+		}
+		catch (const std::invalid_argument&)
+		{
+			std::cout << "Invalid value " << l_value << " of " << l_option << "\n";
+			return false;
+		}
+		catch (const std::out_of_range&)
+		{
+			std::cout << "Out of range value " << l_value << " of " << l_option << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+///
+/// Estimate the peak memory of a job: the raw input, two working copies decoded to double and the encoded output.
+/// 8-bit source expands 8 times per decoded copy, and 64-bit float output is as large as a decoded copy.
+/// The source format is unknown before loading, so resampling is assumed to start from 44.1kHz.
+///
+size_t EstimateJobMemory(size_t fileSize, const ConvertDesc& desc)
+{
+	auto l_expansion = 1.0 + 8.0 * 3.0;
+
+	if (desc.m_SampleRate)
+	{
+		l_expansion *= std::max(1.0, (double)desc.m_SampleRate / 44100.0);
+	}
+	if (desc.m_Channels)
+	{
+		l_expansion *= desc.m_Channels;
+	}
+
+	return (size_t)((double)fileSize * l_expansion);
+}
+
+void RemapChannels(const std::vector<double>& x, unsigned short sourceChannels, unsigned short targetChannels, std::vector<double>& result)
+{
+	auto l_frameCount = x.size() / sourceChannels;
+	result.resize(l_frameCount * targetChannels);
+
+	for (size_t i = 0; i < l_frameCount; i++)
+	{
+		auto l_sourceFrame = &x[i * sourceChannels];
+		auto l_targetFrame = &result[i * targetChannels];
+
+		if (targetChannels == 1)
+		{
+			// Downmix to mono by averaging
+			double l_sum = 0.0;
+			for (unsigned short j = 0; j < sourceChannels; j++)
+			{
+				l_sum += l_sourceFrame[j];
+			}
+			l_targetFrame[0] = l_sum / sourceChannels;
+		}
+		else if (sourceChannels == 1)
+		{
+			// Upmix mono by duplication
+			for (unsigned short j = 0; j < targetChannels; j++)
+			{
+				l_targetFrame[j] = l_sourceFrame[0];
+			}
+		}
+		else
+		{
+			// Keep the shared channels, silence the new ones and drop the rest
+			for (unsigned short j = 0; j < targetChannels; j++)
+			{
+				l_targetFrame[j] = j < sourceChannels ? l_sourceFrame[j] : 0.0;
+			}
+		}
+	}
+}
+
+void Resample(const std::vector<double>& x, unsigned short channels, unsigned long sourceSampleRate, unsigned long targetSampleRate, std::vector<double>& result)
+{
+	Resampler l_resampler;
+
+	// Offline, so the longest filter
+	if (l_resampler.Setup((double)sourceSampleRate, (double)targetSampleRate, channels, ResamplerQuality::Best) != WsResult::Success)
+	{
+		result = x;
+		return;
+	}
+
+	l_resampler.Render(x.data(), x.size() / channels, result);
+}
+
+void TrimSilence(std::vector<double>& x, unsigned short channels, double threshold)
+{
+	auto l_frameCount = x.size() / channels;
+	auto l_threshold = Math::DB2LinearAmp(threshold);
+
+	auto l_isSilent = [&](size_t frame)
+	{
+		for (unsigned short j = 0; j < channels; j++)
+		{
+			if (std::abs(x[frame * channels + j]) > l_threshold)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	size_t l_begin = 0;
+	while (l_begin < l_frameCount && l_isSilent(l_begin))
+	{
+		l_begin++;
+	}
+
+	size_t l_end = l_frameCount;
+	while (l_end > l_begin && l_isSilent(l_end - 1))
+	{
+		l_end--;
+	}
+
+	x.erase(x.begin() + l_end * channels, x.end());
+	x.erase(x.begin(), x.begin() + l_begin * channels);
+}
+
+void Normalize(std::vector<double>& x, double level)
+{
+	// The peak of all channels, the interleaved samples are measured as one channel
+	std::vector<SignalStatistics> l_statistics;
+	if (DSP::GetSignalStatistics(x.data(), x.size(), 1, SampleFormat::Float64, l_statistics) != WsResult::Success)
+	{
+		return;
+	}
+
+	auto l_peak = l_statistics[0].m_Peak;
+
+	if (l_peak == 0.0)
+	{
+		return;
+	}
+
+	auto l_gain = Math::DB2LinearAmp(level) / l_peak;
+	for (auto& i : x)
+	{
+		i *= l_gain;
+	}
+}
+
+WsResult ConvertFile(const fs::path& inputPath, const fs::path& outputPath, const ConvertDesc& desc, ConvertStats& stats)
+{
+	auto l_wavObject = WaveParser::LoadFile(inputPath.generic_string().c_str());
+
+	if (!l_wavObject.header.ChunkValidities[2] || !l_wavObject.header.ChunkValidities[5])
+	{
+		delete[] l_wavObject.samples;
+		return WsResult::NotCompatible;
+	}
+
+	std::vector<double> l_x;
+	auto l_result = WaveParser::DecodePCM(l_wavObject, l_x);
+
+	auto l_sourceHeader = l_wavObject.header;
+	delete[] l_wavObject.samples;
+
+	if (l_result != WsResult::Success)
+	{
+		return l_result;
+	}
+
+	auto l_channels = l_sourceHeader.fmtChunk.nChannels;
+	auto l_sampleRate = l_sourceHeader.fmtChunk.nSamplesPerSec;
+	std::vector<double> l_temp;
+
+	if (!l_channels || !l_sampleRate)
+	{
+		return WsResult::NotCompatible;
+	}
+
+	if (desc.m_Channels && desc.m_Channels != l_channels)
+	{
+		RemapChannels(l_x, l_channels, desc.m_Channels, l_temp);
+		std::swap(l_x, l_temp);
+		l_channels = desc.m_Channels;
+	}
+
+	if (desc.m_SampleRate && desc.m_SampleRate != l_sampleRate)
+	{
+		Resample(l_x, l_channels, l_sampleRate, desc.m_SampleRate, l_temp);
+		std::swap(l_x, l_temp);
+		l_sampleRate = desc.m_SampleRate;
+	}
+
+	if (desc.m_TrimSilence)
+	{
+		TrimSilence(l_x, l_channels, desc.m_TrimSilenceLevel);
+	}
+
+	if (desc.m_Normalize)
+	{
+		Normalize(l_x, desc.m_NormalizeLevel);
+	}
+
+	auto l_bitDepth = desc.m_BitDepth ? desc.m_BitDepth : l_sourceHeader.fmtChunk.wBitsPerSample;
+	auto l_formatTag = desc.m_FormatTag ? desc.m_FormatTag : l_sourceHeader.fmtChunk.wFormatTag;
+
+	if (l_formatTag == 0xFFFE)
+	{
+		unsigned short l_formatCode;
+		std::memcpy(&l_formatCode, &l_sourceHeader.fmtChunk.SubFormat[0], sizeof(l_formatCode));
+		l_formatTag = l_formatCode;
+	}
+
+	auto l_header = WaveParser::GenerateWavHeader(l_channels, l_sampleRate, l_bitDepth, l_x.size(), l_formatTag, desc.m_ContainerType);
+
+	WavObject l_outputObject;
+	l_result = WaveParser::EncodePCM(l_header, l_x, l_outputObject);
+
+	if (l_result != WsResult::Success)
+	{
+		return l_result;
+	}
+
+	fs::create_directories(outputPath.parent_path());
+	l_result = WaveParser::WriteFile(outputPath.generic_string().c_str(), l_outputObject);
+
+	stats.m_OutputBytes += l_outputObject.count;
+	stats.m_OutputDuration += (uint64_t)(l_x.size() / l_channels) * 1000000ull / l_sampleRate;
+
+	delete[] l_outputObject.samples;
+
+	return l_result;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	ConvertDesc l_desc;
+
+	if (!ParseArguments(argc, argv, l_desc))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	fs::path l_inputDir = argv[1];
+	fs::path l_outputDir = argv[2];
+
+	if (!fs::is_directory(l_inputDir))
+	{
+		Logger::Log(LogLevel::Error, "WsConvert: Can't find input directory ", l_inputDir.generic_string().c_str(), "!");
+		return 1;
+	}
+
+	TaskScheduler::Initialize(l_desc.m_JobCount);
+
+	ConvertStats l_stats;
+	InFlightMemoryBudget l_budget(l_desc.m_MaxInFlightMemory);
+	std::vector<std::future<void>> l_futures;
+
+	auto l_startTime = Timer::GetCurrentTimeFromEpoch(TimeUnit::Microsecond);
+
+	for (auto& p : fs::recursive_directory_iterator(l_inputDir))
+	{
+		if (p.is_directory())
+		{
+			continue;
+		}
+
+		auto l_extension = p.path().extension().generic_string();
+		std::transform(l_extension.begin(), l_extension.end(), l_extension.begin(), ::tolower);
+
+		if (l_extension != ".wav")
+		{
+			continue;
+		}
+
+		auto l_inputPath = p.path();
+		auto l_outputPath = l_outputDir / fs::relative(l_inputPath, l_inputDir);
+		auto l_fileSize = (size_t)p.file_size();
+		auto l_jobMemory = EstimateJobMemory(l_fileSize, l_desc);
+
+		l_budget.Acquire(l_jobMemory);
+		l_stats.m_InputBytes += l_fileSize;
+
+		l_futures.emplace_back(TaskScheduler::Submit([=, &l_desc, &l_stats, &l_budget]()
+		{
+			InFlightMemoryGuard l_guard{ l_budget, l_jobMemory };
+			auto l_result = WsResult::Fail;
+
+			try
+			{
+				l_result = ConvertFile(l_inputPath, l_outputPath, l_desc, l_stats);
+			}
+			catch (const std::exception& e)
+			{
+				Logger::Log(LogLevel::Error, "WsConvert: ", e.what());
+			}
+
+			if (l_result == WsResult::Success)
+			{
+				l_stats.m_SucceededFiles++;
+			}
+			else
+			{
+				Logger::Log(LogLevel::Error, "WsConvert: Failed to convert ", l_inputPath.generic_string().c_str(), "!");
+				l_stats.m_FailedFiles++;
+			}
+		}));
+	}
+
+	for (auto& i : l_futures)
+	{
+		i.wait();
+	}
+
+	auto l_endTime = Timer::GetCurrentTimeFromEpoch(TimeUnit::Microsecond);
+	auto l_seconds = std::max((double)(l_endTime - l_startTime) / 1000000.0, 1e-6);
+
+	auto l_inputMB = (double)l_stats.m_InputBytes / (1024.0 * 1024.0);
+	auto l_outputMB = (double)l_stats.m_OutputBytes / (1024.0 * 1024.0);
+	auto l_audioSeconds = (double)l_stats.m_OutputDuration / 1000000.0;
+
+	Logger::Log(LogLevel::Success, "WsConvert: ", (uint64_t)l_stats.m_SucceededFiles, " files converted, ", (uint64_t)l_stats.m_FailedFiles, " failed in ", l_seconds, "s with ", (uint64_t)TaskScheduler::GetThreadCount(), " jobs.");
+	Logger::Log(LogLevel::Success, "WsConvert: Read ", l_inputMB, "MB, wrote ", l_outputMB, "MB, ", l_inputMB / l_seconds, "MB/s, ", (double)l_stats.m_SucceededFiles / l_seconds, " files/s, ", l_audioSeconds / l_seconds, "x realtime.");
+
+	TaskScheduler::Terminate();
+
+	return l_stats.m_FailedFiles ? 1 : 0;
+}
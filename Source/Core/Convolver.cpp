@@ -0,0 +1,200 @@
+#include "Convolver.h"
+#include "MathKernels.h"
+#include "Logger.h"
+
+using namespace Waveless;
+
+template<class T>
+WsResult ConvolverT<T>::Setup(const T* ir, size_t irCount, size_t channels, size_t blockSize)
+{
+	if (!ir)
+	{
+		Logger::Log(LogLevel::Warning, "Convolver impulse response is empty.");
+		return WsResult::Fail;
+	}
+
+	return Setup(&ir, 1, irCount, channels, blockSize);
+}
+
+template<class T>
+WsResult ConvolverT<T>::Setup(const T* const* irs, size_t filterCount, size_t irCount, size_t channels, size_t blockSize)
+{
+	if (!irs || !filterCount || !irCount || !channels)
+	{
+		Logger::Log(LogLevel::Warning, "Convolver impulse responses or channel count are empty.");
+		return WsResult::Fail;
+	}
+
+	m_BlockSize = blockSize ? blockSize : m_DefaultBlockSize;
+	m_PartitionCount = (irCount + m_BlockSize - 1) / m_BlockSize;
+	m_FilterCount = filterCount;
+	m_ChannelCount = channels;
+	m_Plan = RealFFTPlanT<T>::Get(2 * m_BlockSize);
+	m_BinCount = m_Plan->GetBinCount();
+
+	auto l_spectrumSize = 2 * m_BinCount;
+
+	m_Partitions.assign(m_FilterCount * m_PartitionCount * l_spectrumSize, T(0));
+	m_Scratch.resize(m_Plan->GetScratchSize());
+	m_Bins.resize(m_BinCount);
+	m_Accumulator.resize(l_spectrumSize);
+	m_Time.assign(2 * m_BlockSize, T(0));
+
+	for (size_t k = 0; k < m_FilterCount; k++)
+	{
+		if (irs[k])
+		{
+			SetImpulseResponse(k, irs[k], irCount);
+		}
+	}
+
+	m_Input.resize(m_ChannelCount * 2 * m_BlockSize);
+	m_Output.resize(m_FilterCount * m_ChannelCount * m_BlockSize);
+	m_Spectra.resize(m_ChannelCount * m_PartitionCount * l_spectrumSize);
+
+	Reset();
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult ConvolverT<T>::SetImpulseResponse(size_t filter, const T* ir, size_t irCount)
+{
+	if (!ir || filter >= m_FilterCount || irCount > m_PartitionCount * m_BlockSize)
+	{
+		Logger::Log(LogLevel::Warning, "Convolver filter ", filter, " doesn't exist or the impulse response is longer than the partitions.");
+		return WsResult::Fail;
+	}
+
+	auto l_spectrumSize = 2 * m_BinCount;
+	auto l_partitions = &m_Partitions[filter * m_PartitionCount * l_spectrumSize];
+
+	// Each partition is zero padded to the transform size, the second half of the product is the linear part
+	for (size_t p = 0; p < m_PartitionCount; p++)
+	{
+		auto l_offset = std::min(p * m_BlockSize, irCount);
+		auto l_count = std::min(m_BlockSize, irCount - l_offset);
+
+		std::fill(m_Time.begin(), m_Time.end(), T(0));
+		std::copy(ir + l_offset, ir + l_offset + l_count, m_Time.begin());
+
+		auto l_partition = l_partitions + p * l_spectrumSize;
+		m_Plan->Forward(m_Time.data(), m_Bins.data(), m_Scratch.data());
+		MathKernels::SplitComplex(m_Bins.data(), l_partition, l_partition + m_BinCount, m_BinCount);
+	}
+
+	return WsResult::Success;
+}
+
+template<class T>
+void ConvolverT<T>::Reset()
+{
+	std::fill(m_Input.begin(), m_Input.end(), T(0));
+	std::fill(m_Output.begin(), m_Output.end(), T(0));
+	std::fill(m_Spectra.begin(), m_Spectra.end(), T(0));
+	m_SpectrumIndex = 0;
+	m_FrameIndex = 0;
+}
+
+template<class T>
+void ConvolverT<T>::Process(const T* in, T* out, size_t frameCount)
+{
+	Process(in, &out, frameCount, 0, 1);
+}
+
+template<class T>
+void ConvolverT<T>::Process(const T* in, T* const* outputs, size_t frameCount, size_t firstFilter, size_t filterCount)
+{
+	// Without a successful Setup() the block size is 0 and no frame would be consumed
+	if (!m_BlockSize || firstFilter > m_FilterCount || filterCount > m_FilterCount - firstFilter)
+	{
+		Logger::Log(LogLevel::Warning, "Convolver isn't set up or filters ", (uint64_t)firstFilter, " to ", (uint64_t)(firstFilter + filterCount), " don't exist.");
+		return;
+	}
+
+	auto C = m_ChannelCount;
+	auto B = m_BlockSize;
+	size_t l_frame = 0;
+
+	while (l_frame < frameCount)
+	{
+		auto l_count = std::min(B - m_FrameIndex, frameCount - l_frame);
+
+		for (size_t j = 0; j < C; j++)
+		{
+			auto l_input = &m_Input[j * 2 * B + B + m_FrameIndex];
+
+			// The input is read before the outputs are written, so in could be one of them
+			for (size_t i = 0; i < l_count; i++)
+			{
+				auto l_index = (l_frame + i) * C + j;
+				l_input[i] = in[l_index];
+
+				for (size_t k = 0; k < filterCount; k++)
+				{
+					outputs[k][l_index] = m_Output[((firstFilter + k) * C + j) * B + m_FrameIndex + i];
+				}
+			}
+		}
+
+		l_frame += l_count;
+		m_FrameIndex += l_count;
+
+		if (m_FrameIndex == B)
+		{
+			ProcessBlock(firstFilter, filterCount);
+			m_FrameIndex = 0;
+		}
+	}
+}
+
+template<class T>
+void ConvolverT<T>::ProcessBlock(size_t firstFilter, size_t filterCount)
+{
+	auto B = m_BlockSize;
+	auto P = m_PartitionCount;
+	auto N = m_BinCount;
+	auto l_accumulator = m_Accumulator.data();
+
+	for (size_t j = 0; j < m_ChannelCount; j++)
+	{
+		auto l_input = &m_Input[j * 2 * B];
+		auto l_spectra = &m_Spectra[j * P * 2 * N];
+		auto l_spectrum = l_spectra + m_SpectrumIndex * 2 * N;
+
+		// The input block is transformed once for all filters
+		m_Plan->Forward(l_input, m_Bins.data(), m_Scratch.data());
+		MathKernels::SplitComplex(m_Bins.data(), l_spectrum, l_spectrum + N, N);
+
+		for (size_t k = firstFilter; k < firstFilter + filterCount; k++)
+		{
+			auto l_partitions = &m_Partitions[k * P * 2 * N];
+
+			std::fill(m_Accumulator.begin(), m_Accumulator.end(), T(0));
+
+			// Partition p meets the input block of p blocks ago
+			for (size_t p = 0; p < P; p++)
+			{
+				auto l_x = l_spectra + (m_SpectrumIndex + P - p) % P * 2 * N;
+				auto l_h = l_partitions + p * 2 * N;
+				MathKernels::ComplexMultiplyAdd(l_x, l_x + N, l_h, l_h + N, l_accumulator, l_accumulator + N, N);
+			}
+
+			MathKernels::MergeComplex(l_accumulator, l_accumulator + N, m_Bins.data(), N);
+			m_Plan->Inverse(m_Bins.data(), m_Time.data(), m_Scratch.data());
+
+			// The first half wrapped around the circular convolution
+			std::copy(m_Time.begin() + B, m_Time.end(), m_Output.begin() + (k * m_ChannelCount + j) * B);
+		}
+
+		std::copy(l_input + B, l_input + 2 * B, l_input);
+	}
+
+	m_SpectrumIndex = (m_SpectrumIndex + 1) % P;
+}
+
+namespace Waveless
+{
+	template class ConvolverT<float>;
+	template class ConvolverT<double>;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include "Math.h"
+#include "FFTPlan.h"
+
+namespace Waveless
+{
+	///
+	/// Streaming FIR convolution of interleaved multichannel samples with a uniformly partitioned overlap-save.
+	/// The impulse response is cut into partitions of the block size, each block of input is transformed once
+	/// and multiplied with the spectra of all partitions, so the cost per sample grows with irCount / blockSize instead of irCount.
+	/// Several filters could share the spectra of the input, each one adds a multiply-add per partition and an inverse transform per block.
+	/// The output is delayed by the block size, smaller blocks mean less latency and more partitions.
+	///
+	template<class T>
+	class ConvolverT
+	{
+	public:
+		static constexpr size_t m_DefaultBlockSize = 512;
+
+		ConvolverT() = default;
+		~ConvolverT() = default;
+
+		///
+		/// Transform the partitions of the impulse response, every channel is convolved with the same one. 0 picks the default block size
+		///
+		WsResult Setup(const T* ir, size_t irCount, size_t channels = 1, size_t blockSize = 0);
+
+		///
+		/// Transform the partitions of filterCount impulse responses of up to irCount samples, irs[k] could be nullptr for a filter set later
+		///
+		WsResult Setup(const T* const* irs, size_t filterCount, size_t irCount, size_t channels = 1, size_t blockSize = 0);
+
+		///
+		/// Replace the impulse response of a filter, irCount is at most the one of Setup. The history is kept so it could change while streaming
+		///
+		WsResult SetImpulseResponse(size_t filter, const T* ir, size_t irCount);
+
+		///
+		/// Clear the history of the input
+		///
+		void Reset();
+
+		///
+		/// Convolve frameCount interleaved frames with the first filter, in could be the same as out
+		///
+		void Process(const T* in, T* out, size_t frameCount);
+
+		///
+		/// Convolve frameCount interleaved frames with the filters [firstFilter, firstFilter + filterCount), outputs[k] receives the frames of filter firstFilter + k.
+		/// in could be one of the outputs. The filters share the history of the input, a stream should keep running the same ones
+		///
+		void Process(const T* in, T* const* outputs, size_t frameCount, size_t firstFilter, size_t filterCount);
+
+		size_t GetLatency() const { return m_BlockSize; }
+		size_t GetBlockSize() const { return m_BlockSize; }
+		size_t GetPartitionCount() const { return m_PartitionCount; }
+		size_t GetFilterCount() const { return m_FilterCount; }
+		size_t GetChannelCount() const { return m_ChannelCount; }
+
+	private:
+		void ProcessBlock(size_t firstFilter, size_t filterCount);
+
+		const RealFFTPlanT<T>* m_Plan = nullptr;
+		size_t m_BlockSize = 0;
+		size_t m_BinCount = 0;
+		size_t m_PartitionCount = 0;
+		size_t m_FilterCount = 0;
+		size_t m_ChannelCount = 0;
+		// [filter][partition][2 * bin], the real parts and then the imaginary parts of a spectrum
+		std::vector<T> m_Partitions;
+
+		// [channel][2 * block size], the last block and the one being filled
+		std::vector<T> m_Input;
+		// [filter][channel][block size], the outputs of the last block
+		std::vector<T> m_Output;
+		// [channel][partition][2 * bin], the spectra of the last m_PartitionCount input blocks as a ring
+		std::vector<T> m_Spectra;
+		size_t m_SpectrumIndex = 0;
+		size_t m_FrameIndex = 0;
+
+		std::vector<T> m_Accumulator;
+		std::vector<ComplexT<T>> m_Bins;
+		std::vector<ComplexT<T>> m_Scratch;
+		std::vector<T> m_Time;
+	};
+
+	extern template class ConvolverT<float>;
+	extern template class ConvolverT<double>;
+
+	using Convolver = ConvolverT<double>;
+	using ConvolverF = ConvolverT<float>;
+}
\ No newline at end of file
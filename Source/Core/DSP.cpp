@@ -1,43 +1,230 @@
 #include "DSP.h"
+#include "MathKernels.h"
+#include "TaskScheduler.h"
+#include "Logger.h"
 
 namespace Waveless
 {
-	ComplexArray DSP::Gain(const ComplexArray & x, double gainLevel)
+	namespace DSPNS
+	{
+		template<class T>
+		thread_local SpectrumT<T> t_Spectrum;
+		// The scratch spectrum of a thread is kept for signals up to this many bins, a longer one is released after the call
+		constexpr size_t m_MaxCachedBinCount = 1 << 16;
+
+		template<class T>
+		void ReleaseLargeSpectrum(SpectrumT<T>& X)
+		{
+			if (X.m_Real.capacity() > m_MaxCachedBinCount)
+			{
+				X = SpectrumT<T>();
+			}
+		}
+
+		// The frames decoded at a time, the planar blocks of a few channels stay in the L1 cache
+		constexpr size_t m_StatisticsBlockSize = 1024;
+		// The least frames that are split across the workers
+		constexpr size_t m_MinParallelFrameCount = 1 << 16;
+
+		template<SampleFormat F>
+		struct SampleFormatTraits;
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::UInt8>
+		{
+			static constexpr size_t m_Size = 1;
+			// The largest code, both ends of the integer range count as clipped
+			static constexpr double m_ClipLevel = 127.0 / 128.0;
+			static double Decode(const unsigned char* p) { return ((double)p[0] - 128.0) / 128.0; }
+		};
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::Int16>
+		{
+			static constexpr size_t m_Size = 2;
+			static constexpr double m_ClipLevel = 32767.0 / 32768.0;
+			static double Decode(const unsigned char* p)
+			{
+				int16_t l_sample;
+				std::memcpy(&l_sample, p, 2);
+				return (double)l_sample / 32768.0;
+			}
+		};
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::Int24>
+		{
+			static constexpr size_t m_Size = 3;
+			static constexpr double m_ClipLevel = 8388607.0 / 8388608.0;
+			static double Decode(const unsigned char* p)
+			{
+				auto l_sample = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+				return (double)l_sample / 8388608.0;
+			}
+		};
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::Int32>
+		{
+			static constexpr size_t m_Size = 4;
+			static constexpr double m_ClipLevel = 2147483647.0 / 2147483648.0;
+			static double Decode(const unsigned char* p)
+			{
+				int32_t l_sample;
+				std::memcpy(&l_sample, p, 4);
+				return (double)l_sample / 2147483648.0;
+			}
+		};
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::Float32>
+		{
+			static constexpr size_t m_Size = 4;
+			static constexpr double m_ClipLevel = 1.0;
+			static double Decode(const unsigned char* p)
+			{
+				float l_sample;
+				std::memcpy(&l_sample, p, 4);
+				return l_sample;
+			}
+		};
+
+		template<>
+		struct SampleFormatTraits<SampleFormat::Float64>
+		{
+			static constexpr size_t m_Size = 8;
+			static constexpr double m_ClipLevel = 1.0;
+			static double Decode(const unsigned char* p)
+			{
+				double l_sample;
+				std::memcpy(&l_sample, p, 8);
+				return l_sample;
+			}
+		};
+
+		///
+		/// The same statistics as the kernels, x[-1] is the sample before the first one
+		///
+		void AccumulateScalar(const double* x, size_t count, double clipLevel, StatisticsAccumulator<double>& accumulator)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				auto l_abs = std::isnan(x[i]) ? 0.0 : std::abs(x[i]);
+
+				accumulator.m_Peak = std::max(accumulator.m_Peak, l_abs);
+				accumulator.m_Sum += x[i];
+				accumulator.m_SquareSum += x[i] * x[i];
+				accumulator.m_ZeroCrossingCount += std::signbit(x[i]) != std::signbit(x[i - 1]);
+				accumulator.m_ClippedCount += l_abs >= clipLevel;
+			}
+		}
+
+		///
+		/// Decode frames [begin, end) block by block to planar channels and accumulate each channel.
+		/// Slot 0 of a channel holds the previous sample, the first frame of the signal is its own predecessor
+		///
+		template<SampleFormat F>
+		void AccumulateFrames(const unsigned char* samples, size_t begin, size_t end, size_t channels, StatisticsAccumulator<double>* accumulators)
+		{
+			using Traits = SampleFormatTraits<F>;
+
+			constexpr size_t l_stride = m_StatisticsBlockSize + 1;
+
+			auto l_kernels = MathKernels::Get<double>();
+			auto l_frameSize = channels * Traits::m_Size;
+			std::vector<double> l_blocks(channels * l_stride);
+
+			for (size_t c = 0; c < channels; c++)
+			{
+				auto l_previousFrame = begin ? begin - 1 : 0;
+				l_blocks[c * l_stride] = Traits::Decode(samples + l_previousFrame * l_frameSize + c * Traits::m_Size);
+			}
+
+			for (size_t l_frame = begin; l_frame < end; l_frame += m_StatisticsBlockSize)
+			{
+				auto l_count = std::min(m_StatisticsBlockSize, end - l_frame);
+				auto l_source = samples + l_frame * l_frameSize;
+
+				for (size_t c = 0; c < channels; c++)
+				{
+					auto l_x = l_blocks.data() + c * l_stride + 1;
+
+					for (size_t i = 0; i < l_count; i++)
+					{
+						l_x[i] = Traits::Decode(l_source + i * l_frameSize + c * Traits::m_Size);
+					}
+
+					size_t l_vectorCount = 0;
+
+					if (l_kernels)
+					{
+						l_vectorCount = l_count - l_count % l_kernels->m_Width;
+						l_kernels->m_Statistics(l_x, l_vectorCount, Traits::m_ClipLevel, accumulators[c]);
+					}
+
+					AccumulateScalar(l_x + l_vectorCount, l_count - l_vectorCount, Traits::m_ClipLevel, accumulators[c]);
+
+					l_x[-1] = l_x[l_count - 1];
+				}
+			}
+		}
+
+		template<SampleFormat F>
+		void AccumulateSignal(const unsigned char* samples, size_t frameCount, size_t channels, std::vector<StatisticsAccumulator<double>>& accumulators)
+		{
+			// One set of channels per chunk, summed in the chunk order afterwards
+			auto l_chunkCount = frameCount < m_MinParallelFrameCount ? 1 : TaskScheduler::GetThreadCount();
+			accumulators.assign(l_chunkCount * channels, {});
+
+			TaskScheduler::ParallelFor(frameCount, [&](size_t begin, size_t end, size_t chunkIndex)
+			{
+				AccumulateFrames<F>(samples, begin, end, channels, accumulators.data() + chunkIndex * channels);
+			}, m_MinParallelFrameCount);
+		}
+	}
+
+	template<class T>
+	ComplexArrayT<T> DSP::Gain(const ComplexArrayT<T> & x, double gainLevel)
 	{
 		auto N = x.size();
-		ComplexArray l_xProcessed(N);
+		ComplexArrayT<T> l_xProcessed(N);
+		auto l_gain = (T)Math::DB2LinearAmp(gainLevel);
 
 		for (size_t i = 0; i < N; i++)
 		{
-			l_xProcessed[i] = x[i] * Math::DB2LinearAmp(gainLevel);
+			l_xProcessed[i] = x[i] * l_gain;
 		}
 
 		return l_xProcessed;
 	}
 
-	ComplexArray DSP::LPF(const ComplexArray & x, double fs, double cutOffFreq)
+	template<class T>
+	ComplexArrayT<T> DSP::LPF(const ComplexArrayT<T> & x, double fs, double cutOffFreq)
 	{
-		auto l_X = x;
-		Math::FFT_SingleFrame(l_X);
-		auto l_XBin = Math::FreqDomainSeries2FreqBin_SingleFrame(l_X, fs);
-		auto l_xProcessed = LPF(l_XBin, cutOffFreq);
+		auto& l_X = DSPNS::t_Spectrum<T>;
+		Math::TimeDomainSeries2Spectrum_SingleFrame(x, fs, l_X);
+		LPF(l_X, cutOffFreq);
 
-		return l_xProcessed;
+		auto l_result = Math::Synth_SingleFrame(l_X);
+		DSPNS::ReleaseLargeSpectrum(l_X);
+
+		return l_result;
 	}
 
-	ComplexArray DSP::LPF(const FreqBinData & XBinData, double cutOffFreq)
+	template<class T>
+	ComplexArrayT<T> DSP::LPF(const FreqBinDataT<T> & XBinData, double cutOffFreq)
 	{
 		auto N = XBinData.m_FreqBinArray.size();
 
-		ComplexArray l_xProcessed(N);
-		FreqBinData l_XBinProcessed;
+		ComplexArrayT<T> l_xProcessed(N);
+		FreqBinDataT<T> l_XBinProcessed;
 
 		l_XBinProcessed.m_FreqBinArray.reserve(N);
 
 		for (size_t i = 0; i < N; i++)
 		{
 			// @TODO: cut-off curve
-			auto l_mag = XBinData.m_FreqBinArray[i].first <= cutOffFreq ? XBinData.m_FreqBinArray[i].second : 0.0;
+			auto l_mag = XBinData.m_FreqBinArray[i].first <= cutOffFreq ? XBinData.m_FreqBinArray[i].second : ComplexT<T>(0);
 			l_XBinProcessed.m_FreqBinArray.emplace_back(XBinData.m_FreqBinArray[i].first, l_mag);
 		}
 
@@ -46,29 +233,48 @@ namespace Waveless
 		return l_xProcessed;
 	}
 
-	ComplexArray DSP::HPF(const ComplexArray & x, double fs, double cutOffFreq)
+	template<class T>
+	void DSP::LPF(SpectrumT<T>& X, double cutOffFreq)
 	{
-		auto l_X = x;
-		Math::FFT_SingleFrame(l_X);
-		auto l_XBin = Math::FreqDomainSeries2FreqBin_SingleFrame(l_X, fs);
-		auto l_xProcessed = HPF(l_XBin, cutOffFreq);
+		auto l_binCount = X.GetBinCount();
 
-		return l_xProcessed;
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			if (X.GetFrequency(i) > cutOffFreq)
+			{
+				X.m_Real[i] = T(0);
+				X.m_Imag[i] = T(0);
+			}
+		}
 	}
 
-	ComplexArray DSP::HPF(const FreqBinData & XBinData, double cutOffFreq)
+	template<class T>
+	ComplexArrayT<T> DSP::HPF(const ComplexArrayT<T> & x, double fs, double cutOffFreq)
+	{
+		auto& l_X = DSPNS::t_Spectrum<T>;
+		Math::TimeDomainSeries2Spectrum_SingleFrame(x, fs, l_X);
+		HPF(l_X, cutOffFreq);
+
+		auto l_result = Math::Synth_SingleFrame(l_X);
+		DSPNS::ReleaseLargeSpectrum(l_X);
+
+		return l_result;
+	}
+
+	template<class T>
+	ComplexArrayT<T> DSP::HPF(const FreqBinDataT<T> & XBinData, double cutOffFreq)
 	{
 		auto N = XBinData.m_FreqBinArray.size();
 
-		ComplexArray l_xProcessed(N);
-		FreqBinData l_XBinProcessed;
+		ComplexArrayT<T> l_xProcessed(N);
+		FreqBinDataT<T> l_XBinProcessed;
 
 		l_XBinProcessed.m_FreqBinArray.reserve(N);
 
 		for (size_t i = 0; i < N; i++)
 		{
 			// @TODO: cut-off curve
-			auto l_mag = XBinData.m_FreqBinArray[i].first >= cutOffFreq ? XBinData.m_FreqBinArray[i].second : 0.0;
+			auto l_mag = XBinData.m_FreqBinArray[i].first >= cutOffFreq ? XBinData.m_FreqBinArray[i].second : ComplexT<T>(0);
 			l_XBinProcessed.m_FreqBinArray.emplace_back(XBinData.m_FreqBinArray[i].first, l_mag);
 		}
 
@@ -76,4 +282,110 @@ namespace Waveless
 
 		return l_xProcessed;
 	}
+
+	template<class T>
+	void DSP::HPF(SpectrumT<T>& X, double cutOffFreq)
+	{
+		auto l_binCount = X.GetBinCount();
+
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			if (X.GetFrequency(i) < cutOffFreq)
+			{
+				X.m_Real[i] = T(0);
+				X.m_Imag[i] = T(0);
+			}
+		}
+	}
+
+	WsResult DSP::GetSignalStatistics(const void* samples, size_t frameCount, size_t channels, SampleFormat format, std::vector<SignalStatistics>& statistics)
+	{
+		using namespace DSPNS;
+
+		if (!channels || (frameCount && !samples))
+		{
+			Logger::Log(LogLevel::Warning, "DSP: Invalid signal of ", channels, " channels for the statistics!");
+			return WsResult::Fail;
+		}
+
+		statistics.assign(channels, {});
+
+		if (!frameCount)
+		{
+			return WsResult::Success;
+		}
+
+		auto l_samples = reinterpret_cast<const unsigned char*>(samples);
+		std::vector<StatisticsAccumulator<double>> l_accumulators;
+
+		switch (format)
+		{
+		case SampleFormat::UInt8:
+			AccumulateSignal<SampleFormat::UInt8>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		case SampleFormat::Int16:
+			AccumulateSignal<SampleFormat::Int16>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		case SampleFormat::Int24:
+			AccumulateSignal<SampleFormat::Int24>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		case SampleFormat::Int32:
+			AccumulateSignal<SampleFormat::Int32>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		case SampleFormat::Float32:
+			AccumulateSignal<SampleFormat::Float32>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		case SampleFormat::Float64:
+			AccumulateSignal<SampleFormat::Float64>(l_samples, frameCount, channels, l_accumulators);
+			break;
+		default:
+			Logger::Log(LogLevel::Warning, "DSP: Unsupported sample format ", (uint32_t)format, " for the statistics!");
+			return WsResult::Fail;
+		}
+
+		for (size_t i = channels; i < l_accumulators.size(); i++)
+		{
+			auto& l_total = l_accumulators[i % channels];
+			auto& l_partial = l_accumulators[i];
+
+			l_total.m_Peak = std::max(l_total.m_Peak, l_partial.m_Peak);
+			l_total.m_Sum += l_partial.m_Sum;
+			l_total.m_SquareSum += l_partial.m_SquareSum;
+			l_total.m_ZeroCrossingCount += l_partial.m_ZeroCrossingCount;
+			l_total.m_ClippedCount += l_partial.m_ClippedCount;
+		}
+
+		auto l_frameCount = (double)frameCount;
+
+		for (size_t c = 0; c < channels; c++)
+		{
+			auto& l_accumulator = l_accumulators[c];
+			auto& l_statistics = statistics[c];
+
+			l_statistics.m_SampleCount = frameCount;
+			l_statistics.m_Peak = l_accumulator.m_Peak;
+			l_statistics.m_RMS = std::sqrt(l_accumulator.m_SquareSum / l_frameCount);
+			l_statistics.m_DCOffset = l_accumulator.m_Sum / l_frameCount;
+			l_statistics.m_CrestFactor = l_statistics.m_RMS > 0.0 ? l_statistics.m_Peak / l_statistics.m_RMS : 0.0;
+			// The first sample has no predecessor
+			l_statistics.m_ZeroCrossingRate = frameCount > 1 ? (double)l_accumulator.m_ZeroCrossingCount / (l_frameCount - 1.0) : 0.0;
+			l_statistics.m_ClippedSampleCount = (size_t)l_accumulator.m_ClippedCount;
+		}
+
+		return WsResult::Success;
+	}
+
+#define WS_DSP_INSTANTIATE(T) \
+	template ComplexArrayT<T> DSP::Gain<T>(const ComplexArrayT<T>&, double); \
+	template ComplexArrayT<T> DSP::LPF<T>(const ComplexArrayT<T>&, double, double); \
+	template ComplexArrayT<T> DSP::LPF<T>(const FreqBinDataT<T>&, double); \
+	template void DSP::LPF<T>(SpectrumT<T>&, double); \
+	template ComplexArrayT<T> DSP::HPF<T>(const ComplexArrayT<T>&, double, double); \
+	template ComplexArrayT<T> DSP::HPF<T>(const FreqBinDataT<T>&, double); \
+	template void DSP::HPF<T>(SpectrumT<T>&, double);
+
+	WS_DSP_INSTANTIATE(float)
+	WS_DSP_INSTANTIATE(double)
+
+#undef WS_DSP_INSTANTIATE
 }
\ No newline at end of file
@@ -1,9 +1,42 @@
 #pragma once
 #include "stdafx.h"
+#include "Typedef.h"
 #include "Math.h"
 
 namespace Waveless
 {
+	///
+	/// The raw PCM sample formats, integer samples are little-endian two's complement except the unsigned 8-bit ones
+	///
+	enum class SampleFormat
+	{
+		UInt8,
+		Int16,
+		Int24,
+		Int32,
+		Float32,
+		Float64
+	};
+
+	///
+	/// The level statistics of one channel, with the samples normalized to [-1.0, 1.0].
+	/// A NaN sample of the float formats is left out of the peak and the clipped samples, the RMS and the DC offset become NaN
+	///
+	struct SignalStatistics
+	{
+		size_t m_SampleCount = 0;
+		double m_Peak = 0.0;
+		double m_RMS = 0.0;
+		// The mean of the samples
+		double m_DCOffset = 0.0;
+		// Peak / RMS, 0 for a silent channel
+		double m_CrestFactor = 0.0;
+		// The sign changes per sample
+		double m_ZeroCrossingRate = 0.0;
+		// The samples at the largest code of the integer formats or at 1.0 and above of the float formats
+		size_t m_ClippedSampleCount = 0;
+	};
+
 	class DSP
 	{
 	public:
@@ -11,14 +44,31 @@ namespace Waveless
 		~DSP() = default;
 
 		// gain level in dB
-		static ComplexArray Gain(const ComplexArray& x, double gainLevel);
+		template<class T>
+		static ComplexArrayT<T> Gain(const ComplexArrayT<T>& x, double gainLevel);
 
 		// cutOffFreq in Hz
-		static ComplexArray LPF(const ComplexArray& x, double fs, double cutOffFreq);
-		static ComplexArray LPF(const FreqBinData& x, double cutOffFreq);
+		template<class T>
+		static ComplexArrayT<T> LPF(const ComplexArrayT<T>& x, double fs, double cutOffFreq);
+		template<class T>
+		static ComplexArrayT<T> LPF(const FreqBinDataT<T>& x, double cutOffFreq);
+		// An ideal brick-wall filter, the bins above cutOffFreq are zeroed in place
+		template<class T>
+		static void LPF(SpectrumT<T>& X, double cutOffFreq);
 
 		// cutOffFreq in Hz
-		static ComplexArray HPF(const ComplexArray& x, double fs, double cutOffFreq);
-		static ComplexArray HPF(const FreqBinData& x, double cutOffFreq);
+		template<class T>
+		static ComplexArrayT<T> HPF(const ComplexArrayT<T>& x, double fs, double cutOffFreq);
+		template<class T>
+		static ComplexArrayT<T> HPF(const FreqBinDataT<T>& x, double cutOffFreq);
+		// An ideal brick-wall filter, the bins below cutOffFreq are zeroed in place
+		template<class T>
+		static void HPF(SpectrumT<T>& X, double cutOffFreq);
+
+		///
+		/// Measure every channel of the interleaved raw samples in one pass, large signals are split across the worker threads.
+		/// statistics receives one entry per channel
+		///
+		static WsResult GetSignalStatistics(const void* samples, size_t frameCount, size_t channels, SampleFormat format, std::vector<SignalStatistics>& statistics);
 	};
 }
\ No newline at end of file
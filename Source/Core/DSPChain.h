@@ -0,0 +1,330 @@
+#pragma once
+#include "stdafx.h"
+#include "DSP.h"
+#include "FFTPlan.h"
+#include "IIRFilter.h"
+#include <tuple>
+#include <utility>
+
+namespace Waveless
+{
+	///
+	/// The stages of a DSPChainT. A stage declares IsSpectral and implements Process(ComplexT<T>*, size_t, double fs) for the time domain,
+	/// Process(SpectrumT<T>&) for the frequency domain, or both when it could run in either of them.
+	///
+	namespace DSPStage
+	{
+		// gain level in dB
+		template<class T>
+		struct Gain
+		{
+			using ValueType = T;
+			static constexpr bool IsSpectral = false;
+
+			explicit Gain(double gainLevel) : m_Gain((T)Math::DB2LinearAmp(gainLevel)) {}
+
+			void Process(ComplexT<T>* x, size_t N, double fs) const
+			{
+				for (size_t i = 0; i < N; i++)
+				{
+					x[i] *= m_Gain;
+				}
+			}
+
+			// A scalar gain is linear, it could be applied to the bins between two spectral stages as well
+			void Process(SpectrumT<T>& X) const
+			{
+				auto l_binCount = X.GetBinCount();
+
+				for (size_t i = 0; i < l_binCount; i++)
+				{
+					X.m_Real[i] *= m_Gain;
+					X.m_Imag[i] *= m_Gain;
+				}
+			}
+
+			T m_Gain;
+		};
+
+		// cutOffFreq in Hz
+		template<class T>
+		struct LPF
+		{
+			using ValueType = T;
+			static constexpr bool IsSpectral = true;
+
+			explicit LPF(double cutOffFreq) : m_CutOffFreq(cutOffFreq) {}
+
+			void Process(SpectrumT<T>& X) const
+			{
+				DSP::LPF(X, m_CutOffFreq);
+			}
+
+			double m_CutOffFreq;
+		};
+
+		// cutOffFreq in Hz
+		template<class T>
+		struct HPF
+		{
+			using ValueType = T;
+			static constexpr bool IsSpectral = true;
+
+			explicit HPF(double cutOffFreq) : m_CutOffFreq(cutOffFreq) {}
+
+			void Process(SpectrumT<T>& X) const
+			{
+				DSP::HPF(X, m_CutOffFreq);
+			}
+
+			double m_CutOffFreq;
+		};
+
+		// Streaming IIR filter over the real parts, unlike LPF and HPF it has a slope and no pre-ringing.
+		// The state is kept between the calls so a signal could be processed block by block, the filter is set up again only when fs changes
+		template<class T>
+		struct IIR
+		{
+			using ValueType = T;
+			static constexpr bool IsSpectral = false;
+
+			explicit IIR(const FilterDesc& filterDesc) : m_FilterDesc(filterDesc) {}
+
+			void Process(ComplexT<T>* x, size_t N, double fs)
+			{
+				if (fs != m_SampleRate)
+				{
+					if (m_Filter.Setup(m_FilterDesc, fs) != WsResult::Success)
+					{
+						return;
+					}
+
+					m_SampleRate = fs;
+				}
+
+				constexpr size_t l_blockSize = 256;
+				T l_block[l_blockSize];
+
+				for (size_t i = 0; i < N; i += l_blockSize)
+				{
+					auto l_count = std::min(l_blockSize, N - i);
+
+					for (size_t j = 0; j < l_count; j++)
+					{
+						l_block[j] = x[i + j].real();
+					}
+
+					m_Filter.Process(l_block, l_count);
+
+					for (size_t j = 0; j < l_count; j++)
+					{
+						x[i + j] = l_block[j];
+					}
+				}
+			}
+
+			// Start a new signal
+			void Reset()
+			{
+				m_Filter.Reset();
+			}
+
+			FilterDesc m_FilterDesc;
+			IIRFilterT<T> m_Filter;
+			double m_SampleRate = 0.0;
+		};
+	}
+
+	namespace DSPChainNS
+	{
+		template<class T>
+		struct Scratch
+		{
+			std::vector<T> m_Real;
+			std::vector<ComplexT<T>> m_Bins;
+			SpectrumT<T> m_Spectrum;
+		};
+
+		template<class T>
+		inline thread_local Scratch<T> t_Scratch;
+
+		// The indices of the first and the last spectral stage, Count when there is none
+		template<class... Stages>
+		constexpr size_t FirstSpectral()
+		{
+			constexpr bool l_isSpectral[] = { Stages::IsSpectral..., false };
+
+			for (size_t i = 0; i < sizeof...(Stages); i++)
+			{
+				if (l_isSpectral[i])
+				{
+					return i;
+				}
+			}
+
+			return sizeof...(Stages);
+		}
+
+		template<class... Stages>
+		constexpr size_t LastSpectral()
+		{
+			constexpr bool l_isSpectral[] = { Stages::IsSpectral..., false };
+
+			for (size_t i = sizeof...(Stages); i > 0; i--)
+			{
+				if (l_isSpectral[i - 1])
+				{
+					return i - 1;
+				}
+			}
+
+			return sizeof...(Stages);
+		}
+	}
+
+	///
+	/// A fixed sequence of DSP stages composed at compile time and run in a single pass over the caller's buffers.
+	/// The time domain stages before the first spectral stage run on the input samples, every stage from the first to the last spectral one
+	/// runs on a single shared spectrum, and the remaining time domain stages run on the output samples.
+	/// So the whole chain costs at most one forward and one inverse transform, and nothing is allocated after the first call of a thread with the same size.
+	/// The streaming stages keep their state between the calls, the chain is processing one signal at a time.
+	///
+	template<class T, class... Stages>
+	class DSPChainT
+	{
+	public:
+		explicit DSPChainT(Stages... stages) : m_Stages(std::move(stages)...) {}
+		~DSPChainT() = default;
+
+		///
+		/// Process N samples of x into y, x could be the same as y
+		///
+		void Process(const ComplexT<T>* x, ComplexT<T>* y, size_t N, double fs)
+		{
+			if (x != y)
+			{
+				std::copy(x, x + N, y);
+			}
+
+			if constexpr (m_FirstSpectral == sizeof...(Stages))
+			{
+				ProcessTime(y, N, fs, std::make_index_sequence<sizeof...(Stages)>());
+			}
+			else
+			{
+				ProcessTime(y, N, fs, std::make_index_sequence<m_FirstSpectral>());
+
+				if (N)
+				{
+					ProcessSpectrum(y, N, fs);
+				}
+
+				ProcessTime(y, N, fs, OffsetSequence<m_LastSpectral + 1>(std::make_index_sequence<sizeof...(Stages) - m_LastSpectral - 1>()));
+			}
+		}
+
+		///
+		/// Process x into y, y is resized to the size of x and could be the same as x
+		///
+		void Process(const ComplexArrayT<T>& x, ComplexArrayT<T>& y, double fs)
+		{
+			if (y.size() != x.size())
+			{
+				y.resize(x.size());
+			}
+
+			if (x.size())
+			{
+				Process(&x[0], &y[0], x.size(), fs);
+			}
+		}
+
+		ComplexArrayT<T> Process(const ComplexArrayT<T>& x, double fs)
+		{
+			ComplexArrayT<T> y(x.size());
+			Process(x, y, fs);
+
+			return y;
+		}
+
+		///
+		/// A new chain with the stages appended
+		///
+		template<class... Next>
+		DSPChainT<T, Stages..., Next...> Then(Next... next) const
+		{
+			return std::apply([&](const Stages&... stages) { return DSPChainT<T, Stages..., Next...>(stages..., std::move(next)...); }, m_Stages);
+		}
+
+	private:
+		static constexpr size_t m_FirstSpectral = DSPChainNS::FirstSpectral<Stages...>();
+		static constexpr size_t m_LastSpectral = DSPChainNS::LastSpectral<Stages...>();
+
+		template<size_t Offset, size_t... I>
+		static constexpr std::index_sequence<(Offset + I)...> OffsetSequence(std::index_sequence<I...>) { return {}; }
+
+		template<size_t... I>
+		void ProcessTime(ComplexT<T>* x, size_t N, double fs, std::index_sequence<I...>)
+		{
+			(std::get<I>(m_Stages).Process(x, N, fs), ...);
+		}
+
+		template<size_t... I>
+		void ProcessSpectrumStages(SpectrumT<T>& X, std::index_sequence<I...>)
+		{
+			(std::get<I>(m_Stages).Process(X), ...);
+		}
+
+		void ProcessSpectrum(ComplexT<T>* x, size_t N, double fs)
+		{
+			auto& l_scratch = DSPChainNS::t_Scratch<T>;
+			auto& l_X = l_scratch.m_Spectrum;
+			auto l_plan = RealFFTPlanT<T>::Get(N);
+
+			l_scratch.m_Real.resize(N);
+			l_scratch.m_Bins.resize(l_plan->GetBinCount());
+			l_X.m_SampleRate = fs;
+			l_X.Resize(N);
+
+			for (size_t i = 0; i < N; i++)
+			{
+				l_scratch.m_Real[i] = x[i].real();
+			}
+
+			l_plan->Forward(l_scratch.m_Real.data(), l_scratch.m_Bins.data());
+
+			auto l_binCount = l_X.GetBinCount();
+
+			for (size_t i = 0; i < l_binCount; i++)
+			{
+				l_X.m_Real[i] = l_scratch.m_Bins[i].real();
+				l_X.m_Imag[i] = l_scratch.m_Bins[i].imag();
+			}
+
+			ProcessSpectrumStages(l_X, OffsetSequence<m_FirstSpectral>(std::make_index_sequence<m_LastSpectral - m_FirstSpectral + 1>()));
+
+			for (size_t i = 0; i < l_binCount; i++)
+			{
+				l_scratch.m_Bins[i] = l_X.GetBin(i);
+			}
+
+			l_plan->Inverse(l_scratch.m_Bins.data(), l_scratch.m_Real.data());
+
+			for (size_t i = 0; i < N; i++)
+			{
+				x[i] = l_scratch.m_Real[i];
+			}
+		}
+
+		std::tuple<Stages...> m_Stages;
+	};
+
+	///
+	/// Compose a chain of stages, the sample type is the one of the first stage
+	///
+	template<class First, class... Rest>
+	DSPChainT<typename First::ValueType, First, Rest...> MakeDSPChain(First first, Rest... rest)
+	{
+		return DSPChainT<typename First::ValueType, First, Rest...>(std::move(first), std::move(rest)...);
+	}
+}
\ No newline at end of file
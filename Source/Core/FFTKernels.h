@@ -0,0 +1,58 @@
+#pragma once
+#include "stdafx.h"
+#include "SIMD.h"
+
+namespace Waveless
+{
+	///
+	/// One Stockham stage over interleaved complex values, with the radix-specific (m_Radix - 1) twiddles per butterfly.
+	/// The s interleaved sub-transforms are processed m_Width at a time, so s has to be a multiple of m_Width.
+	///
+	template<class T>
+	using FFTStageKernel = void(*)(const T* src, T* dst, size_t s, size_t m, const T* twiddles);
+
+	template<class T>
+	struct FFTKernelTable
+	{
+		size_t m_Width;
+		// Forward at index 0 and inverse at index 1
+		FFTStageKernel<T> m_Radix2[2];
+		FFTStageKernel<T> m_Radix4[2];
+		FFTStageKernel<T> m_Radix8[2];
+	};
+
+	///
+	/// The vectorized kernels of every instruction set, each one is compiled in its own translation unit with the matching target flags.
+	/// nullptr if the instruction set is not available for the target architecture.
+	///
+	namespace FFTKernels
+	{
+		template<class T>
+		const FFTKernelTable<T>* GetSSE2();
+
+		template<class T>
+		const FFTKernelTable<T>* GetAVX2();
+
+		template<class T>
+		const FFTKernelTable<T>* GetAVX512();
+
+		///
+		/// The kernels of SIMD::GetInstructionSet(), nullptr for the scalar path
+		///
+		template<class T>
+		const FFTKernelTable<T>* Get()
+		{
+			switch (SIMD::GetInstructionSet())
+			{
+			case InstructionSet::AVX512:
+				return GetAVX512<T>();
+			case InstructionSet::AVX2:
+				return GetAVX2<T>();
+			case InstructionSet::SSE2:
+				return GetSSE2<T>();
+			default:
+				return nullptr;
+			}
+		}
+	}
+}
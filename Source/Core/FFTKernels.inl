@@ -0,0 +1,202 @@
+// The vectorized Stockham stages, included by every FFTKernels_<ISA>.cpp after the definition of its register traits.
+// A traits class V provides Scalar, Reg, Width, Zero(), Set1(), Add(), Sub(), Mul(),
+// and Load() / Store() which split Width interleaved complex values into real and imaginary registers and back.
+// Only intrinsics are used here, so no inline function of another translation unit is compiled with the target flags.
+
+namespace
+{
+	using namespace Waveless;
+
+	template<class V>
+	struct SplitComplex
+	{
+		typename V::Reg re;
+		typename V::Reg im;
+	};
+
+	template<class V>
+	inline SplitComplex<V> Load(const typename V::Scalar* p)
+	{
+		SplitComplex<V> l_result;
+		V::Load(p, l_result.re, l_result.im);
+		return l_result;
+	}
+
+	template<class V>
+	inline void Store(typename V::Scalar* p, const SplitComplex<V>& x)
+	{
+		V::Store(p, x.re, x.im);
+	}
+
+	template<class V>
+	inline SplitComplex<V> Add(const SplitComplex<V>& lhs, const SplitComplex<V>& rhs)
+	{
+		return { V::Add(lhs.re, rhs.re), V::Add(lhs.im, rhs.im) };
+	}
+
+	template<class V>
+	inline SplitComplex<V> Sub(const SplitComplex<V>& lhs, const SplitComplex<V>& rhs)
+	{
+		return { V::Sub(lhs.re, rhs.re), V::Sub(lhs.im, rhs.im) };
+	}
+
+	template<class V>
+	inline SplitComplex<V> Mul(const SplitComplex<V>& lhs, const SplitComplex<V>& rhs)
+	{
+		return { V::Sub(V::Mul(lhs.re, rhs.re), V::Mul(lhs.im, rhs.im)), V::Add(V::Mul(lhs.re, rhs.im), V::Mul(lhs.im, rhs.re)) };
+	}
+
+	// The same twiddle for all the lanes, conjugated for the inverse transform
+	template<class V, bool Inverse>
+	inline SplitComplex<V> Broadcast(const typename V::Scalar* w)
+	{
+		return { V::Set1(w[0]), V::Set1(Inverse ? -w[1] : w[1]) };
+	}
+
+	// Multiply by -j for the forward transform and by j for the inverse transform
+	template<class V, bool Inverse>
+	inline SplitComplex<V> RotateQuarter(const SplitComplex<V>& x)
+	{
+		if (Inverse)
+		{
+			return { V::Sub(V::Zero(), x.im), x.re };
+		}
+		return { x.im, V::Sub(V::Zero(), x.re) };
+	}
+
+	// Multiply by W_8 = (1 - j) / sqrt(2) for the forward transform and by its conjugate for the inverse transform
+	template<class V, bool Inverse>
+	inline SplitComplex<V> RotateEighth(const SplitComplex<V>& x)
+	{
+		auto l_scale = V::Set1((typename V::Scalar)0.70710678118654752440);
+
+		if (Inverse)
+		{
+			return { V::Mul(V::Sub(x.re, x.im), l_scale), V::Mul(V::Add(x.re, x.im), l_scale) };
+		}
+		return { V::Mul(V::Add(x.re, x.im), l_scale), V::Mul(V::Sub(x.im, x.re), l_scale) };
+	}
+
+	template<class V, bool Inverse>
+	void Radix2(const typename V::Scalar* src, typename V::Scalar* dst, size_t s, size_t m, const typename V::Scalar* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Broadcast<V, Inverse>(twiddles + 2 * p);
+
+			for (size_t q = 0; q < s; q += V::Width)
+			{
+				auto a = Load<V>(src + 2 * (q + s * p));
+				auto b = Load<V>(src + 2 * (q + s * (p + m)));
+
+				Store<V>(dst + 2 * (q + s * (2 * p)), Add(a, b));
+				Store<V>(dst + 2 * (q + s * (2 * p + 1)), Mul(Sub(a, b), w1));
+			}
+		}
+	}
+
+	template<class V, bool Inverse>
+	void Radix4(const typename V::Scalar* src, typename V::Scalar* dst, size_t s, size_t m, const typename V::Scalar* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Broadcast<V, Inverse>(twiddles + 6 * p);
+			auto w2 = Broadcast<V, Inverse>(twiddles + 6 * p + 2);
+			auto w3 = Broadcast<V, Inverse>(twiddles + 6 * p + 4);
+
+			for (size_t q = 0; q < s; q += V::Width)
+			{
+				auto a = Load<V>(src + 2 * (q + s * p));
+				auto b = Load<V>(src + 2 * (q + s * (p + m)));
+				auto c = Load<V>(src + 2 * (q + s * (p + 2 * m)));
+				auto d = Load<V>(src + 2 * (q + s * (p + 3 * m)));
+
+				auto apc = Add(a, c);
+				auto amc = Sub(a, c);
+				auto bpd = Add(b, d);
+				auto jbmd = RotateQuarter<V, Inverse>(Sub(b, d));
+
+				Store<V>(dst + 2 * (q + s * (4 * p)), Add(apc, bpd));
+				Store<V>(dst + 2 * (q + s * (4 * p + 1)), Mul(Add(amc, jbmd), w1));
+				Store<V>(dst + 2 * (q + s * (4 * p + 2)), Mul(Sub(apc, bpd), w2));
+				Store<V>(dst + 2 * (q + s * (4 * p + 3)), Mul(Sub(amc, jbmd), w3));
+			}
+		}
+	}
+
+	// A radix-2 step over the halves, then radix-4 over the even and the odd outputs
+	template<class V, bool Inverse>
+	void Radix8(const typename V::Scalar* src, typename V::Scalar* dst, size_t s, size_t m, const typename V::Scalar* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			SplitComplex<V> w[8];
+
+			for (size_t k = 1; k < 8; k++)
+			{
+				w[k] = Broadcast<V, Inverse>(twiddles + 2 * (7 * p + k - 1));
+			}
+
+			for (size_t q = 0; q < s; q += V::Width)
+			{
+				SplitComplex<V> x[8];
+
+				for (size_t j = 0; j < 8; j++)
+				{
+					x[j] = Load<V>(src + 2 * (q + s * (p + j * m)));
+				}
+
+				SplitComplex<V> a[4];
+				SplitComplex<V> b[4];
+
+				for (size_t j = 0; j < 4; j++)
+				{
+					a[j] = Add(x[j], x[j + 4]);
+					b[j] = Sub(x[j], x[j + 4]);
+				}
+
+				b[1] = RotateEighth<V, Inverse>(b[1]);
+				b[2] = RotateQuarter<V, Inverse>(b[2]);
+				b[3] = RotateQuarter<V, Inverse>(RotateEighth<V, Inverse>(b[3]));
+
+				auto l_dst = dst + 2 * (q + s * (8 * p));
+				auto l_step = 2 * s;
+
+				// y[2k] from a and y[2k + 1] from b
+				for (size_t l_half = 0; l_half < 2; l_half++)
+				{
+					auto& y = l_half ? b : a;
+
+					auto apc = Add(y[0], y[2]);
+					auto amc = Sub(y[0], y[2]);
+					auto bpd = Add(y[1], y[3]);
+					auto jbmd = RotateQuarter<V, Inverse>(Sub(y[1], y[3]));
+
+					auto y0 = Add(apc, bpd);
+					auto y1 = Add(amc, jbmd);
+					auto y2 = Sub(apc, bpd);
+					auto y3 = Sub(amc, jbmd);
+
+					Store<V>(l_dst + l_step * l_half, l_half ? Mul(y0, w[1]) : y0);
+					Store<V>(l_dst + l_step * (2 + l_half), Mul(y1, w[2 + l_half]));
+					Store<V>(l_dst + l_step * (4 + l_half), Mul(y2, w[4 + l_half]));
+					Store<V>(l_dst + l_step * (6 + l_half), Mul(y3, w[6 + l_half]));
+				}
+			}
+		}
+	}
+
+	template<class V>
+	const FFTKernelTable<typename V::Scalar>* GetKernelTable()
+	{
+		static const FFTKernelTable<typename V::Scalar> l_table =
+		{
+			V::Width,
+			{ Radix2<V, false>, Radix2<V, true> },
+			{ Radix4<V, false>, Radix4<V, true> },
+			{ Radix8<V, false>, Radix8<V, true> },
+		};
+
+		return &l_table;
+	}
+}
@@ -0,0 +1,88 @@
+#include "FFTKernels.h"
+
+#if defined(WS_SIMD_X86)
+#include <immintrin.h>
+
+namespace
+{
+	struct AVX512Double
+	{
+		using Scalar = double;
+		using Reg = __m512d;
+		static constexpr size_t Width = 8;
+
+		static Reg Zero() { return _mm512_setzero_pd(); }
+		static Reg Set1(Scalar x) { return _mm512_set1_pd(x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm512_add_pd(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm512_sub_pd(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm512_mul_pd(lhs, rhs); }
+
+		static void Load(const Scalar* p, Reg& re, Reg& im)
+		{
+			auto l_0 = _mm512_loadu_pd(p);
+			auto l_1 = _mm512_loadu_pd(p + 8);
+			re = _mm512_unpacklo_pd(l_0, l_1);
+			im = _mm512_unpackhi_pd(l_0, l_1);
+		}
+
+		static void Store(Scalar* p, Reg re, Reg im)
+		{
+			_mm512_storeu_pd(p, _mm512_unpacklo_pd(re, im));
+			_mm512_storeu_pd(p + 8, _mm512_unpackhi_pd(re, im));
+		}
+	};
+
+	struct AVX512Float
+	{
+		using Scalar = float;
+		using Reg = __m512;
+		static constexpr size_t Width = 16;
+
+		static Reg Zero() { return _mm512_setzero_ps(); }
+		static Reg Set1(Scalar x) { return _mm512_set1_ps(x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm512_add_ps(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm512_sub_ps(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm512_mul_ps(lhs, rhs); }
+
+		static void Load(const Scalar* p, Reg& re, Reg& im)
+		{
+			auto l_0 = _mm512_loadu_ps(p);
+			auto l_1 = _mm512_loadu_ps(p + 16);
+			re = _mm512_shuffle_ps(l_0, l_1, _MM_SHUFFLE(2, 0, 2, 0));
+			im = _mm512_shuffle_ps(l_0, l_1, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+
+		static void Store(Scalar* p, Reg re, Reg im)
+		{
+			_mm512_storeu_ps(p, _mm512_unpacklo_ps(re, im));
+			_mm512_storeu_ps(p + 16, _mm512_unpackhi_ps(re, im));
+		}
+	};
+}
+
+#include "FFTKernels.inl"
+
+template<>
+const FFTKernelTable<double>* Waveless::FFTKernels::GetAVX512<double>()
+{
+	return GetKernelTable<AVX512Double>();
+}
+
+template<>
+const FFTKernelTable<float>* Waveless::FFTKernels::GetAVX512<float>()
+{
+	return GetKernelTable<AVX512Float>();
+}
+#else
+template<>
+const Waveless::FFTKernelTable<double>* Waveless::FFTKernels::GetAVX512<double>()
+{
+	return nullptr;
+}
+
+template<>
+const Waveless::FFTKernelTable<float>* Waveless::FFTKernels::GetAVX512<float>()
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,88 @@
+#include "FFTKernels.h"
+
+#if defined(WS_SIMD_X86)
+#include <emmintrin.h>
+
+namespace
+{
+	struct SSE2Double
+	{
+		using Scalar = double;
+		using Reg = __m128d;
+		static constexpr size_t Width = 2;
+
+		static Reg Zero() { return _mm_setzero_pd(); }
+		static Reg Set1(Scalar x) { return _mm_set1_pd(x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm_add_pd(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm_sub_pd(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm_mul_pd(lhs, rhs); }
+
+		static void Load(const Scalar* p, Reg& re, Reg& im)
+		{
+			auto l_0 = _mm_loadu_pd(p);
+			auto l_1 = _mm_loadu_pd(p + 2);
+			re = _mm_unpacklo_pd(l_0, l_1);
+			im = _mm_unpackhi_pd(l_0, l_1);
+		}
+
+		static void Store(Scalar* p, Reg re, Reg im)
+		{
+			_mm_storeu_pd(p, _mm_unpacklo_pd(re, im));
+			_mm_storeu_pd(p + 2, _mm_unpackhi_pd(re, im));
+		}
+	};
+
+	struct SSE2Float
+	{
+		using Scalar = float;
+		using Reg = __m128;
+		static constexpr size_t Width = 4;
+
+		static Reg Zero() { return _mm_setzero_ps(); }
+		static Reg Set1(Scalar x) { return _mm_set1_ps(x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm_add_ps(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm_sub_ps(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm_mul_ps(lhs, rhs); }
+
+		static void Load(const Scalar* p, Reg& re, Reg& im)
+		{
+			auto l_0 = _mm_loadu_ps(p);
+			auto l_1 = _mm_loadu_ps(p + 4);
+			re = _mm_shuffle_ps(l_0, l_1, _MM_SHUFFLE(2, 0, 2, 0));
+			im = _mm_shuffle_ps(l_0, l_1, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+
+		static void Store(Scalar* p, Reg re, Reg im)
+		{
+			_mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+			_mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+		}
+	};
+}
+
+#include "FFTKernels.inl"
+
+template<>
+const FFTKernelTable<double>* Waveless::FFTKernels::GetSSE2<double>()
+{
+	return GetKernelTable<SSE2Double>();
+}
+
+template<>
+const FFTKernelTable<float>* Waveless::FFTKernels::GetSSE2<float>()
+{
+	return GetKernelTable<SSE2Float>();
+}
+#else
+template<>
+const Waveless::FFTKernelTable<double>* Waveless::FFTKernels::GetSSE2<double>()
+{
+	return nullptr;
+}
+
+template<>
+const Waveless::FFTKernelTable<float>* Waveless::FFTKernels::GetSSE2<float>()
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,768 @@
+#include "FFTPlan.h"
+#include "FFTKernels.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Waveless::FFTPlanNS
+{
+	template<class Plan>
+	struct PlanCache
+	{
+		std::unordered_map<size_t, std::unique_ptr<Plan>> m_Plans;
+		std::shared_mutex m_Mutex;
+	};
+
+	template<class Plan>
+	const Plan* GetCachedPlan(size_t N)
+	{
+		static PlanCache<Plan> l_cache;
+
+		{
+			std::shared_lock<std::shared_mutex> l_lock(l_cache.m_Mutex);
+
+			auto l_result = l_cache.m_Plans.find(N);
+
+			if (l_result != l_cache.m_Plans.end())
+			{
+				return l_result->second.get();
+			}
+		}
+
+		// Built outside of the lock since Bluestein plans and real plans request other plans
+		auto l_newPlan = std::make_unique<Plan>(N);
+
+		std::unique_lock<std::shared_mutex> l_lock(l_cache.m_Mutex);
+
+		auto& l_plan = l_cache.m_Plans[N];
+
+		if (!l_plan)
+		{
+			l_plan = std::move(l_newPlan);
+		}
+
+		return l_plan.get();
+	}
+
+	template<class T>
+	thread_local std::vector<std::complex<T>> t_Scratch;
+
+	template<class T>
+	std::complex<T>* GetScratch(size_t size)
+	{
+		auto& l_scratch = t_Scratch<T>;
+
+		if (l_scratch.size() < size)
+		{
+			l_scratch.resize(size);
+		}
+
+		return l_scratch.data();
+	}
+
+	// The largest prime factor handled by the generic odd butterfly, the other sizes go through Bluestein's algorithm
+	constexpr size_t m_MaxGenericRadix = 13;
+
+	// std::complex multiplication checks for NaN and infinity, which is too slow for the butterflies
+	template<class T>
+	inline std::complex<T> Mul(const std::complex<T>& lhs, const std::complex<T>& rhs)
+	{
+		return std::complex<T>(lhs.real() * rhs.real() - lhs.imag() * rhs.imag(), lhs.real() * rhs.imag() + lhs.imag() * rhs.real());
+	}
+
+	template<bool Inverse, class T>
+	inline std::complex<T> Twiddle(const std::complex<T>& w)
+	{
+		return Inverse ? std::conj(w) : w;
+	}
+
+	// Multiply by -j for the forward transform and by j for the inverse transform
+	template<bool Inverse, class T>
+	inline std::complex<T> RotateQuarter(const std::complex<T>& x)
+	{
+		return Inverse ? std::complex<T>(-x.imag(), x.real()) : std::complex<T>(x.imag(), -x.real());
+	}
+
+	// Multiply by W_8 = (1 - j) / sqrt(2) for the forward transform and by its conjugate for the inverse transform
+	template<bool Inverse, class T>
+	inline std::complex<T> RotateEighth(const std::complex<T>& x)
+	{
+		constexpr T l_scale = T(0.70710678118654752440);
+
+		return Inverse ? std::complex<T>((x.real() - x.imag()) * l_scale, (x.real() + x.imag()) * l_scale)
+			: std::complex<T>((x.real() + x.imag()) * l_scale, (x.imag() - x.real()) * l_scale);
+	}
+
+	// The butterflies read the r inputs m apart and write r consecutive outputs, for each of the s interleaved sub-transforms
+	template<bool Inverse, class T>
+	void Radix2(const std::complex<T>* src, std::complex<T>* dst, size_t s, size_t m, const std::complex<T>* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Twiddle<Inverse>(twiddles[p]);
+
+			for (size_t q = 0; q < s; q++)
+			{
+				auto a = src[q + s * p];
+				auto b = src[q + s * (p + m)];
+
+				dst[q + s * (2 * p)] = a + b;
+				dst[q + s * (2 * p + 1)] = Mul(a - b, w1);
+			}
+		}
+	}
+
+	template<bool Inverse, class T>
+	void Radix3(const std::complex<T>* src, std::complex<T>* dst, size_t s, size_t m, const std::complex<T>* twiddles)
+	{
+		// sin(2 * pi / 3)
+		constexpr T l_sin1 = T(0.86602540378443864676);
+
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Twiddle<Inverse>(twiddles[2 * p]);
+			auto w2 = Twiddle<Inverse>(twiddles[2 * p + 1]);
+
+			for (size_t q = 0; q < s; q++)
+			{
+				auto a = src[q + s * p];
+				auto b = src[q + s * (p + m)];
+				auto c = src[q + s * (p + 2 * m)];
+
+				auto bpc = b + c;
+				auto l_real = a - bpc * T(0.5);
+				auto l_imag = RotateQuarter<Inverse>((b - c) * l_sin1);
+
+				dst[q + s * (3 * p)] = a + bpc;
+				dst[q + s * (3 * p + 1)] = Mul(l_real + l_imag, w1);
+				dst[q + s * (3 * p + 2)] = Mul(l_real - l_imag, w2);
+			}
+		}
+	}
+
+	template<bool Inverse, class T>
+	void Radix4(const std::complex<T>* src, std::complex<T>* dst, size_t s, size_t m, const std::complex<T>* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Twiddle<Inverse>(twiddles[3 * p]);
+			auto w2 = Twiddle<Inverse>(twiddles[3 * p + 1]);
+			auto w3 = Twiddle<Inverse>(twiddles[3 * p + 2]);
+
+			for (size_t q = 0; q < s; q++)
+			{
+				auto a = src[q + s * p];
+				auto b = src[q + s * (p + m)];
+				auto c = src[q + s * (p + 2 * m)];
+				auto d = src[q + s * (p + 3 * m)];
+
+				auto apc = a + c;
+				auto amc = a - c;
+				auto bpd = b + d;
+				auto jbmd = RotateQuarter<Inverse>(b - d);
+
+				dst[q + s * (4 * p)] = apc + bpd;
+				dst[q + s * (4 * p + 1)] = Mul(amc + jbmd, w1);
+				dst[q + s * (4 * p + 2)] = Mul(apc - bpd, w2);
+				dst[q + s * (4 * p + 3)] = Mul(amc - jbmd, w3);
+			}
+		}
+	}
+
+	template<bool Inverse, class T>
+	void Radix5(const std::complex<T>* src, std::complex<T>* dst, size_t s, size_t m, const std::complex<T>* twiddles)
+	{
+		// cos(2 * pi / 5), cos(4 * pi / 5), sin(2 * pi / 5), sin(4 * pi / 5)
+		constexpr T l_cos1 = T(0.30901699437494742410);
+		constexpr T l_cos2 = T(-0.80901699437494742410);
+		constexpr T l_sin1 = T(0.95105651629515357212);
+		constexpr T l_sin2 = T(0.58778525229247312917);
+
+		for (size_t p = 0; p < m; p++)
+		{
+			auto w1 = Twiddle<Inverse>(twiddles[4 * p]);
+			auto w2 = Twiddle<Inverse>(twiddles[4 * p + 1]);
+			auto w3 = Twiddle<Inverse>(twiddles[4 * p + 2]);
+			auto w4 = Twiddle<Inverse>(twiddles[4 * p + 3]);
+
+			for (size_t q = 0; q < s; q++)
+			{
+				auto a = src[q + s * p];
+				auto b = src[q + s * (p + m)];
+				auto c = src[q + s * (p + 2 * m)];
+				auto d = src[q + s * (p + 3 * m)];
+				auto e = src[q + s * (p + 4 * m)];
+
+				auto bpe = b + e;
+				auto bme = b - e;
+				auto cpd = c + d;
+				auto cmd = c - d;
+
+				auto l_real1 = a + bpe * l_cos1 + cpd * l_cos2;
+				auto l_real2 = a + bpe * l_cos2 + cpd * l_cos1;
+				auto l_imag1 = RotateQuarter<Inverse>(bme * l_sin1 + cmd * l_sin2);
+				auto l_imag2 = RotateQuarter<Inverse>(bme * l_sin2 - cmd * l_sin1);
+
+				dst[q + s * (5 * p)] = a + bpe + cpd;
+				dst[q + s * (5 * p + 1)] = Mul(l_real1 + l_imag1, w1);
+				dst[q + s * (5 * p + 2)] = Mul(l_real2 + l_imag2, w2);
+				dst[q + s * (5 * p + 3)] = Mul(l_real2 - l_imag2, w3);
+				dst[q + s * (5 * p + 4)] = Mul(l_real1 - l_imag1, w4);
+			}
+		}
+	}
+
+	// A radix-2 step over the halves, then radix-4 over the even and the odd outputs
+	template<bool Inverse, class T>
+	void Radix8(const std::complex<T>* src, std::complex<T>* dst, size_t s, size_t m, const std::complex<T>* twiddles)
+	{
+		for (size_t p = 0; p < m; p++)
+		{
+			auto l_twiddles = twiddles + 7 * p;
+
+			for (size_t q = 0; q < s; q++)
+			{
+				std::complex<T> a[4];
+				std::complex<T> b[4];
+
+				for (size_t j = 0; j < 4; j++)
+				{
+					auto l_lhs = src[q + s * (p + j * m)];
+					auto l_rhs = src[q + s * (p + (j + 4) * m)];
+
+					a[j] = l_lhs + l_rhs;
+					b[j] = l_lhs - l_rhs;
+				}
+
+				b[1] = RotateEighth<Inverse>(b[1]);
+				b[2] = RotateQuarter<Inverse>(b[2]);
+				b[3] = RotateQuarter<Inverse>(RotateEighth<Inverse>(b[3]));
+
+				// y[2k] from a and y[2k + 1] from b
+				for (size_t l_half = 0; l_half < 2; l_half++)
+				{
+					auto y = l_half ? b : a;
+
+					auto apc = y[0] + y[2];
+					auto amc = y[0] - y[2];
+					auto bpd = y[1] + y[3];
+					auto jbmd = RotateQuarter<Inverse>(y[1] - y[3]);
+
+					auto y0 = apc + bpd;
+
+					dst[q + s * (8 * p + l_half)] = l_half ? Mul(y0, Twiddle<Inverse>(l_twiddles[0])) : y0;
+					dst[q + s * (8 * p + 2 + l_half)] = Mul(amc + jbmd, Twiddle<Inverse>(l_twiddles[1 + l_half]));
+					dst[q + s * (8 * p + 4 + l_half)] = Mul(apc - bpd, Twiddle<Inverse>(l_twiddles[3 + l_half]));
+					dst[q + s * (8 * p + 6 + l_half)] = Mul(amc - jbmd, Twiddle<Inverse>(l_twiddles[5 + l_half]));
+				}
+			}
+		}
+	}
+
+	// Odd prime radix, the inputs are paired as x[j] +- x[r - j] so only the first half of the outputs needs the products.
+	// The roots table holds (cos(2 * pi * k / r), sin(2 * pi * k / r)) for k in [0, r), FixedRadix = 0 reads the radix at runtime
+	template<bool Inverse, size_t FixedRadix, class T>
+	void RadixOdd(const std::complex<T>* src, std::complex<T>* dst, size_t r, size_t s, size_t m, const std::complex<T>* twiddles, const std::complex<T>* roots)
+	{
+		const size_t R = FixedRadix ? FixedRadix : r;
+		const size_t l_half = R / 2;
+
+		std::complex<T> l_sums[m_MaxGenericRadix / 2 + 1];
+		std::complex<T> l_diffs[m_MaxGenericRadix / 2 + 1];
+
+		for (size_t p = 0; p < m; p++)
+		{
+			auto l_twiddles = twiddles + p * (R - 1);
+
+			for (size_t q = 0; q < s; q++)
+			{
+				auto a = src[q + s * p];
+				auto l_dc = a;
+
+				for (size_t j = 1; j <= l_half; j++)
+				{
+					auto l_lhs = src[q + s * (p + j * m)];
+					auto l_rhs = src[q + s * (p + (R - j) * m)];
+
+					l_sums[j] = l_lhs + l_rhs;
+					l_diffs[j] = l_lhs - l_rhs;
+					l_dc += l_sums[j];
+				}
+
+				dst[q + s * (R * p)] = l_dc;
+
+				for (size_t k = 1; k <= l_half; k++)
+				{
+					auto l_real = a;
+					std::complex<T> l_imag;
+					size_t l_rootIndex = 0;
+
+					for (size_t j = 1; j <= l_half; j++)
+					{
+						l_rootIndex += k;
+						if (l_rootIndex >= R)
+						{
+							l_rootIndex -= R;
+						}
+
+						l_real += l_sums[j] * roots[l_rootIndex].real();
+						l_imag += l_diffs[j] * roots[l_rootIndex].imag();
+					}
+
+					l_imag = RotateQuarter<Inverse>(l_imag);
+
+					dst[q + s * (R * p + k)] = Mul(l_real + l_imag, Twiddle<Inverse>(l_twiddles[k - 1]));
+					dst[q + s * (R * p + R - k)] = Mul(l_real - l_imag, Twiddle<Inverse>(l_twiddles[R - k - 1]));
+				}
+			}
+		}
+	}
+}
+
+using namespace Waveless;
+using namespace Waveless::FFTPlanNS;
+
+template<class T>
+const FFTPlanT<T>* FFTPlanT<T>::Get(size_t N)
+{
+	return GetCachedPlan<FFTPlanT<T>>(N);
+}
+
+template<class T>
+FFTPlanT<T>::FFTPlanT(size_t N) : m_Size(N)
+{
+	if (N <= 1)
+	{
+		return;
+	}
+
+	// Radix-8 stages, one radix-4 or radix-2 stage for the rest of the power of 2, then the odd factors
+	std::vector<size_t> l_radices;
+	auto l_remaining = N;
+
+	while (l_remaining % 8 == 0)
+	{
+		l_radices.emplace_back(8);
+		l_remaining /= 8;
+	}
+
+	if (l_remaining % 4 == 0)
+	{
+		l_radices.emplace_back(4);
+		l_remaining /= 4;
+	}
+	else if (l_remaining % 2 == 0)
+	{
+		l_radices.emplace_back(2);
+		l_remaining /= 2;
+	}
+
+	for (size_t l_radix = 3; l_radix <= m_MaxGenericRadix; l_radix += 2)
+	{
+		while (l_remaining % l_radix == 0)
+		{
+			l_radices.emplace_back(l_radix);
+			l_remaining /= l_radix;
+		}
+	}
+
+	if (l_remaining != 1)
+	{
+		// A large prime factor, a generic butterfly would be O(N * p)
+		size_t M = 1;
+
+		while (M < 2 * N - 1)
+		{
+			M <<= 1;
+		}
+
+		m_ConvolutionPlan = FFTPlanT::Get(M);
+		m_ScratchSize = M + m_ConvolutionPlan->GetScratchSize();
+
+		// n^2 is reduced modulo 2N before the division to keep the phase accurate for large n
+		m_Chirp.reserve(N);
+
+		for (size_t n = 0; n < N; n++)
+		{
+			auto l_phase = (n * n) % (2 * N);
+			m_Chirp.emplace_back(std::polar(1.0, -PI<double> * (double)l_phase / (double)N));
+		}
+
+		m_ChirpSpectrum.resize(M);
+		m_ChirpSpectrum[0] = std::conj(m_Chirp[0]);
+
+		for (size_t n = 1; n < N; n++)
+		{
+			m_ChirpSpectrum[n] = std::conj(m_Chirp[n]);
+			m_ChirpSpectrum[M - n] = std::conj(m_Chirp[n]);
+		}
+
+		std::vector<ComplexType> l_scratch(m_ConvolutionPlan->GetScratchSize());
+		m_ConvolutionPlan->Forward(m_ChirpSpectrum.data(), m_ChirpSpectrum.data(), l_scratch.data());
+
+		return;
+	}
+
+	m_ScratchSize = N;
+
+	auto l_length = N;
+	size_t l_stride = 1;
+
+	for (auto l_radix : l_radices)
+	{
+		Stage l_stage;
+		l_stage.m_Radix = l_radix;
+		l_stage.m_Length = l_length;
+		l_stage.m_Stride = l_stride;
+		l_stage.m_TwiddleOffset = m_Twiddles.size();
+
+		auto l_butterflyCount = l_length / l_radix;
+
+		for (size_t p = 0; p < l_butterflyCount; p++)
+		{
+			for (size_t k = 1; k < l_radix; k++)
+			{
+				m_Twiddles.emplace_back(std::polar(1.0, -2.0 * PI<double> * (double)(p * k) / (double)l_length));
+			}
+		}
+
+		// The roots of unity for the generic odd butterfly
+		if (l_radix & 1 && l_radix > 5)
+		{
+			for (size_t k = 0; k < l_radix; k++)
+			{
+				auto l_angle = 2.0 * PI<double> * (double)k / (double)l_radix;
+				m_Twiddles.emplace_back((T)std::cos(l_angle), (T)std::sin(l_angle));
+			}
+		}
+
+		m_Stages.emplace_back(l_stage);
+
+		l_length /= l_radix;
+		l_stride *= l_radix;
+	}
+}
+
+template<class T>
+template<bool Inverse>
+void FFTPlanT<T>::Execute(const ComplexType* in, ComplexType* out, ComplexType* scratch) const
+{
+	auto N = m_Size;
+
+	if (N <= 1)
+	{
+		if (N)
+		{
+			out[0] = in[0];
+		}
+		return;
+	}
+
+	if (m_ConvolutionPlan)
+	{
+		ExecuteBluestein<Inverse>(in, out, scratch);
+		return;
+	}
+
+	auto l_stageCount = m_Stages.size();
+
+	// Stockham stages ping-pong between out and scratch, the last one has to write to out
+	if (in == out && (l_stageCount & 1))
+	{
+		std::copy(in, in + N, scratch);
+		in = scratch;
+	}
+
+	auto l_kernels = FFTKernels::Get<T>();
+	auto l_src = in;
+
+	for (size_t i = 0; i < l_stageCount; i++)
+	{
+		auto& l_stage = m_Stages[i];
+		auto l_dst = ((l_stageCount - 1 - i) & 1) ? scratch : out;
+
+		auto r = l_stage.m_Radix;
+		auto s = l_stage.m_Stride;
+		auto m = l_stage.m_Length / r;
+		auto l_twiddles = m_Twiddles.data() + l_stage.m_TwiddleOffset;
+		auto l_roots = l_twiddles + m * (r - 1);
+
+		// The vectorized kernels run over the interleaved sub-transforms, which are too few in the first stages
+		if (l_kernels && !(s % l_kernels->m_Width) && !(r & (r - 1)))
+		{
+			auto l_kernel = r == 8 ? l_kernels->m_Radix8[Inverse] : r == 4 ? l_kernels->m_Radix4[Inverse] : l_kernels->m_Radix2[Inverse];
+
+			l_kernel(reinterpret_cast<const T*>(l_src), reinterpret_cast<T*>(l_dst), s, m, reinterpret_cast<const T*>(l_twiddles));
+		}
+		else
+		{
+			switch (r)
+			{
+			case 2:
+				Radix2<Inverse>(l_src, l_dst, s, m, l_twiddles);
+				break;
+			case 3:
+				Radix3<Inverse>(l_src, l_dst, s, m, l_twiddles);
+				break;
+			case 4:
+				Radix4<Inverse>(l_src, l_dst, s, m, l_twiddles);
+				break;
+			case 5:
+				Radix5<Inverse>(l_src, l_dst, s, m, l_twiddles);
+				break;
+			case 7:
+				RadixOdd<Inverse, 7>(l_src, l_dst, r, s, m, l_twiddles, l_roots);
+				break;
+			case 8:
+				Radix8<Inverse>(l_src, l_dst, s, m, l_twiddles);
+				break;
+			default:
+				RadixOdd<Inverse, 0>(l_src, l_dst, r, s, m, l_twiddles, l_roots);
+				break;
+			}
+		}
+
+		l_src = l_dst;
+	}
+
+	if (Inverse)
+	{
+		auto l_scale = T(1) / (T)N;
+
+		for (size_t i = 0; i < N; i++)
+		{
+			out[i] *= l_scale;
+		}
+	}
+}
+
+template<class T>
+template<bool Inverse>
+void FFTPlanT<T>::ExecuteBluestein(const ComplexType* in, ComplexType* out, ComplexType* scratch) const
+{
+	// X[k] = c[k] * sum(x[n] * c[n] * conj(c[k - n])) with c[n] = exp(-j * pi * n^2 / N),
+	// the inverse transform conjugates the input and the output around the forward one
+	auto N = m_Size;
+	auto M = m_ConvolutionPlan->GetSize();
+	auto l_work = scratch;
+	auto l_convolutionScratch = scratch + M;
+
+	for (size_t n = 0; n < N; n++)
+	{
+		l_work[n] = Mul(Inverse ? std::conj(in[n]) : in[n], m_Chirp[n]);
+	}
+
+	std::fill(l_work + N, l_work + M, ComplexType(0, 0));
+
+	m_ConvolutionPlan->Forward(l_work, l_work, l_convolutionScratch);
+
+	for (size_t k = 0; k < M; k++)
+	{
+		l_work[k] = Mul(l_work[k], m_ChirpSpectrum[k]);
+	}
+
+	m_ConvolutionPlan->Inverse(l_work, l_work, l_convolutionScratch);
+
+	if (Inverse)
+	{
+		auto l_scale = T(1) / (T)N;
+
+		for (size_t k = 0; k < N; k++)
+		{
+			out[k] = std::conj(Mul(l_work[k], m_Chirp[k])) * l_scale;
+		}
+	}
+	else
+	{
+		for (size_t k = 0; k < N; k++)
+		{
+			out[k] = Mul(l_work[k], m_Chirp[k]);
+		}
+	}
+}
+
+template<class T>
+void FFTPlanT<T>::Forward(const ComplexType* in, ComplexType* out, ComplexType* scratch) const
+{
+	Execute<false>(in, out, scratch);
+}
+
+template<class T>
+void FFTPlanT<T>::Inverse(const ComplexType* in, ComplexType* out, ComplexType* scratch) const
+{
+	Execute<true>(in, out, scratch);
+}
+
+template<class T>
+void FFTPlanT<T>::Forward(ComplexType* x) const
+{
+	Execute<false>(x, x, GetScratch<T>(m_ScratchSize));
+}
+
+template<class T>
+void FFTPlanT<T>::Inverse(ComplexType* x) const
+{
+	Execute<true>(x, x, GetScratch<T>(m_ScratchSize));
+}
+
+template<class T>
+const RealFFTPlanT<T>* RealFFTPlanT<T>::Get(size_t N)
+{
+	return GetCachedPlan<RealFFTPlanT<T>>(N);
+}
+
+template<class T>
+RealFFTPlanT<T>::RealFFTPlanT(size_t N) : m_Size(N)
+{
+	if (N <= 1)
+	{
+		return;
+	}
+
+	if (N & 1)
+	{
+		m_ComplexPlan = FFTPlanT<T>::Get(N);
+		m_ScratchSize = N + m_ComplexPlan->GetScratchSize();
+		return;
+	}
+
+	m_ComplexPlan = FFTPlanT<T>::Get(N / 2);
+	m_ScratchSize = N / 2 + m_ComplexPlan->GetScratchSize();
+
+	m_Twiddles.reserve(N / 4 + 1);
+
+	for (size_t k = 0; k <= N / 4; k++)
+	{
+		m_Twiddles.emplace_back(std::polar(1.0, -2.0 * PI<double> * (double)k / (double)N));
+	}
+}
+
+template<class T>
+void RealFFTPlanT<T>::Forward(const T* in, ComplexType* out, ComplexType* scratch) const
+{
+	auto N = m_Size;
+
+	if (N <= 1)
+	{
+		if (N)
+		{
+			out[0] = in[0];
+		}
+		return;
+	}
+
+	if (N & 1)
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			scratch[i] = in[i];
+		}
+
+		m_ComplexPlan->Forward(scratch, scratch, scratch + N);
+
+		std::copy(scratch, scratch + N / 2 + 1, out);
+
+		return;
+	}
+
+	auto M = N / 2;
+
+	// The even samples are the real parts and the odd samples are the imaginary parts, std::complex has the layout of T[2]
+	m_ComplexPlan->Forward(reinterpret_cast<const ComplexType*>(in), out, scratch);
+
+	auto Z0 = out[0];
+	out[0] = ComplexType(Z0.real() + Z0.imag(), 0);
+	out[M] = ComplexType(Z0.real() - Z0.imag(), 0);
+
+	// X[k] = Fe[k] + W^k * Fo[k], and X[M - k] = conj(Fe[k] - W^k * Fo[k])
+	for (size_t k = 1; k <= M / 2; k++)
+	{
+		auto a = out[k];
+		auto b = std::conj(out[M - k]);
+
+		auto l_even = (a + b) * T(0.5);
+		auto l_diff = a - b;
+		auto l_odd = ComplexType(l_diff.imag() * T(0.5), -l_diff.real() * T(0.5));
+		auto l_oddRotated = Mul(l_odd, m_Twiddles[k]);
+
+		out[k] = l_even + l_oddRotated;
+		out[M - k] = std::conj(l_even - l_oddRotated);
+	}
+}
+
+template<class T>
+void RealFFTPlanT<T>::Inverse(const ComplexType* in, T* out, ComplexType* scratch) const
+{
+	auto N = m_Size;
+
+	if (N <= 1)
+	{
+		if (N)
+		{
+			out[0] = in[0].real();
+		}
+		return;
+	}
+
+	if (N & 1)
+	{
+		scratch[0] = in[0].real();
+
+		for (size_t k = 1; k <= N / 2; k++)
+		{
+			scratch[k] = in[k];
+			scratch[N - k] = std::conj(in[k]);
+		}
+
+		m_ComplexPlan->Inverse(scratch, scratch, scratch + N);
+
+		for (size_t i = 0; i < N; i++)
+		{
+			out[i] = scratch[i].real();
+		}
+
+		return;
+	}
+
+	auto M = N / 2;
+	auto Z = scratch;
+
+	// Z[k] = Fe[k] + j * Fo[k], the inverse of the split in Forward()
+	auto l_dc = in[0].real();
+	auto l_nyquist = in[M].real();
+	Z[0] = ComplexType((l_dc + l_nyquist) * T(0.5), (l_dc - l_nyquist) * T(0.5));
+
+	for (size_t k = 1; k <= M / 2; k++)
+	{
+		auto a = in[k];
+		auto b = std::conj(in[M - k]);
+
+		auto l_even = (a + b) * T(0.5);
+		auto l_odd = Mul((a - b) * T(0.5), std::conj(m_Twiddles[k]));
+
+		Z[k] = ComplexType(l_even.real() - l_odd.imag(), l_even.imag() + l_odd.real());
+		Z[M - k] = ComplexType(l_even.real() + l_odd.imag(), -l_even.imag() + l_odd.real());
+	}
+
+	m_ComplexPlan->Inverse(Z, reinterpret_cast<ComplexType*>(out), scratch + M);
+}
+
+template<class T>
+void RealFFTPlanT<T>::Forward(const T* in, ComplexType* out) const
+{
+	Forward(in, out, GetScratch<T>(m_ScratchSize));
+}
+
+template<class T>
+void RealFFTPlanT<T>::Inverse(const ComplexType* in, T* out) const
+{
+	Inverse(in, out, GetScratch<T>(m_ScratchSize));
+}
+
+namespace Waveless
+{
+	template class FFTPlanT<float>;
+	template class FFTPlanT<double>;
+	template class RealFFTPlanT<float>;
+	template class RealFFTPlanT<double>;
+}
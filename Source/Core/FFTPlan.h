@@ -0,0 +1,138 @@
+#pragma once
+#include "stdafx.h"
+#include "Math.h"
+
+namespace Waveless
+{
+	///
+	/// Precomputed FFT of a fixed size. The twiddle factors of every stage are generated once,
+	/// the execution doesn't allocate and could be shared by any number of threads.
+	/// Sizes with prime factors up to 13 run as mixed radix Stockham stages, other sizes fall back to Bluestein's algorithm.
+	/// The power of 2 stages use the vectorized kernels of SIMD::GetInstructionSet() when the stage is wide enough.
+	///
+	template<class T>
+	class FFTPlanT
+	{
+	public:
+		using ComplexType = std::complex<T>;
+
+		///
+		/// Get the cached plan of size N, the plan is created at the first request and lives until the end of the process.
+		///
+		static const FFTPlanT* Get(size_t N);
+
+		size_t GetSize() const { return m_Size; }
+		size_t GetScratchSize() const { return m_ScratchSize; }
+
+		///
+		/// Forward transform, in could be the same as out. The scratch buffer needs GetScratchSize() elements.
+		///
+		void Forward(const ComplexType* in, ComplexType* out, ComplexType* scratch) const;
+
+		///
+		/// Inverse transform normalized by 1 / N, in could be the same as out. The scratch buffer needs GetScratchSize() elements.
+		///
+		void Inverse(const ComplexType* in, ComplexType* out, ComplexType* scratch) const;
+
+		///
+		/// In-place transforms with a per-thread scratch buffer.
+		///
+		void Forward(ComplexType* x) const;
+		void Inverse(ComplexType* x) const;
+
+		FFTPlanT(size_t N);
+		~FFTPlanT() = default;
+
+		FFTPlanT(const FFTPlanT&) = delete;
+		FFTPlanT& operator=(const FFTPlanT&) = delete;
+
+	private:
+		struct Stage
+		{
+			size_t m_Radix;
+			// Length of the sub-transforms at this stage, and the count of them
+			size_t m_Length;
+			size_t m_Stride;
+			// (m_Radix - 1) twiddles for each of the m_Length / m_Radix butterflies
+			size_t m_TwiddleOffset;
+		};
+
+		template<bool Inverse>
+		void Execute(const ComplexType* in, ComplexType* out, ComplexType* scratch) const;
+
+		template<bool Inverse>
+		void ExecuteBluestein(const ComplexType* in, ComplexType* out, ComplexType* scratch) const;
+
+		size_t m_Size = 0;
+		size_t m_ScratchSize = 0;
+		std::vector<Stage> m_Stages;
+		std::vector<ComplexType> m_Twiddles;
+
+		// Bluestein's algorithm, the DFT as a circular convolution of the power of 2 size M >= 2N - 1
+		const FFTPlanT* m_ConvolutionPlan = nullptr;
+		// exp(-j * pi * n^2 / N) for n in [0, N)
+		std::vector<ComplexType> m_Chirp;
+		// The spectrum of the conjugated chirp wrapped around M
+		std::vector<ComplexType> m_ChirpSpectrum;
+	};
+
+	///
+	/// Precomputed FFT of a real signal of size N, only the N / 2 + 1 non-redundant bins are produced and consumed.
+	/// Even sizes run a complex FFT of size N / 2 on the interleaved samples, odd sizes fall back to a full complex FFT.
+	///
+	template<class T>
+	class RealFFTPlanT
+	{
+	public:
+		using ComplexType = std::complex<T>;
+
+		///
+		/// Get the cached plan of size N, the plan is created at the first request and lives until the end of the process.
+		///
+		static const RealFFTPlanT* Get(size_t N);
+
+		size_t GetSize() const { return m_Size; }
+		size_t GetBinCount() const { return m_Size / 2 + 1; }
+		size_t GetScratchSize() const { return m_ScratchSize; }
+
+		///
+		/// N real samples to N / 2 + 1 bins. The scratch buffer needs GetScratchSize() elements.
+		///
+		void Forward(const T* in, ComplexType* out, ComplexType* scratch) const;
+
+		///
+		/// N / 2 + 1 bins to N real samples, normalized by 1 / N. The imaginary parts of the DC and Nyquist bins are ignored.
+		/// The scratch buffer needs GetScratchSize() elements.
+		///
+		void Inverse(const ComplexType* in, T* out, ComplexType* scratch) const;
+
+		///
+		/// Transforms with a per-thread scratch buffer.
+		///
+		void Forward(const T* in, ComplexType* out) const;
+		void Inverse(const ComplexType* in, T* out) const;
+
+		RealFFTPlanT(size_t N);
+		~RealFFTPlanT() = default;
+
+		RealFFTPlanT(const RealFFTPlanT&) = delete;
+		RealFFTPlanT& operator=(const RealFFTPlanT&) = delete;
+
+	private:
+		size_t m_Size = 0;
+		size_t m_ScratchSize = 0;
+		const FFTPlanT<T>* m_ComplexPlan = nullptr;
+		// W_N^k for k in [0, N / 4], to split the half size transform
+		std::vector<ComplexType> m_Twiddles;
+	};
+
+	extern template class FFTPlanT<float>;
+	extern template class FFTPlanT<double>;
+	extern template class RealFFTPlanT<float>;
+	extern template class RealFFTPlanT<double>;
+
+	using FFTPlan = FFTPlanT<double>;
+	using FFTPlanF = FFTPlanT<float>;
+	using RealFFTPlan = RealFFTPlanT<double>;
+	using RealFFTPlanF = RealFFTPlanT<float>;
+}
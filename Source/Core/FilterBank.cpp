@@ -0,0 +1,203 @@
+#include "FilterBank.h"
+#include "WindowBank.h"
+#include "Logger.h"
+
+namespace Waveless::FilterBankNS
+{
+	// The default design size resolves the narrowest crossfade with this many bins, the Blackman main lobe is 6 bins wide
+	constexpr double m_TransitionBinCount = 8.0;
+
+	inline size_t GetNextPowerOfTwo(size_t x)
+	{
+		size_t l_result = 1;
+
+		while (l_result < x)
+		{
+			l_result <<= 1;
+		}
+
+		return l_result;
+	}
+}
+
+using namespace Waveless;
+using namespace Waveless::FilterBankNS;
+
+template<class T>
+WsResult FilterBankT<T>::Setup(double fs, const double* crossovers, size_t crossoverCount, size_t channels, size_t filterLength, size_t blockSize)
+{
+	if (fs <= 0.0 || !channels || (crossoverCount && !crossovers))
+	{
+		Logger::Log(LogLevel::Warning, "FilterBank sample rate, channel count or crossovers are invalid.");
+		return WsResult::Fail;
+	}
+
+	for (size_t i = 0; i < crossoverCount; i++)
+	{
+		if (crossovers[i] <= 0.0 || crossovers[i] >= fs / 2.0 || (i && crossovers[i] <= crossovers[i - 1]))
+		{
+			Logger::Log(LogLevel::Warning, "FilterBank crossovers must increase within (0, fs / 2), got ", crossovers[i], " Hz.");
+			return WsResult::Fail;
+		}
+	}
+
+	m_SampleRate = fs;
+	m_Crossovers.assign(crossovers, crossovers + crossoverCount);
+	m_TransitionWidth = m_MaxTransitionWidth;
+
+	// Adjacent crossfades may touch but not overlap, or the bands between them would turn negative
+	for (size_t i = 1; i < crossoverCount; i++)
+	{
+		m_TransitionWidth = std::min(m_TransitionWidth, std::log2(crossovers[i] / crossovers[i - 1]));
+	}
+
+	size_t l_designSize = m_MinFilterLength + 1;
+
+	if (filterLength)
+	{
+		l_designSize = GetNextPowerOfTwo(std::clamp(filterLength, m_MinFilterLength, m_MaxFilterLength) + 1);
+	}
+	else if (crossoverCount)
+	{
+		auto l_halfWidth = std::exp2(m_TransitionWidth / 2.0);
+		auto l_transition = crossovers[0] * (l_halfWidth - 1.0 / l_halfWidth);
+		auto l_binCount = std::ceil(m_TransitionBinCount * fs / l_transition);
+
+		l_designSize = GetNextPowerOfTwo((size_t)std::min(l_binCount, (double)(m_MaxFilterLength + 1)));
+		l_designSize = std::max(l_designSize, m_MinFilterLength + 1);
+	}
+
+	auto l_bandCount = GetBandCount();
+
+	m_FilterLength = l_designSize - 1;
+	m_BandResponses.resize(l_bandCount * m_FilterLength);
+	m_Curve.resize(m_FilterLength);
+
+	// The zero-phase impulse response of each band is rotated to the center of the window
+	auto l_designPlan = RealFFTPlanT<double>::Get(l_designSize);
+	auto l_center = m_FilterLength / 2;
+
+	WindowDesc l_windowDesc;
+	l_windowDesc.m_WindowType = WindowType::Blackman;
+	l_windowDesc.m_WindowSize = m_FilterLength;
+	l_windowDesc.m_WindowSymmetry = WindowSymmetry::Symmetric;
+
+	auto& l_window = WindowBank::Get<double>(l_windowDesc);
+	// The sum of the bands is a unit impulse at the center, where the exact Blackman coefficients sum to slightly less than 1
+	auto l_windowScale = 1.0 / l_window[l_center];
+
+	std::vector<ComplexT<double>> l_response(l_designPlan->GetBinCount());
+	std::vector<double> l_zeroPhase(l_designSize);
+	// The bands and then the gain curve, which is set by SetBandGains
+	std::vector<const T*> l_irs(l_bandCount + 1, nullptr);
+
+	for (size_t k = 0; k < l_bandCount; k++)
+	{
+		auto l_ir = &m_BandResponses[k * m_FilterLength];
+
+		for (size_t i = 0; i < l_response.size(); i++)
+		{
+			l_response[i] = GetBandResponse(k, (double)i * fs / (double)l_designSize);
+		}
+
+		l_designPlan->Inverse(l_response.data(), l_zeroPhase.data());
+
+		for (size_t n = 0; n < m_FilterLength; n++)
+		{
+			l_ir[n] = T(l_zeroPhase[(n + l_designSize - l_center) % l_designSize] * l_window[n] * l_windowScale);
+		}
+
+		l_irs[k] = l_ir;
+	}
+
+	if (m_Convolver.Setup(l_irs.data(), l_irs.size(), m_FilterLength, channels, blockSize ? blockSize : m_DefaultBlockSize) != WsResult::Success)
+	{
+		return WsResult::Fail;
+	}
+
+	std::vector<double> l_gainLevels(l_bandCount, 0.0);
+
+	return SetBandGains(l_gainLevels.data());
+}
+
+template<class T>
+WsResult FilterBankT<T>::SetBandGains(const double* gainLevels)
+{
+	if (!gainLevels || m_BandResponses.empty())
+	{
+		Logger::Log(LogLevel::Warning, "FilterBank is not set up or the band gains are empty.");
+		return WsResult::Fail;
+	}
+
+	// The gain curve is the weighted sum of the band impulse responses
+	auto l_bandCount = GetBandCount();
+
+	std::fill(m_Curve.begin(), m_Curve.end(), T(0));
+
+	for (size_t k = 0; k < l_bandCount; k++)
+	{
+		auto l_gain = (T)Math::DB2LinearAmp(gainLevels[k]);
+		auto l_band = &m_BandResponses[k * m_FilterLength];
+
+		for (size_t i = 0; i < m_FilterLength; i++)
+		{
+			m_Curve[i] += l_gain * l_band[i];
+		}
+	}
+
+	return m_Convolver.SetImpulseResponse(l_bandCount, m_Curve.data(), m_FilterLength);
+}
+
+template<class T>
+void FilterBankT<T>::Reset()
+{
+	m_Convolver.Reset();
+}
+
+template<class T>
+void FilterBankT<T>::Process(const T* in, T* out, size_t frameCount)
+{
+	m_Convolver.Process(in, &out, frameCount, GetBandCount(), 1);
+}
+
+template<class T>
+void FilterBankT<T>::ProcessBands(const T* in, T* const* bands, size_t frameCount)
+{
+	m_Convolver.Process(in, bands, frameCount, 0, GetBandCount());
+}
+
+template<class T>
+double FilterBankT<T>::GetBandResponse(size_t band, double frequency) const
+{
+	auto l_bandCount = GetBandCount();
+
+	if (band >= l_bandCount)
+	{
+		return 0.0;
+	}
+
+	// 1 below crossover i and 0 above, with a raised cosine over the transition width centered at it
+	auto l_lowPass = [&](size_t i)
+	{
+		if (frequency <= 0.0)
+		{
+			return 1.0;
+		}
+
+		auto l_t = (std::log2(frequency / m_Crossovers[i]) + m_TransitionWidth / 2.0) / m_TransitionWidth;
+		l_t = std::clamp(l_t, 0.0, 1.0);
+
+		return 0.5 + 0.5 * std::cos(PI<double> * l_t);
+	};
+
+	auto l_upper = band + 1 < l_bandCount ? l_lowPass(band) : 1.0;
+	auto l_lower = band ? l_lowPass(band - 1) : 0.0;
+
+	return l_upper - l_lower;
+}
+
+namespace Waveless
+{
+	template class FilterBankT<float>;
+	template class FilterBankT<double>;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include "Math.h"
+#include "Convolver.h"
+
+namespace Waveless
+{
+	///
+	/// Linear-phase multiband filter bank and graphic EQ over interleaved multichannel samples.
+	/// The band magnitudes are raised cosine crossfades in log frequency around each crossover and sum to 1 everywhere,
+	/// each band is designed as a symmetric FIR by frequency sampling with a Blackman window, so the sum of all bands is a pure delay.
+	/// The FIRs are the filters of one ConvolverT, every block of input is transformed once and each band or the gain curve
+	/// is a multiply-add of the input spectra with its partition spectra and one inverse transform.
+	///
+	template<class T>
+	class FilterBankT
+	{
+	public:
+		static constexpr size_t m_DefaultBlockSize = 512;
+		static constexpr size_t m_MinFilterLength = 255;
+		static constexpr size_t m_MaxFilterLength = 65535;
+		// The widest crossfade between two bands in octaves, narrower when the crossovers are closer
+		static constexpr double m_MaxTransitionWidth = 1.0;
+
+		FilterBankT() = default;
+		~FilterBankT() = default;
+
+		///
+		/// Design crossoverCount + 1 bands split at the increasing crossover frequencies in Hz. All band gains are 0 dB.
+		/// For a graphic EQ the crossovers are the geometric means of the adjacent band centers.
+		/// 0 picks the filter length from the narrowest crossfade and the default block size, the filter length is rounded to 2^n - 1
+		///
+		WsResult Setup(double fs, const double* crossovers, size_t crossoverCount, size_t channels = 1, size_t filterLength = 0, size_t blockSize = 0);
+
+		///
+		/// The gain in dB of every band for Process, the history is kept so the curve could change while streaming
+		///
+		WsResult SetBandGains(const double* gainLevels);
+
+		///
+		/// Clear the history of the input
+		///
+		void Reset();
+
+		///
+		/// Filter frameCount interleaved frames by the gain curve of the bands, in could be the same as out
+		///
+		void Process(const T* in, T* out, size_t frameCount);
+
+		///
+		/// Split frameCount interleaved frames into the bands, bands[k] receives the interleaved frames of band k.
+		/// The sum of the bands is the input delayed by GetLatency(). Process and ProcessBands share the history, a stream should use one of them
+		///
+		void ProcessBands(const T* in, T* const* bands, size_t frameCount);
+
+		///
+		/// The target magnitude of a band at a frequency in Hz
+		///
+		double GetBandResponse(size_t band, double frequency) const;
+
+		// The block size plus the delay of the linear-phase filters
+		size_t GetLatency() const { return m_Convolver.GetLatency() + m_FilterLength / 2; }
+		size_t GetBandCount() const { return m_Crossovers.size() + 1; }
+		size_t GetFilterLength() const { return m_FilterLength; }
+		size_t GetBlockSize() const { return m_Convolver.GetBlockSize(); }
+		size_t GetChannelCount() const { return m_Convolver.GetChannelCount(); }
+
+	private:
+		double m_SampleRate = 0.0;
+		std::vector<double> m_Crossovers;
+		double m_TransitionWidth = 0.0;
+		size_t m_FilterLength = 0;
+
+		// [band][filter length], the gain curve is their weighted sum
+		std::vector<T> m_BandResponses;
+		std::vector<T> m_Curve;
+		// The filters of the bands and then the gain curve
+		ConvolverT<T> m_Convolver;
+	};
+
+	extern template class FilterBankT<float>;
+	extern template class FilterBankT<double>;
+
+	using FilterBank = FilterBankT<double>;
+	using FilterBankF = FilterBankT<float>;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "GainProcessor.h"
+#include "Math.h"
+
+namespace Waveless::GainProcessorNS
+{
+	// Exponential ramps can't start from or reach silence, they are clamped to -120 dB
+	constexpr double m_MinExponentialGain = 1e-6;
+}
+
+using namespace Waveless;
+using namespace Waveless::GainProcessorNS;
+
+template<class T>
+void GainProcessorT<T>::Setup(double fs, double rampTime, GainRamp gainRamp)
+{
+	m_GainRamp = gainRamp;
+	m_RampFrames = (size_t)std::max(std::round(fs * rampTime), 0.0);
+	// Start from unity so the first change away from 0 dB ramps as well
+	m_GainLevel = 0.0;
+	m_TargetGain = T(1);
+	Reset();
+}
+
+template<class T>
+void GainProcessorT<T>::SetGainLevel(double gainLevel)
+{
+	if (gainLevel == m_GainLevel)
+	{
+		return;
+	}
+
+	m_GainLevel = gainLevel;
+	m_TargetGain = (T)Math::DB2LinearAmp(gainLevel);
+
+	if (!m_RampFrames)
+	{
+		Reset();
+		return;
+	}
+
+	m_RampFramesLeft = m_RampFrames;
+
+	if (m_GainRamp == GainRamp::Exponential)
+	{
+		auto l_from = std::max((double)m_Gain, m_MinExponentialGain);
+		auto l_to = std::max((double)m_TargetGain, m_MinExponentialGain);
+		m_Gain = (T)l_from;
+		m_Step = (T)std::pow(l_to / l_from, 1.0 / (double)m_RampFrames);
+	}
+	else
+	{
+		m_Step = (m_TargetGain - m_Gain) / (T)m_RampFrames;
+	}
+}
+
+template<class T>
+void GainProcessorT<T>::Reset()
+{
+	m_Gain = m_TargetGain;
+	m_RampFramesLeft = 0;
+}
+
+template<class T>
+void GainProcessorT<T>::Process(T* x, size_t frameCount, size_t channels)
+{
+	size_t l_frame = 0;
+
+	if (m_RampFramesLeft)
+	{
+		auto l_rampFrames = std::min(m_RampFramesLeft, frameCount);
+		auto l_gain = m_Gain;
+		auto l_step = m_Step;
+
+		if (m_GainRamp == GainRamp::Exponential)
+		{
+			for (; l_frame < l_rampFrames; l_frame++)
+			{
+				l_gain *= l_step;
+
+				for (size_t j = 0; j < channels; j++)
+				{
+					x[l_frame * channels + j] *= l_gain;
+				}
+			}
+
+			m_Gain = l_gain;
+		}
+		else
+		{
+			// The gain of each frame is computed from the start of the ramp, without a dependency between the frames
+			for (; l_frame < l_rampFrames; l_frame++)
+			{
+				auto l_frameGain = l_gain + l_step * (T)(l_frame + 1);
+
+				for (size_t j = 0; j < channels; j++)
+				{
+					x[l_frame * channels + j] *= l_frameGain;
+				}
+			}
+
+			m_Gain = l_gain + l_step * (T)l_rampFrames;
+		}
+
+		m_RampFramesLeft -= l_rampFrames;
+
+		if (!m_RampFramesLeft)
+		{
+			m_Gain = m_TargetGain;
+		}
+	}
+
+	if (m_Gain == T(1))
+	{
+		return;
+	}
+
+	auto l_gain = m_Gain;
+	auto l_sampleCount = frameCount * channels;
+
+	for (size_t i = l_frame * channels; i < l_sampleCount; i++)
+	{
+		x[i] *= l_gain;
+	}
+}
+
+namespace Waveless
+{
+	template class GainProcessorT<float>;
+	template class GainProcessorT<double>;
+}
\ No newline at end of file
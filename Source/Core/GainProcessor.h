@@ -0,0 +1,67 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+
+namespace Waveless
+{
+	enum class GainRamp
+	{
+		// Constant step per frame
+		Linear,
+		// Constant dB step per frame
+		Exponential
+	};
+
+	///
+	/// Per-voice gain over interleaved samples. The gain level is converted from dB once per change,
+	/// and a change ramps from the current gain to the new one over the ramp length so it doesn't click.
+	/// Outside of a ramp the cost is one multiply per sample.
+	///
+	template<class T>
+	class GainProcessorT
+	{
+	public:
+		GainProcessorT() = default;
+		~GainProcessorT() = default;
+
+		///
+		/// The ramp length in seconds at the sample rate fs, a length of 0 makes the changes immediate.
+		/// The gain starts at 0 dB, call Reset after SetGainLevel to start at another level without a ramp
+		///
+		void Setup(double fs, double rampTime = 0.01, GainRamp gainRamp = GainRamp::Linear);
+
+		///
+		/// Set the target gain level in dB, nothing is computed if it didn't change
+		///
+		void SetGainLevel(double gainLevel);
+
+		///
+		/// Jump to the target gain without a ramp
+		///
+		void Reset();
+
+		///
+		/// Apply the gain to frameCount interleaved frames of channels samples
+		///
+		void Process(T* x, size_t frameCount, size_t channels);
+
+		bool IsRamping() const { return m_RampFramesLeft != 0; }
+		T GetGain() const { return m_Gain; }
+
+	private:
+		GainRamp m_GainRamp = GainRamp::Linear;
+		size_t m_RampFrames = 0;
+		size_t m_RampFramesLeft = 0;
+		double m_GainLevel = 0.0;
+		T m_Gain = T(1);
+		T m_TargetGain = T(1);
+		// Added for linear ramps, multiplied for exponential ones
+		T m_Step = T(0);
+	};
+
+	extern template class GainProcessorT<float>;
+	extern template class GainProcessorT<double>;
+
+	using GainProcessor = GainProcessorT<double>;
+	using GainProcessorF = GainProcessorT<float>;
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "IIRFilter.h"
+#include "Math.h"
+#include "Logger.h"
+
+namespace Waveless::IIRFilterNS
+{
+	// Q of the second order sections of a Butterworth filter, pole pair k of order N
+	double GetButterworthQ(size_t k, size_t N)
+	{
+		return 1.0 / (2.0 * std::sin(PI<double> * double(2 * k + 1) / double(2 * N)));
+	}
+}
+
+using namespace Waveless;
+using namespace Waveless::IIRFilterNS;
+
+template<class T>
+WsResult IIRFilterT<T>::Setup(const FilterDesc& filterDesc, double fs, size_t channels)
+{
+	if (filterDesc.m_Frequency <= 0.0 || filterDesc.m_Frequency * 2.0 >= fs)
+	{
+		Logger::Log(LogLevel::Warning, "Filter frequency is beyond the Nyquist frequency.");
+		return WsResult::Fail;
+	}
+
+	if (!filterDesc.m_Order || filterDesc.m_Order > m_MaxOrder || filterDesc.m_Q <= 0.0)
+	{
+		Logger::Log(LogLevel::Warning, "Filter order or Q is out of range.");
+		return WsResult::Fail;
+	}
+
+	if (!channels || channels > m_MaxChannels)
+	{
+		Logger::Log(LogLevel::Warning, "Filter channel count is out of range.");
+		return WsResult::Fail;
+	}
+
+	auto l_type = filterDesc.m_FilterType;
+	auto l_isPass = l_type == FilterType::LowPass || l_type == FilterType::HighPass;
+	auto l_sectionCount = l_isPass ? (filterDesc.m_Order + 1) / 2 : std::max(filterDesc.m_Order / 2, size_t(1));
+
+	if (channels != m_ChannelCount || filterDesc.m_Topology != m_Topology || l_sectionCount != m_SectionCount)
+	{
+		Reset();
+	}
+
+	m_Topology = filterDesc.m_Topology;
+	m_ChannelCount = channels;
+	m_SectionCount = l_sectionCount;
+
+	auto l_w0 = 2.0 * PI<double> * filterDesc.m_Frequency / fs;
+	auto l_cos = std::cos(l_w0);
+	auto l_sin = std::sin(l_w0);
+	auto l_tan = std::tan(l_w0 / 2.0);
+	auto A = std::pow(10.0, filterDesc.m_GainLevel / (40.0 * (double)l_sectionCount));
+
+	for (size_t i = 0; i < l_sectionCount; i++)
+	{
+		auto& l_section = m_Sections[i];
+
+		// The odd order low and high pass filters end with a first order section
+		l_section.m_FirstOrder = l_isPass && (filterDesc.m_Order & 1) && i == l_sectionCount - 1;
+
+		if (l_section.m_FirstOrder)
+		{
+			auto l_lowPass = l_type == FilterType::LowPass;
+
+			// Bilinear one pole
+			auto l_a0 = 1.0 + l_tan;
+			l_section.m_B0 = T((l_lowPass ? l_tan : 1.0) / l_a0);
+			l_section.m_B1 = T((l_lowPass ? l_tan : -1.0) / l_a0);
+			l_section.m_B2 = T(0);
+			l_section.m_A1 = T((l_tan - 1.0) / l_a0);
+			l_section.m_A2 = T(0);
+
+			l_section.m_G = T(l_tan / l_a0);
+			l_section.m_M0 = T(l_lowPass ? 0.0 : 1.0);
+			l_section.m_M1 = T(l_lowPass ? 1.0 : -1.0);
+			l_section.m_M2 = T(0);
+
+			continue;
+		}
+
+		auto Q = l_isPass ? GetButterworthQ(i, filterDesc.m_Order) : filterDesc.m_Q;
+		auto l_alpha = l_sin / (2.0 * Q);
+		auto l_sqrtA = std::sqrt(A);
+
+		// RBJ Audio EQ Cookbook
+		double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+
+		// Simper's SVF, y = m0 * x + m1 * band + m2 * low
+		auto g = l_tan;
+		auto k = 1.0 / Q;
+		double m0 = 0.0, m1 = 0.0, m2 = 0.0;
+
+		switch (l_type)
+		{
+		case FilterType::LowPass:
+			b0 = (1.0 - l_cos) / 2.0; b1 = 1.0 - l_cos; b2 = b0;
+			a0 = 1.0 + l_alpha; a1 = -2.0 * l_cos; a2 = 1.0 - l_alpha;
+			m2 = 1.0;
+			break;
+		case FilterType::HighPass:
+			b0 = (1.0 + l_cos) / 2.0; b1 = -(1.0 + l_cos); b2 = b0;
+			a0 = 1.0 + l_alpha; a1 = -2.0 * l_cos; a2 = 1.0 - l_alpha;
+			m0 = 1.0; m1 = -k; m2 = -1.0;
+			break;
+		case FilterType::BandPass:
+			// Constant 0 dB peak gain
+			b0 = l_alpha; b1 = 0.0; b2 = -l_alpha;
+			a0 = 1.0 + l_alpha; a1 = -2.0 * l_cos; a2 = 1.0 - l_alpha;
+			m1 = k;
+			break;
+		case FilterType::Notch:
+			b0 = 1.0; b1 = -2.0 * l_cos; b2 = 1.0;
+			a0 = 1.0 + l_alpha; a1 = -2.0 * l_cos; a2 = 1.0 - l_alpha;
+			m0 = 1.0; m1 = -k;
+			break;
+		case FilterType::Peak:
+			b0 = 1.0 + l_alpha * A; b1 = -2.0 * l_cos; b2 = 1.0 - l_alpha * A;
+			a0 = 1.0 + l_alpha / A; a1 = -2.0 * l_cos; a2 = 1.0 - l_alpha / A;
+			k = 1.0 / (Q * A);
+			m0 = 1.0; m1 = k * (A * A - 1.0);
+			break;
+		case FilterType::LowShelf:
+			b0 = A * ((A + 1.0) - (A - 1.0) * l_cos + 2.0 * l_sqrtA * l_alpha);
+			b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * l_cos);
+			b2 = A * ((A + 1.0) - (A - 1.0) * l_cos - 2.0 * l_sqrtA * l_alpha);
+			a0 = (A + 1.0) + (A - 1.0) * l_cos + 2.0 * l_sqrtA * l_alpha;
+			a1 = -2.0 * ((A - 1.0) + (A + 1.0) * l_cos);
+			a2 = (A + 1.0) + (A - 1.0) * l_cos - 2.0 * l_sqrtA * l_alpha;
+			g = l_tan / l_sqrtA;
+			m0 = 1.0; m1 = k * (A - 1.0); m2 = A * A - 1.0;
+			break;
+		case FilterType::HighShelf:
+			b0 = A * ((A + 1.0) + (A - 1.0) * l_cos + 2.0 * l_sqrtA * l_alpha);
+			b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * l_cos);
+			b2 = A * ((A + 1.0) + (A - 1.0) * l_cos - 2.0 * l_sqrtA * l_alpha);
+			a0 = (A + 1.0) - (A - 1.0) * l_cos + 2.0 * l_sqrtA * l_alpha;
+			a1 = 2.0 * ((A - 1.0) - (A + 1.0) * l_cos);
+			a2 = (A + 1.0) - (A - 1.0) * l_cos - 2.0 * l_sqrtA * l_alpha;
+			g = l_tan * l_sqrtA;
+			m0 = A * A; m1 = k * (1.0 - A) * A; m2 = 1.0 - A * A;
+			break;
+		default:
+			break;
+		}
+
+		l_section.m_B0 = T(b0 / a0);
+		l_section.m_B1 = T(b1 / a0);
+		l_section.m_B2 = T(b2 / a0);
+		l_section.m_A1 = T(a1 / a0);
+		l_section.m_A2 = T(a2 / a0);
+
+		auto l_a1 = 1.0 / (1.0 + g * (g + k));
+		l_section.m_G = T(g);
+		l_section.m_SA1 = T(l_a1);
+		l_section.m_SA2 = T(g * l_a1);
+		l_section.m_SA3 = T(g * g * l_a1);
+		l_section.m_M0 = T(m0);
+		l_section.m_M1 = T(m1);
+		l_section.m_M2 = T(m2);
+	}
+
+	return WsResult::Success;
+}
+
+template<class T>
+void IIRFilterT<T>::Reset()
+{
+	for (auto& i : m_State)
+	{
+		for (auto& j : i)
+		{
+			std::fill(std::begin(j), std::end(j), T(0));
+		}
+	}
+}
+
+template<class T>
+void IIRFilterT<T>::Process(const T* in, T* out, size_t frameCount)
+{
+	if (in != out)
+	{
+		std::copy(in, in + frameCount * m_ChannelCount, out);
+	}
+
+	for (size_t i = 0; i < m_SectionCount; i++)
+	{
+		if (m_Topology == FilterTopology::SVF)
+		{
+			ProcessSVF(m_Sections[i], m_State[i][0], m_State[i][1], out, frameCount);
+		}
+		else
+		{
+			ProcessBiquad(m_Sections[i], m_State[i][0], m_State[i][1], out, frameCount);
+		}
+	}
+}
+
+template<class T>
+void IIRFilterT<T>::ProcessBiquad(const Section& section, T* s1, T* s2, T* x, size_t frameCount) const
+{
+	auto C = m_ChannelCount;
+	auto b0 = section.m_B0;
+	auto b1 = section.m_B1;
+	auto b2 = section.m_B2;
+	auto a1 = section.m_A1;
+	auto a2 = section.m_A2;
+
+	for (size_t i = 0; i < frameCount; i++)
+	{
+		auto l_frame = x + i * C;
+
+		// Independent across the channels, the compiler vectorizes this loop
+		for (size_t j = 0; j < C; j++)
+		{
+			auto l_x = l_frame[j];
+			auto l_y = b0 * l_x + s1[j];
+			s1[j] = b1 * l_x - a1 * l_y + s2[j];
+			s2[j] = b2 * l_x - a2 * l_y;
+			l_frame[j] = l_y;
+		}
+	}
+}
+
+template<class T>
+void IIRFilterT<T>::ProcessSVF(const Section& section, T* s1, T* s2, T* x, size_t frameCount) const
+{
+	auto C = m_ChannelCount;
+	auto m0 = section.m_M0;
+	auto m1 = section.m_M1;
+	auto m2 = section.m_M2;
+
+	if (section.m_FirstOrder)
+	{
+		auto G = section.m_G;
+
+		for (size_t i = 0; i < frameCount; i++)
+		{
+			auto l_frame = x + i * C;
+
+			for (size_t j = 0; j < C; j++)
+			{
+				auto l_x = l_frame[j];
+				auto v = (l_x - s1[j]) * G;
+				auto l_low = v + s1[j];
+				s1[j] = l_low + v;
+				l_frame[j] = m0 * l_x + m1 * l_low;
+			}
+		}
+
+		return;
+	}
+
+	auto a1 = section.m_SA1;
+	auto a2 = section.m_SA2;
+	auto a3 = section.m_SA3;
+
+	for (size_t i = 0; i < frameCount; i++)
+	{
+		auto l_frame = x + i * C;
+
+		for (size_t j = 0; j < C; j++)
+		{
+			auto l_x = l_frame[j];
+			auto v3 = l_x - s2[j];
+			auto v1 = a1 * s1[j] + a2 * v3;
+			auto v2 = s2[j] + a2 * s1[j] + a3 * v3;
+			s1[j] = T(2) * v1 - s1[j];
+			s2[j] = T(2) * v2 - s2[j];
+			l_frame[j] = m0 * l_x + m1 * v1 + m2 * v2;
+		}
+	}
+}
+
+namespace Waveless
+{
+	template class IIRFilterT<float>;
+	template class IIRFilterT<double>;
+}
\ No newline at end of file
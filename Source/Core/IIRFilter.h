@@ -0,0 +1,111 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+
+namespace Waveless
+{
+	enum class FilterType
+	{
+		LowPass,
+		HighPass,
+		BandPass,
+		Notch,
+		Peak,
+		LowShelf,
+		HighShelf
+	};
+
+	enum class FilterTopology
+	{
+		// RBJ cookbook biquads in transposed direct form II
+		Biquad,
+		// Topology-preserving transform state variable filters, better behaved under fast modulation
+		SVF
+	};
+
+	struct FilterDesc
+	{
+		FilterType m_FilterType = FilterType::LowPass;
+		FilterTopology m_Topology = FilterTopology::Biquad;
+		// Center or cut-off frequency in Hz
+		double m_Frequency = 1000.0;
+		// The slope is 6 dB per octave per order for low and high pass filters, which become Butterworth cascades and ignore m_Q.
+		// The other types cascade max(order / 2, 1) identical sections
+		size_t m_Order = 2;
+		double m_Q = 0.7071067811865476;
+		// Total gain in dB of the peak and shelf filters, split evenly between the sections
+		double m_GainLevel = 0.0;
+	};
+
+	///
+	/// Streaming cascade of second order sections over interleaved multichannel samples.
+	/// The state is kept between the calls so a signal could be processed block by block, the inner loop runs across the channels.
+	/// The storage is fixed, neither setting up nor processing allocates, so the same filter runs in the audio callback and in offline tools.
+	///
+	template<class T>
+	class IIRFilterT
+	{
+	public:
+		static constexpr size_t m_MaxOrder = 16;
+		static constexpr size_t m_MaxChannels = 8;
+		static constexpr size_t m_MaxSectionCount = m_MaxOrder / 2;
+
+		IIRFilterT() = default;
+		~IIRFilterT() = default;
+
+		///
+		/// Compute the coefficients, the state is kept so the parameters could change while streaming
+		///
+		WsResult Setup(const FilterDesc& filterDesc, double fs, size_t channels = 1);
+
+		///
+		/// Clear the state of all sections
+		///
+		void Reset();
+
+		///
+		/// Filter frameCount interleaved frames, in could be the same as out
+		///
+		void Process(const T* in, T* out, size_t frameCount);
+		void Process(T* x, size_t frameCount) { Process(x, x, frameCount); }
+
+		size_t GetChannelCount() const { return m_ChannelCount; }
+		size_t GetSectionCount() const { return m_SectionCount; }
+
+	private:
+		struct Section
+		{
+			bool m_FirstOrder = false;
+			// Biquad, normalized by a0
+			T m_B0 = T(1);
+			T m_B1 = T(0);
+			T m_B2 = T(0);
+			T m_A1 = T(0);
+			T m_A2 = T(0);
+			// SVF, y = m0 * x + m1 * band + m2 * low, the first order ones only use m_G, m0 and m1 (low)
+			T m_G = T(0);
+			T m_SA1 = T(0);
+			T m_SA2 = T(0);
+			T m_SA3 = T(0);
+			T m_M0 = T(0);
+			T m_M1 = T(0);
+			T m_M2 = T(0);
+		};
+
+		void ProcessBiquad(const Section& section, T* s1, T* s2, T* x, size_t frameCount) const;
+		void ProcessSVF(const Section& section, T* s1, T* s2, T* x, size_t frameCount) const;
+
+		FilterTopology m_Topology = FilterTopology::Biquad;
+		size_t m_ChannelCount = 0;
+		size_t m_SectionCount = 0;
+		Section m_Sections[m_MaxSectionCount];
+		// Two state variables of every channel per section, [section][variable][channel]
+		T m_State[m_MaxSectionCount][2][m_MaxChannels] = {};
+	};
+
+	extern template class IIRFilterT<float>;
+	extern template class IIRFilterT<double>;
+
+	using IIRFilter = IIRFilterT<double>;
+	using IIRFilterF = IIRFilterT<float>;
+}
\ No newline at end of file
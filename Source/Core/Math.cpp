@@ -1,4 +1,11 @@
 #include "Math.h"
+#include "MathKernels.h"
+#include "OscillatorBank.h"
+#include "FFTPlan.h"
+#include "STFT.h"
+#include "TaskScheduler.h"
+#include "WindowBank.h"
+#include "Logger.h"
 
 namespace Waveless
 {
@@ -6,6 +13,363 @@ namespace Waveless
 	std::mt19937_64 e2(rd());
 	std::uniform_int_distribution<uint64_t> dist(std::llround(std::pow(2, 61)), std::llround(std::pow(2, 62)));
 
+	namespace MathNS
+	{
+		template<class T>
+		thread_local std::vector<T> t_RealBuffer;
+		template<class T>
+		thread_local std::vector<ComplexT<T>> t_BinBuffer;
+
+		// Values per block of the batch conversions, the fast path of a block is computed first and the special values are patched after.
+		// A multiple of the width of every kernel, only the last block has a scalar tail
+		constexpr size_t m_BatchBlockSize = 256;
+
+		template<class To, class From>
+		inline To BitCast(From x)
+		{
+			To l_result;
+			std::memcpy(&l_result, &x, sizeof(To));
+			return l_result;
+		}
+
+		///
+		/// c[0] + c[1] * x + ... + c[N - 1] * x^(N - 1), unrolled at compile time
+		///
+		template<class T, size_t N, size_t... K>
+		inline T Polynomial(T x, const double* c, std::index_sequence<K...>)
+		{
+			auto l_result = T(c[N - 1]);
+			((l_result = l_result * x + T(c[N - 2 - K])), ...);
+			return l_result;
+		}
+
+		template<size_t N, class T>
+		inline T Polynomial(T x, const double* c)
+		{
+			return Polynomial<T, N>(x, c, std::make_index_sequence<N - 1>());
+		}
+
+		///
+		/// log2 of a positive normal value, the scalar version of the MathKernels one for the tails
+		///
+		template<class T>
+		inline T FastLog2(T x)
+		{
+			using F = FastMathTraits<T>;
+			using Int = typename F::Int;
+			using UInt = std::make_unsigned_t<Int>;
+
+			// Offset by the bits of sqrt(2) / 2, so the exponent is rounded and the mantissa lands in [sqrt(2) / 2, sqrt(2))
+			constexpr T l_halfSqrt2 = T(FastMathConstants::m_HalfSqrt2);
+			auto l_bits = BitCast<Int>(x) - BitCast<Int>(l_halfSqrt2) + (Int(F::m_Bias) << F::m_MantissaBits);
+			auto l_exponentBits = (Int)((UInt)l_bits >> F::m_MantissaBits) + BitCast<Int>(F::m_RoundMagic);
+			auto l_exponent = BitCast<T>(l_exponentBits) - (F::m_RoundMagic + T(F::m_Bias));
+			auto m = BitCast<T>((l_bits & ((Int(1) << F::m_MantissaBits) - 1)) + BitCast<Int>(l_halfSqrt2));
+
+			auto s = (m - T(1)) / (m + T(1));
+			auto p = Polynomial<F::m_LogTerms>(s * s, FastMathConstants::m_LogSeries);
+
+			return l_exponent + T(FastMathConstants::m_TwoLog2E) * s * p;
+		}
+
+		///
+		/// 2^x for x in [-bias + 1, bias), the scalar version of the MathKernels one for the tails
+		///
+		template<class T>
+		inline T FastExp2(T x)
+		{
+			using F = FastMathTraits<T>;
+			using Int = typename F::Int;
+
+			auto i = std::floor(x);
+			auto u = (x - i - T(0.5)) * T(FastMathConstants::m_Ln2);
+			auto p = Polynomial<F::m_ExpTerms>(u, FastMathConstants::m_ExpSeries);
+
+			auto l_scale = BitCast<T>((Int(i) + F::m_Bias) << F::m_MantissaBits);
+
+			return p * l_scale * T(FastMathConstants::m_Sqrt2);
+		}
+
+		///
+		/// out = scale * log10(in)
+		///
+		template<class T>
+		void BatchLog10(const T* in, T* out, size_t count, T scale)
+		{
+			// log10(x) = log2(x) * log10(2)
+			auto l_scale = scale * T(0.30102999566398120);
+			auto l_kernels = MathKernels::Get<T>();
+			T l_block[m_BatchBlockSize];
+
+			for (size_t l_begin = 0; l_begin < count; l_begin += m_BatchBlockSize)
+			{
+				auto l_count = std::min(m_BatchBlockSize, count - l_begin);
+				auto l_in = in + l_begin;
+				auto l_out = out + l_begin;
+				size_t l_vectorCount = 0;
+
+				if (l_kernels)
+				{
+					l_vectorCount = l_count / l_kernels->m_Width * l_kernels->m_Width;
+					l_kernels->m_Log2(l_in, l_block, l_vectorCount, l_scale);
+				}
+
+				for (size_t i = l_vectorCount; i < l_count; i++)
+				{
+					auto x = std::min(std::max(l_in[i], std::numeric_limits<T>::min()), std::numeric_limits<T>::max());
+					l_block[i] = FastLog2(x) * l_scale;
+				}
+
+				// Zero, negative, denormal and non-finite values
+				for (size_t i = 0; i < l_count; i++)
+				{
+					auto x = l_in[i];
+					l_out[i] = x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max() ? l_block[i] : scale * std::log10(x);
+				}
+			}
+		}
+
+		///
+		/// out = 10^(in / scale)
+		///
+		template<class T>
+		void BatchExp10(const T* in, T* out, size_t count, T scale)
+		{
+			using F = FastMathTraits<T>;
+
+			// 10^(x / scale) = 2^(x * log2(10) / scale)
+			auto l_scale = T(3.3219280948873623) / scale;
+			auto l_min = T(-F::m_Bias + 1);
+			auto l_max = T(F::m_Bias);
+			auto l_maxClamp = std::nextafter(l_max, T(0));
+			auto l_kernels = MathKernels::Get<T>();
+			T l_block[m_BatchBlockSize];
+
+			for (size_t l_begin = 0; l_begin < count; l_begin += m_BatchBlockSize)
+			{
+				auto l_count = std::min(m_BatchBlockSize, count - l_begin);
+				auto l_in = in + l_begin;
+				auto l_out = out + l_begin;
+				size_t l_vectorCount = 0;
+
+				if (l_kernels)
+				{
+					l_vectorCount = l_count / l_kernels->m_Width * l_kernels->m_Width;
+					l_kernels->m_Exp2(l_in, l_block, l_vectorCount, l_scale);
+				}
+
+				for (size_t i = l_vectorCount; i < l_count; i++)
+				{
+					auto x = l_in[i] * l_scale;
+					x = x > l_min ? x : l_min;
+					x = x < l_maxClamp ? x : l_maxClamp;
+					l_block[i] = FastExp2(x);
+				}
+
+				// Underflow, overflow and NaN
+				for (size_t i = 0; i < l_count; i++)
+				{
+					auto x = l_in[i] * l_scale;
+					l_out[i] = x >= l_min && x < l_max ? l_block[i] : std::pow(T(10), l_in[i] / scale);
+				}
+			}
+		}
+
+		// The least overlap-save blocks, or products of the direct convolution, that are split across the workers
+		constexpr size_t m_MinParallelBlockCount = 4;
+		constexpr size_t m_MinParallelProductCount = 1 << 20;
+		// The largest transform of the overlap-save blocks, larger ones only fall out of the cache
+		constexpr size_t m_MaxConvolutionFFTSize = 1 << 16;
+
+		///
+		/// The operation counts of the two methods, with 2.5 N log2(N) for a real FFT of size N and 6 per complex product
+		///
+		inline double GetDirectCost(size_t xCount, size_t hCount)
+		{
+			return 2.0 * (double)xCount * (double)hCount;
+		}
+
+		inline double GetFFTCost(size_t yCount, size_t hCount, size_t N)
+		{
+			auto l_blockCount = (double)((yCount + N - hCount) / (N - hCount + 1));
+			return l_blockCount * (5.0 * (double)N * std::log2((double)N) + 3.0 * (double)N);
+		}
+
+		///
+		/// The power of 2 transform size with the least cost per output sample, h is the shorter signal
+		///
+		inline size_t GetConvolutionFFTSize(size_t yCount, size_t hCount)
+		{
+			size_t l_minSize = 2;
+
+			while (l_minSize < 2 * hCount)
+			{
+				l_minSize *= 2;
+			}
+
+			auto l_result = l_minSize;
+			auto l_minCost = GetFFTCost(yCount, hCount, l_minSize);
+
+			// Up to the single block of the whole output
+			for (auto N = l_minSize * 2; N <= m_MaxConvolutionFFTSize && N / 2 < yCount + hCount; N *= 2)
+			{
+				auto l_cost = GetFFTCost(yCount, hCount, N);
+
+				if (l_cost < l_minCost)
+				{
+					l_minCost = l_cost;
+					l_result = N;
+				}
+			}
+
+			return l_result;
+		}
+
+		// The frequencies of a Goertzel pass, a multiple of the width of every kernel
+		constexpr size_t m_GoertzelBlockSize = 64;
+
+		template<class T>
+		void GoertzelBlock(const T* x, size_t count, const double* omega, size_t frequencyCount, ComplexT<T>* X)
+		{
+			// The recursion runs in double for both sample types, the float samples are converted a block at a time
+			auto l_kernels = MathKernels::Get<double>();
+			double l_coefficient[m_GoertzelBlockSize] = {};
+			double l_s1[m_GoertzelBlockSize] = {};
+			double l_s2[m_GoertzelBlockSize] = {};
+
+			for (size_t k = 0; k < frequencyCount; k++)
+			{
+				l_coefficient[k] = 2.0 * std::cos(omega[k]);
+			}
+
+			if (l_kernels)
+			{
+				auto l_laneCount = (frequencyCount + l_kernels->m_Width - 1) / l_kernels->m_Width * l_kernels->m_Width;
+
+				if constexpr (std::is_same_v<T, double>)
+				{
+					l_kernels->m_Goertzel(x, count, l_coefficient, l_s1, l_s2, l_laneCount);
+				}
+				else
+				{
+					double l_block[m_BatchBlockSize];
+
+					for (size_t l_begin = 0; l_begin < count; l_begin += m_BatchBlockSize)
+					{
+						auto l_count = std::min(m_BatchBlockSize, count - l_begin);
+						std::copy(x + l_begin, x + l_begin + l_count, l_block);
+						l_kernels->m_Goertzel(l_block, l_count, l_coefficient, l_s1, l_s2, l_laneCount);
+					}
+				}
+			}
+			else
+			{
+				// s[n] = x[n] + 2 * cos(w) * s[n - 1] - s[n - 2], independent across the frequencies
+				for (size_t n = 0; n < count; n++)
+				{
+					auto l_x = (double)x[n];
+
+					for (size_t k = 0; k < frequencyCount; k++)
+					{
+						auto l_s0 = l_x + l_coefficient[k] * l_s1[k] - l_s2[k];
+						l_s2[k] = l_s1[k];
+						l_s1[k] = l_s0;
+					}
+				}
+			}
+
+			// X = exp(-j * w * (N - 1)) * (s[N - 1] - exp(-j * w) * s[N - 2])
+			for (size_t k = 0; k < frequencyCount; k++)
+			{
+				auto l_y = ComplexT<double>(l_s1[k] - std::cos(omega[k]) * l_s2[k], std::sin(omega[k]) * l_s2[k]);
+				auto l_phase = -omega[k] * (double)(count - 1);
+				auto l_X = l_y * ComplexT<double>(std::cos(l_phase), std::sin(l_phase));
+				X[k] = ComplexT<T>((T)l_X.real(), (T)l_X.imag());
+			}
+		}
+
+		template<class T>
+		void ConvolveDirect(const T* x, size_t xCount, const T* h, size_t hCount, T* y, size_t yCount)
+		{
+			// Every output sample is up to hCount products
+			auto l_minParallelCount = m_MinParallelProductCount / hCount;
+
+			// Every chunk owns a range of the output, the inner loop is an axpy the compiler vectorizes
+			TaskScheduler::ParallelFor(yCount, [&](size_t begin, size_t end, size_t)
+			{
+				std::fill(y + begin, y + end, T(0));
+
+				for (size_t k = 0; k < hCount; k++)
+				{
+					auto l_begin = std::max(begin, k);
+					auto l_end = std::min(end, k + xCount);
+					auto l_h = h[k];
+					auto l_x = x - k;
+
+					for (size_t n = l_begin; n < l_end; n++)
+					{
+						y[n] += l_h * l_x[n];
+					}
+				}
+			}, l_minParallelCount);
+		}
+
+		template<class T>
+		void ConvolveFFT(const T* x, size_t xCount, const T* h, size_t hCount, T* y, size_t yCount)
+		{
+			auto N = GetConvolutionFFTSize(yCount, hCount);
+			auto l_plan = RealFFTPlanT<T>::Get(N);
+			auto l_binCount = l_plan->GetBinCount();
+			auto l_step = N - hCount + 1;
+			auto l_blockCount = (yCount + l_step - 1) / l_step;
+
+			// The real parts and then the imaginary parts of the spectrum of h
+			std::vector<T> H(2 * l_binCount);
+			{
+				std::vector<T> l_h(N, T(0));
+				std::vector<ComplexT<T>> l_H(l_binCount);
+				std::copy(h, h + hCount, l_h.begin());
+				l_plan->Forward(l_h.data(), l_H.data());
+				MathKernels::SplitComplex(l_H.data(), H.data(), H.data() + l_binCount, l_binCount);
+			}
+
+			// Block b writes y[b * step, (b + 1) * step) from x[b * step - (hCount - 1), b * step - (hCount - 1) + N),
+			// the first hCount - 1 samples of the circular convolution wrap around and are dropped
+			TaskScheduler::ParallelFor(l_blockCount, [&](size_t begin, size_t end, size_t)
+			{
+				std::vector<T> l_time(N);
+				std::vector<ComplexT<T>> l_bins(l_binCount);
+				std::vector<ComplexT<T>> l_scratch(l_plan->GetScratchSize());
+				std::vector<T> l_X(2 * l_binCount);
+				std::vector<T> l_Y(2 * l_binCount);
+
+				for (size_t b = begin; b < end; b++)
+				{
+					auto l_offset = (ptrdiff_t)(b * l_step) - (ptrdiff_t)(hCount - 1);
+
+					for (size_t i = 0; i < N; i++)
+					{
+						auto l_index = l_offset + (ptrdiff_t)i;
+						l_time[i] = l_index >= 0 && l_index < (ptrdiff_t)xCount ? x[l_index] : T(0);
+					}
+
+					l_plan->Forward(l_time.data(), l_bins.data(), l_scratch.data());
+					MathKernels::SplitComplex(l_bins.data(), l_X.data(), l_X.data() + l_binCount, l_binCount);
+
+					std::fill(l_Y.begin(), l_Y.end(), T(0));
+					MathKernels::ComplexMultiplyAdd(l_X.data(), l_X.data() + l_binCount, H.data(), H.data() + l_binCount, l_Y.data(), l_Y.data() + l_binCount, l_binCount);
+					MathKernels::MergeComplex(l_Y.data(), l_Y.data() + l_binCount, l_bins.data(), l_binCount);
+
+					l_plan->Inverse(l_bins.data(), l_time.data(), l_scratch.data());
+
+					auto l_begin = b * l_step;
+					auto l_count = std::min(l_step, yCount - l_begin);
+					std::copy(l_time.begin() + (hCount - 1), l_time.begin() + (hCount - 1) + l_count, y + l_begin);
+				}
+			}, m_MinParallelBlockCount);
+		}
+	}
+
 	uint64_t Math::GenerateUUID()
 	{
 		return dist(e2);
@@ -31,272 +395,298 @@ namespace Waveless
 		return 20.0 * std::log10(linear);
 	}
 
-	ComplexArray Math::GenerateSine(double A, double f, double phi, double fs, double t)
+	template<class T>
+	void Math::DB2LinearMag(const T* in, T* out, size_t count)
+	{
+		MathNS::BatchExp10(in, out, count, T(10));
+	}
+
+	template<class T>
+	void Math::Linear2dBMag(const T* in, T* out, size_t count)
+	{
+		MathNS::BatchLog10(in, out, count, T(10));
+	}
+
+	template<class T>
+	void Math::DB2LinearAmp(const T* in, T* out, size_t count)
+	{
+		MathNS::BatchExp10(in, out, count, T(20));
+	}
+
+	template<class T>
+	void Math::Linear2dBAmp(const T* in, T* out, size_t count)
+	{
+		MathNS::BatchLog10(in, out, count, T(20));
+	}
+
+	template<class T>
+	ComplexArrayT<T> Math::GenerateSine(double A, double f, double phi, double fs, double t)
 	{
 		auto N = size_t(std::round(t * fs));
-		ComplexArray x(N);
+		ComplexArrayT<T> x(N);
 
 		auto l_Intensity = DB2LinearAmp(A);
 
+		// Rotated in double whatever T is, the phase error stays below the precision of float over long signals
+		OscillatorBank l_bank;
+		l_bank.Setup(fs, 1);
+		l_bank.SetPartial(0, f, l_Intensity, phi);
+
+		auto& l_real = MathNS::t_RealBuffer<double>;
+		l_real.resize(N);
+		l_bank.Process(l_real.data(), N);
+
 		for (size_t i = 0; i < N; i++)
 		{
-			x[i] = l_Intensity * std::sin(2 * PI<double> * f * (double)i / fs + phi);
+			x[i] = (T)l_real[i];
 		}
 
 		return x;
 	}
 
-	ComplexArray Math::DFT(const ComplexArray& x)
+	template<class T>
+	ComplexArrayT<T> Math::SynthAdditive(const FreqBinDataT<T>& XBinData, double fs, size_t sampleCount)
 	{
-		auto N = x.size();
-		ComplexArray X(N);
+		auto& l_bins = XBinData.m_FreqBinArray;
 
-		for (size_t k = 0; k < N; k++)
-		{
-			auto s = Complex(0.0, 0.0);
+		OscillatorBankT<T> l_bank;
 
-			for (size_t i = 0; i < N; i++)
-			{
-				s += x[i] * std::exp(Complex(0.0, -1.0) * 2.0 * PI<double> * (double)k * ((double)i / (double)N));
-			}
+		if (l_bank.Setup(fs, l_bins.size()) != WsResult::Success)
+		{
+			return ComplexArrayT<T>();
+		}
 
-			X[k] = s;
+		for (size_t i = 0; i < l_bins.size(); i++)
+		{
+			// cos(x + phi) = sin(x + phi + pi / 2)
+			auto& l_X = l_bins[i].second;
+			l_bank.SetPartial(i, l_bins[i].first, std::abs(l_X), std::arg(l_X) + PI<double> / 2.0);
 		}
 
-		return X;
-	}
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		l_real.assign(sampleCount, XBinData.m_DCOffset.real());
+		l_bank.Process(l_real.data(), sampleCount, true);
 
-	ComplexArray Math::IDFT(const ComplexArray & X)
-	{
-		auto N = X.size();
-		ComplexArray x(N);
+		ComplexArrayT<T> x(sampleCount);
 
-		for (size_t k = 0; k < N; k++)
+		for (size_t i = 0; i < sampleCount; i++)
 		{
-			auto s = Complex(0.0, 0.0);
-
-			for (size_t i = 0; i < N; i++)
-			{
-				s += (1.0 / (double)N) * X[i] * std::exp(Complex(0.0, 1.0) * 2.0 * PI<double> * (double)k * ((double)i / (double)N));
-			}
-
-			x[k] = s;
+			x[i] = l_real[i];
 		}
 
 		return x;
 	}
 
-	ComplexArray Math::GenerateWindowFunction(WindowDesc windowDesc)
+	template<class T>
+	ComplexArrayT<T> Math::DFT(const ComplexArrayT<T>& x)
 	{
-		auto N = windowDesc.m_WindowSize;
+		auto X = x;
+		FFT_SingleFrame(X);
 
-		ComplexArray l_result(N);
+		return X;
+	}
 
-		switch (windowDesc.m_WindowType)
-		{
-		case Waveless::WindowType::Rectangular:
-			l_result = 1.0;
-			break;
-		case Waveless::WindowType::Hann:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = pow(sin(PI<double> * (double)i / (double)N), 2.0);
-			}
-			break;
-		case Waveless::WindowType::Hamming:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = 0.53836 + 0.46164 * cos(2.0 * PI<double> * (double)i / (double)N);
-			}
-			break;
-		case Waveless::WindowType::Blackman:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = 0.42659 - 0.49656 * cos(2.0 * PI<double> * (double)i / (double)N) + 0.076849 * cos(4.0 * PI<double> * (double)i / (double)N);
-			}
-			break;
-		case Waveless::WindowType::Nuttall:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = 0.355768 - 0.487396 * cos(2.0 * PI<double> * (double)i / (double)N) + 0.144232 * cos(4.0 * PI<double> * (double)i / (double)N) - 0.012604 * cos(6.0 * PI<double> * (double)i / (double)N);
-			}
-			break;
-		case Waveless::WindowType::BlackmanNuttall:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = 0.3635819 - 0.4891775 * cos(2.0 * PI<double> * (double)i / (double)N) + 0.1365995 * cos(4.0 * PI<double> * (double)i / (double)N) - 0.0106411 * cos(6.0 * PI<double> * (double)i / (double)N);
-			}
-			break;
-		case Waveless::WindowType::BlackmanHarris:
-			for (size_t i = 0; i < N; i++)
-			{
-				l_result[i] = 0.35875 - 0.48829 * cos(2.0 * PI<double> * (double)i / (double)N) + 0.14128 * cos(4.0 * PI<double> * (double)i / (double)N) - 0.01168 * cos(6.0 * PI<double> * (double)i / (double)N);
-			}
-			break;
-		default:
-			break;
-		}
+	template<class T>
+	ComplexArrayT<T> Math::IDFT(const ComplexArrayT<T> & X)
+	{
+		auto x = X;
+		IFFT_SingleFrame(x);
 
-		return l_result;
+		return x;
 	}
 
-	std::vector<ComplexArray> Math::FFT(const ComplexArray & x, WindowDesc windowDesc)
+	template<class T>
+	void Math::Goertzel(const T* x, size_t count, const double* frequencies, size_t frequencyCount, double fs, ComplexT<T>* X)
 	{
-		auto N = x.size();
-		std::vector<ComplexArray> l_result;
-
-		if (N < windowDesc.m_WindowSize)
+		if (!count)
 		{
-			N = windowDesc.m_WindowSize;
+			std::fill(X, X + frequencyCount, ComplexT<T>(0));
+			return;
+		}
 
-			// zero padding
-			ComplexArray l_paddedChunk(N);
+		double l_omega[MathNS::m_GoertzelBlockSize];
 
-			for (size_t i = 0; i < x.size(); i++)
-			{
-				l_paddedChunk[i] = x[i];
-			}
+		for (size_t l_begin = 0; l_begin < frequencyCount; l_begin += MathNS::m_GoertzelBlockSize)
+		{
+			auto l_count = std::min(MathNS::m_GoertzelBlockSize, frequencyCount - l_begin);
 
-			auto l_zeroPaddingSize = N - x.size();
-			for (size_t i = 0; i < l_zeroPaddingSize; i++)
+			for (size_t k = 0; k < l_count; k++)
 			{
-				l_paddedChunk[i + x.size()] = Complex(0.0, 0.0);
+				l_omega[k] = 2.0 * PI<double> * frequencies[l_begin + k] / fs;
 			}
 
-			FFT_SingleFrame(l_paddedChunk);
-
-			l_result.emplace_back(l_paddedChunk);
+			MathNS::GoertzelBlock(x, count, l_omega, l_count, X + l_begin);
 		}
-		else
+	}
+
+	template<class T>
+	void Math::Convolve(const T* x, size_t xCount, const T* h, size_t hCount, std::vector<T>& y, ConvolutionMethod method)
+	{
+		if (!xCount || !hCount)
 		{
-			auto l_window = GenerateWindowFunction(windowDesc);
+			y.clear();
+			return;
+		}
 
-			ComplexArray l_X(N);
+		// The convolution commutes, h is the shorter one
+		if (hCount > xCount)
+		{
+			std::swap(x, h);
+			std::swap(xCount, hCount);
+		}
 
-			auto l_FFTFrameSize = windowDesc.m_WindowSize;
-			auto l_lastFrameSize = N % l_FFTFrameSize;
-			auto l_frameCount = (N - l_lastFrameSize) / l_FFTFrameSize;
+		auto l_yCount = xCount + hCount - 1;
+		y.resize(l_yCount);
 
-			for (size_t i = 0; i < l_frameCount * 2 - 1; i++)
-			{
-				auto l_chunk = ComplexArray(x[std::slice(i * l_FFTFrameSize / 2, l_FFTFrameSize, 1)]);
-				l_chunk *= l_window;
+		if (method == ConvolutionMethod::Auto)
+		{
+			auto N = MathNS::GetConvolutionFFTSize(l_yCount, hCount);
+			method = MathNS::GetDirectCost(xCount, hCount) <= MathNS::GetFFTCost(l_yCount, hCount, N) ? ConvolutionMethod::Direct : ConvolutionMethod::FFT;
+		}
 
-				FFT_SingleFrame(l_chunk);
-				l_result.emplace_back(l_chunk);
-			};
+		if (method == ConvolutionMethod::Direct)
+		{
+			MathNS::ConvolveDirect(x, xCount, h, hCount, y.data(), l_yCount);
+		}
+		else
+		{
+			MathNS::ConvolveFFT(x, xCount, h, hCount, y.data(), l_yCount);
+		}
+	}
 
-			// full size chunks
-			// @TODO: window overlapping
-			if (l_lastFrameSize)
-			{
-				// last chunk with zero padding
-				ComplexArray l_paddedLastChunk(l_FFTFrameSize);
-				auto l_lastChunk = ComplexArray(x[std::slice(l_frameCount * l_FFTFrameSize, l_lastFrameSize, 1)]);
+	template<class T>
+	void Math::CrossCorrelate(const T* x, size_t xCount, const T* y, size_t yCount, std::vector<T>& r, ConvolutionMethod method)
+	{
+		// The convolution with the reversed y
+		std::vector<T> l_reversed(y, y + yCount);
+		std::reverse(l_reversed.begin(), l_reversed.end());
 
-				for (size_t i = 0; i < l_lastChunk.size(); i++)
-				{
-					l_paddedLastChunk[i] = l_lastChunk[i];
-				}
+		Convolve(x, xCount, l_reversed.data(), yCount, r, method);
+	}
 
-				auto l_zeroPaddingSize = l_FFTFrameSize - l_lastFrameSize;
-				for (size_t i = 0; i < l_zeroPaddingSize; i++)
-				{
-					l_paddedLastChunk[i + l_lastFrameSize] = Complex(0.0, 0.0);
-				}
+	template<class T>
+	ComplexArrayT<T> Math::GenerateWindowFunction(WindowDesc windowDesc)
+	{
+		auto& l_window = WindowBank::Get<T>(windowDesc);
+		ComplexArrayT<T> l_result(l_window.size());
 
-				FFT_SingleFrame(l_paddedLastChunk);
-				l_result.emplace_back(l_paddedLastChunk);
-			}
+		for (size_t i = 0; i < l_window.size(); i++)
+		{
+			l_result[i] = l_window[i];
 		}
 
 		return l_result;
 	}
 
-	ComplexArray Math::IFFT(const std::vector<ComplexArray> & X, WindowDesc windowDesc)
+	template<class T>
+	std::vector<ComplexArrayT<T>> Math::FFT(const ComplexArrayT<T> & x, WindowDesc windowDesc)
 	{
-		std::vector<Complex> l_vector;
-		l_vector.reserve(X.size() * X[0].size());
+		// A signal shorter than the window is zero padded by the STFT as well, so every frame is windowed the same way
+		return STFTT<T>(windowDesc).Analyze(x);
+	}
 
-		if (X.size() == 1)
-		{
-			auto X0 = X[0];
-			IFFT_SingleFrame(X0);
-			l_vector.insert(std::end(l_vector), std::begin(X0), std::end(X0));
-		}
-		else
+	template<class T>
+	ComplexArrayT<T> Math::IFFT(const std::vector<ComplexArrayT<T>> & X, WindowDesc windowDesc)
+	{
+		for (size_t i = 0; i < X.size(); i++)
 		{
-			auto l_window = GenerateWindowFunction(windowDesc);
-
-			for (auto Xi : X)
+			if (X[i].size() != windowDesc.m_WindowSize)
 			{
-				IFFT_SingleFrame(Xi);
-				Xi /= l_window;
-				l_vector.insert(std::end(l_vector), std::begin(Xi), std::end(Xi));
+				Logger::Log(LogLevel::Error, "Math: Frame ", (uint64_t)i, " has ", (uint64_t)X[i].size(), " bins instead of the window size ", (uint64_t)windowDesc.m_WindowSize, ", can't synthesize!");
+				return ComplexArrayT<T>();
 			}
 		}
 
-		ComplexArray l_result(l_vector.data(), l_vector.size());
+		return STFTT<T>(windowDesc).Synthesize(X);
+	}
+
+	template<class T>
+	void Math::FFT_SingleFrame(ComplexArrayT<T> & x)
+	{
+		if (x.size() <= 1)
+		{
+			return;
+		}
 
-		return l_result;
+		FFTPlanT<T>::Get(x.size())->Forward(&x[0]);
 	}
 
-	void Math::FFT_SingleFrame(ComplexArray & x)
+	template<class T>
+	void Math::IFFT_SingleFrame(ComplexArrayT<T> & X)
 	{
-		const size_t N = x.size();
-		if (N <= 1)
+		if (X.size() <= 1)
 		{
 			return;
 		}
 
-		// Divide
-		ComplexArray even = x[std::slice(0, N / 2, 2)];
-		ComplexArray odd = x[std::slice(1, N / 2, 2)];
+		FFTPlanT<T>::Get(X.size())->Inverse(&X[0]);
+	}
+
+	template<class T>
+	ComplexArrayT<T> Math::RFFT_SingleFrame(const ComplexArrayT<T> & x)
+	{
+		auto N = x.size();
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		l_real.resize(N);
+
+		for (size_t i = 0; i < N; i++)
+		{
+			l_real[i] = x[i].real();
+		}
 
-		// Conquer
-		FFT_SingleFrame(even);
-		FFT_SingleFrame(odd);
+		ComplexArrayT<T> l_X(N / 2 + 1);
 
-		// Combine
-		for (size_t k = 0; k < N / 2; ++k)
+		if (N)
 		{
-			Complex t = std::polar(1.0, -2 * PI<double> * k / N) * odd[k];
-			x[k] = even[k] + t;
-			x[k + N / 2] = even[k] - t;
+			RealFFTPlanT<T>::Get(N)->Forward(l_real.data(), &l_X[0]);
 		}
+
+		return l_X;
 	}
 
-	void Math::IFFT_SingleFrame(ComplexArray & X)
+	template<class T>
+	ComplexArrayT<T> Math::IRFFT_SingleFrame(const ComplexArrayT<T> & X, size_t N)
 	{
-		// Conjugate the complex numbers
-		X = X.apply(std::conj);
+		ComplexArrayT<T> l_x(N);
 
-		// forward FFT
-		FFT_SingleFrame(X);
+		if (!N || X.size() < N / 2 + 1)
+		{
+			return l_x;
+		}
+
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		l_real.resize(N);
 
-		// Conjugate the complex numbers again
-		X = X.apply(std::conj);
+		RealFFTPlanT<T>::Get(N)->Inverse(&X[0], l_real.data());
 
-		// Scale the numbers
-		X /= (double)X.size();
+		for (size_t i = 0; i < N; i++)
+		{
+			l_x[i] = l_real[i];
+		}
+
+		return l_x;
 	}
 
-	std::vector<FreqBinData> Math::FreqDomainSeries2FreqBin(const std::vector<ComplexArray>& X, double fs)
+	template<class T>
+	std::vector<FreqBinDataT<T>> Math::FreqDomainSeries2FreqBin(const std::vector<ComplexArrayT<T>>& X, double fs)
 	{
-		std::vector<FreqBinData> l_result;
+		std::vector<FreqBinDataT<T>> l_result(X.size());
 
-		for (auto& Xi : X)
+		TaskScheduler::ParallelFor(X.size(), [&](size_t begin, size_t end, size_t)
 		{
-			auto l_XBinData = FreqDomainSeries2FreqBin_SingleFrame(Xi, fs);
-			l_result.emplace_back(l_XBinData);
-		}
+			for (size_t i = begin; i < end; i++)
+			{
+				l_result[i] = FreqDomainSeries2FreqBin_SingleFrame(X[i], fs);
+			}
+		});
 
 		return l_result;
 	}
 
-	std::vector<ComplexArray> Math::FreqBin2FreqDomainSeries(const std::vector<FreqBinData>& XBinData)
+	template<class T>
+	std::vector<ComplexArrayT<T>> Math::FreqBin2FreqDomainSeries(const std::vector<FreqBinDataT<T>>& XBinData)
 	{
-		std::vector<ComplexArray> l_result;
+		std::vector<ComplexArrayT<T>> l_result;
 
 		for (auto& XBinDatai : XBinData)
 		{
@@ -307,9 +697,10 @@ namespace Waveless
 		return l_result;
 	}
 
-	FreqBinData Math::FreqDomainSeries2FreqBin_SingleFrame(const ComplexArray& X, double sampleRate)
+	template<class T>
+	FreqBinDataT<T> Math::FreqDomainSeries2FreqBin_SingleFrame(const ComplexArrayT<T>& X, double sampleRate)
 	{
-		FreqBinData XBinData;
+		FreqBinDataT<T> XBinData;
 		auto N = X.size();
 
 		// X[0] is the DC Offset
@@ -329,18 +720,57 @@ namespace Waveless
 			//auto amp_imag = linear2dBMag(std::abs(X[i].imag()));
 			//amp_imag = X[i].imag() > 0.0 ? amp_imag : -amp_imag;
 			auto amp_imag = X[i].imag();
-			FreqBin bin(freq, Complex(amp_real, amp_imag));
+			FreqBinT<T> bin(freq, ComplexT<T>(amp_real, amp_imag));
 			XBinData.m_FreqBinArray.emplace_back(bin);
 		}
 
 		return XBinData;
 	}
 
-	ComplexArray Math::FreqBin2FreqDomainSeries_SingleFrame(const FreqBinData & XBinData)
+	template<class T>
+	FreqBinDataT<T> Math::TimeDomainSeries2FreqBin_SingleFrame(const ComplexArrayT<T>& x, double sampleRate)
+	{
+		FreqBinDataT<T> XBinData;
+		auto N = x.size();
+
+		if (N < 2)
+		{
+			return XBinData;
+		}
+
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		auto& l_X = MathNS::t_BinBuffer<T>;
+		l_real.resize(N);
+		l_X.resize(N / 2 + 1);
+
+		for (size_t i = 0; i < N; i++)
+		{
+			l_real[i] = x[i].real();
+		}
+
+		RealFFTPlanT<T>::Get(N)->Forward(l_real.data(), l_X.data());
+
+		// X[0] is the DC Offset
+		XBinData.m_DCOffset = l_X[0];
+
+		auto l_binSize = N / 2;
+		XBinData.m_FreqBinArray.reserve(l_binSize);
+
+		for (size_t i = 1; i < l_binSize + 1; i++)
+		{
+			auto freq = sampleRate * (double)i / (double)N;
+			XBinData.m_FreqBinArray.emplace_back(freq, l_X[i]);
+		}
+
+		return XBinData;
+	}
+
+	template<class T>
+	ComplexArrayT<T> Math::FreqBin2FreqDomainSeries_SingleFrame(const FreqBinDataT<T> & XBinData)
 	{
 		auto N = XBinData.m_FreqBinArray.size();
 		auto l_dataSize = N * 2;
-		ComplexArray X(l_dataSize);
+		ComplexArrayT<T> X(l_dataSize);
 
 		// X[0] is the DC Offset
 		X[0] = XBinData.m_DCOffset;
@@ -354,7 +784,7 @@ namespace Waveless
 			//auto amp_imag = dB2LinearMag(XBinData[i].second.imag());
 			//amp_imag = XBinData[i].second.imag() > 0.0 ? amp_imag : -amp_imag;
 			auto amp_imag = XBinData.m_FreqBinArray[i].second.imag();
-			X[i + 1] = Complex(amp_real, amp_imag);
+			X[i + 1] = ComplexT<T>(amp_real, amp_imag);
 		}
 
 		// Second half of data, without XBinData[N - 1]
@@ -362,36 +792,251 @@ namespace Waveless
 		{
 			auto amp_real = X[N - i].real();
 			auto amp_imag = X[N - i].imag();
-			X[i + N] = Complex(amp_real, amp_imag);
+			X[i + N] = ComplexT<T>(amp_real, amp_imag);
 		}
 
 		return X;
 	}
 
-	ComplexArray Math::Synth(const std::vector<FreqBinData>& XBinData, WindowDesc windowDesc)
+	template<class T>
+	ComplexArrayT<T> Math::Synth(const std::vector<FreqBinDataT<T>>& XBinData, WindowDesc windowDesc)
 	{
-		std::vector<Complex> l_vector;
-		l_vector.reserve(XBinData.size() * XBinData[0].m_FreqBinArray.size());
+		if (XBinData.empty())
+		{
+			return ComplexArrayT<T>();
+		}
 
-		// @TODO: Merge window overlap
-		for (auto XBinDatai : XBinData)
+		// Every frame of bins synthesizes twice its bin count of samples, the frames are overlap-added so they should be the same size
+		auto l_binCount = XBinData[0].m_FreqBinArray.size();
+
+		for (size_t i = 1; i < XBinData.size(); i++)
 		{
-			auto l_x = Synth_SingleFrame(XBinDatai);
-			l_vector.insert(std::end(l_vector), std::begin(l_x), std::end(l_x));
+			if (XBinData[i].m_FreqBinArray.size() != l_binCount)
+			{
+				Logger::Log(LogLevel::Error, "Math: Frame ", (uint64_t)i, " has ", (uint64_t)XBinData[i].m_FreqBinArray.size(), " bins instead of ", (uint64_t)l_binCount, ", can't synthesize!");
+				return ComplexArrayT<T>();
+			}
 		}
 
-		ComplexArray l_result(l_vector.data(), l_vector.size());
+		windowDesc.m_WindowSize = l_binCount * 2;
+
+		STFTT<T> l_STFT(windowDesc);
+
+		auto l_frameCount = XBinData.size();
+		auto l_frameSize = l_STFT.GetWindowSize();
+		auto l_sampleCount = l_STFT.GetSampleCount(l_frameCount);
+
+		std::vector<ComplexT<T>> l_frames(l_frameCount * l_frameSize, ComplexT<T>(0, 0));
+
+		TaskScheduler::ParallelFor(l_frameCount, [&](size_t begin, size_t end, size_t)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				auto l_x = Synth_SingleFrame(XBinData[i]);
+				std::copy(std::begin(l_x), std::end(l_x), l_frames.begin() + i * l_frameSize);
+			}
+		});
+
+		ComplexArrayT<T> l_result(l_sampleCount);
+		l_STFT.OverlapAddFrames(l_frames.data(), l_frameCount, &l_result[0], l_sampleCount);
 
 		return l_result;
 	}
 
-	ComplexArray Math::Synth_SingleFrame(const FreqBinData & XBinData)
+	template<class T>
+	ComplexArrayT<T> Math::Synth_SingleFrame(const FreqBinDataT<T> & XBinData)
 	{
-		auto l_X = FreqBin2FreqDomainSeries_SingleFrame(XBinData);
-		IFFT_SingleFrame(l_X);
-		return l_X;
+		// The bins are the non-redundant half of a real signal's spectrum, the other half is implied
+		auto l_binCount = XBinData.m_FreqBinArray.size();
+		auto N = l_binCount * 2;
+
+		ComplexArrayT<T> l_x(N);
+
+		if (!N)
+		{
+			return l_x;
+		}
+
+		auto& l_X = MathNS::t_BinBuffer<T>;
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		l_X.resize(l_binCount + 1);
+		l_real.resize(N);
+
+		l_X[0] = XBinData.m_DCOffset;
+
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			l_X[i + 1] = XBinData.m_FreqBinArray[i].second;
+		}
+
+		RealFFTPlanT<T>::Get(N)->Inverse(l_X.data(), l_real.data());
+
+		for (size_t i = 0; i < N; i++)
+		{
+			l_x[i] = l_real[i];
+		}
+
+		return l_x;
+	}
+
+	template<class T>
+	void Math::TimeDomainSeries2Spectrum_SingleFrame(const ComplexArrayT<T>& x, double fs, SpectrumT<T>& X)
+	{
+		auto N = x.size();
+		X.m_SampleRate = fs;
+		X.Resize(N);
+
+		if (!N)
+		{
+			return;
+		}
+
+		auto l_binCount = X.GetBinCount();
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		auto& l_X = MathNS::t_BinBuffer<T>;
+		l_real.resize(N);
+		l_X.resize(l_binCount);
+
+		for (size_t i = 0; i < N; i++)
+		{
+			l_real[i] = x[i].real();
+		}
+
+		RealFFTPlanT<T>::Get(N)->Forward(l_real.data(), l_X.data());
+
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			X.m_Real[i] = l_X[i].real();
+			X.m_Imag[i] = l_X[i].imag();
+		}
 	}
 
+	template<class T>
+	SpectrumT<T> Math::TimeDomainSeries2Spectrum_SingleFrame(const ComplexArrayT<T>& x, double fs)
+	{
+		SpectrumT<T> X;
+		TimeDomainSeries2Spectrum_SingleFrame(x, fs, X);
+
+		return X;
+	}
+
+	template<class T>
+	SpectrumT<T> Math::FreqBin2Spectrum_SingleFrame(const FreqBinDataT<T>& XBinData, double fs)
+	{
+		auto l_binCount = XBinData.m_FreqBinArray.size();
+
+		SpectrumT<T> X;
+		X.m_SampleRate = fs;
+		X.Resize(l_binCount * 2);
+
+		if (!l_binCount)
+		{
+			return X;
+		}
+
+		X.m_Real[0] = XBinData.m_DCOffset.real();
+		X.m_Imag[0] = XBinData.m_DCOffset.imag();
+
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			X.m_Real[i + 1] = XBinData.m_FreqBinArray[i].second.real();
+			X.m_Imag[i + 1] = XBinData.m_FreqBinArray[i].second.imag();
+		}
+
+		return X;
+	}
+
+	template<class T>
+	FreqBinDataT<T> Math::Spectrum2FreqBin_SingleFrame(const SpectrumT<T>& X)
+	{
+		FreqBinDataT<T> XBinData;
+		auto l_binCount = X.GetBinCount();
+
+		if (!l_binCount)
+		{
+			return XBinData;
+		}
+
+		XBinData.m_DCOffset = X.GetBin(0);
+		XBinData.m_FreqBinArray.reserve(l_binCount - 1);
+
+		for (size_t i = 1; i < l_binCount; i++)
+		{
+			XBinData.m_FreqBinArray.emplace_back(X.GetFrequency(i), X.GetBin(i));
+		}
+
+		return XBinData;
+	}
+
+	template<class T>
+	ComplexArrayT<T> Math::Synth_SingleFrame(const SpectrumT<T>& X)
+	{
+		auto N = X.m_FrameSize;
+		ComplexArrayT<T> l_x(N);
+
+		if (!N)
+		{
+			return l_x;
+		}
+
+		auto l_binCount = X.GetBinCount();
+		auto& l_X = MathNS::t_BinBuffer<T>;
+		auto& l_real = MathNS::t_RealBuffer<T>;
+		l_X.resize(l_binCount);
+		l_real.resize(N);
+
+		for (size_t i = 0; i < l_binCount; i++)
+		{
+			l_X[i] = X.GetBin(i);
+		}
+
+		RealFFTPlanT<T>::Get(N)->Inverse(l_X.data(), l_real.data());
+
+		for (size_t i = 0; i < N; i++)
+		{
+			l_x[i] = l_real[i];
+		}
+
+		return l_x;
+	}
+
+#define WS_MATH_INSTANTIATE(T) \
+	template void Math::DB2LinearMag<T>(const T*, T*, size_t); \
+	template void Math::Linear2dBMag<T>(const T*, T*, size_t); \
+	template void Math::DB2LinearAmp<T>(const T*, T*, size_t); \
+	template void Math::Linear2dBAmp<T>(const T*, T*, size_t); \
+	template ComplexArrayT<T> Math::GenerateSine<T>(double, double, double, double, double); \
+	template ComplexArrayT<T> Math::SynthAdditive<T>(const FreqBinDataT<T>&, double, size_t); \
+	template void Math::Goertzel<T>(const T*, size_t, const double*, size_t, double, ComplexT<T>*); \
+	template void Math::Convolve<T>(const T*, size_t, const T*, size_t, std::vector<T>&, ConvolutionMethod); \
+	template void Math::CrossCorrelate<T>(const T*, size_t, const T*, size_t, std::vector<T>&, ConvolutionMethod); \
+	template ComplexArrayT<T> Math::DFT<T>(const ComplexArrayT<T>&); \
+	template ComplexArrayT<T> Math::IDFT<T>(const ComplexArrayT<T>&); \
+	template ComplexArrayT<T> Math::GenerateWindowFunction<T>(WindowDesc); \
+	template std::vector<ComplexArrayT<T>> Math::FFT<T>(const ComplexArrayT<T>&, WindowDesc); \
+	template ComplexArrayT<T> Math::IFFT<T>(const std::vector<ComplexArrayT<T>>&, WindowDesc); \
+	template void Math::FFT_SingleFrame<T>(ComplexArrayT<T>&); \
+	template void Math::IFFT_SingleFrame<T>(ComplexArrayT<T>&); \
+	template ComplexArrayT<T> Math::RFFT_SingleFrame<T>(const ComplexArrayT<T>&); \
+	template ComplexArrayT<T> Math::IRFFT_SingleFrame<T>(const ComplexArrayT<T>&, size_t); \
+	template std::vector<FreqBinDataT<T>> Math::FreqDomainSeries2FreqBin<T>(const std::vector<ComplexArrayT<T>>&, double); \
+	template FreqBinDataT<T> Math::FreqDomainSeries2FreqBin_SingleFrame<T>(const ComplexArrayT<T>&, double); \
+	template FreqBinDataT<T> Math::TimeDomainSeries2FreqBin_SingleFrame<T>(const ComplexArrayT<T>&, double); \
+	template std::vector<ComplexArrayT<T>> Math::FreqBin2FreqDomainSeries<T>(const std::vector<FreqBinDataT<T>>&); \
+	template ComplexArrayT<T> Math::FreqBin2FreqDomainSeries_SingleFrame<T>(const FreqBinDataT<T>&); \
+	template ComplexArrayT<T> Math::Synth<T>(const std::vector<FreqBinDataT<T>>&, WindowDesc); \
+	template ComplexArrayT<T> Math::Synth_SingleFrame<T>(const FreqBinDataT<T>&); \
+	template void Math::TimeDomainSeries2Spectrum_SingleFrame<T>(const ComplexArrayT<T>&, double, SpectrumT<T>&); \
+	template SpectrumT<T> Math::TimeDomainSeries2Spectrum_SingleFrame<T>(const ComplexArrayT<T>&, double); \
+	template SpectrumT<T> Math::FreqBin2Spectrum_SingleFrame<T>(const FreqBinDataT<T>&, double); \
+	template FreqBinDataT<T> Math::Spectrum2FreqBin_SingleFrame<T>(const SpectrumT<T>&); \
+	template ComplexArrayT<T> Math::Synth_SingleFrame<T>(const SpectrumT<T>&);
+
+	WS_MATH_INSTANTIATE(float)
+	WS_MATH_INSTANTIATE(double)
+
+#undef WS_MATH_INSTANTIATE
+
 	Vector::Vector(float in_x, float in_y, float in_z, float in_w)
 	{
 		x = in_x;
@@ -29,19 +29,67 @@ namespace Waveless
 		float Length();
 	};
 
-	using Complex = std::complex<double>;
-	using ComplexArray = std::valarray<Complex>;
+	// The transforms are templated on the sample type and instantiated for float and double,
+	// the unsuffixed aliases are the double versions and the F suffixed aliases are the float versions
+	template<class T>
+	using ComplexT = std::complex<T>;
+	template<class T>
+	using ComplexArrayT = std::valarray<ComplexT<T>>;
+
+	using Complex = ComplexT<double>;
+	using ComplexArray = ComplexArrayT<double>;
+	using ComplexF = ComplexT<float>;
+	using ComplexArrayF = ComplexArrayT<float>;
 
 	using Freq = double;
-	using FreqBin = std::pair<Freq, Complex>;
-	using FreqBinArray = std::vector<FreqBin>;
+	template<class T>
+	using FreqBinT = std::pair<Freq, ComplexT<T>>;
+	template<class T>
+	using FreqBinArrayT = std::vector<FreqBinT<T>>;
 
-	struct FreqBinData
+	template<class T>
+	struct FreqBinDataT
 	{
-		Complex m_DCOffset;
-		FreqBinArray m_FreqBinArray;
+		ComplexT<T> m_DCOffset;
+		FreqBinArrayT<T> m_FreqBinArray;
 	};
 
+	using FreqBin = FreqBinT<double>;
+	using FreqBinArray = FreqBinArrayT<double>;
+	using FreqBinData = FreqBinDataT<double>;
+	using FreqBinF = FreqBinT<float>;
+	using FreqBinArrayF = FreqBinArrayT<float>;
+	using FreqBinDataF = FreqBinDataT<float>;
+
+	///
+	/// The non-redundant half of a real signal's spectrum, N / 2 + 1 bins from DC up to the Nyquist frequency.
+	/// The bin frequencies are implied by the sample rate and the frame size, the real and imaginary parts are stored in separate arrays.
+	///
+	template<class T>
+	struct SpectrumT
+	{
+		double m_SampleRate = 0.0;
+		// Sample count of the time domain frame
+		size_t m_FrameSize = 0;
+		std::vector<T> m_Real;
+		std::vector<T> m_Imag;
+
+		size_t GetBinCount() const { return m_Real.size(); }
+		double GetBinSpacing() const { return m_FrameSize ? m_SampleRate / (double)m_FrameSize : 0.0; }
+		double GetFrequency(size_t bin) const { return GetBinSpacing() * (double)bin; }
+		ComplexT<T> GetBin(size_t bin) const { return ComplexT<T>(m_Real[bin], m_Imag[bin]); }
+
+		void Resize(size_t frameSize)
+		{
+			m_FrameSize = frameSize;
+			m_Real.resize(frameSize ? frameSize / 2 + 1 : 0);
+			m_Imag.resize(m_Real.size());
+		}
+	};
+
+	using Spectrum = SpectrumT<double>;
+	using SpectrumF = SpectrumT<float>;
+
 	enum class WindowType
 	{
 		Rectangular,
@@ -53,10 +101,31 @@ namespace Waveless
 		BlackmanHarris
 	};
 
+	enum class WindowSymmetry
+	{
+		// w[i] = f(i / N), one period of a window of size N + 1 without the last sample, for the STFT and spectral analysis
+		Periodic,
+		// w[i] = f(i / (N - 1)), even around the center, for FIR filter design
+		Symmetric
+	};
+
 	struct WindowDesc
 	{
 		WindowType m_WindowType;
 		size_t m_WindowSize;
+		// Distance between the starts of two STFT frames, 0 means half of the window size
+		size_t m_HopSize = 0;
+		WindowSymmetry m_WindowSymmetry = WindowSymmetry::Periodic;
+	};
+
+	enum class ConvolutionMethod
+	{
+		// The cheaper one by the operation counts of the two lengths
+		Auto,
+		// The sum of products, for short kernels
+		Direct,
+		// Overlap-save over blocks of real FFTs
+		FFT
 	};
 
 	class Math
@@ -75,10 +144,29 @@ namespace Waveless
 
 		static double Linear2dBAmp(double linear);
 
+		///
+		/// Batch conversions of count values, in could be the same as out.
+		/// The logarithm and the exponential are polynomial approximations over the mantissa, run by the SSE2, AVX2 or AVX-512 kernels of the current instruction set.
+		/// The error is within a few ulps of the result, about 1e-4 dB for float and 1e-12 dB for double over the whole range,
+		/// zero, negative, denormal and non-finite values fall back to the exact functions.
+		///
+		template<class T>
+		static void DB2LinearMag(const T* in, T* out, size_t count);
+
+		template<class T>
+		static void Linear2dBMag(const T* in, T* out, size_t count);
+
+		template<class T>
+		static void DB2LinearAmp(const T* in, T* out, size_t count);
+
+		template<class T>
+		static void Linear2dBAmp(const T* in, T* out, size_t count);
+
 		///
 		/// Generate A real sinusoid signal series.
 		///
-		static ComplexArray GenerateSine(
+		template<class T = double>
+		static ComplexArrayT<T> GenerateSine(
 			double A ///< Amplitude in dB
 			, double f ///< Freq in Hz
 			, double phi ///< Initial phase offset
@@ -86,63 +174,172 @@ namespace Waveless
 			, double t ///< Sample period in second
 		);
 
-		static ComplexArray DFT(const ComplexArray& x);
+		///
+		/// Additive synthesis of sampleCount samples from a frequency bin collection, on an oscillator bank without per-sample trigonometry.
+		/// Every bin is a partial, x = DC + sum(|X| * cos(2 * pi * f * t + arg(X))), the amplitudes are taken as they are without the scale of a transform.
+		///
+		template<class T>
+		static ComplexArrayT<T> SynthAdditive(
+			const FreqBinDataT<T>& XBinData ///< Input frequency bin collection
+			, double fs ///< Sample rate in Hz
+			, size_t sampleCount ///< Output sample count
+		);
 
-		static ComplexArray IDFT(const ComplexArray& X);
+		template<class T>
+		static ComplexArrayT<T> DFT(const ComplexArrayT<T>& x);
 
-		static ComplexArray GenerateWindowFunction(WindowDesc windowDesc);
+		template<class T>
+		static ComplexArrayT<T> IDFT(const ComplexArrayT<T>& X);
 
-		static std::vector<ComplexArray> FFT(const ComplexArray& x, WindowDesc windowDesc);
+		///
+		/// The DFT of count samples at frequencyCount arbitrary frequencies, X[k] = sum(x[n] * exp(-j * 2 * pi * f[k] * n / fs)).
+		/// Goertzel's recursion costs O(count * frequencyCount) instead of a whole transform, the frequencies are the lanes of the MathKernels recursion.
+		/// The recursion runs in double for float samples as well, its error grows with count at frequencies close to 0 and fs / 2.
+		///
+		template<class T>
+		static void Goertzel(const T* x, size_t count, const double* frequencies, size_t frequencyCount, double fs, ComplexT<T>* X);
 
-		static ComplexArray IFFT(const std::vector<ComplexArray>& X, WindowDesc windowDesc);
+		///
+		/// Linear convolution of x with h into xCount + hCount - 1 samples.
+		/// The FFT method splits the output into overlap-save blocks, long signals are processed on the worker threads of TaskScheduler.
+		///
+		template<class T>
+		static void Convolve(const T* x, size_t xCount, const T* h, size_t hCount, std::vector<T>& y, ConvolutionMethod method = ConvolutionMethod::Auto);
 
-		static void FFT_SingleFrame(ComplexArray& x);
+		///
+		/// Cross-correlation into xCount + yCount - 1 lags, r[i] = sum(x[n + i - (yCount - 1)] * y[n]).
+		/// The peak at index i means x is y delayed by i - (yCount - 1) samples.
+		///
+		template<class T>
+		static void CrossCorrelate(const T* x, size_t xCount, const T* y, size_t yCount, std::vector<T>& r, ConvolutionMethod method = ConvolutionMethod::Auto);
 
-		static void IFFT_SingleFrame(ComplexArray& x);
+		///
+		/// A copy of the cached window of WindowBank as complex values
+		///
+		template<class T = double>
+		static ComplexArrayT<T> GenerateWindowFunction(WindowDesc windowDesc);
+
+		///
+		/// The frames of the STFT of x, a signal shorter than the window is covered by zero padded frames like the edges of a longer one.
+		///
+		template<class T>
+		static std::vector<ComplexArrayT<T>> FFT(const ComplexArrayT<T>& x, WindowDesc windowDesc);
+
+		///
+		/// Resynthesize the frames of FFT() with the same window, every frame should be of the window size.
+		///
+		template<class T>
+		static ComplexArrayT<T> IFFT(const std::vector<ComplexArrayT<T>>& X, WindowDesc windowDesc);
+
+		template<class T>
+		static void FFT_SingleFrame(ComplexArrayT<T>& x);
+
+		template<class T>
+		static void IFFT_SingleFrame(ComplexArrayT<T>& x);
+
+		///
+		/// Real-input FFT, the real parts of x are transformed into x.size() / 2 + 1 bins.
+		///
+		template<class T>
+		static ComplexArrayT<T> RFFT_SingleFrame(const ComplexArrayT<T>& x);
+
+		///
+		/// Inverse of RFFT_SingleFrame, N / 2 + 1 bins are transformed into N real samples.
+		///
+		template<class T>
+		static ComplexArrayT<T> IRFFT_SingleFrame(const ComplexArrayT<T>& X, size_t N);
 
 		///
 		/// Convert the frequency domain signal series to a frequency bin collection.
 		///
-		static std::vector<FreqBinData> FreqDomainSeries2FreqBin(
-			const std::vector<ComplexArray>& X ///< Input frequency domain signal series
+		template<class T>
+		static std::vector<FreqBinDataT<T>> FreqDomainSeries2FreqBin(
+			const std::vector<ComplexArrayT<T>>& X ///< Input frequency domain signal series
 			, double fs ///< Sample rate in Hz
 		);
 
 		///
 		/// Convert the frequency domain signal series to a frequency bin collection. Single frame version.
 		///
-		static FreqBinData FreqDomainSeries2FreqBin_SingleFrame(
-			const ComplexArray& X ///< Input frequency domain signal series
+		template<class T>
+		static FreqBinDataT<T> FreqDomainSeries2FreqBin_SingleFrame(
+			const ComplexArrayT<T>& X ///< Input frequency domain signal series
+			, double fs ///< Sample rate in Hz
+		);
+
+		///
+		/// Convert the real parts of a time domain signal series to a frequency bin collection with a real-input FFT. Single frame version.
+		///
+		template<class T>
+		static FreqBinDataT<T> TimeDomainSeries2FreqBin_SingleFrame(
+			const ComplexArrayT<T>& x ///< Input time domain signal series
+			, double fs ///< Sample rate in Hz
+		);
+
+		///
+		/// Transform the real parts of a time domain signal series into a spectrum. The spectrum's storage is reused.
+		///
+		template<class T>
+		static void TimeDomainSeries2Spectrum_SingleFrame(
+			const ComplexArrayT<T>& x ///< Input time domain signal series
+			, double fs ///< Sample rate in Hz
+			, SpectrumT<T>& X ///< Output spectrum
+		);
+
+		template<class T>
+		static SpectrumT<T> TimeDomainSeries2Spectrum_SingleFrame(
+			const ComplexArrayT<T>& x ///< Input time domain signal series
 			, double fs ///< Sample rate in Hz
 		);
 
+		///
+		/// Convert between a frequency bin collection and a spectrum of 2 * bin count samples.
+		///
+		template<class T>
+		static SpectrumT<T> FreqBin2Spectrum_SingleFrame(const FreqBinDataT<T>& XBinData, double fs);
+
+		template<class T>
+		static FreqBinDataT<T> Spectrum2FreqBin_SingleFrame(const SpectrumT<T>& X);
+
 		///
 		/// Convert the frequency bin collection to a frequency domain signal series.
 		///
-		static std::vector <ComplexArray> FreqBin2FreqDomainSeries(
-			const std::vector<FreqBinData>& XBinData ///< Input frequency bin collection
+		template<class T>
+		static std::vector <ComplexArrayT<T>> FreqBin2FreqDomainSeries(
+			const std::vector<FreqBinDataT<T>>& XBinData ///< Input frequency bin collection
 		);
 
 		///
 		/// Convert the frequency bin collection to a frequency domain signal series. Single frame version.
 		///
-		static ComplexArray FreqBin2FreqDomainSeries_SingleFrame(
-			const FreqBinData& XBinData ///< Input frequency bin collection
+		template<class T>
+		static ComplexArrayT<T> FreqBin2FreqDomainSeries_SingleFrame(
+			const FreqBinDataT<T>& XBinData ///< Input frequency bin collection
 		);
 
 		///
-		/// Synthesize a time domain signal series by a given frequency bin collection.
+		/// Synthesize a time domain signal series by a given frequency bin collection, the frames are overlap-added and should have the same bin count.
 		///
-		static ComplexArray Synth(
-			const std::vector<FreqBinData>& XBinData, ///< Input frequency bin collection
+		template<class T>
+		static ComplexArrayT<T> Synth(
+			const std::vector<FreqBinDataT<T>>& XBinData, ///< Input frequency bin collection
 			WindowDesc windowDesc ///< STFT window description
 		);
 
 		///
 		/// Synthesize a time domain signal series by a given frequency bin collection. Single frame version.
 		///
-		static ComplexArray Synth_SingleFrame(
-			const FreqBinData& XBinData ///< Input frequency bin collection
+		template<class T>
+		static ComplexArrayT<T> Synth_SingleFrame(
+			const FreqBinDataT<T>& XBinData ///< Input frequency bin collection
+		);
+
+		///
+		/// Synthesize the time domain frame of a spectrum.
+		///
+		template<class T>
+		static ComplexArrayT<T> Synth_SingleFrame(
+			const SpectrumT<T>& X ///< Input spectrum
 		);
 	};
 }
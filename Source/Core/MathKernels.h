@@ -0,0 +1,251 @@
+#pragma once
+#include "stdafx.h"
+#include "SIMD.h"
+
+namespace Waveless
+{
+	///
+	/// The constants of the log2 and exp2 approximations, shared by the scalar path and the vectorized kernels.
+	/// log2 moves the mantissa to [sqrt(2) / 2, sqrt(2)) and expands log(m) = 2 * atanh((m - 1) / (m + 1)) as a series,
+	/// exp2 splits x into floor(x) and a fraction f and expands 2^f = sqrt(2) * e^((f - 0.5) * ln(2)) as a series.
+	/// The term counts keep the truncation error below the precision of the type.
+	///
+	template<class T>
+	struct FastMathTraits;
+
+	template<>
+	struct FastMathTraits<float>
+	{
+		using Int = int32_t;
+		static constexpr int m_MantissaBits = 23;
+		static constexpr int m_Bias = 127;
+		// 1.5 * 2^23, the low bits of the mantissa of m_RoundMagic + i hold the two's complement of a small integer i
+		static constexpr float m_RoundMagic = 12582912.0f;
+		static constexpr size_t m_LogTerms = 4;
+		static constexpr size_t m_ExpTerms = 8;
+	};
+
+	template<>
+	struct FastMathTraits<double>
+	{
+		using Int = int64_t;
+		static constexpr int m_MantissaBits = 52;
+		static constexpr int m_Bias = 1023;
+		static constexpr double m_RoundMagic = 6755399441055744.0;
+		static constexpr size_t m_LogTerms = 10;
+		static constexpr size_t m_ExpTerms = 14;
+	};
+
+	namespace FastMathConstants
+	{
+		// 1 / (2k + 1), the atanh series in s^2
+		constexpr double m_LogSeries[] = {
+			1.0, 1.0 / 3.0, 1.0 / 5.0, 1.0 / 7.0, 1.0 / 9.0, 1.0 / 11.0, 1.0 / 13.0, 1.0 / 15.0, 1.0 / 17.0, 1.0 / 19.0 };
+
+		// 1 / k!, the exponential series
+		constexpr double m_ExpSeries[] = {
+			1.0, 1.0, 1.0 / 2.0, 1.0 / 6.0, 1.0 / 24.0, 1.0 / 120.0, 1.0 / 720.0, 1.0 / 5040.0, 1.0 / 40320.0, 1.0 / 362880.0,
+			1.0 / 3628800.0, 1.0 / 39916800.0, 1.0 / 479001600.0, 1.0 / 6227020800.0 };
+
+		constexpr double m_Sqrt2 = 1.4142135623730951;
+		constexpr double m_HalfSqrt2 = 0.70710678118654752;
+		constexpr double m_Ln2 = 0.69314718055994531;
+		// 2 / ln(2)
+		constexpr double m_TwoLog2E = 2.8853900817779268;
+	}
+
+	///
+	/// out = scale * log2(in) or out = 2^(scale * in) for a multiple of the kernel width of values.
+	/// The log2 inputs are clamped to the positive normal range and the exp2 arguments to [-bias + 1, bias), the caller patches the values out of range.
+	///
+	template<class T>
+	using MathKernel = void(*)(const T* in, T* out, size_t count, T scale);
+
+	///
+	/// The partials of an oscillator bank as arrays, laneCount is a multiple of the kernel width
+	///
+	template<class T>
+	struct OscillatorLanes
+	{
+		T* m_Real;
+		T* m_Imag;
+		T* m_RotationReal;
+		T* m_RotationImag;
+		const T* m_ChirpReal;
+		const T* m_ChirpImag;
+		T* m_Amplitude;
+		const T* m_AmplitudeStep;
+		size_t m_LaneCount;
+	};
+
+	// The maximum frame count of an oscillator kernel call, the partial sums of every frame are kept in registers or on the stack
+	constexpr size_t m_OscillatorBlockSize = 64;
+
+	///
+	/// Rotate the phasors frameCount times and add the sum of amplitude * imaginary part to out[0, frameCount).
+	/// During a ramp the amplitudes step and the rotations turn by the chirps every frame
+	///
+	template<class T>
+	using OscillatorKernel = void(*)(const OscillatorLanes<T>& lanes, T* out, size_t frameCount, bool isRamping);
+
+	///
+	/// The sum of lhs[i] * rhs[i], count is a multiple of the kernel width
+	///
+	template<class T>
+	using DotKernel = T(*)(const T* lhs, const T* rhs, size_t count);
+
+	///
+	/// Goertzel's recursion s[n] = x[n] + coefficient * s[n - 1] - s[n - 2] over count samples for laneCount frequencies,
+	/// s1 and s2 hold s[n - 1] and s[n - 2] and carry the states between the calls. laneCount is a multiple of the kernel width
+	///
+	template<class T>
+	using GoertzelKernel = void(*)(const T* x, size_t count, const T* coefficient, T* s1, T* s2, size_t laneCount);
+
+	///
+	/// The frequencies of a sliding DFT as arrays, laneCount is a multiple of the kernel width
+	///
+	template<class T>
+	struct SlidingDFTLanes
+	{
+		T* m_Real;
+		T* m_Imag;
+		const T* m_RotationReal;
+		const T* m_RotationImag;
+		const T* m_InputReal;
+		const T* m_InputImag;
+		size_t m_LaneCount;
+	};
+
+	///
+	/// S = (S - oldest[n]) * rotation + newest[n] * input for count samples
+	///
+	template<class T>
+	using SlidingDFTKernel = void(*)(const SlidingDFTLanes<T>& lanes, const T* newest, const T* oldest, size_t count);
+
+	///
+	/// The running sums and counts of a signal, the kernels accumulate into them
+	///
+	template<class T>
+	struct StatisticsAccumulator
+	{
+		T m_Peak;
+		T m_Sum;
+		T m_SquareSum;
+		uint64_t m_ZeroCrossingCount;
+		uint64_t m_ClippedCount;
+	};
+
+	///
+	/// Accumulate the peak of |x|, the sums of x and x^2, the sign changes from x[i - 1] to x[i] and the count of |x| >= clipLevel over x[0, count).
+	/// x[-1] is read as the sample before the first one, count is a multiple of the kernel width and less than 2^31.
+	/// A NaN is measured as 0 by the peak and the clip level, and carried by the sums
+	///
+	template<class T>
+	using StatisticsKernel = void(*)(const T* x, size_t count, T clipLevel, StatisticsAccumulator<T>& accumulator);
+
+	///
+	/// acc += a * b for count complex values stored as separate real and imaginary arrays, count is a multiple of the kernel width
+	///
+	template<class T>
+	using ComplexMultiplyAddKernel = void(*)(const T* aReal, const T* aImag, const T* bReal, const T* bImag, T* accReal, T* accImag, size_t count);
+
+	template<class T>
+	struct MathKernelTable
+	{
+		size_t m_Width;
+		MathKernel<T> m_Log2;
+		MathKernel<T> m_Exp2;
+		OscillatorKernel<T> m_Oscillate;
+		DotKernel<T> m_Dot;
+		GoertzelKernel<T> m_Goertzel;
+		SlidingDFTKernel<T> m_SlidingDFT;
+		StatisticsKernel<T> m_Statistics;
+		ComplexMultiplyAddKernel<T> m_ComplexMultiplyAdd;
+	};
+
+	///
+	/// The vectorized kernels of every instruction set, each one is compiled in its own translation unit with the matching target flags.
+	/// nullptr if the instruction set is not available for the target architecture.
+	///
+	namespace MathKernels
+	{
+		template<class T>
+		const MathKernelTable<T>* GetSSE2();
+
+		template<class T>
+		const MathKernelTable<T>* GetAVX2();
+
+		template<class T>
+		const MathKernelTable<T>* GetAVX512();
+
+		///
+		/// The kernels of SIMD::GetInstructionSet(), nullptr for the scalar path
+		///
+		template<class T>
+		const MathKernelTable<T>* Get()
+		{
+			switch (SIMD::GetInstructionSet())
+			{
+			case InstructionSet::AVX512:
+				return GetAVX512<T>();
+			case InstructionSet::AVX2:
+				return GetAVX2<T>();
+			case InstructionSet::SSE2:
+				return GetSSE2<T>();
+			default:
+				return nullptr;
+			}
+		}
+
+		///
+		/// acc += a * b for count complex values stored as separate real and imaginary arrays, the kernel of Get() runs the multiples of its width.
+		/// The tail is written out so the multiply doesn't go through the NaN checks of std::complex
+		///
+		template<class T>
+		void ComplexMultiplyAdd(const T* aReal, const T* aImag, const T* bReal, const T* bImag, T* accReal, T* accImag, size_t count)
+		{
+			size_t i = 0;
+
+			if (auto l_kernels = Get<T>())
+			{
+				i = count / l_kernels->m_Width * l_kernels->m_Width;
+
+				if (i)
+				{
+					l_kernels->m_ComplexMultiplyAdd(aReal, aImag, bReal, bImag, accReal, accImag, i);
+				}
+			}
+
+			for (; i < count; i++)
+			{
+				accReal[i] += aReal[i] * bReal[i] - aImag[i] * bImag[i];
+				accImag[i] += aReal[i] * bImag[i] + aImag[i] * bReal[i];
+			}
+		}
+
+		///
+		/// Move count interleaved complex values, such as the bins of an FFT plan, to separate real and imaginary arrays
+		///
+		template<class T>
+		void SplitComplex(const std::complex<T>* in, T* real, T* imag, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				real[i] = in[i].real();
+				imag[i] = in[i].imag();
+			}
+		}
+
+		///
+		/// Interleave count complex values of separate real and imaginary arrays
+		///
+		template<class T>
+		void MergeComplex(const T* real, const T* imag, std::complex<T>* out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				out[i] = std::complex<T>(real[i], imag[i]);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,458 @@
+// The vectorized log2 and exp2 approximations, the oscillator bank rotation, the dot product, the Goertzel and sliding DFT recursions, the signal statistics and the complex multiply-add of spectra, included by every MathKernels_<ISA>.cpp after the definition of its register traits.
+// A traits class V provides Scalar, Reg, Width, Set1(), Load(), Store(), Add(), Sub(), Mul(), Div(), Min(), Max(), Floor(), Sum() of the lanes,
+// and the lane-wise integer operations on the bits of the registers: Set1Bits(), AddBits(), SubBits(), AndBits(), ShiftLeftBits<N>() and ShiftRightBits<N>() (logical).
+// Only intrinsics are used here, so no inline function of another translation unit is compiled with the target flags.
+
+namespace
+{
+	using namespace Waveless;
+
+	template<class To, class From>
+	inline To BitCast(From x)
+	{
+		To l_result;
+		std::memcpy(&l_result, &x, sizeof(To));
+		return l_result;
+	}
+
+	template<class V, size_t N>
+	inline typename V::Reg Polynomial(typename V::Reg x, const double* c)
+	{
+		using Scalar = typename V::Scalar;
+
+		auto l_result = V::Set1(Scalar(c[N - 1]));
+
+		for (size_t k = N - 1; k > 0; k--)
+		{
+			l_result = V::Add(V::Mul(l_result, x), V::Set1(Scalar(c[k - 1])));
+		}
+
+		return l_result;
+	}
+
+	template<class V>
+	void Log2(const typename V::Scalar* in, typename V::Scalar* out, size_t count, typename V::Scalar scale)
+	{
+		using Scalar = typename V::Scalar;
+		using F = FastMathTraits<Scalar>;
+		using Int = typename F::Int;
+
+		constexpr auto l_minValue = std::numeric_limits<Scalar>::min();
+		constexpr auto l_maxValue = std::numeric_limits<Scalar>::max();
+		const auto l_min = V::Set1(l_minValue);
+		const auto l_max = V::Set1(l_maxValue);
+		const auto l_one = V::Set1(Scalar(1));
+		const auto l_halfSqrt2 = V::Set1(Scalar(FastMathConstants::m_HalfSqrt2));
+		// The biased exponent keeps the offset bits positive for the logical shift
+		const auto l_offset = V::Set1Bits((Int(F::m_Bias) << F::m_MantissaBits) - BitCast<Int>(Scalar(FastMathConstants::m_HalfSqrt2)));
+		const auto l_mantissaMask = V::Set1Bits((Int(1) << F::m_MantissaBits) - 1);
+		const auto l_roundMagic = V::Set1(F::m_RoundMagic);
+		const auto l_exponentOffset = V::Set1(F::m_RoundMagic + Scalar(F::m_Bias));
+		const auto l_scale = V::Set1(scale * Scalar(FastMathConstants::m_TwoLog2E));
+		const auto l_scaleExponent = V::Set1(scale);
+
+		for (size_t i = 0; i < count; i += V::Width)
+		{
+			// NaN takes the second operand of Max and ends at the minimum
+			auto x = V::Min(V::Max(V::Load(in + i), l_min), l_max);
+
+			auto l_bits = V::AddBits(x, l_offset);
+			auto l_exponent = V::Sub(V::AddBits(V::template ShiftRightBits<F::m_MantissaBits>(l_bits), l_roundMagic), l_exponentOffset);
+			auto m = V::AddBits(V::AndBits(l_bits, l_mantissaMask), l_halfSqrt2);
+
+			auto s = V::Div(V::Sub(m, l_one), V::Add(m, l_one));
+			auto p = Polynomial<V, F::m_LogTerms>(V::Mul(s, s), FastMathConstants::m_LogSeries);
+
+			V::Store(out + i, V::Add(V::Mul(l_exponent, l_scaleExponent), V::Mul(V::Mul(s, p), l_scale)));
+		}
+	}
+
+	template<class V>
+	void Exp2(const typename V::Scalar* in, typename V::Scalar* out, size_t count, typename V::Scalar scale)
+	{
+		using Scalar = typename V::Scalar;
+		using F = FastMathTraits<Scalar>;
+
+		const auto l_min = V::Set1(Scalar(-F::m_Bias + 1));
+		// The largest value below the bias
+		constexpr auto l_maxValue = Scalar(F::m_Bias) - Scalar(F::m_Bias) * std::numeric_limits<Scalar>::epsilon();
+		const auto l_max = V::Set1(l_maxValue);
+		const auto l_scale = V::Set1(scale);
+		const auto l_half = V::Set1(Scalar(0.5));
+		const auto l_ln2 = V::Set1(Scalar(FastMathConstants::m_Ln2));
+		const auto l_sqrt2 = V::Set1(Scalar(FastMathConstants::m_Sqrt2));
+		const auto l_roundMagic = V::Set1(F::m_RoundMagic);
+		const auto l_bias = V::Set1Bits(F::m_Bias);
+
+		for (size_t i = 0; i < count; i += V::Width)
+		{
+			auto x = V::Min(V::Max(V::Mul(V::Load(in + i), l_scale), l_min), l_max);
+
+			auto l_integer = V::Floor(x);
+			auto u = V::Mul(V::Sub(V::Sub(x, l_integer), l_half), l_ln2);
+			auto p = Polynomial<V, F::m_ExpTerms>(u, FastMathConstants::m_ExpSeries);
+
+			// The integer sits in the low bits of the mantissa after the magic addition
+			auto l_integerBits = V::SubBits(V::Add(l_integer, l_roundMagic), l_roundMagic);
+			auto l_exponent = V::template ShiftLeftBits<F::m_MantissaBits>(V::AddBits(l_integerBits, l_bias));
+
+			V::Store(out + i, V::Mul(V::Mul(p, l_exponent), l_sqrt2));
+		}
+	}
+
+	///
+	/// G groups of partials rotated together, their chains of dependent multiplies overlap in the pipeline
+	///
+	template<class V, bool IsRamping, size_t G>
+	void OscillateGroups(const OscillatorLanes<typename V::Scalar>& lanes, size_t k, typename V::Reg* sum, size_t frameCount)
+	{
+		using Reg = typename V::Reg;
+
+		Reg l_real[G], l_imag[G], l_rotationReal[G], l_rotationImag[G], l_amplitude[G];
+		Reg l_chirpReal[G], l_chirpImag[G], l_amplitudeStep[G];
+
+		for (size_t g = 0; g < G; g++)
+		{
+			auto l_offset = k + g * V::Width;
+			l_real[g] = V::Load(lanes.m_Real + l_offset);
+			l_imag[g] = V::Load(lanes.m_Imag + l_offset);
+			l_rotationReal[g] = V::Load(lanes.m_RotationReal + l_offset);
+			l_rotationImag[g] = V::Load(lanes.m_RotationImag + l_offset);
+			l_amplitude[g] = V::Load(lanes.m_Amplitude + l_offset);
+
+			if (IsRamping)
+			{
+				l_chirpReal[g] = V::Load(lanes.m_ChirpReal + l_offset);
+				l_chirpImag[g] = V::Load(lanes.m_ChirpImag + l_offset);
+				l_amplitudeStep[g] = V::Load(lanes.m_AmplitudeStep + l_offset);
+			}
+		}
+
+		for (size_t n = 0; n < frameCount; n++)
+		{
+			auto l_sum = sum[n];
+
+			for (size_t g = 0; g < G; g++)
+			{
+				l_sum = V::Add(l_sum, V::Mul(l_amplitude[g], l_imag[g]));
+
+				auto l_re = V::Sub(V::Mul(l_real[g], l_rotationReal[g]), V::Mul(l_imag[g], l_rotationImag[g]));
+				l_imag[g] = V::Add(V::Mul(l_real[g], l_rotationImag[g]), V::Mul(l_imag[g], l_rotationReal[g]));
+				l_real[g] = l_re;
+
+				if (IsRamping)
+				{
+					auto l_rotRe = V::Sub(V::Mul(l_rotationReal[g], l_chirpReal[g]), V::Mul(l_rotationImag[g], l_chirpImag[g]));
+					l_rotationImag[g] = V::Add(V::Mul(l_rotationReal[g], l_chirpImag[g]), V::Mul(l_rotationImag[g], l_chirpReal[g]));
+					l_rotationReal[g] = l_rotRe;
+					l_amplitude[g] = V::Add(l_amplitude[g], l_amplitudeStep[g]);
+				}
+			}
+
+			sum[n] = l_sum;
+		}
+
+		for (size_t g = 0; g < G; g++)
+		{
+			auto l_offset = k + g * V::Width;
+			V::Store(lanes.m_Real + l_offset, l_real[g]);
+			V::Store(lanes.m_Imag + l_offset, l_imag[g]);
+
+			if (IsRamping)
+			{
+				V::Store(lanes.m_RotationReal + l_offset, l_rotationReal[g]);
+				V::Store(lanes.m_RotationImag + l_offset, l_rotationImag[g]);
+				V::Store(lanes.m_Amplitude + l_offset, l_amplitude[g]);
+			}
+		}
+	}
+
+	template<class V, bool IsRamping>
+	void OscillateLanes(const OscillatorLanes<typename V::Scalar>& lanes, typename V::Scalar* out, size_t frameCount)
+	{
+		using Scalar = typename V::Scalar;
+		using Reg = typename V::Reg;
+
+		// Enough independent chains to hide the latency of the multiplies, with few spills on the 16 registers of SSE2 and AVX2
+		constexpr size_t l_groupCount = 4;
+		constexpr size_t l_groupWidth = l_groupCount * V::Width;
+
+		Reg l_sum[m_OscillatorBlockSize];
+
+		for (size_t n = 0; n < frameCount; n++)
+		{
+			l_sum[n] = V::Set1(Scalar(0));
+		}
+
+		size_t k = 0;
+
+		for (; k + l_groupWidth <= lanes.m_LaneCount; k += l_groupWidth)
+		{
+			OscillateGroups<V, IsRamping, l_groupCount>(lanes, k, l_sum, frameCount);
+		}
+
+		for (; k < lanes.m_LaneCount; k += V::Width)
+		{
+			OscillateGroups<V, IsRamping, 1>(lanes, k, l_sum, frameCount);
+		}
+
+		Scalar l_lanes[V::Width];
+
+		for (size_t n = 0; n < frameCount; n++)
+		{
+			V::Store(l_lanes, l_sum[n]);
+
+			auto l_result = Scalar(0);
+
+			for (size_t j = 0; j < V::Width; j++)
+			{
+				l_result += l_lanes[j];
+			}
+
+			out[n] += l_result;
+		}
+	}
+
+	template<class V>
+	void Oscillate(const OscillatorLanes<typename V::Scalar>& lanes, typename V::Scalar* out, size_t frameCount, bool isRamping)
+	{
+		if (isRamping)
+		{
+			OscillateLanes<V, true>(lanes, out, frameCount);
+		}
+		else
+		{
+			OscillateLanes<V, false>(lanes, out, frameCount);
+		}
+	}
+
+	template<class V>
+	typename V::Scalar Dot(const typename V::Scalar* lhs, const typename V::Scalar* rhs, size_t count)
+	{
+		using Scalar = typename V::Scalar;
+
+		// Two accumulators halve the chain of dependent additions
+		auto l_sum0 = V::Set1(Scalar(0));
+		auto l_sum1 = V::Set1(Scalar(0));
+		size_t i = 0;
+
+		for (; i + 2 * V::Width <= count; i += 2 * V::Width)
+		{
+			l_sum0 = V::Add(l_sum0, V::Mul(V::Load(lhs + i), V::Load(rhs + i)));
+			l_sum1 = V::Add(l_sum1, V::Mul(V::Load(lhs + i + V::Width), V::Load(rhs + i + V::Width)));
+		}
+
+		for (; i < count; i += V::Width)
+		{
+			l_sum0 = V::Add(l_sum0, V::Mul(V::Load(lhs + i), V::Load(rhs + i)));
+		}
+
+		return V::Sum(V::Add(l_sum0, l_sum1));
+	}
+
+	///
+	/// G groups of frequencies keep their states in registers while the samples stream through
+	///
+	template<class V, size_t G>
+	void GoertzelGroups(const typename V::Scalar* x, size_t count, const typename V::Scalar* coefficient, typename V::Scalar* s1, typename V::Scalar* s2)
+	{
+		using Reg = typename V::Reg;
+
+		Reg l_coefficient[G], l_s1[G], l_s2[G];
+
+		for (size_t g = 0; g < G; g++)
+		{
+			l_coefficient[g] = V::Load(coefficient + g * V::Width);
+			l_s1[g] = V::Load(s1 + g * V::Width);
+			l_s2[g] = V::Load(s2 + g * V::Width);
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			auto l_x = V::Set1(x[n]);
+
+			for (size_t g = 0; g < G; g++)
+			{
+				// x - s[n - 2] is off the chain of dependent operations
+				auto l_s0 = V::Add(V::Sub(l_x, l_s2[g]), V::Mul(l_coefficient[g], l_s1[g]));
+				l_s2[g] = l_s1[g];
+				l_s1[g] = l_s0;
+			}
+		}
+
+		for (size_t g = 0; g < G; g++)
+		{
+			V::Store(s1 + g * V::Width, l_s1[g]);
+			V::Store(s2 + g * V::Width, l_s2[g]);
+		}
+	}
+
+	template<class V>
+	void Goertzel(const typename V::Scalar* x, size_t count, const typename V::Scalar* coefficient, typename V::Scalar* s1, typename V::Scalar* s2, size_t laneCount)
+	{
+		constexpr size_t l_groupCount = 4;
+		constexpr size_t l_groupWidth = l_groupCount * V::Width;
+
+		size_t k = 0;
+
+		for (; k + l_groupWidth <= laneCount; k += l_groupWidth)
+		{
+			GoertzelGroups<V, l_groupCount>(x, count, coefficient + k, s1 + k, s2 + k);
+		}
+
+		for (; k < laneCount; k += V::Width)
+		{
+			GoertzelGroups<V, 1>(x, count, coefficient + k, s1 + k, s2 + k);
+		}
+	}
+
+	template<class V, size_t G>
+	void SlidingDFTGroups(const SlidingDFTLanes<typename V::Scalar>& lanes, size_t k, const typename V::Scalar* newest, const typename V::Scalar* oldest, size_t count)
+	{
+		using Reg = typename V::Reg;
+
+		Reg l_real[G], l_imag[G], l_rotationReal[G], l_rotationImag[G], l_inputReal[G], l_inputImag[G];
+
+		for (size_t g = 0; g < G; g++)
+		{
+			auto l_offset = k + g * V::Width;
+			l_real[g] = V::Load(lanes.m_Real + l_offset);
+			l_imag[g] = V::Load(lanes.m_Imag + l_offset);
+			l_rotationReal[g] = V::Load(lanes.m_RotationReal + l_offset);
+			l_rotationImag[g] = V::Load(lanes.m_RotationImag + l_offset);
+			l_inputReal[g] = V::Load(lanes.m_InputReal + l_offset);
+			l_inputImag[g] = V::Load(lanes.m_InputImag + l_offset);
+		}
+
+		for (size_t n = 0; n < count; n++)
+		{
+			auto l_newest = V::Set1(newest[n]);
+			auto l_oldest = V::Set1(oldest[n]);
+
+			for (size_t g = 0; g < G; g++)
+			{
+				auto a = V::Sub(l_real[g], l_oldest);
+				auto b = l_imag[g];
+				l_real[g] = V::Add(V::Sub(V::Mul(a, l_rotationReal[g]), V::Mul(b, l_rotationImag[g])), V::Mul(l_newest, l_inputReal[g]));
+				l_imag[g] = V::Add(V::Add(V::Mul(a, l_rotationImag[g]), V::Mul(b, l_rotationReal[g])), V::Mul(l_newest, l_inputImag[g]));
+			}
+		}
+
+		for (size_t g = 0; g < G; g++)
+		{
+			auto l_offset = k + g * V::Width;
+			V::Store(lanes.m_Real + l_offset, l_real[g]);
+			V::Store(lanes.m_Imag + l_offset, l_imag[g]);
+		}
+	}
+
+	template<class V>
+	void SlidingDFT(const SlidingDFTLanes<typename V::Scalar>& lanes, const typename V::Scalar* newest, const typename V::Scalar* oldest, size_t count)
+	{
+		// 6 registers per group, 2 groups fit in the 16 registers of SSE2 and AVX2
+		constexpr size_t l_groupCount = 2;
+		constexpr size_t l_groupWidth = l_groupCount * V::Width;
+
+		size_t k = 0;
+
+		for (; k + l_groupWidth <= lanes.m_LaneCount; k += l_groupWidth)
+		{
+			SlidingDFTGroups<V, l_groupCount>(lanes, k, newest, oldest, count);
+		}
+
+		for (; k < lanes.m_LaneCount; k += V::Width)
+		{
+			SlidingDFTGroups<V, 1>(lanes, k, newest, oldest, count);
+		}
+	}
+
+	template<class V>
+	void Statistics(const typename V::Scalar* x, size_t count, typename V::Scalar clipLevel, StatisticsAccumulator<typename V::Scalar>& accumulator)
+	{
+		using Scalar = typename V::Scalar;
+		using Int = typename FastMathTraits<Scalar>::Int;
+		constexpr int l_signShift = (int)sizeof(Scalar) * 8 - 1;
+
+		auto l_absMask = V::Set1Bits(std::numeric_limits<Int>::max());
+		auto l_one = V::Set1Bits(1);
+		auto l_clipLevel = V::Set1(clipLevel);
+		auto l_zero = V::Set1(Scalar(0));
+
+		auto l_peak = V::Set1(Scalar(0));
+		auto l_sum = V::Set1(Scalar(0));
+		auto l_squareSum = V::Set1(Scalar(0));
+		auto l_zeroCrossingCount = V::Set1Bits(0);
+		auto l_unclippedCount = V::Set1Bits(0);
+
+		for (size_t i = 0; i < count; i += V::Width)
+		{
+			auto l_x = V::Load(x + i);
+			auto l_previous = V::Load(x + i - 1);
+			// NaN takes the second operand of Max and is measured as 0
+			auto l_abs = V::Max(V::AndBits(l_x, l_absMask), l_zero);
+
+			l_peak = V::Max(l_peak, l_abs);
+			l_sum = V::Add(l_sum, l_x);
+			l_squareSum = V::Add(l_squareSum, V::Mul(l_x, l_x));
+
+			// The sum of the two sign bits is odd where the signs differ
+			auto l_signs = V::AddBits(V::template ShiftRightBits<l_signShift>(l_x), V::template ShiftRightBits<l_signShift>(l_previous));
+			l_zeroCrossingCount = V::AddBits(l_zeroCrossingCount, V::AndBits(l_signs, l_one));
+
+			// The bits of non-negative values order like the values, the difference is negative below the clip level
+			l_unclippedCount = V::AddBits(l_unclippedCount, V::template ShiftRightBits<l_signShift>(V::SubBits(l_abs, l_clipLevel)));
+		}
+
+		Scalar l_peaks[V::Width], l_zeroCrossingCounts[V::Width], l_unclippedCounts[V::Width];
+		V::Store(l_peaks, l_peak);
+		V::Store(l_zeroCrossingCounts, l_zeroCrossingCount);
+		V::Store(l_unclippedCounts, l_unclippedCount);
+
+		uint64_t l_unclipped = 0;
+
+		for (size_t i = 0; i < V::Width; i++)
+		{
+			accumulator.m_Peak = l_peaks[i] > accumulator.m_Peak ? l_peaks[i] : accumulator.m_Peak;
+			accumulator.m_ZeroCrossingCount += (uint64_t)BitCast<Int>(l_zeroCrossingCounts[i]);
+			l_unclipped += (uint64_t)BitCast<Int>(l_unclippedCounts[i]);
+		}
+
+		accumulator.m_Sum += V::Sum(l_sum);
+		accumulator.m_SquareSum += V::Sum(l_squareSum);
+		accumulator.m_ClippedCount += count - l_unclipped;
+	}
+
+	template<class V>
+	void ComplexMultiplyAdd(const typename V::Scalar* aReal, const typename V::Scalar* aImag, const typename V::Scalar* bReal, const typename V::Scalar* bImag, typename V::Scalar* accReal, typename V::Scalar* accImag, size_t count)
+	{
+		for (size_t i = 0; i < count; i += V::Width)
+		{
+			auto l_aReal = V::Load(aReal + i);
+			auto l_aImag = V::Load(aImag + i);
+			auto l_bReal = V::Load(bReal + i);
+			auto l_bImag = V::Load(bImag + i);
+
+			V::Store(accReal + i, V::Add(V::Load(accReal + i), V::Sub(V::Mul(l_aReal, l_bReal), V::Mul(l_aImag, l_bImag))));
+			V::Store(accImag + i, V::Add(V::Load(accImag + i), V::Add(V::Mul(l_aReal, l_bImag), V::Mul(l_aImag, l_bReal))));
+		}
+	}
+
+	template<class V>
+	const MathKernelTable<typename V::Scalar>* GetKernelTable()
+	{
+		static const MathKernelTable<typename V::Scalar> l_table =
+		{
+			V::Width,
+			Log2<V>,
+			Exp2<V>,
+			Oscillate<V>,
+			Dot<V>,
+			Goertzel<V>,
+			SlidingDFT<V>,
+			Statistics<V>,
+			ComplexMultiplyAdd<V>,
+		};
+
+		return &l_table;
+	}
+}
\ No newline at end of file
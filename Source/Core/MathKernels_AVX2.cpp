@@ -0,0 +1,97 @@
+#include "MathKernels.h"
+
+#if defined(WS_SIMD_X86)
+#include <immintrin.h>
+
+namespace
+{
+	struct AVX2Double
+	{
+		using Scalar = double;
+		using Reg = __m256d;
+		static constexpr size_t Width = 4;
+
+		static Reg Set1(Scalar x) { return _mm256_set1_pd(x); }
+		static Reg Load(const Scalar* p) { return _mm256_loadu_pd(p); }
+		static void Store(Scalar* p, Reg x) { _mm256_storeu_pd(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm256_add_pd(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm256_sub_pd(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm256_mul_pd(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm256_div_pd(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm256_min_pd(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm256_max_pd(lhs, rhs); }
+		static Reg Floor(Reg x) { return _mm256_floor_pd(x); }
+
+		static Scalar Sum(Reg x)
+		{
+			auto l_sum = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+			return _mm_cvtsd_f64(_mm_add_sd(l_sum, _mm_unpackhi_pd(l_sum, l_sum)));
+		}
+
+		static Reg Set1Bits(int64_t x) { return _mm256_castsi256_pd(_mm256_set1_epi64x(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(lhs), _mm256_castpd_si256(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_castpd_si256(lhs), _mm256_castpd_si256(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm256_and_pd(lhs, rhs); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(x), N)); }
+	};
+
+	struct AVX2Float
+	{
+		using Scalar = float;
+		using Reg = __m256;
+		static constexpr size_t Width = 8;
+
+		static Reg Set1(Scalar x) { return _mm256_set1_ps(x); }
+		static Reg Load(const Scalar* p) { return _mm256_loadu_ps(p); }
+		static void Store(Scalar* p, Reg x) { _mm256_storeu_ps(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm256_add_ps(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm256_sub_ps(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm256_mul_ps(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm256_div_ps(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm256_min_ps(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm256_max_ps(lhs, rhs); }
+		static Reg Floor(Reg x) { return _mm256_floor_ps(x); }
+
+		static Scalar Sum(Reg x)
+		{
+			auto l_sum = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+			l_sum = _mm_add_ps(l_sum, _mm_movehl_ps(l_sum, l_sum));
+			return _mm_cvtss_f32(_mm_add_ss(l_sum, _mm_shuffle_ps(l_sum, l_sum, 1)));
+		}
+
+		static Reg Set1Bits(int32_t x) { return _mm256_castsi256_ps(_mm256_set1_epi32(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(lhs), _mm256_castps_si256(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_castps_si256(lhs), _mm256_castps_si256(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm256_and_ps(lhs, rhs); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm256_castsi256_ps(_mm256_srli_epi32(_mm256_castps_si256(x), N)); }
+	};
+}
+
+#include "MathKernels.inl"
+
+template<>
+const MathKernelTable<double>* Waveless::MathKernels::GetAVX2<double>()
+{
+	return GetKernelTable<AVX2Double>();
+}
+
+template<>
+const MathKernelTable<float>* Waveless::MathKernels::GetAVX2<float>()
+{
+	return GetKernelTable<AVX2Float>();
+}
+#else
+template<>
+const Waveless::MathKernelTable<double>* Waveless::MathKernels::GetAVX2<double>()
+{
+	return nullptr;
+}
+
+template<>
+const Waveless::MathKernelTable<float>* Waveless::MathKernels::GetAVX2<float>()
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,89 @@
+#include "MathKernels.h"
+
+#if defined(WS_SIMD_X86)
+#include <immintrin.h>
+
+namespace
+{
+	// Only AVX-512F, the floating point logic operations of AVX-512DQ go through the integer ones
+	struct AVX512Double
+	{
+		using Scalar = double;
+		using Reg = __m512d;
+		static constexpr size_t Width = 8;
+
+		static Reg Set1(Scalar x) { return _mm512_set1_pd(x); }
+		static Reg Load(const Scalar* p) { return _mm512_loadu_pd(p); }
+		static void Store(Scalar* p, Reg x) { _mm512_storeu_pd(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm512_add_pd(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm512_sub_pd(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm512_mul_pd(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm512_div_pd(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm512_min_pd(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm512_max_pd(lhs, rhs); }
+		static Reg Floor(Reg x) { return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+		static Scalar Sum(Reg x) { return _mm512_reduce_add_pd(x); }
+
+		static Reg Set1Bits(int64_t x) { return _mm512_castsi512_pd(_mm512_set1_epi64(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm512_castsi512_pd(_mm512_sub_epi64(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs))); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm512_castsi512_pd(_mm512_srli_epi64(_mm512_castpd_si512(x), N)); }
+	};
+
+	struct AVX512Float
+	{
+		using Scalar = float;
+		using Reg = __m512;
+		static constexpr size_t Width = 16;
+
+		static Reg Set1(Scalar x) { return _mm512_set1_ps(x); }
+		static Reg Load(const Scalar* p) { return _mm512_loadu_ps(p); }
+		static void Store(Scalar* p, Reg x) { _mm512_storeu_ps(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm512_add_ps(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm512_sub_ps(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm512_mul_ps(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm512_div_ps(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm512_min_ps(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm512_max_ps(lhs, rhs); }
+		static Reg Floor(Reg x) { return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+		static Scalar Sum(Reg x) { return _mm512_reduce_add_ps(x); }
+
+		static Reg Set1Bits(int32_t x) { return _mm512_castsi512_ps(_mm512_set1_epi32(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm512_castsi512_ps(_mm512_add_epi32(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm512_castsi512_ps(_mm512_sub_epi32(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs))); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_castps_si512(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm512_castsi512_ps(_mm512_srli_epi32(_mm512_castps_si512(x), N)); }
+	};
+}
+
+#include "MathKernels.inl"
+
+template<>
+const MathKernelTable<double>* Waveless::MathKernels::GetAVX512<double>()
+{
+	return GetKernelTable<AVX512Double>();
+}
+
+template<>
+const MathKernelTable<float>* Waveless::MathKernels::GetAVX512<float>()
+{
+	return GetKernelTable<AVX512Float>();
+}
+#else
+template<>
+const Waveless::MathKernelTable<double>* Waveless::MathKernels::GetAVX512<double>()
+{
+	return nullptr;
+}
+
+template<>
+const Waveless::MathKernelTable<float>* Waveless::MathKernels::GetAVX512<float>()
+{
+	return nullptr;
+}
+#endif
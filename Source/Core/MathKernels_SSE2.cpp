@@ -0,0 +1,105 @@
+#include "MathKernels.h"
+
+#if defined(WS_SIMD_X86)
+#include <emmintrin.h>
+
+namespace
+{
+	struct SSE2Double
+	{
+		using Scalar = double;
+		using Reg = __m128d;
+		static constexpr size_t Width = 2;
+
+		static Reg Set1(Scalar x) { return _mm_set1_pd(x); }
+		static Reg Load(const Scalar* p) { return _mm_loadu_pd(p); }
+		static void Store(Scalar* p, Reg x) { _mm_storeu_pd(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm_add_pd(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm_sub_pd(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm_mul_pd(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm_div_pd(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm_min_pd(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm_max_pd(lhs, rhs); }
+
+		// No rounding instruction before SSE4.1, round to the nearest with the magic constant and step down where it rounded up
+		static Reg Floor(Reg x)
+		{
+			auto l_magic = _mm_set1_pd(6755399441055744.0);
+			auto l_rounded = _mm_sub_pd(_mm_add_pd(x, l_magic), l_magic);
+			return _mm_sub_pd(l_rounded, _mm_and_pd(_mm_cmpgt_pd(l_rounded, x), _mm_set1_pd(1.0)));
+		}
+
+		static Scalar Sum(Reg x) { return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x))); }
+
+		static Reg Set1Bits(int64_t x) { return _mm_castsi128_pd(_mm_set1_epi64x(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(lhs), _mm_castpd_si128(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm_castsi128_pd(_mm_sub_epi64(_mm_castpd_si128(lhs), _mm_castpd_si128(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm_and_pd(lhs, rhs); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(x), N)); }
+	};
+
+	struct SSE2Float
+	{
+		using Scalar = float;
+		using Reg = __m128;
+		static constexpr size_t Width = 4;
+
+		static Reg Set1(Scalar x) { return _mm_set1_ps(x); }
+		static Reg Load(const Scalar* p) { return _mm_loadu_ps(p); }
+		static void Store(Scalar* p, Reg x) { _mm_storeu_ps(p, x); }
+		static Reg Add(Reg lhs, Reg rhs) { return _mm_add_ps(lhs, rhs); }
+		static Reg Sub(Reg lhs, Reg rhs) { return _mm_sub_ps(lhs, rhs); }
+		static Reg Mul(Reg lhs, Reg rhs) { return _mm_mul_ps(lhs, rhs); }
+		static Reg Div(Reg lhs, Reg rhs) { return _mm_div_ps(lhs, rhs); }
+		static Reg Min(Reg lhs, Reg rhs) { return _mm_min_ps(lhs, rhs); }
+		static Reg Max(Reg lhs, Reg rhs) { return _mm_max_ps(lhs, rhs); }
+
+		static Reg Floor(Reg x)
+		{
+			auto l_magic = _mm_set1_ps(12582912.0f);
+			auto l_rounded = _mm_sub_ps(_mm_add_ps(x, l_magic), l_magic);
+			return _mm_sub_ps(l_rounded, _mm_and_ps(_mm_cmpgt_ps(l_rounded, x), _mm_set1_ps(1.0f)));
+		}
+
+		static Scalar Sum(Reg x)
+		{
+			auto l_sum = _mm_add_ps(x, _mm_movehl_ps(x, x));
+			return _mm_cvtss_f32(_mm_add_ss(l_sum, _mm_shuffle_ps(l_sum, l_sum, 1)));
+		}
+
+		static Reg Set1Bits(int32_t x) { return _mm_castsi128_ps(_mm_set1_epi32(x)); }
+		static Reg AddBits(Reg lhs, Reg rhs) { return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(lhs), _mm_castps_si128(rhs))); }
+		static Reg SubBits(Reg lhs, Reg rhs) { return _mm_castsi128_ps(_mm_sub_epi32(_mm_castps_si128(lhs), _mm_castps_si128(rhs))); }
+		static Reg AndBits(Reg lhs, Reg rhs) { return _mm_and_ps(lhs, rhs); }
+		template<int N> static Reg ShiftLeftBits(Reg x) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(x), N)); }
+		template<int N> static Reg ShiftRightBits(Reg x) { return _mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(x), N)); }
+	};
+}
+
+#include "MathKernels.inl"
+
+template<>
+const MathKernelTable<double>* Waveless::MathKernels::GetSSE2<double>()
+{
+	return GetKernelTable<SSE2Double>();
+}
+
+template<>
+const MathKernelTable<float>* Waveless::MathKernels::GetSSE2<float>()
+{
+	return GetKernelTable<SSE2Float>();
+}
+#else
+template<>
+const Waveless::MathKernelTable<double>* Waveless::MathKernels::GetSSE2<double>()
+{
+	return nullptr;
+}
+
+template<>
+const Waveless::MathKernelTable<float>* Waveless::MathKernels::GetSSE2<float>()
+{
+	return nullptr;
+}
+#endif
@@ -0,0 +1,276 @@
+#include "OscillatorBank.h"
+#include "Math.h"
+#include "MathKernels.h"
+#include "Logger.h"
+
+using namespace Waveless;
+
+template<class T>
+WsResult OscillatorBankT<T>::Setup(double fs, size_t partialCount)
+{
+	if (fs <= 0.0)
+	{
+		Logger::Log(LogLevel::Warning, "Oscillator bank sample rate is invalid.");
+		return WsResult::Fail;
+	}
+
+	m_SampleRate = fs;
+	m_PartialCount = partialCount;
+	m_LaneCount = (partialCount + m_Lanes - 1) / m_Lanes * m_Lanes;
+	m_RampingCount = 0;
+	m_ResyncFrames = 0;
+
+	m_Real.assign(m_LaneCount, T(1));
+	m_Imag.assign(m_LaneCount, T(0));
+	m_RotationReal.assign(m_LaneCount, T(1));
+	m_RotationImag.assign(m_LaneCount, T(0));
+	m_ChirpReal.assign(m_LaneCount, T(1));
+	m_ChirpImag.assign(m_LaneCount, T(0));
+	m_Amplitude.assign(m_LaneCount, T(0));
+	m_AmplitudeStep.assign(m_LaneCount, T(0));
+
+	m_Phase.assign(m_LaneCount, 0.0);
+	m_Frequency.assign(m_LaneCount, 0.0);
+	m_FrequencyStep.assign(m_LaneCount, 0.0);
+	m_TargetFrequency.assign(m_LaneCount, 0.0);
+	m_TargetAmplitude.assign(m_LaneCount, 0.0);
+	m_RampFramesLeft.assign(m_LaneCount, 0);
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult OscillatorBankT<T>::SetPartial(size_t index, double frequency, double amplitude, double phase)
+{
+	if (index >= m_PartialCount)
+	{
+		Logger::Log(LogLevel::Warning, "Oscillator bank partial index is out of range.");
+		return WsResult::Fail;
+	}
+
+	if (m_RampFramesLeft[index])
+	{
+		m_RampFramesLeft[index] = 0;
+		m_RampingCount--;
+	}
+
+	m_Phase[index] = phase - 2.0 * PI<double> * std::floor(phase / (2.0 * PI<double>));
+	m_Real[index] = T(std::cos(m_Phase[index]));
+	m_Imag[index] = T(std::sin(m_Phase[index]));
+	m_Amplitude[index] = T(amplitude);
+	m_AmplitudeStep[index] = T(0);
+	m_ChirpReal[index] = T(1);
+	m_ChirpImag[index] = T(0);
+	m_Frequency[index] = frequency;
+	m_FrequencyStep[index] = 0.0;
+	SetRotation(index, frequency);
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult OscillatorBankT<T>::RampPartial(size_t index, double frequency, double amplitude, size_t rampFrames)
+{
+	if (index >= m_PartialCount)
+	{
+		Logger::Log(LogLevel::Warning, "Oscillator bank partial index is out of range.");
+		return WsResult::Fail;
+	}
+
+	if (!rampFrames)
+	{
+		m_Amplitude[index] = T(amplitude);
+		m_AmplitudeStep[index] = T(0);
+		m_ChirpReal[index] = T(1);
+		m_ChirpImag[index] = T(0);
+		m_Frequency[index] = frequency;
+		m_FrequencyStep[index] = 0.0;
+		SetRotation(index, frequency);
+
+		if (m_RampFramesLeft[index])
+		{
+			m_RampFramesLeft[index] = 0;
+			m_RampingCount--;
+		}
+
+		return WsResult::Success;
+	}
+
+	if (!m_RampFramesLeft[index])
+	{
+		m_RampingCount++;
+	}
+
+	m_RampFramesLeft[index] = rampFrames;
+	m_TargetFrequency[index] = frequency;
+	m_TargetAmplitude[index] = amplitude;
+	m_FrequencyStep[index] = (frequency - m_Frequency[index]) / (double)rampFrames;
+	m_AmplitudeStep[index] = T((amplitude - (double)m_Amplitude[index]) / (double)rampFrames);
+
+	// The rotation starts from the current frequency and turns by the frequency step every sample
+	SetRotation(index, m_Frequency[index]);
+	auto l_chirp = 2.0 * PI<double> * m_FrequencyStep[index] / m_SampleRate;
+	m_ChirpReal[index] = T(std::cos(l_chirp));
+	m_ChirpImag[index] = T(std::sin(l_chirp));
+
+	return WsResult::Success;
+}
+
+template<class T>
+void OscillatorBankT<T>::Process(T* out, size_t frameCount, bool accumulate)
+{
+	if (!accumulate)
+	{
+		std::fill(out, out + frameCount, T(0));
+	}
+
+	size_t l_frame = 0;
+
+	while (l_frame < frameCount)
+	{
+		auto l_blockSize = std::min({ m_BlockSize, frameCount - l_frame, m_ResyncInterval - m_ResyncFrames });
+
+		// A block ends with the first ramp, the partials stay in lock step inside of it
+		for (size_t i = 0; m_RampingCount && i < m_PartialCount; i++)
+		{
+			if (m_RampFramesLeft[i])
+			{
+				l_blockSize = std::min(l_blockSize, m_RampFramesLeft[i]);
+			}
+		}
+
+		ProcessBlock(out + l_frame, l_blockSize, m_RampingCount != 0);
+		Advance(l_blockSize);
+		l_frame += l_blockSize;
+	}
+}
+
+template<class T>
+void OscillatorBankT<T>::ProcessBlock(T* out, size_t frameCount, bool isRamping)
+{
+	static_assert(m_BlockSize <= m_OscillatorBlockSize, "The block doesn't fit in the oscillator kernels.");
+
+	if (auto l_kernels = MathKernels::Get<T>())
+	{
+		OscillatorLanes<T> l_lanes =
+		{
+			m_Real.data(), m_Imag.data(), m_RotationReal.data(), m_RotationImag.data(),
+			m_ChirpReal.data(), m_ChirpImag.data(), m_Amplitude.data(), m_AmplitudeStep.data(), m_LaneCount
+		};
+
+		l_kernels->m_Oscillate(l_lanes, out, frameCount, isRamping);
+		return;
+	}
+
+	for (size_t i = 0; i < m_PartialCount; i++)
+	{
+		auto l_real = m_Real[i];
+		auto l_imag = m_Imag[i];
+		auto l_rotationReal = m_RotationReal[i];
+		auto l_rotationImag = m_RotationImag[i];
+		auto l_amplitude = m_Amplitude[i];
+
+		for (size_t n = 0; n < frameCount; n++)
+		{
+			out[n] += l_amplitude * l_imag;
+
+			auto l_re = l_real * l_rotationReal - l_imag * l_rotationImag;
+			l_imag = l_real * l_rotationImag + l_imag * l_rotationReal;
+			l_real = l_re;
+
+			if (isRamping)
+			{
+				auto l_rotRe = l_rotationReal * m_ChirpReal[i] - l_rotationImag * m_ChirpImag[i];
+				l_rotationImag = l_rotationReal * m_ChirpImag[i] + l_rotationImag * m_ChirpReal[i];
+				l_rotationReal = l_rotRe;
+				l_amplitude += m_AmplitudeStep[i];
+			}
+		}
+
+		m_Real[i] = l_real;
+		m_Imag[i] = l_imag;
+		m_RotationReal[i] = l_rotationReal;
+		m_RotationImag[i] = l_rotationImag;
+		m_Amplitude[i] = l_amplitude;
+	}
+}
+
+template<class T>
+void OscillatorBankT<T>::Advance(size_t frameCount)
+{
+	auto l_frames = (double)frameCount;
+	auto l_omega = 2.0 * PI<double> / m_SampleRate;
+
+	for (size_t i = 0; i < m_PartialCount; i++)
+	{
+		// The frequencies of the block are f, f + step, ..., f + (frameCount - 1) * step
+		m_Phase[i] += l_omega * (m_Frequency[i] * l_frames + m_FrequencyStep[i] * l_frames * (l_frames - 1.0) / 2.0);
+	}
+
+	for (size_t i = 0; m_RampingCount && i < m_PartialCount; i++)
+	{
+		if (!m_RampFramesLeft[i])
+		{
+			continue;
+		}
+
+		// Measured back from the targets, the sums of the steps would drift over a long ramp
+		m_RampFramesLeft[i] -= frameCount;
+		m_Frequency[i] = m_TargetFrequency[i] - m_FrequencyStep[i] * (double)m_RampFramesLeft[i];
+		m_Amplitude[i] = T(m_TargetAmplitude[i] - (double)m_AmplitudeStep[i] * (double)m_RampFramesLeft[i]);
+
+		// The chirps rotate the rotation, its rounding grows into the phase with the square of the frames, so a ramping partial is resynced every block
+		if (m_RampFramesLeft[i])
+		{
+			m_Phase[i] -= 2.0 * PI<double> * std::floor(m_Phase[i] / (2.0 * PI<double>));
+			m_Real[i] = T(std::cos(m_Phase[i]));
+			m_Imag[i] = T(std::sin(m_Phase[i]));
+			SetRotation(i, m_Frequency[i]);
+			continue;
+		}
+
+		// Land exactly on the target, the accumulated steps are rounded
+		m_RampingCount--;
+		m_Frequency[i] = m_TargetFrequency[i];
+		m_FrequencyStep[i] = 0.0;
+		m_Amplitude[i] = T(m_TargetAmplitude[i]);
+		m_AmplitudeStep[i] = T(0);
+		m_ChirpReal[i] = T(1);
+		m_ChirpImag[i] = T(0);
+		SetRotation(i, m_Frequency[i]);
+	}
+
+	m_ResyncFrames += frameCount;
+
+	if (m_ResyncFrames == m_ResyncInterval)
+	{
+		Resync();
+	}
+}
+
+template<class T>
+void OscillatorBankT<T>::Resync()
+{
+	m_ResyncFrames = 0;
+
+	for (size_t i = 0; i < m_PartialCount; i++)
+	{
+		m_Phase[i] -= 2.0 * PI<double> * std::floor(m_Phase[i] / (2.0 * PI<double>));
+		m_Real[i] = T(std::cos(m_Phase[i]));
+		m_Imag[i] = T(std::sin(m_Phase[i]));
+	}
+}
+
+template<class T>
+void OscillatorBankT<T>::SetRotation(size_t index, double frequency)
+{
+	auto w = 2.0 * PI<double> * frequency / m_SampleRate;
+	m_RotationReal[index] = T(std::cos(w));
+	m_RotationImag[index] = T(std::sin(w));
+}
+
+namespace Waveless
+{
+	template class OscillatorBankT<float>;
+	template class OscillatorBankT<double>;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+
+namespace Waveless
+{
+	///
+	/// A bank of sine oscillators summed into one output.
+	/// Every partial is a phasor rotated by a complex multiply per sample, there is no trigonometric function in the sample loop.
+	/// The partials are arrays padded to m_Lanes, the SSE2, AVX2 or AVX-512 kernels of MathKernels rotate a vector of them at once.
+	/// The rounding of the rotation accumulates, every m_ResyncInterval samples the phasors are reset from a phase kept in double, every block during a ramp.
+	///
+	template<class T>
+	class OscillatorBankT
+	{
+	public:
+		// A multiple of the width of every kernel
+		static constexpr size_t m_Lanes = 16;
+		static constexpr size_t m_BlockSize = 64;
+		static constexpr size_t m_ResyncInterval = 1024;
+
+		OscillatorBankT() = default;
+		~OscillatorBankT() = default;
+
+		///
+		/// Allocate partialCount silent partials at the sample rate fs, the only allocation of the bank
+		///
+		WsResult Setup(double fs, size_t partialCount);
+
+		///
+		/// Jump a partial to the frequency in Hz, the linear amplitude and the phase in radians, it outputs amplitude * sin(phase).
+		/// Frequencies beyond the Nyquist frequency alias
+		///
+		WsResult SetPartial(size_t index, double frequency, double amplitude, double phase = 0.0);
+
+		///
+		/// Ramp a partial linearly from its current frequency and amplitude to the new ones over rampFrames, the phase stays continuous
+		///
+		WsResult RampPartial(size_t index, double frequency, double amplitude, size_t rampFrames);
+
+		///
+		/// Render frameCount samples of the sum of the partials, added to out if accumulate is true
+		///
+		void Process(T* out, size_t frameCount, bool accumulate = false);
+
+		size_t GetPartialCount() const { return m_PartialCount; }
+
+	private:
+		void ProcessBlock(T* out, size_t frameCount, bool isRamping);
+
+		void Advance(size_t frameCount);
+		void Resync();
+		void SetRotation(size_t index, double frequency);
+
+		double m_SampleRate = 0.0;
+		size_t m_PartialCount = 0;
+		// m_PartialCount rounded up to the lanes, the padding partials are silent
+		size_t m_LaneCount = 0;
+		size_t m_RampingCount = 0;
+		size_t m_ResyncFrames = 0;
+
+		// The phasor, the output is its imaginary part
+		std::vector<T> m_Real;
+		std::vector<T> m_Imag;
+		// The rotation per sample, e^(i * 2 * pi * f / fs)
+		std::vector<T> m_RotationReal;
+		std::vector<T> m_RotationImag;
+		// The rotation of the rotation per sample during a frequency ramp, 1 otherwise
+		std::vector<T> m_ChirpReal;
+		std::vector<T> m_ChirpImag;
+		std::vector<T> m_Amplitude;
+		std::vector<T> m_AmplitudeStep;
+
+		// The exact phase at the last block, wrapped to [0, 2 * pi) at every resync
+		std::vector<double> m_Phase;
+		std::vector<double> m_Frequency;
+		std::vector<double> m_FrequencyStep;
+		std::vector<double> m_TargetFrequency;
+		std::vector<double> m_TargetAmplitude;
+		std::vector<size_t> m_RampFramesLeft;
+	};
+
+	extern template class OscillatorBankT<float>;
+	extern template class OscillatorBankT<double>;
+
+	using OscillatorBank = OscillatorBankT<double>;
+	using OscillatorBankF = OscillatorBankT<float>;
+}
\ No newline at end of file
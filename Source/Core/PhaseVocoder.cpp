@@ -0,0 +1,382 @@
+#include "PhaseVocoder.h"
+#include "WindowBank.h"
+#include "Logger.h"
+
+namespace Waveless::PhaseVocoderNS
+{
+	constexpr double m_MinTimeStretch = 0.125;
+	constexpr double m_MaxTimeStretch = 8.0;
+	constexpr double m_MaxPitchShift = 24.0;
+	// A rise of 6 dB
+	constexpr double m_TransientRise = 2.0;
+	// Below this window sum the output is not covered by a frame
+	constexpr double m_MinWindowSum = 1e-6;
+
+	template<class T>
+	inline T WrapPhase(T x)
+	{
+		return x - T(2) * PI<T> * std::round(x / (T(2) * PI<T>));
+	}
+}
+
+using namespace Waveless;
+using namespace Waveless::PhaseVocoderNS;
+
+template<class T>
+WsResult PhaseVocoderT<T>::Setup(const PhaseVocoderDesc& desc)
+{
+	auto N = desc.m_WindowDesc.m_WindowSize;
+	auto l_hopSize = desc.m_WindowDesc.m_HopSize ? desc.m_WindowDesc.m_HopSize : N / 4;
+
+	if (N < 16 || (N & 1) || l_hopSize > N / 2)
+	{
+		Logger::Log(LogLevel::Warning, "Phase vocoder window size should be even and at least twice the hop size.");
+		return WsResult::Fail;
+	}
+
+	m_Desc = desc;
+	m_Desc.m_WindowDesc.m_HopSize = l_hopSize;
+
+	if (SetTimeStretch(desc.m_TimeStretch) != WsResult::Success || SetPitchShift(desc.m_PitchShift) != WsResult::Success)
+	{
+		return WsResult::Fail;
+	}
+
+	if (m_Resampler.Setup(m_PitchRatio, 1.0) != WsResult::Success)
+	{
+		return WsResult::Fail;
+	}
+
+	m_WindowSize = N;
+	m_HopSize = l_hopSize;
+	m_BinCount = N / 2 + 1;
+	m_Plan = RealFFTPlanT<T>::Get(N);
+
+	m_Window = WindowBank::Get<T>(m_Desc.m_WindowDesc);
+
+	m_Bins.resize(m_BinCount);
+	m_Scratch.resize(m_Plan->GetScratchSize());
+	m_Frame.resize(N);
+	m_Magnitude.resize(m_BinCount);
+	m_Phase.resize(m_BinCount);
+	m_PreviousMagnitude.resize(m_BinCount);
+	m_PreviousPhase.resize(m_BinCount);
+	m_SynthesisPhase.resize(m_BinCount);
+	m_Frequency.resize(m_BinCount);
+	m_Peaks.reserve(m_BinCount);
+	m_Accumulator.resize(N);
+	m_WindowSum.resize(N);
+	// The consumed input is dropped past a window
+	m_Input.Reserve(4 * N);
+	m_Stretched.reserve(N);
+
+	Reset();
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult PhaseVocoderT<T>::SetTimeStretch(double timeStretch)
+{
+	if (!(timeStretch >= m_MinTimeStretch && timeStretch <= m_MaxTimeStretch))
+	{
+		Logger::Log(LogLevel::Warning, "Phase vocoder time stretch is out of range.");
+		return WsResult::Fail;
+	}
+
+	m_Desc.m_TimeStretch = timeStretch;
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult PhaseVocoderT<T>::SetPitchShift(double pitchShift)
+{
+	if (!(std::abs(pitchShift) <= m_MaxPitchShift))
+	{
+		Logger::Log(LogLevel::Warning, "Phase vocoder pitch shift is out of range.");
+		return WsResult::Fail;
+	}
+
+	m_Desc.m_PitchShift = pitchShift;
+	m_PitchRatio = std::pow(2.0, pitchShift / 12.0);
+
+	// The resampler is set up after the pitch ratio, while streaming only its ratio changes
+	if (m_WindowSize)
+	{
+		return m_Resampler.SetSampleRates(m_PitchRatio, 1.0);
+	}
+
+	return WsResult::Success;
+}
+
+template<class T>
+void PhaseVocoderT<T>::Reset()
+{
+	m_Input.Assign(m_WindowSize / 2, T(0));
+	m_AnalysisPosition = 0.0;
+	m_PreviousStart = 0;
+	m_HasPrevious = false;
+	m_WasTransient = false;
+	m_IsFlushed = false;
+	m_IsDrained = false;
+	m_InputEnd = 0;
+
+	std::fill(m_Accumulator.begin(), m_Accumulator.end(), T(0));
+	std::fill(m_WindowSum.begin(), m_WindowSum.end(), T(0));
+	m_LatencyLeft = m_WindowSize / 2;
+
+	for (size_t k = 0; k < m_BinCount; k++)
+	{
+		m_Frequency[k] = T(2) * PI<T> * T(k) / T(m_WindowSize);
+	}
+
+	m_Resampler.Reset();
+}
+
+template<class T>
+void PhaseVocoderT<T>::Push(const T* in, size_t count)
+{
+	if (m_IsFlushed)
+	{
+		Logger::Log(LogLevel::Warning, "Phase vocoder input is pushed after the end of the stream.");
+		return;
+	}
+
+	m_Input.Push(in, count);
+}
+
+template<class T>
+void PhaseVocoderT<T>::Flush()
+{
+	if (!m_IsFlushed)
+	{
+		m_IsFlushed = true;
+		m_InputEnd = m_Input.GetSize();
+	}
+}
+
+template<class T>
+size_t PhaseVocoderT<T>::Pull(T* out, size_t count)
+{
+	size_t l_written = 0;
+
+	while (l_written < count)
+	{
+		l_written += m_Resampler.Pull(out + l_written, count - l_written);
+
+		if (l_written == count || !ProcessFrame())
+		{
+			break;
+		}
+	}
+
+	return l_written;
+}
+
+template<class T>
+void PhaseVocoderT<T>::Render(const T* in, size_t count, std::vector<T>& out)
+{
+	Reset();
+
+	out.resize((size_t)std::llround((double)count * m_Desc.m_TimeStretch));
+
+	Push(in, count);
+	Flush();
+
+	auto l_written = Pull(out.data(), out.size());
+	std::fill(out.begin() + l_written, out.end(), T(0));
+}
+
+template<class T>
+bool PhaseVocoderT<T>::ProcessFrame()
+{
+	if (m_IsDrained || !m_WindowSize)
+	{
+		return false;
+	}
+
+	auto N = m_WindowSize;
+	auto l_start = (size_t)std::llround(m_AnalysisPosition);
+
+	if (m_IsFlushed && l_start >= m_InputEnd)
+	{
+		// No frame is left, the rest of the overlap-add is final
+		EmitSamples(N - m_HopSize);
+		m_Resampler.Flush();
+		m_IsDrained = true;
+		return true;
+	}
+
+	if (l_start + N > m_Input.GetSize())
+	{
+		if (!m_IsFlushed)
+		{
+			return false;
+		}
+
+		m_Input.PushZeros(l_start + N - m_Input.GetSize());
+	}
+
+	for (size_t i = 0; i < N; i++)
+	{
+		m_Frame[i] = m_Input[l_start + i] * m_Window[i];
+	}
+
+	m_Plan->Forward(m_Frame.data(), m_Bins.data(), m_Scratch.data());
+
+	for (size_t k = 0; k < m_BinCount; k++)
+	{
+		m_Magnitude[k] = std::abs(m_Bins[k]);
+		m_Phase[k] = std::arg(m_Bins[k]);
+	}
+
+	ComputeSynthesisPhases(m_HasPrevious ? (double)(l_start - m_PreviousStart) : 0.0);
+
+	for (size_t k = 0; k < m_BinCount; k++)
+	{
+		m_Bins[k] = std::polar(m_Magnitude[k], m_SynthesisPhase[k]);
+	}
+
+	m_Plan->Inverse(m_Bins.data(), m_Frame.data(), m_Scratch.data());
+
+	for (size_t i = 0; i < N; i++)
+	{
+		m_Accumulator[i] += m_Frame[i] * m_Window[i];
+		m_WindowSum[i] += m_Window[i] * m_Window[i];
+	}
+
+	// No later frame overlaps the first hop
+	EmitSamples(m_HopSize);
+
+	std::swap(m_Magnitude, m_PreviousMagnitude);
+	std::swap(m_Phase, m_PreviousPhase);
+	m_PreviousStart = l_start;
+	m_HasPrevious = true;
+	m_AnalysisPosition += (double)m_HopSize / (m_Desc.m_TimeStretch * m_PitchRatio);
+
+	auto l_dropped = m_Input.Discard(l_start, N);
+	m_AnalysisPosition -= (double)l_dropped;
+	m_PreviousStart -= l_dropped;
+	m_InputEnd -= m_IsFlushed ? l_dropped : 0;
+
+	return true;
+}
+
+template<class T>
+void PhaseVocoderT<T>::ComputeSynthesisPhases(double analysisHop)
+{
+	auto l_isTransient = false;
+
+	if (m_Desc.m_TransientPreservation && m_HasPrevious)
+	{
+		T l_risingEnergy = T(0);
+		T l_energy = T(0);
+
+		for (size_t k = 0; k < m_BinCount; k++)
+		{
+			auto l_binEnergy = m_Magnitude[k] * m_Magnitude[k];
+			l_energy += l_binEnergy;
+			l_risingEnergy += m_Magnitude[k] > T(m_TransientRise) * m_PreviousMagnitude[k] ? l_binEnergy : T(0);
+		}
+
+		// An onset spans several frames, the phases are only reset at its first one
+		l_isTransient = l_energy > T(0) && l_risingEnergy > T(m_Desc.m_TransientThreshold) * l_energy && !m_WasTransient;
+		m_WasTransient = l_isTransient;
+	}
+
+	if (!m_HasPrevious || l_isTransient)
+	{
+		std::copy(m_Phase.begin(), m_Phase.end(), m_SynthesisPhase.begin());
+		return;
+	}
+
+	auto l_hopSize = T(m_HopSize);
+
+	// The same frame analyzed twice has no phase advance, the last frequencies are kept
+	if (analysisHop > 0.0)
+	{
+		auto l_analysisHop = T(analysisHop);
+
+		for (size_t k = 0; k < m_BinCount; k++)
+		{
+			auto l_binFrequency = T(2) * PI<T> * T(k) / T(m_WindowSize);
+			auto l_deviation = WrapPhase(m_Phase[k] - m_PreviousPhase[k] - l_binFrequency * l_analysisHop);
+			m_Frequency[k] = l_binFrequency + l_deviation / l_analysisHop;
+		}
+	}
+
+	m_Peaks.clear();
+
+	if (m_Desc.m_PhaseLocking)
+	{
+		for (size_t k = 2; k + 2 < m_BinCount; k++)
+		{
+			auto l_magnitude = m_Magnitude[k];
+
+			if (l_magnitude > m_Magnitude[k - 1] && l_magnitude > m_Magnitude[k - 2] && l_magnitude >= m_Magnitude[k + 1] && l_magnitude >= m_Magnitude[k + 2])
+			{
+				m_Peaks.emplace_back(k);
+			}
+		}
+	}
+
+	if (m_Peaks.empty())
+	{
+		for (size_t k = 0; k < m_BinCount; k++)
+		{
+			m_SynthesisPhase[k] = WrapPhase(m_SynthesisPhase[k] + m_Frequency[k] * l_hopSize);
+		}
+
+		return;
+	}
+
+	// Identity phase locking, the bins closer to a peak than to its neighbours keep their analysis phase relative to the peak.
+	// The regions are disjoint and every one only reads the previous phase of its own peak
+	for (size_t i = 0; i < m_Peaks.size(); i++)
+	{
+		auto l_peak = m_Peaks[i];
+		auto l_begin = i ? (m_Peaks[i - 1] + l_peak) / 2 + 1 : 0;
+		auto l_end = i + 1 < m_Peaks.size() ? (l_peak + m_Peaks[i + 1]) / 2 + 1 : m_BinCount;
+
+		auto l_peakPhase = WrapPhase(m_SynthesisPhase[l_peak] + m_Frequency[l_peak] * l_hopSize);
+		auto l_rotation = l_peakPhase - m_Phase[l_peak];
+
+		for (size_t k = l_begin; k < l_end; k++)
+		{
+			m_SynthesisPhase[k] = WrapPhase(m_Phase[k] + l_rotation);
+		}
+	}
+}
+
+template<class T>
+void PhaseVocoderT<T>::EmitSamples(size_t count)
+{
+	auto N = m_WindowSize;
+	m_Stretched.clear();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (m_LatencyLeft)
+		{
+			m_LatencyLeft--;
+			continue;
+		}
+
+		auto l_windowSum = m_WindowSum[i];
+		m_Stretched.emplace_back(l_windowSum > T(m_MinWindowSum) ? m_Accumulator[i] / l_windowSum : T(0));
+	}
+
+	m_Resampler.Push(m_Stretched.data(), m_Stretched.size());
+
+	std::copy(m_Accumulator.begin() + count, m_Accumulator.end(), m_Accumulator.begin());
+	std::copy(m_WindowSum.begin() + count, m_WindowSum.end(), m_WindowSum.begin());
+	std::fill(m_Accumulator.begin() + (N - count), m_Accumulator.end(), T(0));
+	std::fill(m_WindowSum.begin() + (N - count), m_WindowSum.end(), T(0));
+}
+
+namespace Waveless
+{
+	template class PhaseVocoderT<float>;
+	template class PhaseVocoderT<double>;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include "Math.h"
+#include "FFTPlan.h"
+#include "SampleQueue.h"
+#include "Resampler.h"
+
+namespace Waveless
+{
+	struct PhaseVocoderDesc
+	{
+		// The window size should be even, the hop size is the synthesis hop, 0 means a quarter of the window size
+		WindowDesc m_WindowDesc = { WindowType::Hann, 2048, 0 };
+		// Output duration over input duration, in [1 / 8, 8]
+		double m_TimeStretch = 1.0;
+		// In semitones, in [-24, 24]
+		double m_PitchShift = 0.0;
+		// Keep the phases of the bins around a spectral peak relative to the peak, which removes most of the phasiness
+		bool m_PhaseLocking = true;
+		// Reset the synthesis phases to the analysis ones at the onsets, so the attacks stay sharp
+		bool m_TransientPreservation = true;
+		// The fraction of the energy of a frame in bins rising by more than 6 dB for the frame to be an onset
+		double m_TransientThreshold = 0.5;
+	};
+
+	///
+	/// Phase vocoder time stretching and pitch shifting of a mono signal.
+	/// The analysis frames are taken every synthesis hop / (stretch * pitch ratio) input samples and resynthesized every synthesis hop,
+	/// the stretched signal is then resampled to be read pitch ratio times faster, the band-limited filter of ResamplerT removes what would alias above the new Nyquist frequency.
+	/// Setup() allocates the FFT plan and the frame buffers and reserves the sample queues for a few windows, a push larger than that grows them.
+	/// A stream is pushed and pulled block by block, and the stretch and the pitch could change between the blocks.
+	///
+	template<class T>
+	class PhaseVocoderT
+	{
+	public:
+		PhaseVocoderT() = default;
+		~PhaseVocoderT() = default;
+
+		WsResult Setup(const PhaseVocoderDesc& desc);
+
+		WsResult SetTimeStretch(double timeStretch);
+		WsResult SetPitchShift(double pitchShift);
+
+		///
+		/// Start a new stream, the settings are kept
+		///
+		void Reset();
+
+		///
+		/// Queue count input samples
+		///
+		void Push(const T* in, size_t count);
+
+		///
+		/// Mark the end of the input, the frames are then padded with zeros until the last input sample is synthesized
+		///
+		void Flush();
+
+		///
+		/// Write up to count output samples, fewer if more input is needed or the flushed stream ended
+		///
+		size_t Pull(T* out, size_t count);
+
+		///
+		/// Offline rendering of a whole signal into round(count * time stretch) samples, the stream is reset
+		///
+		void Render(const T* in, size_t count, std::vector<T>& out);
+
+		size_t GetWindowSize() const { return m_WindowSize; }
+		size_t GetHopSize() const { return m_HopSize; }
+
+	private:
+		bool ProcessFrame();
+		void ComputeSynthesisPhases(double analysisHop);
+		void EmitSamples(size_t count);
+
+		PhaseVocoderDesc m_Desc;
+		double m_PitchRatio = 1.0;
+		size_t m_WindowSize = 0;
+		size_t m_HopSize = 0;
+		size_t m_BinCount = 0;
+		const RealFFTPlanT<T>* m_Plan = nullptr;
+		std::vector<T> m_Window;
+
+		std::vector<ComplexT<T>> m_Bins;
+		std::vector<ComplexT<T>> m_Scratch;
+		std::vector<T> m_Frame;
+		std::vector<T> m_Magnitude;
+		std::vector<T> m_Phase;
+		std::vector<T> m_PreviousMagnitude;
+		std::vector<T> m_PreviousPhase;
+		std::vector<T> m_SynthesisPhase;
+		// The instantaneous frequencies in radians per sample
+		std::vector<T> m_Frequency;
+		std::vector<size_t> m_Peaks;
+
+		// The input from the first sample of the next frames, it starts with half a window of zeros so the first frame is centered on the first sample
+		SampleQueueT<T> m_Input;
+		double m_AnalysisPosition = 0.0;
+		size_t m_PreviousStart = 0;
+		bool m_HasPrevious = false;
+		bool m_WasTransient = false;
+		bool m_IsFlushed = false;
+		bool m_IsDrained = false;
+		size_t m_InputEnd = 0;
+
+		// The windowed overlap-add of the synthesis frames and the sum of their squared windows
+		std::vector<T> m_Accumulator;
+		std::vector<T> m_WindowSum;
+		// Half a window of the output lies before the first input sample
+		size_t m_LatencyLeft = 0;
+
+		// The time stretched samples of a frame, and the pitch shift from the pitch ratio to 1
+		std::vector<T> m_Stretched;
+		ResamplerT<T> m_Resampler;
+	};
+
+	extern template class PhaseVocoderT<float>;
+	extern template class PhaseVocoderT<double>;
+
+	using PhaseVocoder = PhaseVocoderT<double>;
+	using PhaseVocoderF = PhaseVocoderT<float>;
+}
\ No newline at end of file
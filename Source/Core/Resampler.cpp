@@ -0,0 +1,363 @@
+#include "Resampler.h"
+#include "Math.h"
+#include "MathKernels.h"
+#include "Logger.h"
+
+namespace Waveless::ResamplerNS
+{
+	struct QualityDesc
+	{
+		size_t m_TapCount;
+		double m_KaiserBeta;
+		// Relative to the Nyquist frequency of the lower sample rate
+		double m_Cutoff;
+	};
+
+	constexpr QualityDesc m_QualityDescs[] =
+	{
+		{ 8, 4.0, 0.80 },
+		{ 16, 6.0, 0.82 },
+		{ 32, 8.0, 0.86 },
+		{ 64, 10.0, 0.91 },
+	};
+
+	// The widest kernel, 16 floats of AVX-512
+	constexpr size_t m_TapAlignment = 16;
+	// The downsampling filters are longer by the ratio to keep the transition band, up to this factor
+	constexpr double m_MaxTapScale = 4.0;
+	constexpr uint64_t m_InterpolatedDenominator = 1ull << 32;
+
+	// Modified Bessel function of the first kind of order 0
+	double BesselI0(double x)
+	{
+		auto l_result = 1.0;
+		auto l_term = 1.0;
+
+		for (int k = 1; k < 64 && l_term > l_result * 1e-17; k++)
+		{
+			auto l_half = x / (2.0 * (double)k);
+			l_term *= l_half * l_half;
+			l_result += l_term;
+		}
+
+		return l_result;
+	}
+
+	uint64_t GreatestCommonDivisor(uint64_t a, uint64_t b)
+	{
+		while (b)
+		{
+			auto l_remainder = a % b;
+			a = b;
+			b = l_remainder;
+		}
+
+		return a;
+	}
+}
+
+using namespace Waveless;
+using namespace Waveless::ResamplerNS;
+
+template<class T>
+WsResult ResamplerT<T>::Setup(double sourceSampleRate, double targetSampleRate, size_t channels, ResamplerQuality quality)
+{
+	if (!(sourceSampleRate > 0.0) || !(targetSampleRate > 0.0) || !channels)
+	{
+		Logger::Log(LogLevel::Warning, "Resampler sample rate or channel count is invalid.");
+		return WsResult::Fail;
+	}
+
+	m_ChannelCount = channels;
+	m_Quality = quality;
+
+	ComputeFilters(sourceSampleRate, targetSampleRate);
+
+	m_Input.resize(channels);
+
+	// The consumed input is dropped past 4 filter lengths
+	for (auto& i : m_Input)
+	{
+		i.Reserve(m_PaddedTapCount * 8);
+	}
+
+	Reset();
+
+	return WsResult::Success;
+}
+
+template<class T>
+WsResult ResamplerT<T>::SetSampleRates(double sourceSampleRate, double targetSampleRate)
+{
+	if (!(sourceSampleRate > 0.0) || !(targetSampleRate > 0.0) || !m_ChannelCount)
+	{
+		Logger::Log(LogLevel::Warning, "Resampler sample rate is invalid or the resampler isn't set up.");
+		return WsResult::Fail;
+	}
+
+	// The input frame of the next output frame and the fraction after it
+	auto l_position = m_Index + m_TapCount / 2 - 1;
+	auto l_fraction = (double)m_Fraction / (double)m_Denominator;
+
+	ComputeFilters(sourceSampleRate, targetSampleRate);
+
+	m_Fraction = std::min((uint64_t)std::llround(l_fraction * (double)m_Denominator), m_Denominator - 1);
+
+	// A longer filter reads further back, the frames before the first one are zeros
+	auto l_delay = m_TapCount / 2 - 1;
+	auto l_missing = l_delay > l_position ? l_delay - l_position : 0;
+
+	for (auto& i : m_Input)
+	{
+		i.PushFrontZeros(l_missing);
+
+		if (m_IsFlushed && i.GetSize() < m_InputEnd + l_missing + m_PaddedTapCount)
+		{
+			i.PushZeros(m_InputEnd + l_missing + m_PaddedTapCount - i.GetSize());
+		}
+	}
+
+	m_InputEnd += m_IsFlushed ? l_missing : 0;
+	m_Index = l_position + l_missing - l_delay;
+
+	return WsResult::Success;
+}
+
+template<class T>
+void ResamplerT<T>::ComputeFilters(double sourceSampleRate, double targetSampleRate)
+{
+	auto l_ratio = targetSampleRate / sourceSampleRate;
+	auto& l_quality = m_QualityDescs[(size_t)m_Quality];
+
+	auto l_isInteger = [](double x) { return x == std::floor(x) && x < 4294967296.0; };
+	m_IsExact = false;
+
+	if (l_isInteger(sourceSampleRate) && l_isInteger(targetSampleRate))
+	{
+		auto l_source = (uint64_t)sourceSampleRate;
+		auto l_target = (uint64_t)targetSampleRate;
+		auto l_divisor = GreatestCommonDivisor(l_source, l_target);
+
+		if (l_target / l_divisor <= m_MaxExactPhaseCount)
+		{
+			m_IsExact = true;
+			m_Denominator = l_target / l_divisor;
+			m_Step = l_source / l_divisor;
+		}
+	}
+
+	if (!m_IsExact)
+	{
+		m_Denominator = m_InterpolatedDenominator;
+		m_Step = (uint64_t)std::llround((double)m_InterpolatedDenominator / l_ratio);
+	}
+
+	m_PhaseCount = m_IsExact ? (size_t)m_Denominator : m_InterpolatedPhaseCount;
+
+	auto l_tapScale = std::min(std::max(1.0, 1.0 / l_ratio), m_MaxTapScale);
+	m_TapCount = ((size_t)std::ceil((double)l_quality.m_TapCount * l_tapScale) + 1) & ~size_t(1);
+	m_PaddedTapCount = (m_TapCount + m_TapAlignment - 1) / m_TapAlignment * m_TapAlignment;
+
+	// Normalized to the input sample rate. The same rates only read integer positions, the full band sinc is a unit impulse there
+	auto l_cutoff = sourceSampleRate == targetSampleRate ? 1.0 : l_quality.m_Cutoff * std::min(1.0, l_ratio);
+	auto l_halfTapCount = (double)(m_TapCount / 2);
+	auto l_besselBeta = BesselI0(l_quality.m_KaiserBeta);
+	auto l_rowCount = m_IsExact ? m_PhaseCount : m_PhaseCount + 1;
+
+	m_Table.assign(l_rowCount * m_PaddedTapCount, T(0));
+
+	for (size_t l_phase = 0; l_phase < l_rowCount; l_phase++)
+	{
+		auto l_row = &m_Table[l_phase * m_PaddedTapCount];
+		auto l_fraction = (double)l_phase / (double)m_PhaseCount;
+		auto l_sum = 0.0;
+		std::vector<double> l_coefficients(m_TapCount);
+
+		// Tap k reads the input frame m_Index + k, the output position is m_Index + m_TapCount / 2 - 1 + l_fraction
+		for (size_t k = 0; k < m_TapCount; k++)
+		{
+			auto t = (double)k - (l_halfTapCount - 1.0) - l_fraction;
+			auto r = t / l_halfTapCount;
+			auto l_window = std::abs(r) < 1.0 ? BesselI0(l_quality.m_KaiserBeta * std::sqrt(1.0 - r * r)) / l_besselBeta : 0.0;
+			auto x = PI<double> * l_cutoff * t;
+			auto l_sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(x) / x;
+
+			l_coefficients[k] = l_cutoff * l_sinc * l_window;
+			l_sum += l_coefficients[k];
+		}
+
+		// Unit gain at DC for every phase
+		for (size_t k = 0; k < m_TapCount; k++)
+		{
+			l_row[k] = T(l_coefficients[k] / l_sum);
+		}
+	}
+}
+
+template<class T>
+void ResamplerT<T>::Reset()
+{
+	m_Index = 0;
+	m_Fraction = 0;
+	m_IsFlushed = false;
+	m_InputEnd = 0;
+
+	for (auto& i : m_Input)
+	{
+		i.Assign(m_TapCount / 2 - 1, T(0));
+	}
+}
+
+template<class T>
+void ResamplerT<T>::Push(const T* in, size_t frameCount)
+{
+	if (m_IsFlushed)
+	{
+		Logger::Log(LogLevel::Warning, "Resampler input is pushed after the end of the stream.");
+		return;
+	}
+
+	for (size_t j = 0; j < m_ChannelCount; j++)
+	{
+		m_Input[j].Push(in + j, frameCount, m_ChannelCount);
+	}
+}
+
+template<class T>
+void ResamplerT<T>::Flush()
+{
+	if (m_IsFlushed || !m_ChannelCount)
+	{
+		return;
+	}
+
+	m_IsFlushed = true;
+	m_InputEnd = m_Input[0].GetSize();
+
+	// The taps after the last frame read zeros
+	for (auto& i : m_Input)
+	{
+		i.PushZeros(m_PaddedTapCount);
+	}
+}
+
+template<class T>
+size_t ResamplerT<T>::Pull(T* out, size_t frameCount)
+{
+	if (!m_ChannelCount)
+	{
+		return 0;
+	}
+
+	auto l_kernels = MathKernels::Get<T>();
+	auto l_delay = m_TapCount / 2 - 1;
+	auto l_inputSize = m_Input[0].GetSize();
+	size_t l_frame = 0;
+
+	for (; l_frame < frameCount; l_frame++)
+	{
+		if (m_IsFlushed ? m_Index + l_delay >= m_InputEnd : m_Index + m_PaddedTapCount > l_inputSize)
+		{
+			break;
+		}
+
+		const T* l_coefficients = nullptr;
+		const T* l_nextCoefficients = nullptr;
+		auto l_weight = T(0);
+
+		if (m_IsExact)
+		{
+			l_coefficients = &m_Table[(size_t)m_Fraction * m_PaddedTapCount];
+		}
+		else
+		{
+			auto l_phase = m_Fraction * m_PhaseCount;
+			auto l_index = (size_t)(l_phase / m_Denominator);
+			l_weight = T((double)(l_phase % m_Denominator) / (double)m_Denominator);
+			l_coefficients = &m_Table[l_index * m_PaddedTapCount];
+			l_nextCoefficients = l_coefficients + m_PaddedTapCount;
+		}
+
+		for (size_t j = 0; j < m_ChannelCount; j++)
+		{
+			auto l_input = m_Input[j].GetData() + m_Index;
+			T l_result;
+
+			if (l_kernels)
+			{
+				l_result = l_kernels->m_Dot(l_input, l_coefficients, m_PaddedTapCount);
+
+				if (l_nextCoefficients)
+				{
+					l_result += l_weight * (l_kernels->m_Dot(l_input, l_nextCoefficients, m_PaddedTapCount) - l_result);
+				}
+			}
+			else
+			{
+				l_result = T(0);
+				auto l_next = T(0);
+
+				for (size_t k = 0; k < m_TapCount; k++)
+				{
+					l_result += l_input[k] * l_coefficients[k];
+				}
+
+				if (l_nextCoefficients)
+				{
+					for (size_t k = 0; k < m_TapCount; k++)
+					{
+						l_next += l_input[k] * l_nextCoefficients[k];
+					}
+
+					l_result += l_weight * (l_next - l_result);
+				}
+			}
+
+			out[l_frame * m_ChannelCount + j] = l_result;
+		}
+
+		m_Fraction += m_Step;
+		m_Index += (size_t)(m_Fraction / m_Denominator);
+		m_Fraction %= m_Denominator;
+	}
+
+	size_t l_dropped = 0;
+
+	for (auto& i : m_Input)
+	{
+		l_dropped = i.Discard(m_Index, m_PaddedTapCount * 4);
+	}
+
+	m_Index -= l_dropped;
+	m_InputEnd -= m_IsFlushed ? l_dropped : 0;
+
+	return l_frame;
+}
+
+template<class T>
+void ResamplerT<T>::Render(const T* in, size_t frameCount, std::vector<T>& out)
+{
+	Reset();
+
+	auto l_outputFrameCount = GetOutputFrameCount(frameCount);
+	out.resize(l_outputFrameCount * m_ChannelCount);
+
+	Push(in, frameCount);
+	Flush();
+
+	auto l_frame = Pull(out.data(), l_outputFrameCount);
+	std::fill(out.begin() + l_frame * m_ChannelCount, out.end(), T(0));
+}
+
+template<class T>
+size_t ResamplerT<T>::GetOutputFrameCount(size_t inputFrameCount) const
+{
+	// The frames n with n * m_Step < inputFrameCount * m_Denominator
+	return (size_t)(((uint64_t)inputFrameCount * m_Denominator + m_Step - 1) / m_Step);
+}
+
+namespace Waveless
+{
+	template class ResamplerT<float>;
+	template class ResamplerT<double>;
+}
\ No newline at end of file
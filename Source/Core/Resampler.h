@@ -0,0 +1,117 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include "SampleQueue.h"
+
+namespace Waveless
+{
+	///
+	/// Kaiser windowed sinc filters by stopband attenuation, the downsampling filters are longer by the ratio.
+	/// The cost grows with the tap count, Bench measures the throughput of every tier
+	///
+	enum class ResamplerQuality
+	{
+		// 8 taps, about 45 dB
+		Low,
+		// 16 taps, about 60 dB
+		Medium,
+		// 32 taps, about 80 dB
+		High,
+		// 64 taps, about 100 dB
+		Best
+	};
+
+	///
+	/// Polyphase sample rate converter over interleaved multichannel samples.
+	/// The ratio of two integer sample rates with at most m_MaxExactPhaseCount phases is exact, e.g. 44100 to 48000 Hz has 160 phases.
+	/// Any other ratio reads m_InterpolatedPhaseCount phases and interpolates linearly between the two nearest ones.
+	/// The filter taps are a dot product with the vectorized kernels of MathKernels, the channels are kept planar for it.
+	/// The output frame n is the input at the position n * source rate / target rate, without any delay.
+	///
+	template<class T>
+	class ResamplerT
+	{
+	public:
+		static constexpr size_t m_MaxExactPhaseCount = 1024;
+		static constexpr size_t m_InterpolatedPhaseCount = 512;
+
+		ResamplerT() = default;
+		~ResamplerT() = default;
+
+		///
+		/// Compute the filter table, the only allocation besides the input queue
+		///
+		WsResult Setup(double sourceSampleRate, double targetSampleRate, size_t channels = 1, ResamplerQuality quality = ResamplerQuality::High);
+
+		///
+		/// Change the ratio while streaming, the queued input and the position in it are kept so the output continues without a jump.
+		/// The filter table is computed again, which allocates
+		///
+		WsResult SetSampleRates(double sourceSampleRate, double targetSampleRate);
+
+		///
+		/// Start a new stream
+		///
+		void Reset();
+
+		///
+		/// Queue frameCount interleaved input frames
+		///
+		void Push(const T* in, size_t frameCount);
+
+		///
+		/// Mark the end of the input, the last frames are then read with zeros after them
+		///
+		void Flush();
+
+		///
+		/// Write up to frameCount interleaved output frames, fewer if more input is needed or the flushed stream ended
+		///
+		size_t Pull(T* out, size_t frameCount);
+
+		///
+		/// Offline conversion of a whole signal of interleaved frames into GetOutputFrameCount(frameCount) frames, the stream is reset
+		///
+		void Render(const T* in, size_t frameCount, std::vector<T>& out);
+
+		///
+		/// The output frame count of inputFrameCount input frames, the frames at the positions inside of the input
+		///
+		size_t GetOutputFrameCount(size_t inputFrameCount) const;
+
+		size_t GetChannelCount() const { return m_ChannelCount; }
+		size_t GetTapCount() const { return m_TapCount; }
+		size_t GetPhaseCount() const { return m_PhaseCount; }
+		bool IsExact() const { return m_IsExact; }
+
+	private:
+		void ComputeFilters(double sourceSampleRate, double targetSampleRate);
+
+		ResamplerQuality m_Quality = ResamplerQuality::High;
+		size_t m_ChannelCount = 0;
+		size_t m_TapCount = 0;
+		// The taps rounded up to the widest kernel, the extra coefficients are zero
+		size_t m_PaddedTapCount = 0;
+		size_t m_PhaseCount = 0;
+		bool m_IsExact = false;
+		// [phase][tap], one more phase than m_PhaseCount when the phases are interpolated
+		std::vector<T> m_Table;
+
+		// The position is m_Index + m_Fraction / m_Denominator input frames, it moves by m_Step / m_Denominator per output frame
+		uint64_t m_Denominator = 1;
+		uint64_t m_Step = 1;
+		size_t m_Index = 0;
+		uint64_t m_Fraction = 0;
+
+		// Planar input from the first tap of the next output frame, it starts with the taps before the first input frame as zeros
+		std::vector<SampleQueueT<T>> m_Input;
+		bool m_IsFlushed = false;
+		size_t m_InputEnd = 0;
+	};
+
+	extern template class ResamplerT<float>;
+	extern template class ResamplerT<double>;
+
+	using Resampler = ResamplerT<double>;
+	using ResamplerF = ResamplerT<float>;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "SIMD.h"
+#include <atomic>
+
+#if defined(WS_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Waveless::SIMDNS
+{
+#if defined(WS_SIMD_X86)
+	void CPUID(uint32_t leaf, uint32_t subLeaf, uint32_t result[4])
+	{
+#if defined(_MSC_VER)
+		int l_result[4];
+		__cpuidex(l_result, (int)leaf, (int)subLeaf);
+		for (size_t i = 0; i < 4; i++)
+		{
+			result[i] = (uint32_t)l_result[i];
+		}
+#else
+		if (!__get_cpuid_count(leaf, subLeaf, &result[0], &result[1], &result[2], &result[3]))
+		{
+			result[0] = result[1] = result[2] = result[3] = 0;
+		}
+#endif
+	}
+
+	// The register states enabled by the OS
+	uint64_t XGETBV()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32_t l_eax, l_edx;
+		__asm__ volatile("xgetbv" : "=a"(l_eax), "=d"(l_edx) : "c"(0));
+		return ((uint64_t)l_edx << 32) | l_eax;
+#endif
+	}
+#endif
+
+	InstructionSet DetectInstructionSet()
+	{
+#if defined(WS_SIMD_X86)
+		uint32_t l_leaf0[4];
+		CPUID(0, 0, l_leaf0);
+		auto l_maxLeaf = l_leaf0[0];
+
+		uint32_t l_leaf1[4];
+		CPUID(1, 0, l_leaf1);
+
+		// EDX bit 26
+		if (!(l_leaf1[3] & (1u << 26)))
+		{
+			return InstructionSet::Scalar;
+		}
+
+		// ECX bit 27 OSXSAVE and bit 28 AVX
+		bool l_hasXSave = (l_leaf1[2] & (1u << 27)) && (l_leaf1[2] & (1u << 28));
+
+		if (!l_hasXSave || l_maxLeaf < 7)
+		{
+			return InstructionSet::SSE2;
+		}
+
+		auto l_xcr0 = XGETBV();
+
+		uint32_t l_leaf7[4];
+		CPUID(7, 0, l_leaf7);
+
+		// XMM and YMM states
+		if ((l_xcr0 & 0x6) != 0x6 || !(l_leaf7[1] & (1u << 5)))
+		{
+			return InstructionSet::SSE2;
+		}
+
+		// Opmask, ZMM_Hi256 and Hi16_ZMM states, EBX bit 16 AVX512F
+		if ((l_xcr0 & 0xE6) != 0xE6 || !(l_leaf7[1] & (1u << 16)))
+		{
+			return InstructionSet::AVX2;
+		}
+
+		return InstructionSet::AVX512;
+#else
+		return InstructionSet::Scalar;
+#endif
+	}
+
+	InstructionSet m_SupportedInstructionSet = DetectInstructionSet();
+	std::atomic<InstructionSet> m_InstructionSet = m_SupportedInstructionSet;
+}
+
+using namespace Waveless;
+using namespace Waveless::SIMDNS;
+
+InstructionSet SIMD::GetSupportedInstructionSet()
+{
+	return m_SupportedInstructionSet;
+}
+
+InstructionSet SIMD::GetInstructionSet()
+{
+	return m_InstructionSet.load(std::memory_order_relaxed);
+}
+
+WsResult SIMD::SetInstructionSet(InstructionSet instructionSet)
+{
+	if (instructionSet > m_SupportedInstructionSet)
+	{
+		return WsResult::NotCompatible;
+	}
+
+	m_InstructionSet.store(instructionSet, std::memory_order_relaxed);
+
+	return WsResult::Success;
+}
+
+const char* SIMD::GetInstructionSetName(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::SSE2:
+		return "SSE2";
+	case InstructionSet::AVX2:
+		return "AVX2";
+	case InstructionSet::AVX512:
+		return "AVX-512";
+	default:
+		return "Scalar";
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define WS_SIMD_X86
+#endif
+
+namespace Waveless
+{
+	enum class InstructionSet { Scalar, SSE2, AVX2, AVX512 };
+
+	///
+	/// Runtime detection of the vector instruction sets, the kernels are picked by the current instruction set at every call.
+	///
+	class SIMD
+	{
+	public:
+		///
+		/// The best instruction set supported by both the CPU and the OS, detected once with CPUID
+		///
+		static InstructionSet GetSupportedInstructionSet();
+
+		///
+		/// The instruction set used by the dispatched kernels, the supported one by default
+		///
+		static InstructionSet GetInstructionSet();
+
+		///
+		/// Restrict the dispatched kernels to a lower instruction set, e.g. to compare them in a benchmark
+		///
+		static WsResult SetInstructionSet(InstructionSet instructionSet);
+
+		static const char* GetInstructionSetName(InstructionSet instructionSet);
+	};
+}
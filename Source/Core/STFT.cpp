@@ -0,0 +1,230 @@
+#include "STFT.h"
+#include "TaskScheduler.h"
+#include "WindowBank.h"
+
+namespace Waveless::STFTNS
+{
+	// The least frames, or hops of the overlap-add, that are split across the workers
+	constexpr size_t m_MinParallelFrameCount = 16;
+}
+
+using namespace Waveless;
+using namespace Waveless::STFTNS;
+
+template<class T>
+STFTT<T>::STFTT(WindowDesc windowDesc)
+{
+	m_WindowSize = windowDesc.m_WindowSize;
+	m_HopSize = windowDesc.m_HopSize ? std::min(windowDesc.m_HopSize, m_WindowSize) : std::max(m_WindowSize / 2, (size_t)1);
+	m_Padding = m_WindowSize - m_HopSize;
+
+	m_Window = &WindowBank::Get<T>(windowDesc);
+
+	m_Plan = FFTPlanT<T>::Get(m_WindowSize);
+}
+
+template<class T>
+size_t STFTT<T>::GetFrameCount(size_t sampleCount) const
+{
+	if (!sampleCount || !m_WindowSize)
+	{
+		return 0;
+	}
+
+	// The last frame starts before the last sample
+	return (sampleCount + m_Padding + m_HopSize - 1) / m_HopSize;
+}
+
+template<class T>
+size_t STFTT<T>::GetSampleCount(size_t frameCount) const
+{
+	return frameCount * m_HopSize;
+}
+
+template<class T>
+void STFTT<T>::AnalyzeFrame(const ComplexT<T>* x, size_t sampleCount, size_t frameIndex, ComplexT<T>* X) const
+{
+	// Signed since the first frames start before the first sample
+	auto l_start = (int64_t)(frameIndex * m_HopSize) - (int64_t)m_Padding;
+
+	for (size_t i = 0; i < m_WindowSize; i++)
+	{
+		auto n = l_start + (int64_t)i;
+		X[i] = (n >= 0 && n < (int64_t)sampleCount) ? x[n] * (*m_Window)[i] : ComplexT<T>(0, 0);
+	}
+
+	m_Plan->Forward(X);
+}
+
+template<class T>
+void STFTT<T>::SynthesizeFrame(ComplexT<T>* X, size_t frameIndex, ComplexT<T>* y, size_t sampleCount) const
+{
+	m_Plan->Inverse(X);
+
+	OverlapAddFrame(X, frameIndex, y, sampleCount);
+}
+
+template<class T>
+void STFTT<T>::OverlapAddFrame(const ComplexT<T>* frame, size_t frameIndex, ComplexT<T>* y, size_t sampleCount) const
+{
+	auto l_start = (int64_t)(frameIndex * m_HopSize) - (int64_t)m_Padding;
+
+	for (size_t i = 0; i < m_WindowSize; i++)
+	{
+		auto n = l_start + (int64_t)i;
+
+		if (n >= 0 && n < (int64_t)sampleCount)
+		{
+			y[n] += frame[i] * (*m_Window)[i];
+		}
+	}
+}
+
+template<class T>
+void STFTT<T>::Normalize(ComplexT<T>* y, size_t sampleCount, size_t frameCount) const
+{
+	for (size_t n = 0; n < sampleCount; n++)
+	{
+		// The frames k with 0 <= n + padding - k * hop < window size
+		auto l_position = n + m_Padding;
+		auto l_lastFrame = std::min(l_position / m_HopSize, frameCount ? frameCount - 1 : 0);
+		auto l_firstFrame = l_position >= m_WindowSize ? (l_position - m_WindowSize) / m_HopSize + 1 : 0;
+
+		T l_sum = 0;
+
+		for (auto k = l_firstFrame; k <= l_lastFrame && k < frameCount; k++)
+		{
+			auto w = (*m_Window)[l_position - k * m_HopSize];
+			l_sum += w * w;
+		}
+
+		y[n] = l_sum > std::numeric_limits<T>::epsilon() ? y[n] / l_sum : ComplexT<T>(0, 0);
+	}
+}
+
+template<class T>
+void STFTT<T>::AnalyzeFrames(const ComplexT<T>* x, size_t sampleCount, ComplexT<T>* frames) const
+{
+	TaskScheduler::ParallelFor(GetFrameCount(sampleCount), [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			AnalyzeFrame(x, sampleCount, i, frames + i * m_WindowSize);
+		}
+	}, m_MinParallelFrameCount);
+}
+
+template<class T>
+void STFTT<T>::SynthesizeFrames(ComplexT<T>* frames, size_t frameCount, ComplexT<T>* y, size_t sampleCount) const
+{
+	TaskScheduler::ParallelFor(frameCount, [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			m_Plan->Inverse(frames + i * m_WindowSize);
+		}
+	}, m_MinParallelFrameCount);
+
+	OverlapAddFrames(frames, frameCount, y, sampleCount);
+}
+
+template<class T>
+void STFTT<T>::OverlapAddFrames(const ComplexT<T>* frames, size_t frameCount, ComplexT<T>* y, size_t sampleCount) const
+{
+	if (!frameCount)
+	{
+		std::fill(y, y + sampleCount, ComplexT<T>(0, 0));
+		return;
+	}
+
+	// Partitioned by hops, so a chunk is about as much work as a frame
+	auto l_hopCount = (sampleCount + m_HopSize - 1) / m_HopSize;
+
+	TaskScheduler::ParallelFor(l_hopCount, [&](size_t begin, size_t end, size_t)
+	{
+		auto l_end = std::min(end * m_HopSize, sampleCount);
+
+		for (auto n = begin * m_HopSize; n < l_end; n++)
+		{
+			auto l_position = n + m_Padding;
+			auto l_lastFrame = std::min(l_position / m_HopSize, frameCount - 1);
+			auto l_firstFrame = l_position >= m_WindowSize ? (l_position - m_WindowSize) / m_HopSize + 1 : 0;
+
+			ComplexT<T> l_sum(0, 0);
+			T l_windowSum = 0;
+
+			for (auto k = l_firstFrame; k <= l_lastFrame; k++)
+			{
+				auto i = l_position - k * m_HopSize;
+				auto w = (*m_Window)[i];
+
+				l_sum += frames[k * m_WindowSize + i] * w;
+				l_windowSum += w * w;
+			}
+
+			y[n] = l_windowSum > std::numeric_limits<T>::epsilon() ? l_sum / l_windowSum : ComplexT<T>(0, 0);
+		}
+	}, m_MinParallelFrameCount);
+}
+
+template<class T>
+std::vector<ComplexArrayT<T>> STFTT<T>::Analyze(const ComplexArrayT<T>& x) const
+{
+	auto l_sampleCount = x.size();
+
+	if (!l_sampleCount)
+	{
+		return {};
+	}
+
+	auto l_frameCount = GetFrameCount(l_sampleCount);
+
+	std::vector<ComplexArrayT<T>> l_result(l_frameCount, ComplexArrayT<T>(m_WindowSize));
+
+	TaskScheduler::ParallelFor(l_frameCount, [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			AnalyzeFrame(&x[0], l_sampleCount, i, &l_result[i][0]);
+		}
+	}, m_MinParallelFrameCount);
+
+	return l_result;
+}
+
+template<class T>
+ComplexArrayT<T> STFTT<T>::Synthesize(const std::vector<ComplexArrayT<T>>& X, size_t sampleCount) const
+{
+	auto l_frameCount = X.size();
+
+	if (!sampleCount)
+	{
+		sampleCount = GetSampleCount(l_frameCount);
+	}
+
+	ComplexArrayT<T> l_result(ComplexT<T>(0, 0), sampleCount);
+
+	if (!sampleCount)
+	{
+		return l_result;
+	}
+
+	// The frames are transformed in place, in one contiguous matrix
+	std::vector<ComplexT<T>> l_frames(l_frameCount * m_WindowSize, ComplexT<T>(0, 0));
+
+	for (size_t i = 0; i < l_frameCount; i++)
+	{
+		auto l_binCount = std::min(X[i].size(), m_WindowSize);
+		std::copy(std::begin(X[i]), std::begin(X[i]) + l_binCount, l_frames.begin() + i * m_WindowSize);
+	}
+
+	SynthesizeFrames(l_frames.data(), l_frameCount, &l_result[0], sampleCount);
+
+	return l_result;
+}
+
+namespace Waveless
+{
+	template class STFTT<float>;
+	template class STFTT<double>;
+}
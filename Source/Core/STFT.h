@@ -0,0 +1,96 @@
+#pragma once
+#include "stdafx.h"
+#include "Math.h"
+#include "FFTPlan.h"
+
+namespace Waveless
+{
+	///
+	/// Short-time Fourier transform with a configurable hop and weighted overlap-add resynthesis.
+	/// Frame k covers the samples [k * hop - (window - hop), k * hop + hop), so every sample is covered by the same number of frames,
+	/// the samples outside of the signal are zero. The resynthesis applies the window again and divides by the sum of the squared windows,
+	/// which reconstructs the unmodified signal exactly wherever that sum is non-zero. The samples where every covering frame has a zero of the window
+	/// are set to zero instead, e.g. the frame edges of a Hann window with the hop equal to the window size, so the hop should be shorter than the non-zero span of the window.
+	///
+	template<class T>
+	class STFTT
+	{
+	public:
+		STFTT(WindowDesc windowDesc);
+		~STFTT() = default;
+
+		size_t GetWindowSize() const { return m_WindowSize; }
+		size_t GetHopSize() const { return m_HopSize; }
+		const std::vector<T>& GetWindow() const { return *m_Window; }
+
+		///
+		/// The frame count to cover sampleCount samples
+		///
+		size_t GetFrameCount(size_t sampleCount) const;
+
+		///
+		/// The sample count covered by frameCount frames
+		///
+		size_t GetSampleCount(size_t frameCount) const;
+
+		///
+		/// Window the frame frameIndex of x and transform it into GetWindowSize() bins of X, no allocation after the first call of the thread.
+		///
+		void AnalyzeFrame(const ComplexT<T>* x, size_t sampleCount, size_t frameIndex, ComplexT<T>* X) const;
+
+		///
+		/// Inverse transform X in place and overlap-add it to y as the frame frameIndex.
+		///
+		void SynthesizeFrame(ComplexT<T>* X, size_t frameIndex, ComplexT<T>* y, size_t sampleCount) const;
+
+		///
+		/// Apply the synthesis window to a time domain frame and overlap-add it to y as the frame frameIndex.
+		///
+		void OverlapAddFrame(const ComplexT<T>* frame, size_t frameIndex, ComplexT<T>* y, size_t sampleCount) const;
+
+		///
+		/// Divide the overlap-added samples by the sum of the squared windows of the frameCount frames.
+		/// The samples only covered by zeros of the window are set to zero.
+		///
+		void Normalize(ComplexT<T>* y, size_t sampleCount, size_t frameCount) const;
+
+		///
+		/// Analyze all the frames of x into a contiguous frame matrix of GetFrameCount(sampleCount) * GetWindowSize() bins.
+		/// The frames are partitioned across the TaskScheduler workers, each worker transforms with its own scratch buffer.
+		///
+		void AnalyzeFrames(const ComplexT<T>* x, size_t sampleCount, ComplexT<T>* frames) const;
+
+		///
+		/// Inverse transform a contiguous frame matrix in place and resynthesize sampleCount samples into y, in parallel.
+		///
+		void SynthesizeFrames(ComplexT<T>* frames, size_t frameCount, ComplexT<T>* y, size_t sampleCount) const;
+
+		///
+		/// Overlap-add and normalize a contiguous matrix of time domain frames into sampleCount samples of y, in parallel.
+		/// Every output sample gathers its own frames, so the workers never write to the same sample.
+		///
+		void OverlapAddFrames(const ComplexT<T>* frames, size_t frameCount, ComplexT<T>* y, size_t sampleCount) const;
+
+		std::vector<ComplexArrayT<T>> Analyze(const ComplexArrayT<T>& x) const;
+
+		///
+		/// Resynthesize the frames, sampleCount 0 means all the samples covered by the frames.
+		///
+		ComplexArrayT<T> Synthesize(const std::vector<ComplexArrayT<T>>& X, size_t sampleCount = 0) const;
+
+	private:
+		size_t m_WindowSize = 0;
+		size_t m_HopSize = 0;
+		// Zeros before the first sample, to cover the beginning with as many frames as the rest
+		size_t m_Padding = 0;
+		// Shared with every STFT of the same window
+		const std::vector<T>* m_Window = nullptr;
+		const FFTPlanT<T>* m_Plan = nullptr;
+	};
+
+	extern template class STFTT<float>;
+	extern template class STFTT<double>;
+
+	using STFT = STFTT<double>;
+	using STFTF = STFTT<float>;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "stdafx.h"
+
+namespace Waveless
+{
+	///
+	/// Contiguous queue of samples for the streaming processors that read a window at a moving position.
+	/// Dropping the samples before the read position only moves the front offset, the storage is compacted
+	/// once the dropped prefix is at least as long as the rest, so a whole signal pushed at once is consumed in linear time
+	///
+	template<class T>
+	class SampleQueueT
+	{
+	public:
+		SampleQueueT() = default;
+		~SampleQueueT() = default;
+
+		void Reserve(size_t capacity)
+		{
+			m_Samples.reserve(m_Front + capacity);
+		}
+
+		///
+		/// Start over with count samples of value
+		///
+		void Assign(size_t count, T value)
+		{
+			m_Samples.assign(count, value);
+			m_Front = 0;
+		}
+
+		///
+		/// Append count samples read every stride elements of in, e.g. one channel of interleaved frames
+		///
+		void Push(const T* in, size_t count, size_t stride = 1)
+		{
+			auto l_offset = m_Samples.size();
+			m_Samples.resize(l_offset + count);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				m_Samples[l_offset + i] = in[i * stride];
+			}
+		}
+
+		void Push(T value)
+		{
+			m_Samples.emplace_back(value);
+		}
+
+		void PushZeros(size_t count)
+		{
+			m_Samples.resize(m_Samples.size() + count, T(0));
+		}
+
+		///
+		/// Insert count zeros before the first sample
+		///
+		void PushFrontZeros(size_t count)
+		{
+			if (count <= m_Front)
+			{
+				m_Front -= count;
+				std::fill(m_Samples.begin() + m_Front, m_Samples.begin() + m_Front + count, T(0));
+				return;
+			}
+
+			m_Samples.insert(m_Samples.begin() + m_Front, count - m_Front, T(0));
+			std::fill(m_Samples.begin(), m_Samples.begin() + m_Front, T(0));
+			m_Front = 0;
+		}
+
+		///
+		/// Drop the samples before position once there are at least minCount of them.
+		/// Returns the count of dropped samples, the caller moves its positions back by it
+		///
+		size_t Discard(size_t position, size_t minCount)
+		{
+			position = std::min(position, GetSize());
+
+			if (!position || position < minCount)
+			{
+				return 0;
+			}
+
+			m_Front += position;
+
+			if (m_Front >= m_Samples.size() - m_Front)
+			{
+				m_Samples.erase(m_Samples.begin(), m_Samples.begin() + m_Front);
+				m_Front = 0;
+			}
+
+			return position;
+		}
+
+		const T* GetData() const { return m_Samples.data() + m_Front; }
+		size_t GetSize() const { return m_Samples.size() - m_Front; }
+		T operator[](size_t index) const { return m_Samples[m_Front + index]; }
+
+	private:
+		std::vector<T> m_Samples;
+		// The samples before it are dropped
+		size_t m_Front = 0;
+	};
+}
\ No newline at end of file
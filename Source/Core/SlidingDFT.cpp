@@ -0,0 +1,132 @@
+#include "SlidingDFT.h"
+#include "MathKernels.h"
+#include "Logger.h"
+
+namespace Waveless::SlidingDFTNS
+{
+	// 8 doubles of AVX-512
+	constexpr size_t m_LaneAlignment = 8;
+}
+
+using namespace Waveless;
+using namespace Waveless::SlidingDFTNS;
+
+template<class T>
+WsResult SlidingDFTT<T>::Setup(double fs, size_t windowSize, const double* frequencies, size_t frequencyCount)
+{
+	if (!(fs > 0.0) || !windowSize)
+	{
+		Logger::Log(LogLevel::Warning, "Sliding DFT sample rate or window size is invalid.");
+		return WsResult::Fail;
+	}
+
+	auto l_laneCount = (frequencyCount + m_LaneAlignment - 1) / m_LaneAlignment * m_LaneAlignment;
+
+	m_FrequencyCount = frequencyCount;
+	m_Real.resize(l_laneCount);
+	m_Imag.resize(l_laneCount);
+	m_RotationReal.assign(l_laneCount, 0.0);
+	m_RotationImag.assign(l_laneCount, 0.0);
+	m_InputReal.assign(l_laneCount, 0.0);
+	m_InputImag.assign(l_laneCount, 0.0);
+
+	for (size_t k = 0; k < frequencyCount; k++)
+	{
+		auto l_omega = 2.0 * PI<double> * frequencies[k] / fs;
+		auto l_phase = -l_omega * (double)(windowSize - 1);
+
+		m_RotationReal[k] = std::cos(l_omega);
+		m_RotationImag[k] = std::sin(l_omega);
+		m_InputReal[k] = std::cos(l_phase);
+		m_InputImag[k] = std::sin(l_phase);
+	}
+
+	m_History.resize(windowSize);
+
+	Reset();
+
+	return WsResult::Success;
+}
+
+template<class T>
+void SlidingDFTT<T>::Reset()
+{
+	std::fill(m_Real.begin(), m_Real.end(), 0.0);
+	std::fill(m_Imag.begin(), m_Imag.end(), 0.0);
+	std::fill(m_History.begin(), m_History.end(), T(0));
+	m_HistoryIndex = 0;
+}
+
+template<class T>
+void SlidingDFTT<T>::Process(const T* x, size_t count)
+{
+	// Without a successful Setup() the window is empty and no sample would be consumed
+	if (m_History.empty())
+	{
+		Logger::Log(LogLevel::Warning, "Sliding DFT isn't set up.");
+		return;
+	}
+
+	auto l_kernels = MathKernels::Get<double>();
+	auto l_windowSize = m_History.size();
+	auto K = m_FrequencyCount;
+	auto l_real = m_Real.data();
+	auto l_imag = m_Imag.data();
+	auto l_rotationReal = m_RotationReal.data();
+	auto l_rotationImag = m_RotationImag.data();
+	auto l_inputReal = m_InputReal.data();
+	auto l_inputImag = m_InputImag.data();
+
+	SlidingDFTLanes<double> l_lanes = { l_real, l_imag, l_rotationReal, l_rotationImag, l_inputReal, l_inputImag, 0 };
+
+	if (l_kernels)
+	{
+		l_lanes.m_LaneCount = (K + l_kernels->m_Width - 1) / l_kernels->m_Width * l_kernels->m_Width;
+	}
+
+	double l_newest[m_BlockSize];
+	double l_oldest[m_BlockSize];
+
+	// Up to a window per block, so the samples leaving the window are all in the history before the block
+	for (size_t l_begin = 0; l_begin < count;)
+	{
+		auto l_count = std::min({ m_BlockSize, count - l_begin, l_windowSize });
+
+		for (size_t i = 0; i < l_count; i++)
+		{
+			auto l_index = m_HistoryIndex + i;
+			l_index -= l_index >= l_windowSize ? l_windowSize : 0;
+			l_oldest[i] = (double)m_History[l_index];
+			l_newest[i] = (double)x[l_begin + i];
+			m_History[l_index] = x[l_begin + i];
+		}
+
+		m_HistoryIndex = (m_HistoryIndex + l_count) % l_windowSize;
+
+		if (l_kernels)
+		{
+			l_kernels->m_SlidingDFT(l_lanes, l_newest, l_oldest, l_count);
+		}
+		else
+		{
+			for (size_t n = 0; n < l_count; n++)
+			{
+				for (size_t k = 0; k < K; k++)
+				{
+					auto a = l_real[k] - l_oldest[n];
+					auto b = l_imag[k];
+					l_real[k] = a * l_rotationReal[k] - b * l_rotationImag[k] + l_newest[n] * l_inputReal[k];
+					l_imag[k] = a * l_rotationImag[k] + b * l_rotationReal[k] + l_newest[n] * l_inputImag[k];
+				}
+			}
+		}
+
+		l_begin += l_count;
+	}
+}
+
+namespace Waveless
+{
+	template class SlidingDFTT<float>;
+	template class SlidingDFTT<double>;
+}
\ No newline at end of file
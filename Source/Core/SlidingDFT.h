@@ -0,0 +1,71 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include "Math.h"
+
+namespace Waveless
+{
+	///
+	/// Streaming DFT of the last windowSize samples at a set of arbitrary frequencies, updated in O(frequency count) per sample.
+	/// S[n] = (S[n - 1] - x[n - N]) * exp(j * w) + x[n] * exp(-j * w * (N - 1)), the frequencies are the lanes of the MathKernels update.
+	/// The states are kept in double, the rounding of the rotation doesn't grow into the result over hours of input.
+	///
+	template<class T>
+	class SlidingDFTT
+	{
+	public:
+		// The samples per kernel call
+		static constexpr size_t m_BlockSize = 256;
+
+		SlidingDFTT() = default;
+		~SlidingDFTT() = default;
+
+		WsResult Setup(double fs, size_t windowSize, const double* frequencies, size_t frequencyCount);
+
+		///
+		/// Clear the window to silence
+		///
+		void Reset();
+
+		///
+		/// Slide the window over count samples
+		///
+		void Process(const T* x, size_t count);
+
+		///
+		/// The DFT of the window at frequency k, X = sum(x[m] * exp(-j * w * m)) with the oldest sample at m = 0.
+		/// Equal to Math::Goertzel() over the last windowSize samples
+		///
+		ComplexT<T> GetBin(size_t k) const { return ComplexT<T>((T)m_Real[k], (T)m_Imag[k]); }
+
+		///
+		/// The amplitude of a sinusoid at frequency k, 2 * |X| / windowSize
+		///
+		T GetAmplitude(size_t k) const { return (T)(2.0 * std::hypot(m_Real[k], m_Imag[k]) / (double)m_History.size()); }
+
+		size_t GetWindowSize() const { return m_History.size(); }
+		size_t GetFrequencyCount() const { return m_FrequencyCount; }
+
+	private:
+		size_t m_FrequencyCount = 0;
+		// Padded to the widest kernel, the padding lanes stay at 0
+		std::vector<double> m_Real;
+		std::vector<double> m_Imag;
+		// exp(j * w)
+		std::vector<double> m_RotationReal;
+		std::vector<double> m_RotationImag;
+		// exp(-j * w * (N - 1)), the weight of the newest sample
+		std::vector<double> m_InputReal;
+		std::vector<double> m_InputImag;
+
+		// The last windowSize samples as a ring
+		std::vector<T> m_History;
+		size_t m_HistoryIndex = 0;
+	};
+
+	extern template class SlidingDFTT<float>;
+	extern template class SlidingDFTT<double>;
+
+	using SlidingDFT = SlidingDFTT<double>;
+	using SlidingDFTF = SlidingDFTT<float>;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "TaskScheduler.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+
+namespace Waveless::TaskSchedulerNS
+{
+	std::vector<std::thread> m_Threads;
+	// Published under the mutex once the workers are spawned, so the readers outside the lock never touch m_Threads
+	std::atomic<size_t> m_ThreadCount{ 0 };
+	std::deque<std::packaged_task<void()>> m_Tasks;
+	std::mutex m_Mutex;
+	std::condition_variable m_CV;
+	bool m_Terminated = false;
+	thread_local bool t_IsWorkerThread = false;
+
+	void WorkerLoop()
+	{
+		t_IsWorkerThread = true;
+
+		while (true)
+		{
+			std::packaged_task<void()> l_task;
+			{
+				std::unique_lock<std::mutex> l_lock(m_Mutex);
+				m_CV.wait(l_lock, [] { return m_Terminated || !m_Tasks.empty(); });
+
+				if (m_Tasks.empty())
+				{
+					return;
+				}
+
+				l_task = std::move(m_Tasks.front());
+				m_Tasks.pop_front();
+			}
+
+			l_task();
+		}
+	}
+
+	///
+	/// Wait for every queued chunk of a ParallelFor, they hold a reference to the task of the caller
+	///
+	struct FutureGuard
+	{
+		std::vector<std::future<void>>& m_Futures;
+
+		~FutureGuard()
+		{
+			for (auto& i : m_Futures)
+			{
+				if (i.valid())
+				{
+					i.wait();
+				}
+			}
+		}
+	};
+
+	// Join the workers before the queue and the mutex above are destroyed, in case Terminate() wasn't called
+	struct TaskSchedulerGuard
+	{
+		~TaskSchedulerGuard()
+		{
+			TaskScheduler::Terminate();
+		}
+	} m_Guard;
+}
+
+using namespace Waveless;
+using namespace Waveless::TaskSchedulerNS;
+
+WsResult TaskScheduler::Initialize(size_t threadCount)
+{
+	std::unique_lock<std::mutex> l_lock(m_Mutex);
+
+	if (m_Threads.size())
+	{
+		return WsResult::Success;
+	}
+
+	if (!threadCount)
+	{
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	m_Terminated = false;
+	m_Threads.reserve(threadCount);
+
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_Threads.emplace_back(WorkerLoop);
+	}
+
+	m_ThreadCount = threadCount;
+
+	return WsResult::Success;
+}
+
+WsResult TaskScheduler::Terminate()
+{
+	{
+		std::unique_lock<std::mutex> l_lock(m_Mutex);
+		m_Terminated = true;
+	}
+
+	m_CV.notify_all();
+
+	for (auto& i : m_Threads)
+	{
+		i.join();
+	}
+
+	std::unique_lock<std::mutex> l_lock(m_Mutex);
+	m_Threads.clear();
+	m_ThreadCount = 0;
+
+	return WsResult::Success;
+}
+
+size_t TaskScheduler::GetThreadCount()
+{
+	if (!m_ThreadCount)
+	{
+		Initialize();
+	}
+
+	return m_ThreadCount;
+}
+
+std::future<void> TaskScheduler::Submit(std::function<void()>&& task)
+{
+	if (!m_ThreadCount)
+	{
+		Initialize();
+	}
+
+	std::packaged_task<void()> l_task(std::move(task));
+	auto l_result = l_task.get_future();
+
+	{
+		std::unique_lock<std::mutex> l_lock(m_Mutex);
+		m_Tasks.emplace_back(std::move(l_task));
+	}
+
+	m_CV.notify_one();
+
+	return l_result;
+}
+
+void TaskScheduler::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end, size_t chunkIndex)>& task, size_t minParallelCount)
+{
+	if (!count)
+	{
+		return;
+	}
+
+	// Checked before GetThreadCount(), a small range doesn't spawn the workers
+	if (t_IsWorkerThread || count < minParallelCount)
+	{
+		task(0, count, 0);
+		return;
+	}
+
+	auto l_chunkCount = std::min(GetThreadCount(), count);
+
+	if (l_chunkCount == 1)
+	{
+		task(0, count, 0);
+		return;
+	}
+
+	auto l_chunkSize = (count + l_chunkCount - 1) / l_chunkCount;
+
+	std::vector<std::future<void>> l_futures;
+	l_futures.reserve(l_chunkCount);
+
+	// Even when the chunk of the calling thread throws, the queued ones finish before task goes out of scope
+	FutureGuard l_guard{ l_futures };
+
+	for (size_t i = 1; i < l_chunkCount; i++)
+	{
+		auto l_begin = i * l_chunkSize;
+		auto l_end = std::min(l_begin + l_chunkSize, count);
+
+		if (l_begin >= l_end)
+		{
+			break;
+		}
+
+		l_futures.emplace_back(Submit([=, &task]() { task(l_begin, l_end, i); }));
+	}
+
+	// The calling thread takes the first chunk instead of idling
+	task(0, std::min(l_chunkSize, count), 0);
+
+	// Rethrow the first exception of the workers
+	for (auto& i : l_futures)
+	{
+		i.get();
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "stdafx.h"
+#include "Typedef.h"
+#include <functional>
+#include <future>
+
+namespace Waveless
+{
+	class TaskScheduler
+	{
+	public:
+		TaskScheduler() = default;
+		~TaskScheduler() = default;
+
+		///
+		/// Spawn the worker threads, 0 means one worker per hardware thread
+		///
+		static WsResult Initialize(size_t threadCount = 0);
+
+		///
+		/// Finish all queued tasks and join the worker threads
+		///
+		static WsResult Terminate();
+
+		///
+		/// Get the worker thread count, initialize the scheduler with the default thread count if necessary
+		///
+		static size_t GetThreadCount();
+
+		///
+		/// Queue a task to the worker threads
+		///
+		static std::future<void> Submit(std::function<void()>&& task);
+
+		///
+		/// Split [0, count) into contiguous chunks and block until all of them are processed.
+		/// The chunk index is always less than GetThreadCount(), it could be used to pick per-thread scratch memory.
+		/// When called from a worker thread, or when count is less than minParallelCount, the whole range is processed inline as chunk 0,
+		/// a caller passes the count below which the work doesn't pay for the tasks.
+		/// The first exception thrown by a chunk is rethrown after all chunks have finished.
+		///
+		static void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end, size_t chunkIndex)>& task, size_t minParallelCount = 0);
+	};
+}
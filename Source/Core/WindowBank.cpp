@@ -0,0 +1,184 @@
+#include "WindowBank.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Waveless::WindowBankNS
+{
+	constexpr size_t m_CosineTableSize = WindowBank::m_MaxTableSize;
+	constexpr size_t m_QuarterSize = m_CosineTableSize / 4;
+
+	///
+	/// cos(x) for x in [0, pi / 2] by its Taylor series, the terms fall below the double precision before the 12th
+	///
+	constexpr double ConstexprCos(double x)
+	{
+		auto l_square = x * x;
+		auto l_term = 1.0;
+		auto l_result = 1.0;
+
+		for (int k = 1; k < 12; k++)
+		{
+			l_term *= -l_square / (double)((2 * k - 1) * (2 * k));
+			l_result += l_term;
+		}
+
+		return l_result;
+	}
+
+	///
+	/// cos(2 * pi * i / m_CosineTableSize) for the first quarter of the period
+	///
+	template<size_t N>
+	struct CosineTable
+	{
+		double m_Values[N + 1] = {};
+
+		constexpr CosineTable()
+		{
+			for (size_t i = 0; i <= N; i++)
+			{
+				m_Values[i] = ConstexprCos(1.5707963267948966 * (double)i / (double)N);
+			}
+		}
+	};
+
+	constexpr CosineTable<m_QuarterSize> m_CosineTable;
+
+	///
+	/// cos(2 * pi * i / m_CosineTableSize) of any i by the symmetries of the quarter
+	///
+	inline double GetCosine(size_t i)
+	{
+		i &= m_CosineTableSize - 1;
+
+		if (i <= m_QuarterSize)
+		{
+			return m_CosineTable.m_Values[i];
+		}
+		if (i <= 2 * m_QuarterSize)
+		{
+			return -m_CosineTable.m_Values[2 * m_QuarterSize - i];
+		}
+		if (i <= 3 * m_QuarterSize)
+		{
+			return -m_CosineTable.m_Values[i - 2 * m_QuarterSize];
+		}
+
+		return m_CosineTable.m_Values[m_CosineTableSize - i];
+	}
+
+	///
+	/// The generalized cosine windows, w = a0 - a1 * cos(x) + a2 * cos(2x) - a3 * cos(3x)
+	///
+	struct CosineTerms
+	{
+		double m_A[4];
+		size_t m_TermCount;
+	};
+
+	CosineTerms GetCosineTerms(WindowType windowType)
+	{
+		switch (windowType)
+		{
+		case WindowType::Hann:
+			return { { 0.5, 0.5, 0.0, 0.0 }, 2 };
+		case WindowType::Hamming:
+			return { { 0.53836, 0.46164, 0.0, 0.0 }, 2 };
+		case WindowType::Blackman:
+			return { { 0.42659, 0.49656, 0.076849, 0.0 }, 3 };
+		case WindowType::Nuttall:
+			return { { 0.355768, 0.487396, 0.144232, 0.012604 }, 4 };
+		case WindowType::BlackmanNuttall:
+			return { { 0.3635819, 0.4891775, 0.1365995, 0.0106411 }, 4 };
+		case WindowType::BlackmanHarris:
+			return { { 0.35875, 0.48829, 0.14128, 0.01168 }, 4 };
+		default:
+			return { { 1.0, 0.0, 0.0, 0.0 }, 1 };
+		}
+	}
+
+	template<class T>
+	std::vector<T> GenerateWindow(const WindowDesc& windowDesc)
+	{
+		auto N = windowDesc.m_WindowSize;
+		auto l_terms = GetCosineTerms(windowDesc.m_WindowType);
+		std::vector<T> l_result(N, T(1));
+
+		if (l_terms.m_TermCount == 1 || N <= 1)
+		{
+			return l_result;
+		}
+
+		auto l_isPeriodic = windowDesc.m_WindowSymmetry == WindowSymmetry::Periodic;
+		auto l_isTable = l_isPeriodic && N <= m_CosineTableSize && !(N & (N - 1));
+		// The period in samples
+		auto l_period = l_isPeriodic ? (double)N : (double)(N - 1);
+		auto l_tableStep = m_CosineTableSize / N;
+
+		for (size_t i = 0; i < N; i++)
+		{
+			auto l_value = l_terms.m_A[0];
+			auto l_sign = -1.0;
+
+			for (size_t k = 1; k < l_terms.m_TermCount; k++)
+			{
+				auto l_cosine = l_isTable ? GetCosine(k * i * l_tableStep) : std::cos(2.0 * PI<double> * (double)(k * i) / l_period);
+				l_value += l_sign * l_terms.m_A[k] * l_cosine;
+				l_sign = -l_sign;
+			}
+
+			l_result[i] = T(l_value);
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	struct WindowCache
+	{
+		std::unordered_map<uint64_t, std::unique_ptr<std::vector<T>>> m_Windows;
+		std::shared_mutex m_Mutex;
+	};
+}
+
+using namespace Waveless;
+using namespace Waveless::WindowBankNS;
+
+template<class T>
+const std::vector<T>& WindowBank::Get(const WindowDesc& windowDesc)
+{
+	static WindowCache<T> l_cache;
+
+	auto l_key = ((uint64_t)windowDesc.m_WindowSize << 8) | ((uint64_t)windowDesc.m_WindowType << 1) | (uint64_t)windowDesc.m_WindowSymmetry;
+
+	{
+		std::shared_lock<std::shared_mutex> l_lock(l_cache.m_Mutex);
+
+		auto l_result = l_cache.m_Windows.find(l_key);
+
+		if (l_result != l_cache.m_Windows.end())
+		{
+			return *l_result->second;
+		}
+	}
+
+	auto l_newWindow = std::make_unique<std::vector<T>>(GenerateWindow<T>(windowDesc));
+
+	std::unique_lock<std::shared_mutex> l_lock(l_cache.m_Mutex);
+
+	auto& l_window = l_cache.m_Windows[l_key];
+
+	if (!l_window)
+	{
+		l_window = std::move(l_newWindow);
+	}
+
+	return *l_window;
+}
+
+namespace Waveless
+{
+	template const std::vector<float>& WindowBank::Get<float>(const WindowDesc&);
+	template const std::vector<double>& WindowBank::Get<double>(const WindowDesc&);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include "stdafx.h"
+#include "Math.h"
+
+namespace Waveless
+{
+	///
+	/// Cache of the real window functions by type, size, symmetry and precision.
+	/// A window is computed at its first request and lives until the end of the process, the later requests only look it up.
+	/// The periodic windows of the power of 2 sizes up to m_MaxTableSize are summed from a cosine table generated at compile time,
+	/// the other ones call std::cos once per sample and term.
+	///
+	class WindowBank
+	{
+	public:
+		static constexpr size_t m_MaxTableSize = 16384;
+
+		WindowBank() = default;
+		~WindowBank() = default;
+
+		///
+		/// The window of windowDesc, the hop size is ignored. Could be called from any thread, the windows are never modified after they are created
+		///
+		template<class T>
+		static const std::vector<T>& Get(const WindowDesc& windowDesc);
+	};
+}
\ No newline at end of file
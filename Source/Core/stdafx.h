@@ -1,4 +1,5 @@
 #include <cmath>
+#include <cstring>
 #include <complex>
 #include <algorithm>
 #include <random>
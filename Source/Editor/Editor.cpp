@@ -35,6 +35,7 @@ WsResult Editor::Render()
 {
 	while (ImGuiWrapper::get().Render() == WsResult::Success)
 	{
+		NodeDescriptorManager::ReloadChangedNodeDescriptors();
 		PluginManager::Update();
 		AudioEngine::Flush();
 	}
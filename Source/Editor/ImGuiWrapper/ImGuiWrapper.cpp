@@ -5,7 +5,6 @@
 #include "../../Core/String.h"
 #include "../../Core/Vector.h"
 #include "../../IO/IOService.h"
-#include "../../IO/JSONParser.h"
 #include "../../Runtime/PluginManager.h"
 #include "../NodeDescriptorManager.h"
 #include "../NodeModelManager.h"
@@ -273,25 +272,6 @@ static PinWidget* FindPin(ed::PinId id)
 	return nullptr;
 }
 
-static PinWidget* FindPinByUUID(uint64_t id)
-{
-	if (!id)
-		return nullptr;
-
-	for (auto& node : s_Nodes)
-	{
-		for (auto& pin : node->Inputs)
-			if (pin.Model->UUID == id)
-				return &pin;
-
-		for (auto& pin : node->Outputs)
-			if (pin.Model->UUID == id)
-				return &pin;
-	}
-
-	return nullptr;
-}
-
 static bool IsPinLinked(PinWidget* pin)
 {
 	if (pin == nullptr)
@@ -394,14 +374,7 @@ static void BuildNodes()
 
 static void LoadCanvas(const char* fileName)
 {
-	NodeModelManager::LoadCanvas(fileName);
-
-	NodeModel* l_startNodeModel;
-	NodeModelManager::GetStartNodeModel(l_startNodeModel);
-
-	m_pluginInputData.resize(l_startNodeModel->OutputPinCount);
-	m_sortedStartNodePinModels.resize(l_startNodeModel->OutputPinCount);
-
+	// The widgets refer to the models, remove them before the models are reloaded
 	for (auto node : s_Nodes)
 	{
 		node->Inputs.clear();
@@ -409,8 +382,8 @@ static void LoadCanvas(const char* fileName)
 		node->Inputs.shrink_to_fit();
 		node->Outputs.shrink_to_fit();
 
-		delete node;
 		ed::DeleteNode(node->ID);
+		delete node;
 	}
 	for (auto& link : s_Links)
 	{
@@ -421,9 +394,25 @@ static void LoadCanvas(const char* fileName)
 	s_Nodes.shrink_to_fit();
 	s_Links.shrink_to_fit();
 
+	if (NodeModelManager::LoadCanvas(fileName) != WsResult::Success)
+	{
+		return;
+	}
+
+	NodeModel* l_startNodeModel;
+	NodeModelManager::GetStartNodeModel(l_startNodeModel);
+
+	m_pluginInputData.resize(l_startNodeModel->OutputPinCount);
+	m_sortedStartNodePinModels.resize(l_startNodeModel->OutputPinCount);
+
 	std::vector<NodeModel*>* l_nodeModels;
 	NodeModelManager::GetAllNodeModels(l_nodeModels);
 
+	s_Nodes.reserve(l_nodeModels->size());
+
+	// The pin widgets don't move once their node is spawned
+	std::unordered_map<PinModel*, PinWidget*> l_pinWidgets;
+
 	for (auto l_nodeModel : *l_nodeModels)
 	{
 		auto l_nodeWidget = SpawnNodeWidget(l_nodeModel);
@@ -432,16 +421,28 @@ static void LoadCanvas(const char* fileName)
 			m_StartNode = l_nodeWidget;
 		}
 
+		for (auto& input : l_nodeWidget->Inputs)
+		{
+			l_pinWidgets.emplace(input.Model, &input);
+		}
+
+		for (auto& output : l_nodeWidget->Outputs)
+		{
+			l_pinWidgets.emplace(output.Model, &output);
+		}
+
 		ed::SetNodePosition(l_nodeWidget->ID, ImVec2(l_nodeModel->InitialPosition[0], l_nodeModel->InitialPosition[1]));
 	}
 
 	std::vector<LinkModel*>* l_linkModels;
 	NodeModelManager::GetAllLinkModels(l_linkModels);
 
+	s_Links.reserve(l_linkModels->size());
+
 	for (auto l_linkModel : *l_linkModels)
 	{
-		auto l_startPin = FindPinByUUID(l_linkModel->StartPin->UUID);
-		auto l_endPin = FindPinByUUID(l_linkModel->EndPin->UUID);
+		auto l_startPin = l_pinWidgets[l_linkModel->StartPin];
+		auto l_endPin = l_pinWidgets[l_linkModel->EndPin];
 
 		auto l_linkWidget = SpawnLinkWidget(l_startPin, l_endPin);
 		l_linkWidget->Model = l_linkModel;
@@ -453,122 +454,44 @@ static void LoadCanvas(const char* fileName)
 
 static void SaveCanvas(const char* fileName)
 {
-	json j;
+	std::vector<NodeModel*> l_nodeModels;
+	l_nodeModels.reserve(s_Nodes.size());
 
-	for (auto& node : s_Nodes)
+	// The widget IDs are saved as the model UUIDs
+	for (auto node : s_Nodes)
 	{
 		auto l_pos = ed::GetNodePosition(node->ID);
-		json j_node;
-		j_node["ID"] = node->ID.Get();
-		j_node["Name"] = node->Model->Desc->Name;
-		j_node["NodeType"] = node->Model->Desc->Type;
-		j_node["Position"]["X"] = (int)l_pos.x;
-		j_node["Position"]["Y"] = (int)l_pos.y;
+		node->Model->UUID = node->ID.Get();
+		node->Model->InitialPosition[0] = l_pos.x;
+		node->Model->InitialPosition[1] = l_pos.y;
 
 		for (auto& input : node->Inputs)
 		{
-			json j_input;
-			j_input["ID"] = input.ID.Get();
-			j_input["Name"] = input.Model->Desc->Name;
-			if (input.Model->Desc->Type == PinType::String)
-			{
-				if (input.Model->Value)
-				{
-					j_input["Value"] = StringManager::FindString(input.Model->Value).value;
-				}
-			}
-			else if (input.Model->Desc->Type == PinType::Bool)
-			{
-				bool value = *reinterpret_cast<bool*>(&input.Model->Value);
-				j_input["Value"] = value;
-			}
-			else if (input.Model->Desc->Type == PinType::Int)
-			{
-				int32_t value = *reinterpret_cast<int32_t*>(&input.Model->Value);
-				j_input["Value"] = value;
-			}
-			else if (input.Model->Desc->Type == PinType::Float)
-			{
-				float value = *reinterpret_cast<float*>(&input.Model->Value);
-				j_input["Value"] = value;
-			}
-			else if (input.Model->Desc->Type == PinType::Vector)
-			{
-				if (input.Model->Value)
-				{
-					auto l_vector = VectorManager::FindVector(input.Model->Value);
-					j_input["Value"]["X"] = l_vector.value->x;
-					j_input["Value"]["Y"] = l_vector.value->y;
-					j_input["Value"]["Z"] = l_vector.value->z;
-					j_input["Value"]["W"] = l_vector.value->w;
-				}
-			}
-			else
-			{
-				j_input["Value"] = input.Model->Value;
-			}
-
-			j_node["Inputs"].emplace_back(j_input);
+			input.Model->UUID = input.ID.Get();
 		}
 
 		for (auto& output : node->Outputs)
 		{
-			json j_output;
-			j_output["ID"] = output.ID.Get();
-			j_output["Name"] = output.Model->Desc->Name;
-			if (output.Model->Desc->Type == PinType::String)
-			{
-				if (output.Model->Value)
-				{
-					j_output["Value"] = StringManager::FindString(output.Model->Value).value;
-				}
-			}
-			else if (output.Model->Desc->Type == PinType::Bool)
-			{
-				bool value = *reinterpret_cast<bool*>(&output.Model->Value);
-				j_output["Value"] = value;
-			}
-			else if (output.Model->Desc->Type == PinType::Int)
-			{
-				int32_t value = *reinterpret_cast<int32_t*>(&output.Model->Value);
-				j_output["Value"] = value;
-			}
-			else if (output.Model->Desc->Type == PinType::Float)
-			{
-				float value = *reinterpret_cast<float*>(&output.Model->Value);
-				j_output["Value"] = value;
-			}
-			else if (output.Model->Desc->Type == PinType::Vector)
-			{
-				if (output.Model->Value)
-				{
-					auto l_vector = VectorManager::FindVector(output.Model->Value);
-					j_output["Value"]["X"] = l_vector.value->x;
-					j_output["Value"]["Y"] = l_vector.value->y;
-					j_output["Value"]["Z"] = l_vector.value->z;
-					j_output["Value"]["W"] = l_vector.value->w;
-				}
-			}
-			else
-			{
-				j_output["Value"] = output.Model->Value;
-			}
-			j_node["Outputs"].emplace_back(j_output);
+			output.Model->UUID = output.ID.Get();
 		}
 
-		j["Nodes"].emplace_back(j_node);
+		l_nodeModels.emplace_back(node->Model);
 	}
 
-	for (auto& link : s_Links)
+	// Links created in the editor don't have a model yet
+	std::vector<LinkModel> l_links(s_Links.size());
+	std::vector<LinkModel*> l_linkModels;
+	l_linkModels.reserve(s_Links.size());
+
+	for (size_t i = 0; i < s_Links.size(); i++)
 	{
-		json j_link;
-		j_link["ID"] = link.ID.Get();
-		j_link["StartPinID"] = link.StartPin->ID.Get();
-		j_link["EndPinID"] = link.EndPin->ID.Get();
-		j["Links"].emplace_back(j_link);
+		l_links[i].UUID = s_Links[i].ID.Get();
+		l_links[i].StartPin = s_Links[i].StartPin->Model;
+		l_links[i].EndPin = s_Links[i].EndPin->Model;
+		l_linkModels.emplace_back(&l_links[i]);
 	}
 
-	Waveless::JSONParser::saveJsonDataToDisk(("..//..//Asset//Canvas//" + std::string(fileName)).c_str(), j);
+	NodeModelManager::SaveCanvas(fileName, l_nodeModels, l_linkModels);
 }
 
 void EditConstVar(PinWidget & output)
@@ -532,15 +532,17 @@ WsResult GenerateSourceFile(const char* inputFileName, const char* outputFileNam
 
 WsResult GeneratePluginSourceFile(const char* inputFileName, const char* outputFileName)
 {
-	std::vector<char> l_TU;
+	IOService::FileView l_template;
 
-	if (IOService::loadFile("..//..//Source//Core//PluginEntryTemplate.inl", l_TU, IOService::IOMode::Text) != WsResult::Success)
+	if (IOService::mapFile("..//..//Source//Core//PluginEntryTemplate.inl", l_template) != WsResult::Success)
 	{
 		return WsResult::Fail;
 	}
 
-	std::string l_TUStr = l_TU.data();
+	std::string l_TUStr(l_template.view());
 	l_TUStr = std::regex_replace(l_TUStr, std::regex("PluginName"), inputFileName);
+
+	std::vector<char> l_TU;
 	l_TU.resize(l_TUStr.size());
 	std::memcpy(l_TU.data(), l_TUStr.data(), l_TUStr.size());
 
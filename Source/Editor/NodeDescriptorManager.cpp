@@ -1,246 +1,723 @@
 #include "NodeDescriptorManager.h"
 #include "../Core/stdafx.h"
+#include <atomic>
+#include <deque>
 #include "../Core/Logger.h"
 #include "../Core/String.h"
+#include "../Core/TaskScheduler.h"
 #include "../IO/IOService.h"
 #include "../IO/JSONParser.h"
 
 namespace Waveless::NodeDescriptorManager
 {
 	std::vector<NodeDescriptor*> m_nodeDescriptors;
-	std::vector<PinDescriptor> m_inputPinDescriptors;
-	std::vector<PinDescriptor> m_outputPinDescriptors;
-	std::vector<ParamMetadata> m_ParamMetadatas;
-	std::vector<FunctionMetadata> m_FunctionMetadatas;
+	// Nodes on the canvas hold raw pointers to these, so the storage must not relocate when templates are reloaded
+	std::deque<NodeDescriptor> m_nodeDescriptorPool;
+	std::deque<PinDescriptor> m_inputPinDescriptors;
+	std::deque<PinDescriptor> m_outputPinDescriptors;
+	std::deque<ParamMetadata> m_ParamMetadatas;
+	std::deque<FunctionMetadata> m_FunctionMetadatas;
 	std::unordered_map<std::string, NodeDescriptor*> m_nodeDescriptorsMap;
+	std::string m_nodeTemplateDirectoryPath;
 
-	PinType GetPinType(const char * pinType);
-	NodeDescriptor* LoadNodeDescriptor(const char * nodeDescriptorPath);
-	void ParseParams(FunctionMetadata* FuncMetadata, const std::string& params);
-	void LoadFunctionDefinitions(NodeDescriptor* nodeDesc);
-	void LoadNewNodeDescriptor(const char * nodeDescriptorPath);
+	const char* m_nodeTemplateCacheFileName = "NodeTemplates.wsd";
+	const uint32_t m_nodeTemplateCacheMagic = 0x444E5357; // "WSND"
+	const uint32_t m_nodeTemplateCacheVersion = 1;
+
+	struct NodeTemplatePin
+	{
+		std::string Name;
+		PinType Type = PinType::Flow;
+		PinKind Kind = PinKind::Input;
+		PinValue DefaultValue = 0;
+		int ParamIndex = -1;
+	};
+
+	struct NodeTemplateParam
+	{
+		std::string Type;
+		std::string Name;
+		PinKind Kind = PinKind::Input;
+	};
+
+	// Everything parsed from a .json and its companion .h, without touching any shared state,
+	// so the templates could be parsed in parallel and cached on disk
+	struct NodeTemplate
+	{
+		std::string RelativePath;
+		uint64_t JsonWriteTime = 0;
+		uint64_t CodeWriteTime = 0;
+
+		NodeType Type = NodeType::ConstVar;
+		int Color[4] = { 0 };
+		std::vector<NodeTemplatePin> Pins;
+
+		bool HasFunction = false;
+		std::string FuncName;
+		std::string FuncDefi;
+		std::vector<NodeTemplateParam> Params;
+
+		std::string Error;
+		std::vector<std::string> Warnings;
+	};
+
+	bool GetPinType(const std::string& pinType, PinType& result);
+	bool ParseParams(NodeTemplate& nodeTemplate, std::string_view params);
+	void ParseFunctionDefinition(const std::string& codePath, NodeTemplate& nodeTemplate);
+	void ParseNodeTemplate(const std::string& nodeDescriptorPath, NodeTemplate& nodeTemplate);
+	void SpawnNodeDescriptor(const NodeTemplate& nodeTemplate, NodeDescriptor* nodeDesc);
+	void LoadNewNodeDescriptor(const NodeTemplate& nodeTemplate);
+	void ReloadNodeDescriptor(const char * nodeDescriptorPath);
+	void RemoveNodeDescriptor(const char * nodeDescriptorPath);
+	void LoadNodeTemplateCache(const std::string& cachePath, std::unordered_map<std::string, NodeTemplate>& result);
+	void SaveNodeTemplateCache(const std::string& cachePath, const std::vector<NodeTemplate>& nodeTemplates);
 }
 
 using namespace Waveless;
 
-PinType NodeDescriptorManager::GetPinType(const char * pinType)
+bool NodeDescriptorManager::GetPinType(const std::string& pinType, PinType& result)
 {
-	if (!strcmp(pinType, "Flow"))
+	if (pinType == "Flow")
 	{
-		return PinType::Flow;
+		result = PinType::Flow;
 	}
-	else if (!strcmp(pinType, "Bool"))
+	else if (pinType == "Bool")
 	{
-		return PinType::Bool;
+		result = PinType::Bool;
 	}
-	else if (!strcmp(pinType, "Int"))
+	else if (pinType == "Int")
 	{
-		return PinType::Int;
+		result = PinType::Int;
 	}
-	else if (!strcmp(pinType, "Float"))
+	else if (pinType == "Float")
 	{
-		return PinType::Float;
+		result = PinType::Float;
 	}
-	else if (!strcmp(pinType, "String"))
+	else if (pinType == "String")
 	{
-		return PinType::String;
+		result = PinType::String;
 	}
-	else if (!strcmp(pinType, "Vector"))
+	else if (pinType == "Vector")
 	{
-		return PinType::Vector;
+		result = PinType::Vector;
 	}
-	else if (!strcmp(pinType, "Object"))
+	else if (pinType == "Object")
 	{
-		return PinType::Object;
+		result = PinType::Object;
 	}
 	else
 	{
-		Logger::Log(LogLevel::Warning, "Unknown pin type: ", pinType);
-
-		return PinType::Flow;
+		result = PinType::Flow;
+		return false;
 	}
+
+	return true;
 }
 
-NodeDescriptor* NodeDescriptorManager::LoadNodeDescriptor(const char * nodeDescriptorPath)
+bool NodeDescriptorManager::ParseParams(NodeTemplate& nodeTemplate, std::string_view params)
 {
-	auto l_nodeDesc = new NodeDescriptor();
-	l_nodeDesc->RelativePath = StringManager::SpawnString(nodeDescriptorPath).value;
-	l_nodeDesc->Name = StringManager::SpawnString(IOService::getFileName(nodeDescriptorPath).c_str()).value;
-
-	json j;
-	JSONParser::loadJsonDataFromDisk(nodeDescriptorPath, j);
-
-	int nodeType = j["NodeType"];
-	l_nodeDesc->Type = NodeType(nodeType);
-
-	for (auto k : j["Parameters"])
+	while (params.size())
 	{
-		int pinKind = k["PinKind"];
-		std::string pinType = k["PinType"];
-		std::string pinName = k["Name"];
-		if (!pinName.size())
+		auto l_separatorPos = params.find(',');
+		auto s = params.substr(0, l_separatorPos);
+		params = l_separatorPos == std::string_view::npos ? std::string_view() : params.substr(l_separatorPos + 1);
+
+		NodeTemplateParam p;
+		auto l_endPos = s.find("in_");
+		auto l_startPos = 0;
+		if (l_endPos == std::string_view::npos)
 		{
-			pinName = "NoName";
+			l_endPos = s.find("out_");
 		}
+		if (l_endPos == std::string_view::npos || !l_endPos)
+		{
+			return false;
+		}
+		if (!s.compare(0, 1, " "))
+		{
+			l_startPos = 1;
+		}
+		p.Type = std::string(s.substr(l_startPos, l_endPos - 1 - l_startPos));
+		p.Name = std::string(s.substr(l_endPos, std::string_view::npos));
 
-		PinDescriptor pinDesc;
-		pinDesc.Kind = PinKind(pinKind);
-		pinDesc.Name = StringManager::SpawnString(pinName.c_str()).value;
-		pinDesc.Type = GetPinType(pinType.c_str());
-
-		if (pinDesc.Type == PinType::Bool)
+		if (p.Name.find("in_") != std::string::npos)
 		{
-			pinDesc.DefaultValue = (bool)k["DefaultValue"];
+			p.Kind = PinKind::Input;
 		}
-		else if (pinDesc.Type == PinType::Int)
+		else
 		{
-			pinDesc.DefaultValue = k["DefaultValue"];
+			p.Kind = PinKind::Output;
 		}
-		else if (pinDesc.Type == PinType::Float)
+
+		nodeTemplate.Params.emplace_back(std::move(p));
+	}
+
+	return true;
+}
+
+void NodeDescriptorManager::ParseFunctionDefinition(const std::string& codePath, NodeTemplate& nodeTemplate)
+{
+	IOService::FileView l_code;
+
+	if (IOService::mapFile(codePath.c_str(), l_code) != WsResult::Success)
+	{
+		return;
+	}
+
+	auto l_codeStr = l_code.view();
+
+	auto l_funcName = IOService::getFileName(codePath.c_str());
+	std::replace(l_funcName.begin(), l_funcName.end(), '/', '_');
+	std::replace(l_funcName.begin(), l_funcName.end(), '.', '_');
+
+	nodeTemplate.HasFunction = true;
+	nodeTemplate.FuncName = "Execute_" + l_funcName;
+
+	auto l_signEndPos = l_codeStr.find_first_of("\n");
+	nodeTemplate.FuncDefi = std::string(l_codeStr.substr(l_signEndPos + 1, std::string_view::npos));
+
+	// "void Execute(" ... ")", the line ending could be CRLF
+	constexpr std::string_view l_signPrefix = "void Execute(";
+
+	auto l_sign = l_codeStr.substr(0, l_signEndPos);
+	if (l_sign.size() && l_sign.back() == '\r')
+	{
+		l_sign.remove_suffix(1);
+	}
+
+	if (l_sign.size() <= l_signPrefix.size() || l_sign.compare(0, l_signPrefix.size(), l_signPrefix) || l_sign.back() != ')')
+	{
+		nodeTemplate.HasFunction = false;
+		nodeTemplate.Error = "Can't parse the function signature of " + codePath;
+		return;
+	}
+
+	auto l_params = l_sign.substr(l_signPrefix.size(), l_sign.size() - l_signPrefix.size() - 1);
+	if (!ParseParams(nodeTemplate, l_params))
+	{
+		nodeTemplate.HasFunction = false;
+		nodeTemplate.Params.clear();
+		nodeTemplate.Error = "Can't parse the parameters of " + codePath + ", they need an in_ or out_ prefix";
+	}
+}
+
+void NodeDescriptorManager::ParseNodeTemplate(const std::string& nodeDescriptorPath, NodeTemplate& nodeTemplate)
+{
+	IOService::FileView l_file;
+
+	if (IOService::mapFile(nodeDescriptorPath.c_str(), l_file) != WsResult::Success)
+	{
+		nodeTemplate.Error = "Can't open node descriptor " + nodeDescriptorPath;
+		return;
+	}
+
+	try
+	{
+		auto j = json::parse(l_file.data(), l_file.data() + l_file.size());
+
+		int nodeType = j["NodeType"];
+		nodeTemplate.Type = NodeType(nodeType);
+
+		for (auto& k : j["Parameters"])
 		{
-			pinDesc.DefaultValue = k["DefaultValue"];
+			NodeTemplatePin l_pin;
+
+			int pinKind = k["PinKind"];
+			l_pin.Kind = PinKind(pinKind);
+
+			l_pin.Name = k["Name"];
+			if (!l_pin.Name.size())
+			{
+				l_pin.Name = "NoName";
+			}
+
+			std::string pinType = k["PinType"];
+			if (!GetPinType(pinType, l_pin.Type))
+			{
+				nodeTemplate.Warnings.emplace_back("Unknown pin type: " + pinType);
+			}
+
+			if (l_pin.Type == PinType::Bool)
+			{
+				l_pin.DefaultValue = (bool)k["DefaultValue"];
+			}
+			else if (l_pin.Type == PinType::Int)
+			{
+				l_pin.DefaultValue = k["DefaultValue"];
+			}
+			else if (l_pin.Type == PinType::Float)
+			{
+				l_pin.DefaultValue = k["DefaultValue"];
+			}
+			l_pin.ParamIndex = k["ParamIndex"];
+
+			nodeTemplate.Pins.emplace_back(std::move(l_pin));
 		}
-		pinDesc.ParamIndex = k["ParamIndex"];
+
+		nodeTemplate.Color[0] = j["Color"]["R"];
+		nodeTemplate.Color[1] = j["Color"]["G"];
+		nodeTemplate.Color[2] = j["Color"]["B"];
+		nodeTemplate.Color[3] = j["Color"]["A"];
+	}
+	catch (const std::exception& e)
+	{
+		nodeTemplate.Error = "Can't parse node descriptor " + nodeDescriptorPath + ": " + e.what();
+		return;
+	}
+
+	ParseFunctionDefinition(nodeDescriptorPath.substr(0, nodeDescriptorPath.rfind(".")) + ".h", nodeTemplate);
+}
+
+void NodeDescriptorManager::SpawnNodeDescriptor(const NodeTemplate& nodeTemplate, NodeDescriptor* nodeDesc)
+{
+	auto l_nodeDescriptorPath = m_nodeTemplateDirectoryPath + nodeTemplate.RelativePath;
+
+	*nodeDesc = NodeDescriptor();
+	nodeDesc->RelativePath = StringManager::SpawnString(l_nodeDescriptorPath.c_str()).value;
+	nodeDesc->Name = StringManager::SpawnString(IOService::getFileName(l_nodeDescriptorPath.c_str()).c_str()).value;
+	nodeDesc->Type = nodeTemplate.Type;
+
+	// The pins of one node are contiguous, inputs and outputs are stored separately
+	for (auto& i : nodeTemplate.Pins)
+	{
+		PinDescriptor pinDesc;
+		pinDesc.Kind = i.Kind;
+		pinDesc.Name = StringManager::SpawnString(i.Name.c_str()).value;
+		pinDesc.Type = i.Type;
+		pinDesc.DefaultValue = i.DefaultValue;
+		pinDesc.ParamIndex = i.ParamIndex;
 
 		if (pinDesc.Kind == PinKind::Output)
 		{
-			l_nodeDesc->OutputPinCount++;
+			nodeDesc->OutputPinCount++;
 			m_outputPinDescriptors.emplace_back(pinDesc);
 		}
 		else
 		{
-			l_nodeDesc->InputPinCount++;
+			nodeDesc->InputPinCount++;
 			m_inputPinDescriptors.emplace_back(pinDesc);
 		}
 	}
 
-	if (l_nodeDesc->InputPinCount)
+	if (nodeDesc->InputPinCount)
+	{
+		nodeDesc->InputPinIndexOffset = (int)m_inputPinDescriptors.size() - nodeDesc->InputPinCount;
+	}
+
+	if (nodeDesc->OutputPinCount)
 	{
-		l_nodeDesc->InputPinIndexOffset = (int)m_inputPinDescriptors.size() - l_nodeDesc->InputPinCount;
+		nodeDesc->OutputPinIndexOffset = (int)m_outputPinDescriptors.size() - nodeDesc->OutputPinCount;
 	}
 
-	if (l_nodeDesc->OutputPinCount)
+	for (int i = 0; i < 4; i++)
 	{
-		l_nodeDesc->OutputPinIndexOffset = (int)m_outputPinDescriptors.size() - l_nodeDesc->OutputPinCount;
+		nodeDesc->Color[i] = nodeTemplate.Color[i];
 	}
 
-	l_nodeDesc->Color[0] = j["Color"]["R"];
-	l_nodeDesc->Color[1] = j["Color"]["G"];
-	l_nodeDesc->Color[2] = j["Color"]["B"];
-	l_nodeDesc->Color[3] = j["Color"]["A"];
+	if (nodeTemplate.HasFunction)
+	{
+		FunctionMetadata l_funcMetadata;
+		l_funcMetadata.Name = StringManager::SpawnString(nodeTemplate.FuncName.c_str()).value;
+		l_funcMetadata.Defi = StringManager::SpawnString(nodeTemplate.FuncDefi.c_str()).value;
+
+		for (auto& i : nodeTemplate.Params)
+		{
+			ParamMetadata p;
+			p.Type = StringManager::SpawnString(i.Type.c_str()).value;
+			p.Name = StringManager::SpawnString(i.Name.c_str()).value;
+			p.Kind = i.Kind;
+
+			m_ParamMetadatas.emplace_back(p);
+		}
+
+		if (nodeTemplate.Params.size())
+		{
+			l_funcMetadata.ParamsCount = (int)nodeTemplate.Params.size();
+			l_funcMetadata.ParamsIndexOffset = (int)m_ParamMetadatas.size() - l_funcMetadata.ParamsCount;
+		}
 
-	return l_nodeDesc;
+		m_FunctionMetadatas.emplace_back(l_funcMetadata);
+		nodeDesc->FuncMetadata = &m_FunctionMetadatas.back();
+	}
 }
 
-void NodeDescriptorManager::ParseParams(FunctionMetadata* FuncMetadata, const std::string& params)
+void NodeDescriptorManager::LoadNewNodeDescriptor(const NodeTemplate& nodeTemplate)
 {
-	std::stringstream ss(params);
-	std::string s;
-	int index = 0;
+	m_nodeDescriptorPool.emplace_back();
+	auto l_nodeDesc = &m_nodeDescriptorPool.back();
 
-	while (std::getline(ss, s, ','))
+	SpawnNodeDescriptor(nodeTemplate, l_nodeDesc);
+
+	m_nodeDescriptors.emplace_back(l_nodeDesc);
+	m_nodeDescriptorsMap.emplace(l_nodeDesc->Name, l_nodeDesc);
+}
+
+void NodeDescriptorManager::ReloadNodeDescriptor(const char * nodeDescriptorPath)
+{
+	NodeTemplate l_nodeTemplate;
+	l_nodeTemplate.RelativePath = std::string(nodeDescriptorPath).substr(m_nodeTemplateDirectoryPath.size());
+
+	ParseNodeTemplate(nodeDescriptorPath, l_nodeTemplate);
+
+	for (auto& i : l_nodeTemplate.Warnings)
 	{
-		ParamMetadata p;
-		auto l_endPos = s.find("in_");
-		auto l_startPos = 0;
-		if (l_endPos == std::string::npos)
+		Logger::Log(LogLevel::Warning, i.c_str());
+	}
+
+	if (l_nodeTemplate.Error.size())
+	{
+		Logger::Log(LogLevel::Error, l_nodeTemplate.Error.c_str());
+		return;
+	}
+
+	auto l_result = m_nodeDescriptorsMap.find(IOService::getFileName(nodeDescriptorPath));
+
+	if (l_result == m_nodeDescriptorsMap.end())
+	{
+		LoadNewNodeDescriptor(l_nodeTemplate);
+		return;
+	}
+
+	// Reuse the descriptor object, the previous pins and params stay alive for the nodes already created from it
+	SpawnNodeDescriptor(l_nodeTemplate, l_result->second);
+
+	Logger::Log(LogLevel::Verbose, "Node descriptor ", nodeDescriptorPath, " has been reloaded.");
+}
+
+void NodeDescriptorManager::RemoveNodeDescriptor(const char * nodeDescriptorPath)
+{
+	auto l_result = m_nodeDescriptorsMap.find(IOService::getFileName(nodeDescriptorPath));
+
+	if (l_result == m_nodeDescriptorsMap.end())
+	{
+		return;
+	}
+
+	// The descriptor is not deleted since the nodes on the canvas may still refer to it
+	auto l_nodeDesc = l_result->second;
+	m_nodeDescriptorsMap.erase(l_result);
+	m_nodeDescriptors.erase(std::remove(m_nodeDescriptors.begin(), m_nodeDescriptors.end(), l_nodeDesc), m_nodeDescriptors.end());
+
+	Logger::Log(LogLevel::Verbose, "Node descriptor ", nodeDescriptorPath, " has been removed.");
+}
+
+namespace Waveless::NodeDescriptorManager
+{
+	template<typename T>
+	void WriteCacheValue(std::vector<char>& content, const T& value)
+	{
+		content.insert(content.end(), (const char*)&value, (const char*)&value + sizeof(T));
+	}
+
+	void WriteCacheString(std::vector<char>& content, const std::string& value)
+	{
+		WriteCacheValue(content, (uint32_t)value.size());
+		content.insert(content.end(), value.begin(), value.end());
+	}
+
+	// Bounds checked, any read past the end invalidates the whole cache
+	struct CacheReader
+	{
+		const char* m_Data;
+		size_t m_Size;
+		size_t m_Pos = 0;
+		bool m_Valid = true;
+
+		template<typename T>
+		T Read()
 		{
-			l_endPos = s.find("out_");
+			T l_value = T();
+
+			if (m_Pos + sizeof(T) > m_Size)
+			{
+				m_Valid = false;
+				return l_value;
+			}
+
+			std::memcpy(&l_value, m_Data + m_Pos, sizeof(T));
+			m_Pos += sizeof(T);
+
+			return l_value;
 		}
-		if (!s.compare(0, 1, " "))
+
+		std::string ReadString()
 		{
-			l_startPos = 1;
+			auto l_size = Read<uint32_t>();
+
+			if (!m_Valid || m_Pos + l_size > m_Size)
+			{
+				m_Valid = false;
+				return std::string();
+			}
+
+			std::string l_value(m_Data + m_Pos, l_size);
+			m_Pos += l_size;
+
+			return l_value;
 		}
-		auto l_type = s.substr(l_startPos, l_endPos - 1 - l_startPos);
-		p.Type = StringManager::SpawnString(l_type.c_str()).value;
+	};
+}
+
+void NodeDescriptorManager::LoadNodeTemplateCache(const std::string& cachePath, std::unordered_map<std::string, NodeTemplate>& result)
+{
+	IOService::FileView l_file;
+
+	if (!IOService::isFileExist(cachePath.c_str()) || IOService::mapFile(cachePath.c_str(), l_file) != WsResult::Success)
+	{
+		return;
+	}
 
-		auto l_name = s.substr(l_endPos, std::string::npos);
-		p.Name = StringManager::SpawnString(l_name.c_str()).value;
+	CacheReader l_reader{ l_file.data(), l_file.size() };
 
-		if (l_name.find("in_") != std::string::npos)
+	if (l_reader.Read<uint32_t>() != m_nodeTemplateCacheMagic || l_reader.Read<uint32_t>() != m_nodeTemplateCacheVersion)
+	{
+		return;
+	}
+
+	auto l_count = l_reader.Read<uint32_t>();
+	result.reserve(l_count);
+
+	for (uint32_t i = 0; i < l_count && l_reader.m_Valid; i++)
+	{
+		NodeTemplate l_nodeTemplate;
+		l_nodeTemplate.RelativePath = l_reader.ReadString();
+		l_nodeTemplate.JsonWriteTime = l_reader.Read<uint64_t>();
+		l_nodeTemplate.CodeWriteTime = l_reader.Read<uint64_t>();
+		l_nodeTemplate.Type = NodeType(l_reader.Read<int32_t>());
+
+		for (int j = 0; j < 4; j++)
 		{
-			p.Kind = PinKind::Input;
+			l_nodeTemplate.Color[j] = l_reader.Read<int32_t>();
 		}
-		else
+
+		auto l_pinCount = l_reader.Read<uint32_t>();
+
+		for (uint32_t j = 0; j < l_pinCount && l_reader.m_Valid; j++)
 		{
-			p.Kind = PinKind::Output;
+			NodeTemplatePin l_pin;
+			l_pin.Name = l_reader.ReadString();
+			l_pin.Type = PinType(l_reader.Read<int32_t>());
+			l_pin.Kind = PinKind(l_reader.Read<int32_t>());
+			l_pin.DefaultValue = l_reader.Read<PinValue>();
+			l_pin.ParamIndex = l_reader.Read<int32_t>();
+
+			l_nodeTemplate.Pins.emplace_back(std::move(l_pin));
 		}
 
-		m_ParamMetadatas.emplace_back(p);
+		l_nodeTemplate.HasFunction = l_reader.Read<uint8_t>() != 0;
+		l_nodeTemplate.FuncName = l_reader.ReadString();
+		l_nodeTemplate.FuncDefi = l_reader.ReadString();
+
+		auto l_paramCount = l_reader.Read<uint32_t>();
+
+		for (uint32_t j = 0; j < l_paramCount && l_reader.m_Valid; j++)
+		{
+			NodeTemplateParam l_param;
+			l_param.Type = l_reader.ReadString();
+			l_param.Name = l_reader.ReadString();
+			l_param.Kind = PinKind(l_reader.Read<int32_t>());
 
-		index++;
+			l_nodeTemplate.Params.emplace_back(std::move(l_param));
+		}
+
+		if (l_reader.m_Valid)
+		{
+			auto l_relativePath = l_nodeTemplate.RelativePath;
+			result.emplace(std::move(l_relativePath), std::move(l_nodeTemplate));
+		}
 	}
 
-	if (index)
+	if (!l_reader.m_Valid)
 	{
-		FuncMetadata->ParamsCount = index;
-		FuncMetadata->ParamsIndexOffset = (int)m_ParamMetadatas.size() - index;
+		Logger::Log(LogLevel::Warning, "Node template cache ", cachePath.c_str(), " is corrupted, ignore it.");
+		result.clear();
 	}
 }
 
-void NodeDescriptorManager::LoadFunctionDefinitions(NodeDescriptor* nodeDesc)
+void NodeDescriptorManager::SaveNodeTemplateCache(const std::string& cachePath, const std::vector<NodeTemplate>& nodeTemplates)
 {
-	auto l_fileName = std::string(nodeDesc->RelativePath);
-	l_fileName = l_fileName.substr(0, l_fileName.rfind("."));
-	auto l_filePath = l_fileName + ".h";
+	std::vector<char> l_content;
 
-	std::vector<char> l_code;
+	WriteCacheValue(l_content, m_nodeTemplateCacheMagic);
+	WriteCacheValue(l_content, m_nodeTemplateCacheVersion);
+	WriteCacheValue(l_content, (uint32_t)0);
 
-	if (IOService::loadFile(l_filePath.c_str(), l_code, IOService::IOMode::Text) == WsResult::Success)
+	uint32_t l_count = 0;
+
+	for (auto& i : nodeTemplates)
 	{
-		std::string l_codeStr = &l_code[0];
+		if (i.Error.size())
+		{
+			continue;
+		}
 
-		auto l_funcName = IOService::getFileName(l_filePath.c_str());
-		std::replace(l_funcName.begin(), l_funcName.end(), '/', '_');
-		std::replace(l_funcName.begin(), l_funcName.end(), '.', '_');
+		WriteCacheString(l_content, i.RelativePath);
+		WriteCacheValue(l_content, i.JsonWriteTime);
+		WriteCacheValue(l_content, i.CodeWriteTime);
+		WriteCacheValue(l_content, (int32_t)i.Type);
 
-		l_funcName = "Execute_" + l_funcName;
-		auto l_funcNameCStr = StringManager::SpawnString(l_funcName.c_str()).value;
+		for (int j = 0; j < 4; j++)
+		{
+			WriteCacheValue(l_content, (int32_t)i.Color[j]);
+		}
 
-		FunctionMetadata l_funcMetadata;
-		l_funcMetadata.Name = l_funcNameCStr;
+		WriteCacheValue(l_content, (uint32_t)i.Pins.size());
 
-		auto l_signEndPos = l_codeStr.find_first_of("\n");
-		auto l_funcDefi = l_codeStr.substr(l_signEndPos + 1, std::string::npos);
-		l_funcMetadata.Defi = StringManager::SpawnString(l_funcDefi.c_str()).value;
+		for (auto& j : i.Pins)
+		{
+			WriteCacheString(l_content, j.Name);
+			WriteCacheValue(l_content, (int32_t)j.Type);
+			WriteCacheValue(l_content, (int32_t)j.Kind);
+			WriteCacheValue(l_content, j.DefaultValue);
+			WriteCacheValue(l_content, (int32_t)j.ParamIndex);
+		}
 
-		auto l_params = l_codeStr.substr(13, l_signEndPos - 14);
-		ParseParams(&l_funcMetadata, l_params);
+		WriteCacheValue(l_content, (uint8_t)i.HasFunction);
+		WriteCacheString(l_content, i.FuncName);
+		WriteCacheString(l_content, i.FuncDefi);
+		WriteCacheValue(l_content, (uint32_t)i.Params.size());
 
-		l_codeStr.replace(l_codeStr.begin() + 5, l_codeStr.begin() + 12, l_funcName);
-		l_codeStr.append("\n\n");
+		for (auto& j : i.Params)
+		{
+			WriteCacheString(l_content, j.Type);
+			WriteCacheString(l_content, j.Name);
+			WriteCacheValue(l_content, (int32_t)j.Kind);
+		}
 
-		m_FunctionMetadatas.emplace_back(l_funcMetadata);
-		nodeDesc->FuncMetadata = &m_FunctionMetadatas.back();
+		l_count++;
 	}
+
+	std::memcpy(&l_content[2 * sizeof(uint32_t)], &l_count, sizeof(l_count));
+
+	IOService::saveFile(cachePath.c_str(), l_content, IOService::IOMode::Binary);
 }
 
-void NodeDescriptorManager::LoadNewNodeDescriptor(const char * nodeDescriptorPath)
+WsResult NodeDescriptorManager::LoadAllNodeDescriptors(const char * nodeTemplateDirectoryPath)
 {
-	auto l_nodeDesc = LoadNodeDescriptor(nodeDescriptorPath);
+	m_nodeTemplateDirectoryPath = nodeTemplateDirectoryPath;
+
+	// The function definitions are watched as well, so editing them reloads the node template
+	if (IOService::indexDirectory(nodeTemplateDirectoryPath, { ".json", ".h" }) != WsResult::Success)
+	{
+		return WsResult::Fail;
+	}
 
-	LoadFunctionDefinitions(l_nodeDesc);
+	std::vector<NodeTemplate> l_nodeTemplates;
 
-	m_nodeDescriptors.emplace_back(l_nodeDesc);
-	m_nodeDescriptorsMap.emplace(l_nodeDesc->Name, m_nodeDescriptors.back());
+	for (auto& i : IOService::getIndexedFilePaths(nodeTemplateDirectoryPath))
+	{
+		if (IOService::getFileExtension(i.c_str()) == ".json")
+		{
+			l_nodeTemplates.emplace_back();
+			l_nodeTemplates.back().RelativePath = i;
+		}
+	}
+
+	auto l_cachePath = m_nodeTemplateDirectoryPath + m_nodeTemplateCacheFileName;
+	std::unordered_map<std::string, NodeTemplate> l_cachedNodeTemplates;
+	LoadNodeTemplateCache(l_cachePath, l_cachedNodeTemplates);
+
+	std::atomic<size_t> l_parsedCount = 0;
+
+	// Only the templates changed since the cache was written are parsed, each worker writes to its own slots
+	TaskScheduler::ParallelFor(l_nodeTemplates.size(), [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			auto& l_nodeTemplate = l_nodeTemplates[i];
+			auto l_nodeDescriptorPath = m_nodeTemplateDirectoryPath + l_nodeTemplate.RelativePath;
+			auto l_codePath = l_nodeDescriptorPath.substr(0, l_nodeDescriptorPath.rfind(".")) + ".h";
+
+			auto l_jsonWriteTime = IOService::getLastWriteTime(l_nodeDescriptorPath.c_str());
+			auto l_codeWriteTime = IOService::getLastWriteTime(l_codePath.c_str());
+
+			auto l_cachedNodeTemplate = l_cachedNodeTemplates.find(l_nodeTemplate.RelativePath);
+
+			if (l_cachedNodeTemplate != l_cachedNodeTemplates.end()
+				&& l_cachedNodeTemplate->second.JsonWriteTime == l_jsonWriteTime
+				&& l_cachedNodeTemplate->second.CodeWriteTime == l_codeWriteTime)
+			{
+				l_nodeTemplate = std::move(l_cachedNodeTemplate->second);
+				continue;
+			}
+
+			l_nodeTemplate.JsonWriteTime = l_jsonWriteTime;
+			l_nodeTemplate.CodeWriteTime = l_codeWriteTime;
+
+			ParseNodeTemplate(l_nodeDescriptorPath, l_nodeTemplate);
+
+			l_parsedCount++;
+		}
+	});
+
+	// StringManager is not thread-safe, so the descriptors are spawned serially
+	for (auto& i : l_nodeTemplates)
+	{
+		for (auto& j : i.Warnings)
+		{
+			Logger::Log(LogLevel::Warning, j.c_str());
+		}
+
+		if (i.Error.size())
+		{
+			Logger::Log(LogLevel::Error, i.Error.c_str());
+			continue;
+		}
+
+		LoadNewNodeDescriptor(i);
+	}
+
+	if (l_parsedCount || l_cachedNodeTemplates.size() != l_nodeTemplates.size())
+	{
+		SaveNodeTemplateCache(l_cachePath, l_nodeTemplates);
+	}
+
+	Logger::Log(LogLevel::Verbose, "NodeDescriptorManager: ", (uint64_t)l_nodeTemplates.size(), " node templates have been loaded, ", (uint64_t)l_parsedCount, " of them are parsed.");
+
+	return WsResult::Success;
 }
 
-WsResult NodeDescriptorManager::LoadAllNodeDescriptors(const char * nodeTemplateDirectoryPath)
+WsResult NodeDescriptorManager::ReloadChangedNodeDescriptors()
 {
-	// @TODO: Pool them
-	m_nodeDescriptors.reserve(512);
-	m_inputPinDescriptors.reserve(2048);
-	m_outputPinDescriptors.reserve(2048);
-	m_ParamMetadatas.reserve(2048);
-	m_FunctionMetadatas.reserve(1024);
+	if (!m_nodeTemplateDirectoryPath.size())
+	{
+		return WsResult::Fail;
+	}
 
-	auto l_filePaths = IOService::getAllFilePaths(nodeTemplateDirectoryPath);
+	std::vector<IOService::FileChange> l_changes;
 
-	for (auto& i : l_filePaths)
+	if (IOService::pollDirectoryChanges(m_nodeTemplateDirectoryPath.c_str(), l_changes) != WsResult::Success)
 	{
-		if (IOService::getFileExtension(i.c_str()) == ".json")
+		return WsResult::Fail;
+	}
+
+	for (auto& i : l_changes)
+	{
+		auto l_path = m_nodeTemplateDirectoryPath + i.m_RelativePath;
+
+		if (IOService::getFileExtension(l_path.c_str()) == ".h")
+		{
+			l_path = l_path.substr(0, l_path.rfind(".")) + ".json";
+
+			if (!IOService::isFileExist(l_path.c_str()))
+			{
+				continue;
+			}
+
+			i.m_Type = IOService::FileChangeType::Modified;
+		}
+
+		switch (i.m_Type)
 		{
-			LoadNewNodeDescriptor((nodeTemplateDirectoryPath + i).c_str());
+		case IOService::FileChangeType::Added:
+		case IOService::FileChangeType::Modified:
+			ReloadNodeDescriptor(l_path.c_str());
+			break;
+		case IOService::FileChangeType::Removed:
+			RemoveNodeDescriptor(l_path.c_str());
+			break;
+		default:
+			break;
 		}
 	}
 
@@ -6,6 +6,10 @@ namespace Waveless
 	namespace NodeDescriptorManager
 	{
 		WsResult LoadAllNodeDescriptors(const char* nodeTemplateDirectoryPath);
+		///
+		/// Apply the node template changes since the last call, existing descriptors are updated in place
+		///
+		WsResult ReloadChangedNodeDescriptors();
 		WsResult GetAllNodeDescriptors(std::vector<NodeDescriptor*>*& result);
 		WsResult GetPinDescriptor(int pinIndex, PinKind pinKind, PinDescriptor*& result);
 		WsResult GetNodeDescriptor(const char* nodeTemplateName, NodeDescriptor*& result);
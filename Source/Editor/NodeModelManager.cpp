@@ -3,6 +3,8 @@
 #include "../Core/Math.h"
 #include "../Core/String.h"
 #include "../Core/Vector.h"
+#include "../Core/Logger.h"
+#include "../IO/IOService.h"
 #include "../IO/JSONParser.h"
 
 using namespace Waveless;
@@ -16,6 +18,52 @@ namespace NodeModelManagerNS
 	std::vector<NodeModel*> s_Nodes;
 	std::vector<PinModel*> s_Pins;
 	std::vector<LinkModel*> s_Links;
+
+	// Flat binary canvas: header, node records, pin records, link records, vector values and a string table.
+	// Pins are stored in spawn order and links refer to them by index, so nothing is resolved by name or UUID at load time.
+	const uint32_t m_CanvasMagic = 0x56435357; // "WSCV"
+	const uint32_t m_CanvasVersion = 1;
+
+	struct CanvasHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t NodeCount;
+		uint32_t PinCount;
+		uint32_t LinkCount;
+		uint32_t VectorCount;
+		uint64_t StringTableSize;
+	};
+
+	struct CanvasNodeRecord
+	{
+		uint64_t UUID;
+		// Hash of the descriptor's pin layout, the record is stale if the node template changed since
+		uint64_t Signature;
+		uint32_t NameOffset;
+		uint16_t InputPinCount;
+		uint16_t OutputPinCount;
+		float Position[2];
+	};
+
+	// String values are string table offsets + 1 and vector values are vector indices + 1, 0 means no value
+	struct CanvasPinRecord
+	{
+		uint64_t UUID;
+		PinValue Value;
+	};
+
+	struct CanvasLinkRecord
+	{
+		uint64_t UUID;
+		uint32_t StartPinIndex;
+		uint32_t EndPinIndex;
+	};
+
+	struct CanvasVectorRecord
+	{
+		float Value[4];
+	};
 }
 
 using namespace NodeModelManagerNS;
@@ -140,21 +188,7 @@ WsResult Waveless::NodeModelManager::GetAllLinkModels(std::vector<LinkModel*>*&
 	return WsResult::Success;
 }
 
-static PinModel* FindPinByUUID(uint64_t id)
-{
-	if (!id)
-		return nullptr;
-
-	for (auto pin : s_Pins)
-	{
-		if (pin->UUID == id)
-			return pin;
-	}
-
-	return nullptr;
-}
-
-WsResult Waveless::NodeModelManager::LoadCanvas(const char * inputFileName)
+static void ClearCanvas()
 {
 	for (auto node : s_Nodes)
 	{
@@ -177,148 +211,579 @@ WsResult Waveless::NodeModelManager::LoadCanvas(const char * inputFileName)
 	s_Pins.shrink_to_fit();
 	s_Links.shrink_to_fit();
 
-	auto l_filePath = "..//..//Asset//Canvas//" + std::string(inputFileName);
+	m_StartNode = 0;
+	m_EndNode = 0;
+	m_InputDataSize = 0;
+}
+
+static void SpawnCanvasNodeModel(NodeDescriptor* nodeDesc, NodeModel*& result)
+{
+	NodeModelManager::SpawnNodeModel(nodeDesc->Name, result);
+
+	if (strstr(nodeDesc->Name, "Input"))
+	{
+		m_StartNode = result;
+	}
+	else if (strstr(nodeDesc->Name, "Output"))
+	{
+		m_EndNode = result;
+	}
+}
+
+template<typename T>
+static T GetPinValue(const json& j_pin)
+{
+	auto j_value = j_pin.find("Value");
+
+	// Some canvases store booleans as numbers and vice versa
+	if (j_value == j_pin.end())
+	{
+		return T();
+	}
+	else if (j_value->is_boolean())
+	{
+		return T(j_value->get<bool>());
+	}
+	else if (j_value->is_number())
+	{
+		return T(j_value->get<double>());
+	}
+
+	return T();
+}
+
+static void LoadPinValues(const json& j_pins, int pinIndexOffset, int pinCount, std::unordered_map<uint64_t, PinModel*>& pinMap)
+{
+	for (auto& j_pin : j_pins)
+	{
+		auto& l_pinName = j_pin["Name"].get_ref<const std::string&>();
+
+		for (int i = 0; i < pinCount; i++)
+		{
+			auto l_pin = s_Pins[pinIndexOffset + i];
+
+			if (strcmp(l_pin->Desc->Name, l_pinName.c_str()))
+			{
+				continue;
+			}
+
+			l_pin->UUID = j_pin["ID"];
+			pinMap.emplace(l_pin->UUID, l_pin);
+
+			if (l_pin->Desc->Type == PinType::String)
+			{
+				if (j_pin.find("Value") != j_pin.end())
+				{
+					auto l_string = StringManager::SpawnString(j_pin["Value"].get_ref<const std::string&>().c_str());
+					l_pin->Value = l_string.UUID;
+				}
+			}
+			else if (l_pin->Desc->Type == PinType::Bool)
+			{
+				auto value = GetPinValue<bool>(j_pin);
+				std::memcpy(&l_pin->Value, &value, sizeof(value));
+			}
+			else if (l_pin->Desc->Type == PinType::Int)
+			{
+				auto value = GetPinValue<int32_t>(j_pin);
+				std::memcpy(&l_pin->Value, &value, sizeof(value));
+			}
+			else if (l_pin->Desc->Type == PinType::Float)
+			{
+				auto value = GetPinValue<float>(j_pin);
+				std::memcpy(&l_pin->Value, &value, sizeof(value));
+			}
+			else if (l_pin->Desc->Type == PinType::Vector)
+			{
+				// Older canvases saved the unset vectors as 0
+				auto j_vector = j_pin.find("Value");
+
+				if (j_vector != j_pin.end() && j_vector->is_object())
+				{
+					auto l_vector = VectorManager::SpawnVector((*j_vector)["X"], (*j_vector)["Y"], (*j_vector)["Z"], (*j_vector)["W"]);
+					l_pin->Value = l_vector.UUID;
+				}
+			}
+
+			break;
+		}
+	}
+}
+
+static WsResult LoadCanvasFromJSON(const char* filePath)
+{
 	json j;
 
-	if (JSONParser::loadJsonDataFromDisk(l_filePath.c_str(), j) != WsResult::Success)
+	if (JSONParser::loadJsonDataFromDisk(filePath, j) != WsResult::Success)
 	{
 		return WsResult::Fail;
 	};
 
-	for (auto& j_node : j["Nodes"])
+	auto& j_nodes = j["Nodes"];
+	auto& j_links = j["Links"];
+
+	s_Nodes.reserve(j_nodes.size());
+	s_Links.reserve(j_links.size());
+
+	// Links refer to the pins by UUID
+	std::unordered_map<uint64_t, PinModel*> l_pinMap;
+
+	for (auto& j_node : j_nodes)
 	{
-		auto l_nodeName = std::string(j_node["Name"]);
-		NodeModel* l_node;
-		SpawnNodeModel(l_nodeName.c_str(), l_node);
-		l_node->UUID = j_node["ID"];
+		NodeDescriptor* l_nodeDesc;
 
-		if (strstr(l_nodeName.c_str(), "Input"))
+		if (NodeDescriptorManager::GetNodeDescriptor(j_node["Name"].get_ref<const std::string&>().c_str(), l_nodeDesc) != WsResult::Success)
 		{
-			m_StartNode = l_node;
+			return WsResult::Fail;
 		}
-		else if (strstr(l_nodeName.c_str(), "Output"))
+
+		NodeModel* l_node;
+		SpawnCanvasNodeModel(l_nodeDesc, l_node);
+		l_node->UUID = j_node["ID"];
+
+		LoadPinValues(j_node["Inputs"], l_node->InputPinIndexOffset, l_node->InputPinCount, l_pinMap);
+		LoadPinValues(j_node["Outputs"], l_node->OutputPinIndexOffset, l_node->OutputPinCount, l_pinMap);
+
+		l_node->InitialPosition[0] = j_node["Position"]["X"];
+		l_node->InitialPosition[1] = j_node["Position"]["Y"];
+	}
+
+	for (auto& j_link : j_links)
+	{
+		auto l_startPin = l_pinMap.find(j_link["StartPinID"]);
+		auto l_endPin = l_pinMap.find(j_link["EndPinID"]);
+
+		if (l_startPin == l_pinMap.end() || l_endPin == l_pinMap.end())
 		{
-			m_EndNode = l_node;
+			Logger::Log(LogLevel::Warning, "NodeModelManager: Link ", j_link["ID"].get<uint64_t>(), " refers to an unknown pin in ", filePath, ".");
+			continue;
 		}
 
-		for (auto& j_input : j_node["Inputs"])
+		LinkModel* l_link;
+		NodeModelManager::SpawnLinkModel(l_startPin->second, l_endPin->second, l_link);
+		l_link->UUID = j_link["ID"];
+	}
+
+	return WsResult::Success;
+}
+
+static WsResult SaveCanvasToJSON(const char* filePath, const std::vector<NodeModel*>& nodes, const std::vector<LinkModel*>& links)
+{
+	auto l_savePins = [](int pinIndexOffset, int pinCount, json& j_pins)
+	{
+		for (int i = 0; i < pinCount; i++)
 		{
-			for (uint64_t i = 0; i < l_node->InputPinCount; i++)
+			auto l_pin = s_Pins[pinIndexOffset + i];
+
+			json j_pin;
+			j_pin["ID"] = l_pin->UUID;
+			j_pin["Name"] = l_pin->Desc->Name;
+
+			if (l_pin->Desc->Type == PinType::String)
 			{
-				PinModel* l_pin;
-				GetPinModel(l_node->InputPinIndexOffset + (int)i, l_pin);
-				if (l_pin->Desc->Name == j_input["Name"])
+				if (l_pin->Value)
 				{
-					l_pin->UUID = j_input["ID"];
-					if (l_pin->Desc->Type == PinType::String)
-					{
-						if (j_input.find("Value") != j_input.end())
-						{
-							std::string l_stringTemp = j_input["Value"];
-							auto l_string = StringManager::SpawnString(l_stringTemp.c_str());
-							l_pin->Value = l_string.UUID;
-						}
-					}
-					else if (l_pin->Desc->Type == PinType::Bool)
-					{
-						bool value = j_input["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Int)
-					{
-						int32_t value = j_input["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Float)
-					{
-						float value = j_input["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Vector)
-					{
-						if (j_input.find("Value") != j_input.end())
-						{
-							auto l_x = j_input["Value"]["X"];
-							auto l_y = j_input["Value"]["Y"];
-							auto l_z = j_input["Value"]["Z"];
-							auto l_w = j_input["Value"]["W"];
-
-							auto l_vector = VectorManager::SpawnVector(l_x, l_y, l_z, l_w);
-							l_pin->Value = l_vector.UUID;
-						}
-					}
+					j_pin["Value"] = StringManager::FindString(l_pin->Value).value;
 				}
 			}
+			else if (l_pin->Desc->Type == PinType::Bool)
+			{
+				bool value = *reinterpret_cast<bool*>(&l_pin->Value);
+				j_pin["Value"] = value;
+			}
+			else if (l_pin->Desc->Type == PinType::Int)
+			{
+				int32_t value = *reinterpret_cast<int32_t*>(&l_pin->Value);
+				j_pin["Value"] = value;
+			}
+			else if (l_pin->Desc->Type == PinType::Float)
+			{
+				float value = *reinterpret_cast<float*>(&l_pin->Value);
+				j_pin["Value"] = value;
+			}
+			else if (l_pin->Desc->Type == PinType::Vector)
+			{
+				if (l_pin->Value)
+				{
+					auto l_vector = VectorManager::FindVector(l_pin->Value);
+					j_pin["Value"]["X"] = l_vector.value->x;
+					j_pin["Value"]["Y"] = l_vector.value->y;
+					j_pin["Value"]["Z"] = l_vector.value->z;
+					j_pin["Value"]["W"] = l_vector.value->w;
+				}
+			}
+			else
+			{
+				j_pin["Value"] = l_pin->Value;
+			}
+
+			j_pins.emplace_back(j_pin);
 		}
+	};
+
+	json j;
 
-		for (auto& j_output : j_node["Outputs"])
+	for (auto node : nodes)
+	{
+		json j_node;
+		j_node["ID"] = node->UUID;
+		j_node["Name"] = node->Desc->Name;
+		j_node["NodeType"] = node->Desc->Type;
+		j_node["Position"]["X"] = (int)node->InitialPosition[0];
+		j_node["Position"]["Y"] = (int)node->InitialPosition[1];
+
+		l_savePins(node->InputPinIndexOffset, node->InputPinCount, j_node["Inputs"]);
+		l_savePins(node->OutputPinIndexOffset, node->OutputPinCount, j_node["Outputs"]);
+
+		j["Nodes"].emplace_back(j_node);
+	}
+
+	for (auto link : links)
+	{
+		json j_link;
+		j_link["ID"] = link->UUID;
+		j_link["StartPinID"] = link->StartPin->UUID;
+		j_link["EndPinID"] = link->EndPin->UUID;
+		j["Links"].emplace_back(j_link);
+	}
+
+	// The JSON file stays pretty-printed, it's the diffable source of the canvas
+	return JSONParser::saveJsonDataToDisk(filePath, j);
+}
+
+static std::string GetCanvasCachePath(const std::string& filePath)
+{
+	return filePath.substr(0, filePath.rfind(".")) + ".wsc";
+}
+
+static uint64_t GetNodeDescriptorSignature(NodeDescriptor* nodeDesc, std::unordered_map<NodeDescriptor*, uint64_t>& signatureCache)
+{
+	auto l_result = signatureCache.find(nodeDesc);
+
+	if (l_result != signatureCache.end())
+	{
+		return l_result->second;
+	}
+
+	// FNV-1a
+	uint64_t l_hash = 14695981039346656037ull;
+
+	auto l_hashBytes = [&](const void* data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
 		{
-			for (uint64_t i = 0; i < l_node->OutputPinCount; i++)
+			l_hash ^= reinterpret_cast<const unsigned char*>(data)[i];
+			l_hash *= 1099511628211ull;
+		}
+	};
+
+	auto l_hashPins = [&](int pinIndexOffset, int pinCount, PinKind pinKind)
+	{
+		for (int i = 0; i < pinCount; i++)
+		{
+			PinDescriptor* l_pinDesc;
+			NodeDescriptorManager::GetPinDescriptor(pinIndexOffset + i, pinKind, l_pinDesc);
+			l_hashBytes(l_pinDesc->Name, strlen(l_pinDesc->Name) + 1);
+			l_hashBytes(&l_pinDesc->Type, sizeof(l_pinDesc->Type));
+		}
+	};
+
+	l_hashPins(nodeDesc->InputPinIndexOffset, nodeDesc->InputPinCount, PinKind::Input);
+	l_hashPins(nodeDesc->OutputPinIndexOffset, nodeDesc->OutputPinCount, PinKind::Output);
+
+	signatureCache.emplace(nodeDesc, l_hash);
+
+	return l_hash;
+}
+
+static WsResult SaveCanvasToBinary(const char* filePath, const std::vector<NodeModel*>& nodes, const std::vector<LinkModel*>& links)
+{
+	std::vector<CanvasNodeRecord> l_nodeRecords;
+	std::vector<CanvasPinRecord> l_pinRecords;
+	std::vector<CanvasLinkRecord> l_linkRecords;
+	std::vector<CanvasVectorRecord> l_vectorRecords;
+	std::vector<char> l_stringTable;
+
+	l_nodeRecords.reserve(nodes.size());
+	l_linkRecords.reserve(links.size());
+
+	std::unordered_map<NodeDescriptor*, uint64_t> l_signatureCache;
+	std::unordered_map<const PinModel*, uint32_t> l_pinIndices;
+	std::unordered_map<const char*, uint32_t> l_nameOffsets;
+
+	auto l_addString = [&](const char* value)
+	{
+		auto l_offset = (uint32_t)l_stringTable.size();
+		l_stringTable.insert(l_stringTable.end(), value, value + strlen(value) + 1);
+		return l_offset;
+	};
+
+	auto l_savePins = [&](int pinIndexOffset, int pinCount)
+	{
+		for (int i = 0; i < pinCount; i++)
+		{
+			auto l_pin = s_Pins[pinIndexOffset + i];
+
+			CanvasPinRecord l_pinRecord;
+			l_pinRecord.UUID = l_pin->UUID;
+			l_pinRecord.Value = l_pin->Value;
+
+			if (l_pin->Desc->Type == PinType::String && l_pin->Value)
 			{
-				PinModel* l_pin;
-				GetPinModel(l_node->OutputPinIndexOffset + (int)i, l_pin);
-				if (l_pin->Desc->Name == j_output["Name"])
+				l_pinRecord.Value = l_addString(StringManager::FindString(l_pin->Value).value) + 1;
+			}
+			else if (l_pin->Desc->Type == PinType::Vector && l_pin->Value)
+			{
+				auto l_vector = VectorManager::FindVector(l_pin->Value);
+				l_vectorRecords.push_back({ { l_vector.value->x, l_vector.value->y, l_vector.value->z, l_vector.value->w } });
+				l_pinRecord.Value = l_vectorRecords.size();
+			}
+
+			l_pinIndices.emplace(l_pin, (uint32_t)l_pinRecords.size());
+			l_pinRecords.emplace_back(l_pinRecord);
+		}
+	};
+
+	for (auto node : nodes)
+	{
+		// Node names are interned by the descriptors, store each of them once
+		auto l_nameOffset = l_nameOffsets.find(node->Desc->Name);
+
+		if (l_nameOffset == l_nameOffsets.end())
+		{
+			l_nameOffset = l_nameOffsets.emplace(node->Desc->Name, l_addString(node->Desc->Name)).first;
+		}
+
+		CanvasNodeRecord l_nodeRecord;
+		l_nodeRecord.UUID = node->UUID;
+		l_nodeRecord.Signature = GetNodeDescriptorSignature(node->Desc, l_signatureCache);
+		l_nodeRecord.NameOffset = l_nameOffset->second;
+		l_nodeRecord.InputPinCount = (uint16_t)node->InputPinCount;
+		l_nodeRecord.OutputPinCount = (uint16_t)node->OutputPinCount;
+		l_nodeRecord.Position[0] = node->InitialPosition[0];
+		l_nodeRecord.Position[1] = node->InitialPosition[1];
+
+		l_nodeRecords.emplace_back(l_nodeRecord);
+
+		l_savePins(node->InputPinIndexOffset, node->InputPinCount);
+		l_savePins(node->OutputPinIndexOffset, node->OutputPinCount);
+	}
+
+	for (auto link : links)
+	{
+		auto l_startPin = l_pinIndices.find(link->StartPin);
+		auto l_endPin = l_pinIndices.find(link->EndPin);
+
+		if (l_startPin == l_pinIndices.end() || l_endPin == l_pinIndices.end())
+		{
+			continue;
+		}
+
+		l_linkRecords.push_back({ link->UUID, l_startPin->second, l_endPin->second });
+	}
+
+	CanvasHeader l_header;
+	l_header.Magic = m_CanvasMagic;
+	l_header.Version = m_CanvasVersion;
+	l_header.NodeCount = (uint32_t)l_nodeRecords.size();
+	l_header.PinCount = (uint32_t)l_pinRecords.size();
+	l_header.LinkCount = (uint32_t)l_linkRecords.size();
+	l_header.VectorCount = (uint32_t)l_vectorRecords.size();
+	l_header.StringTableSize = l_stringTable.size();
+
+	std::vector<char> l_content;
+	l_content.reserve(sizeof(l_header)
+		+ l_nodeRecords.size() * sizeof(CanvasNodeRecord)
+		+ l_pinRecords.size() * sizeof(CanvasPinRecord)
+		+ l_linkRecords.size() * sizeof(CanvasLinkRecord)
+		+ l_vectorRecords.size() * sizeof(CanvasVectorRecord)
+		+ l_stringTable.size());
+
+	auto l_append = [&](const void* data, size_t size)
+	{
+		l_content.insert(l_content.end(), (const char*)data, (const char*)data + size);
+	};
+
+	l_append(&l_header, sizeof(l_header));
+	l_append(l_nodeRecords.data(), l_nodeRecords.size() * sizeof(CanvasNodeRecord));
+	l_append(l_pinRecords.data(), l_pinRecords.size() * sizeof(CanvasPinRecord));
+	l_append(l_linkRecords.data(), l_linkRecords.size() * sizeof(CanvasLinkRecord));
+	l_append(l_vectorRecords.data(), l_vectorRecords.size() * sizeof(CanvasVectorRecord));
+	l_append(l_stringTable.data(), l_stringTable.size());
+
+	return IOService::saveFile(filePath, l_content, IOService::IOMode::Binary);
+}
+
+static WsResult LoadCanvasFromBinary(const char* filePath)
+{
+	IOService::FileView l_file;
+
+	if (IOService::mapFile(filePath, l_file) != WsResult::Success)
+	{
+		return WsResult::FileNotFound;
+	}
+
+	if (l_file.size() < sizeof(CanvasHeader))
+	{
+		return WsResult::Fail;
+	}
+
+	auto l_header = reinterpret_cast<const CanvasHeader*>(l_file.data());
+
+	if (l_header->Magic != m_CanvasMagic || l_header->Version != m_CanvasVersion)
+	{
+		return WsResult::Fail;
+	}
+
+	auto l_nodeRecords = reinterpret_cast<const CanvasNodeRecord*>(l_header + 1);
+	auto l_pinRecords = reinterpret_cast<const CanvasPinRecord*>(l_nodeRecords + l_header->NodeCount);
+	auto l_linkRecords = reinterpret_cast<const CanvasLinkRecord*>(l_pinRecords + l_header->PinCount);
+	auto l_vectorRecords = reinterpret_cast<const CanvasVectorRecord*>(l_linkRecords + l_header->LinkCount);
+	auto l_stringTable = reinterpret_cast<const char*>(l_vectorRecords + l_header->VectorCount);
+
+	auto l_expectedSize = sizeof(CanvasHeader)
+		+ (uint64_t)l_header->NodeCount * sizeof(CanvasNodeRecord)
+		+ (uint64_t)l_header->PinCount * sizeof(CanvasPinRecord)
+		+ (uint64_t)l_header->LinkCount * sizeof(CanvasLinkRecord)
+		+ (uint64_t)l_header->VectorCount * sizeof(CanvasVectorRecord)
+		+ l_header->StringTableSize;
+
+	if (l_expectedSize != l_file.size() || (l_header->StringTableSize && l_stringTable[l_header->StringTableSize - 1]))
+	{
+		return WsResult::Fail;
+	}
+
+	s_Nodes.reserve(l_header->NodeCount);
+	s_Pins.reserve(l_header->PinCount);
+	s_Links.reserve(l_header->LinkCount);
+
+	std::unordered_map<NodeDescriptor*, uint64_t> l_signatureCache;
+	uint32_t l_pinIndex = 0;
+
+	for (uint32_t i = 0; i < l_header->NodeCount; i++)
+	{
+		auto& l_nodeRecord = l_nodeRecords[i];
+
+		if (l_nodeRecord.NameOffset >= l_header->StringTableSize)
+		{
+			return WsResult::Fail;
+		}
+
+		NodeDescriptor* l_nodeDesc;
+
+		if (NodeDescriptorManager::GetNodeDescriptor(l_stringTable + l_nodeRecord.NameOffset, l_nodeDesc) != WsResult::Success
+			|| GetNodeDescriptorSignature(l_nodeDesc, l_signatureCache) != l_nodeRecord.Signature
+			|| l_nodeRecord.InputPinCount != l_nodeDesc->InputPinCount
+			|| l_nodeRecord.OutputPinCount != l_nodeDesc->OutputPinCount
+			|| l_pinIndex + l_nodeRecord.InputPinCount + l_nodeRecord.OutputPinCount > l_header->PinCount)
+		{
+			return WsResult::Fail;
+		}
+
+		NodeModel* l_node;
+		SpawnCanvasNodeModel(l_nodeDesc, l_node);
+		l_node->UUID = l_nodeRecord.UUID;
+		l_node->InitialPosition[0] = l_nodeRecord.Position[0];
+		l_node->InitialPosition[1] = l_nodeRecord.Position[1];
+
+		// The input pins are followed by the output pins, the same order as the records
+		for (size_t j = s_Pins.size() - l_node->InputPinCount - l_node->OutputPinCount; j < s_Pins.size(); j++)
+		{
+			auto& l_pinRecord = l_pinRecords[l_pinIndex++];
+			auto l_pin = s_Pins[j];
+
+			l_pin->UUID = l_pinRecord.UUID;
+
+			switch (l_pin->Desc->Type)
+			{
+			case PinType::Bool:
+			case PinType::Int:
+			case PinType::Float:
+				l_pin->Value = l_pinRecord.Value;
+				break;
+			case PinType::String:
+				if (l_pinRecord.Value && l_pinRecord.Value <= l_header->StringTableSize)
+				{
+					l_pin->Value = StringManager::SpawnString(l_stringTable + l_pinRecord.Value - 1).UUID;
+				}
+				break;
+			case PinType::Vector:
+				if (l_pinRecord.Value && l_pinRecord.Value <= l_header->VectorCount)
 				{
-					l_pin->UUID = j_output["ID"];
-					if (l_pin->Desc->Type == PinType::String)
-					{
-						if (j_output.find("Value") != j_output.end())
-						{
-							std::string l_stringTemp = j_output["Value"];
-							auto l_string = StringManager::SpawnString(l_stringTemp.c_str());
-							l_pin->Value = l_string.UUID;
-						}
-					}
-					else if (l_pin->Desc->Type == PinType::Bool)
-					{
-						bool value = j_output["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Int)
-					{
-						int32_t value = j_output["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Float)
-					{
-						float value = j_output["Value"];
-						std::memcpy(&l_pin->Value, &value, sizeof(value));
-					}
-					else if (l_pin->Desc->Type == PinType::Vector)
-					{
-						if (j_output.find("Value") != j_output.end())
-						{
-							auto l_x = j_output["Value"]["X"];
-							auto l_y = j_output["Value"]["Y"];
-							auto l_z = j_output["Value"]["Z"];
-							auto l_w = j_output["Value"]["W"];
-
-							auto l_vector = VectorManager::SpawnVector(l_x, l_y, l_z, l_w);
-							l_pin->Value = l_vector.UUID;
-						}
-					}
+					auto& l_vector = l_vectorRecords[l_pinRecord.Value - 1].Value;
+					l_pin->Value = VectorManager::SpawnVector(l_vector[0], l_vector[1], l_vector[2], l_vector[3]).UUID;
 				}
+				break;
+			default:
+				break;
 			}
 		}
-
-		l_node->InitialPosition[0] = j_node["Position"]["X"];
-		l_node->InitialPosition[1] = j_node["Position"]["Y"];
 	}
 
-	for (auto& j_link : j["Links"])
+	for (uint32_t i = 0; i < l_header->LinkCount; i++)
 	{
-		auto l_startPin = FindPinByUUID(j_link["StartPinID"]);
-		auto l_endPin = FindPinByUUID(j_link["EndPinID"]);
+		auto& l_linkRecord = l_linkRecords[i];
+
+		if (l_linkRecord.StartPinIndex >= s_Pins.size() || l_linkRecord.EndPinIndex >= s_Pins.size())
+		{
+			return WsResult::Fail;
+		}
 
 		LinkModel* l_link;
-		SpawnLinkModel(l_startPin, l_endPin, l_link);
-		l_link->UUID = j_link["ID"];
+		NodeModelManager::SpawnLinkModel(s_Pins[l_linkRecord.StartPinIndex], s_Pins[l_linkRecord.EndPinIndex], l_link);
+		l_link->UUID = l_linkRecord.UUID;
+	}
+
+	return WsResult::Success;
+}
+
+WsResult Waveless::NodeModelManager::LoadCanvas(const char * inputFileName)
+{
+	ClearCanvas();
+
+	auto l_filePath = "..//..//Asset//Canvas//" + std::string(inputFileName);
+	auto l_cachePath = GetCanvasCachePath(l_filePath);
+
+	auto l_fileTime = IOService::getLastWriteTime(l_filePath.c_str());
+	auto l_cacheTime = IOService::getLastWriteTime(l_cachePath.c_str());
+
+	bool l_loaded = false;
+
+	// The binary cache is only trusted if it's not older than the JSON source
+	if (l_cacheTime && l_cacheTime >= l_fileTime)
+	{
+		if (LoadCanvasFromBinary(l_cachePath.c_str()) == WsResult::Success)
+		{
+			Logger::Log(LogLevel::Verbose, "NodeModelManager: Canvas cache ", l_cachePath.c_str(), " has been loaded.");
+			l_loaded = true;
+		}
+		else
+		{
+			Logger::Log(LogLevel::Warning, "NodeModelManager: Canvas cache ", l_cachePath.c_str(), " is outdated, fall back to JSON.");
+			ClearCanvas();
+		}
+	}
+
+	if (!l_loaded)
+	{
+		if (LoadCanvasFromJSON(l_filePath.c_str()) != WsResult::Success)
+		{
+			ClearCanvas();
+			return WsResult::Fail;
+		}
+
+		SaveCanvasToBinary(l_cachePath.c_str(), s_Nodes, s_Links);
+	}
+
+	if (!m_StartNode)
+	{
+		Logger::Log(LogLevel::Error, "NodeModelManager: Canvas ", inputFileName, " doesn't have an input node!");
+		return WsResult::Fail;
 	}
 
 	for (int i = 0; i < m_StartNode->OutputPinCount; i++)
 	{
-		PinDescriptor* l_pinDesc;
-		NodeDescriptorManager::GetPinDescriptor(m_StartNode->OutputPinIndexOffset + i, PinKind::Input, l_pinDesc);
+		auto l_pinDesc = s_Pins[m_StartNode->OutputPinIndexOffset + i]->Desc;
 
 		switch (l_pinDesc->Type)
 		{
@@ -354,6 +819,18 @@ WsResult Waveless::NodeModelManager::LoadCanvas(const char * inputFileName)
 	return WsResult::Success;
 }
 
+WsResult Waveless::NodeModelManager::SaveCanvas(const char * outputFileName, const std::vector<NodeModel*>& nodes, const std::vector<LinkModel*>& links)
+{
+	auto l_filePath = "..//..//Asset//Canvas//" + std::string(outputFileName);
+
+	if (SaveCanvasToJSON(l_filePath.c_str(), nodes, links) != WsResult::Success)
+	{
+		return WsResult::Fail;
+	}
+
+	return SaveCanvasToBinary(GetCanvasCachePath(l_filePath).c_str(), nodes, links);
+}
+
 WsResult Waveless::NodeModelManager::GetInputDataSize(uint64_t & size)
 {
 	size = m_InputDataSize;
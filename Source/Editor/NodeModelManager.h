@@ -53,7 +53,14 @@ namespace Waveless
 		WsResult GetAllNodeModels(std::vector<NodeModel*>*& result);
 		WsResult GetAllLinkModels(std::vector<LinkModel*>*& result);
 
+		///
+		/// Load a canvas from its binary cache if it's up to date, otherwise from the JSON file and then refresh the cache
+		///
 		WsResult LoadCanvas(const char * inputFileName);
+		///
+		/// Save the canvas as JSON and as the binary cache, the pins of the nodes must be owned by NodeModelManager
+		///
+		WsResult SaveCanvas(const char * outputFileName, const std::vector<NodeModel*>& nodes, const std::vector<LinkModel*>& links);
 		WsResult GetInputDataSize(uint64_t& size);
 	};
 }
\ No newline at end of file
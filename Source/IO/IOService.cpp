@@ -1,17 +1,973 @@
 #include "IOService.h"
 #include "../Core/Logger.h"
-
-#ifdef __GNUC__
-#include <experimental/filesystem>
-namespace fs = std::experimental::filesystem;
-#else
+#include "../Core/Config.h"
+#include "../Core/TaskScheduler.h"
+#include <chrono>
 #include <filesystem>
+#include <mutex>
+#include <unordered_set>
+
 namespace fs = std::filesystem;
+
+#if defined WS_OS_WIN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined WS_OS_LINUX
+#include <sys/inotify.h>
 #endif
 
 namespace Waveless::IOService
 {
 	std::string m_workingDir;
+
+	// Files smaller than this are read into a pooled buffer, mapping them costs more than the copy
+	const size_t m_MinMappedFileSize = 64 * 1024;
+
+	// Without a file system watcher the directory is walked again at most this often, the changes in between are reported by the next walk
+	const std::chrono::milliseconds m_RescanInterval(1000);
+
+	struct ResolvedPath
+	{
+		std::string m_RelativePath;
+		std::string m_FullPath;
+	};
+
+	// The entries are never replaced nor erased and the nodes don't move, so a resolved path could be referenced without the lock
+	std::unordered_multimap<uint64_t, ResolvedPath> m_resolvedPaths;
+	std::mutex m_resolvedPathsMutex;
+
+	std::vector<std::unique_ptr<std::vector<char>>> m_bufferPool;
+	std::mutex m_bufferPoolMutex;
+
+	uint64_t HashPath(const char* filePath)
+	{
+		// FNV-1a
+		uint64_t l_hash = 14695981039346656037ull;
+		while (*filePath)
+		{
+			l_hash ^= (unsigned char)*filePath++;
+			l_hash *= 1099511628211ull;
+		}
+		return l_hash;
+	}
+
+	std::vector<char>* AcquireBuffer()
+	{
+		std::unique_lock<std::mutex> l_lock(m_bufferPoolMutex);
+
+		if (m_bufferPool.empty())
+		{
+			return new std::vector<char>();
+		}
+
+		auto l_result = m_bufferPool.back().release();
+		m_bufferPool.pop_back();
+
+		return l_result;
+	}
+
+	void ReleaseBuffer(std::vector<char>* buffer)
+	{
+		std::unique_lock<std::mutex> l_lock(m_bufferPoolMutex);
+		m_bufferPool.emplace_back(buffer);
+	}
+
+	bool MapFileContent(const std::string& fullPath, const char*& data, size_t& size, void*& mappedAddress)
+	{
+#if defined WS_OS_WIN
+		auto l_file = CreateFileA(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (l_file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER l_fileSize;
+		GetFileSizeEx(l_file, &l_fileSize);
+		size = (size_t)l_fileSize.QuadPart;
+
+		if (!size)
+		{
+			CloseHandle(l_file);
+			return true;
+		}
+
+		// The view keeps the mapping object alive, both handles could be closed right away
+		auto l_mapping = CreateFileMappingA(l_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(l_file);
+
+		if (!l_mapping)
+		{
+			return false;
+		}
+
+		mappedAddress = MapViewOfFile(l_mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(l_mapping);
+#else
+		auto l_file = open(fullPath.c_str(), O_RDONLY);
+		if (l_file < 0)
+		{
+			return false;
+		}
+
+		struct stat l_stat;
+		fstat(l_file, &l_stat);
+		size = (size_t)l_stat.st_size;
+
+		if (!size)
+		{
+			close(l_file);
+			return true;
+		}
+
+		mappedAddress = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, l_file, 0);
+		close(l_file);
+
+		if (mappedAddress == MAP_FAILED)
+		{
+			mappedAddress = nullptr;
+		}
+#endif
+		data = reinterpret_cast<const char*>(mappedAddress);
+
+		return mappedAddress != nullptr;
+	}
+
+	void UnmapFileContent(void* mappedAddress, size_t size)
+	{
+#if defined WS_OS_WIN
+		UnmapViewOfFile(mappedAddress);
+#else
+		munmap(mappedAddress, size);
+#endif
+	}
+
+	// Without constructing a fs::path, which would copy the path
+	bool IsPathExist(const std::string& fullPath)
+	{
+#if defined WS_OS_WIN
+		return GetFileAttributesA(fullPath.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+		struct stat l_stat;
+		return stat(fullPath.c_str(), &l_stat) == 0;
+#endif
+	}
+}
+
+namespace Waveless::IOService
+{
+	struct DirectoryIndex
+	{
+		DirectoryIndex() = default;
+		DirectoryIndex(const DirectoryIndex&) = delete;
+		DirectoryIndex& operator=(const DirectoryIndex&) = delete;
+
+		// The watcher lives as long as the index, including the ones still alive at shutdown
+		~DirectoryIndex()
+		{
+#if defined WS_OS_LINUX
+			if (m_Watcher >= 0)
+			{
+				close(m_Watcher);
+			}
+#elif defined WS_OS_WIN
+			if (m_Directory != INVALID_HANDLE_VALUE)
+			{
+				// The pending read writes into m_NotifyBuffer until it's cancelled
+				DWORD l_length = 0;
+				CancelIo(m_Directory);
+				GetOverlappedResult(m_Directory, &m_Overlapped, &l_length, TRUE);
+				CloseHandle(m_Directory);
+			}
+			if (m_Overlapped.hEvent)
+			{
+				CloseHandle(m_Overlapped.hEvent);
+			}
+#endif
+		}
+
+		std::string m_FullPath; // With trailing '/'
+		std::vector<std::string> m_Extensions;
+		std::vector<std::string> m_FilePaths;
+		// Ordered so the files under a directory are a contiguous range
+		std::map<std::string, size_t> m_FilePathIndices;
+		std::vector<FileChange> m_PendingChanges;
+		// The paths of the pending additions and modifications
+		std::unordered_set<std::string> m_PendingChangedPaths;
+
+#if defined WS_OS_LINUX
+		int m_Watcher = -1;
+		std::unordered_map<int, std::string> m_WatchedDirectories; // Watch descriptor to relative directory path with trailing '/'
+#elif defined WS_OS_WIN
+		HANDLE m_Directory = INVALID_HANDLE_VALUE;
+		OVERLAPPED m_Overlapped = {};
+		std::vector<DWORD> m_NotifyBuffer = std::vector<DWORD>(16 * 1024);
+#else
+		std::unordered_map<std::string, fs::file_time_type> m_LastWriteTimes;
+		std::chrono::steady_clock::time_point m_LastScanTime;
+#endif
+	};
+
+	std::unordered_map<std::string, std::unique_ptr<DirectoryIndex>> m_directoryIndices;
+	std::mutex m_directoryIndicesMutex;
+
+	bool MatchExtension(const DirectoryIndex& index, const std::string& filePath)
+	{
+		if (index.m_Extensions.empty())
+		{
+			return true;
+		}
+
+		for (auto& i : index.m_Extensions)
+		{
+			if (filePath.size() >= i.size() && !filePath.compare(filePath.size() - i.size(), i.size(), i))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool AddIndexedFile(DirectoryIndex& index, const std::string& relativePath)
+	{
+		if (!MatchExtension(index, relativePath) || index.m_FilePathIndices.count(relativePath))
+		{
+			return false;
+		}
+
+		index.m_FilePathIndices.emplace(relativePath, index.m_FilePaths.size());
+		index.m_FilePaths.emplace_back(relativePath);
+
+		return true;
+	}
+
+	bool RemoveIndexedFile(DirectoryIndex& index, const std::string& relativePath)
+	{
+		auto l_result = index.m_FilePathIndices.find(relativePath);
+
+		if (l_result == index.m_FilePathIndices.end())
+		{
+			return false;
+		}
+
+		// Swap with the last one to keep the removal O(1)
+		auto l_position = l_result->second;
+		index.m_FilePathIndices.erase(l_result);
+
+		if (l_position != index.m_FilePaths.size() - 1)
+		{
+			index.m_FilePaths[l_position] = std::move(index.m_FilePaths.back());
+			index.m_FilePathIndices[index.m_FilePaths[l_position]] = l_position;
+		}
+
+		index.m_FilePaths.pop_back();
+
+		return true;
+	}
+
+	void AddChange(DirectoryIndex& index, FileChangeType type, const std::string& relativePath)
+	{
+		// A new file is usually created and then written, report it once
+		if (type == FileChangeType::Removed)
+		{
+			index.m_PendingChangedPaths.erase(relativePath);
+		}
+		else if (!index.m_PendingChangedPaths.emplace(relativePath).second && type == FileChangeType::Modified)
+		{
+			return;
+		}
+
+		FileChange l_change;
+		l_change.m_Type = type;
+		l_change.m_RelativePath = relativePath;
+		index.m_PendingChanges.emplace_back(std::move(l_change));
+	}
+
+	void RemoveIndexedDirectory(DirectoryIndex& index, const std::string& relativeDirectoryPath)
+	{
+		std::vector<std::string> l_removedFilePaths;
+
+		for (auto it = index.m_FilePathIndices.lower_bound(relativeDirectoryPath); it != index.m_FilePathIndices.end() && !it->first.compare(0, relativeDirectoryPath.size(), relativeDirectoryPath); it++)
+		{
+			l_removedFilePaths.emplace_back(it->first);
+		}
+
+		for (auto& i : l_removedFilePaths)
+		{
+			RemoveIndexedFile(index, i);
+			AddChange(index, FileChangeType::Removed, i);
+		}
+
+#if defined WS_OS_LINUX
+		// A moved away directory keeps its watches, they would report with stale paths
+		for (auto it = index.m_WatchedDirectories.begin(); it != index.m_WatchedDirectories.end();)
+		{
+			if (!it->second.compare(0, relativeDirectoryPath.size(), relativeDirectoryPath))
+			{
+				inotify_rm_watch(index.m_Watcher, it->first);
+				it = index.m_WatchedDirectories.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+#endif
+	}
+
+	// A watch descriptor and the relative directory path with trailing '/' it reports for
+	using Watch = std::pair<int, std::string>;
+
+	///
+	/// Start watching a directory, it could be called from the walking jobs, the caller records the watch.
+	/// Returns -1 if the platform has no per directory watches or the watch couldn't be added.
+	///
+	int AddWatch(const DirectoryIndex& index, const std::string& relativeDirectoryPath)
+	{
+#if defined WS_OS_LINUX
+		return inotify_add_watch(index.m_Watcher, (index.m_FullPath + relativeDirectoryPath).c_str(), IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF);
+#else
+		(void)index;
+		(void)relativeDirectoryPath;
+		return -1;
+#endif
+	}
+
+	void WatchDirectory(DirectoryIndex& index, const std::string& relativeDirectoryPath)
+	{
+#if defined WS_OS_LINUX
+		auto l_watch = AddWatch(index, relativeDirectoryPath);
+
+		if (l_watch >= 0)
+		{
+			index.m_WatchedDirectories[l_watch] = relativeDirectoryPath;
+		}
+#else
+		(void)index;
+		(void)relativeDirectoryPath;
+#endif
+	}
+
+	///
+	/// Recursively collect the matching files under a relative directory path.
+	/// Every subdirectory is watched before it's walked, so a file created during the walk is either found or reported by the watcher.
+	///
+	void WalkDirectory(const DirectoryIndex& index, const std::string& relativeDirectoryPath, std::vector<std::string>& filePaths, std::vector<Watch>& watches)
+	{
+		std::error_code l_errorCode;
+
+		for (auto& p : fs::directory_iterator(index.m_FullPath + relativeDirectoryPath, l_errorCode))
+		{
+			auto l_relativePath = relativeDirectoryPath + p.path().filename().generic_string();
+
+			if (p.is_directory(l_errorCode))
+			{
+				l_relativePath += "/";
+
+				auto l_watch = AddWatch(index, l_relativePath);
+
+				if (l_watch >= 0)
+				{
+					watches.emplace_back(l_watch, l_relativePath);
+				}
+
+				WalkDirectory(index, l_relativePath, filePaths, watches);
+			}
+			else if (MatchExtension(index, l_relativePath))
+			{
+				filePaths.emplace_back(std::move(l_relativePath));
+			}
+		}
+	}
+
+	///
+	/// Index a subdirectory which appeared after the initial walk.
+	///
+	void AddIndexedDirectory(DirectoryIndex& index, const std::string& relativeDirectoryPath)
+	{
+		std::vector<std::string> l_filePaths;
+		std::vector<Watch> l_watches;
+
+		WatchDirectory(index, relativeDirectoryPath);
+		WalkDirectory(index, relativeDirectoryPath, l_filePaths, l_watches);
+
+#if defined WS_OS_LINUX
+		for (auto& i : l_watches)
+		{
+			index.m_WatchedDirectories[i.first] = std::move(i.second);
+		}
+#endif
+
+		for (auto& i : l_filePaths)
+		{
+			if (AddIndexedFile(index, i))
+			{
+				AddChange(index, FileChangeType::Added, i);
+			}
+		}
+	}
+
+	void BuildIndex(DirectoryIndex& index)
+	{
+		index.m_FilePaths.clear();
+		index.m_FilePathIndices.clear();
+
+		// The watcher starts before the walk, the files created while walking are then reported instead of missed
+#if defined WS_OS_LINUX
+		if (index.m_Watcher >= 0)
+		{
+			close(index.m_Watcher);
+		}
+
+		index.m_WatchedDirectories.clear();
+		index.m_Watcher = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+		if (index.m_Watcher < 0)
+		{
+			Logger::Log(LogLevel::Warning, "IOService: Can't create inotify watcher for ", index.m_FullPath.c_str(), ", changes will not be tracked.");
+		}
+		else
+		{
+			WatchDirectory(index, "");
+		}
+#elif defined WS_OS_WIN
+		if (index.m_Directory == INVALID_HANDLE_VALUE)
+		{
+			index.m_Directory = CreateFileA(index.m_FullPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+			index.m_Overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+		}
+		else
+		{
+			CancelIo(index.m_Directory);
+		}
+
+		if (index.m_Directory == INVALID_HANDLE_VALUE)
+		{
+			Logger::Log(LogLevel::Warning, "IOService: Can't watch ", index.m_FullPath.c_str(), ", changes will not be tracked.");
+		}
+		else
+		{
+			ResetEvent(index.m_Overlapped.hEvent);
+			ReadDirectoryChangesW(index.m_Directory, index.m_NotifyBuffer.data(), (DWORD)(index.m_NotifyBuffer.size() * sizeof(DWORD)), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &index.m_Overlapped, NULL);
+		}
+#endif
+
+		std::vector<std::string> l_topDirectoryPaths;
+		std::error_code l_errorCode;
+
+		for (auto& p : fs::directory_iterator(index.m_FullPath, l_errorCode))
+		{
+			auto l_relativePath = p.path().filename().generic_string();
+
+			if (p.is_directory(l_errorCode))
+			{
+				l_topDirectoryPaths.emplace_back(l_relativePath + "/");
+			}
+			else
+			{
+				AddIndexedFile(index, l_relativePath);
+			}
+		}
+
+		// Each top level subdirectory is walked as an independent job
+		std::vector<std::vector<std::string>> l_filePaths(TaskScheduler::GetThreadCount());
+		std::vector<std::vector<Watch>> l_watches(TaskScheduler::GetThreadCount());
+
+		TaskScheduler::ParallelFor(l_topDirectoryPaths.size(), [&](size_t begin, size_t end, size_t chunkIndex)
+		{
+			for (auto i = begin; i < end; i++)
+			{
+				auto l_watch = AddWatch(index, l_topDirectoryPaths[i]);
+
+				if (l_watch >= 0)
+				{
+					l_watches[chunkIndex].emplace_back(l_watch, l_topDirectoryPaths[i]);
+				}
+
+				WalkDirectory(index, l_topDirectoryPaths[i], l_filePaths[chunkIndex], l_watches[chunkIndex]);
+			}
+		});
+
+		for (auto& i : l_filePaths)
+		{
+			for (auto& j : i)
+			{
+				AddIndexedFile(index, j);
+			}
+		}
+
+#if defined WS_OS_LINUX
+		// The events of the walk are queued on the watcher until the next poll, the watches are known by then
+		for (auto& i : l_watches)
+		{
+			for (auto& j : i)
+			{
+				index.m_WatchedDirectories[j.first] = std::move(j.second);
+			}
+		}
+#elif !defined WS_OS_WIN
+		index.m_LastWriteTimes.clear();
+		index.m_LastScanTime = std::chrono::steady_clock::now();
+
+		for (auto& i : index.m_FilePaths)
+		{
+			index.m_LastWriteTimes[i] = fs::last_write_time(index.m_FullPath + i, l_errorCode);
+		}
+#endif
+	}
+
+	///
+	/// Rebuild the whole index when the watcher lost events, and report the difference.
+	///
+	void RebuildIndex(DirectoryIndex& index)
+	{
+		auto l_oldFilePaths = std::move(index.m_FilePaths);
+		index.m_FilePaths.clear();
+
+		BuildIndex(index);
+
+		std::unordered_set<std::string> l_oldFilePathSet(l_oldFilePaths.begin(), l_oldFilePaths.end());
+
+		for (auto& i : index.m_FilePaths)
+		{
+			AddChange(index, l_oldFilePathSet.erase(i) ? FileChangeType::Modified : FileChangeType::Added, i);
+		}
+
+		for (auto& i : l_oldFilePathSet)
+		{
+			AddChange(index, FileChangeType::Removed, i);
+		}
+	}
+
+	void ProcessWatcherEvents(DirectoryIndex& index)
+	{
+#if defined WS_OS_LINUX
+		if (index.m_Watcher < 0)
+		{
+			return;
+		}
+
+		alignas(inotify_event) char l_buffer[16 * 1024];
+		ssize_t l_length;
+
+		while ((l_length = read(index.m_Watcher, l_buffer, sizeof(l_buffer))) > 0)
+		{
+			for (char* l_ptr = l_buffer; l_ptr < l_buffer + l_length;)
+			{
+				auto l_event = reinterpret_cast<inotify_event*>(l_ptr);
+				l_ptr += sizeof(inotify_event) + l_event->len;
+
+				if (l_event->mask & IN_Q_OVERFLOW)
+				{
+					RebuildIndex(index);
+					return;
+				}
+
+				auto l_watchedDirectory = index.m_WatchedDirectories.find(l_event->wd);
+
+				if (l_watchedDirectory == index.m_WatchedDirectories.end())
+				{
+					continue;
+				}
+
+				if (l_event->mask & IN_IGNORED)
+				{
+					index.m_WatchedDirectories.erase(l_watchedDirectory);
+					continue;
+				}
+
+				if (!l_event->len)
+				{
+					continue;
+				}
+
+				auto l_relativePath = l_watchedDirectory->second + l_event->name;
+
+				if (l_event->mask & IN_ISDIR)
+				{
+					if (l_event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						AddIndexedDirectory(index, l_relativePath + "/");
+					}
+					else if (l_event->mask & (IN_DELETE | IN_MOVED_FROM))
+					{
+						RemoveIndexedDirectory(index, l_relativePath + "/");
+					}
+				}
+				else if (l_event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					if (AddIndexedFile(index, l_relativePath))
+					{
+						AddChange(index, FileChangeType::Added, l_relativePath);
+					}
+				}
+				else if (l_event->mask & IN_CLOSE_WRITE)
+				{
+					if (AddIndexedFile(index, l_relativePath))
+					{
+						AddChange(index, FileChangeType::Added, l_relativePath);
+					}
+					else if (MatchExtension(index, l_relativePath))
+					{
+						AddChange(index, FileChangeType::Modified, l_relativePath);
+					}
+				}
+				else if (l_event->mask & (IN_DELETE | IN_MOVED_FROM))
+				{
+					if (RemoveIndexedFile(index, l_relativePath))
+					{
+						AddChange(index, FileChangeType::Removed, l_relativePath);
+					}
+				}
+			}
+		}
+#elif defined WS_OS_WIN
+		if (index.m_Directory == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+
+		DWORD l_length = 0;
+
+		if (!GetOverlappedResult(index.m_Directory, &index.m_Overlapped, &l_length, FALSE))
+		{
+			return;
+		}
+
+		if (!l_length)
+		{
+			// The notify buffer overflowed
+			RebuildIndex(index);
+			return;
+		}
+
+		auto l_ptr = reinterpret_cast<const char*>(index.m_NotifyBuffer.data());
+
+		while (true)
+		{
+			auto l_info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(l_ptr);
+
+			auto l_nameLength = WideCharToMultiByte(CP_UTF8, 0, l_info->FileName, l_info->FileNameLength / sizeof(WCHAR), NULL, 0, NULL, NULL);
+			std::string l_relativePath(l_nameLength, '\0');
+			WideCharToMultiByte(CP_UTF8, 0, l_info->FileName, l_info->FileNameLength / sizeof(WCHAR), &l_relativePath[0], l_nameLength, NULL, NULL);
+			std::replace(l_relativePath.begin(), l_relativePath.end(), '\\', '/');
+
+			switch (l_info->Action)
+			{
+			case FILE_ACTION_ADDED:
+			case FILE_ACTION_RENAMED_NEW_NAME:
+				if (fs::is_directory(index.m_FullPath + l_relativePath))
+				{
+					AddIndexedDirectory(index, l_relativePath + "/");
+				}
+				else if (AddIndexedFile(index, l_relativePath))
+				{
+					AddChange(index, FileChangeType::Added, l_relativePath);
+				}
+				break;
+			case FILE_ACTION_REMOVED:
+			case FILE_ACTION_RENAMED_OLD_NAME:
+				// The entry is gone, a path which isn't an indexed file could have been a directory
+				if (RemoveIndexedFile(index, l_relativePath))
+				{
+					AddChange(index, FileChangeType::Removed, l_relativePath);
+				}
+				else
+				{
+					RemoveIndexedDirectory(index, l_relativePath + "/");
+				}
+				break;
+			case FILE_ACTION_MODIFIED:
+				if (index.m_FilePathIndices.count(l_relativePath))
+				{
+					AddChange(index, FileChangeType::Modified, l_relativePath);
+				}
+				break;
+			default:
+				break;
+			}
+
+			if (!l_info->NextEntryOffset)
+			{
+				break;
+			}
+
+			l_ptr += l_info->NextEntryOffset;
+		}
+
+		ResetEvent(index.m_Overlapped.hEvent);
+		ReadDirectoryChangesW(index.m_Directory, index.m_NotifyBuffer.data(), (DWORD)(index.m_NotifyBuffer.size() * sizeof(DWORD)), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &index.m_Overlapped, NULL);
+#else
+		// No watcher on this platform, compare with a fresh walk once the interval has passed
+		auto l_now = std::chrono::steady_clock::now();
+
+		if (l_now - index.m_LastScanTime < m_RescanInterval)
+		{
+			return;
+		}
+
+		index.m_LastScanTime = l_now;
+
+		std::vector<std::string> l_filePaths;
+		std::vector<Watch> l_watches;
+		WalkDirectory(index, "", l_filePaths, l_watches);
+
+		std::unordered_set<std::string> l_currentFilePaths(l_filePaths.begin(), l_filePaths.end());
+		std::vector<std::string> l_removedFilePaths;
+		std::error_code l_errorCode;
+
+		for (auto& i : index.m_FilePaths)
+		{
+			if (!l_currentFilePaths.count(i))
+			{
+				l_removedFilePaths.emplace_back(i);
+			}
+		}
+
+		for (auto& i : l_removedFilePaths)
+		{
+			RemoveIndexedFile(index, i);
+			index.m_LastWriteTimes.erase(i);
+			AddChange(index, FileChangeType::Removed, i);
+		}
+
+		for (auto& i : l_filePaths)
+		{
+			auto l_lastWriteTime = fs::last_write_time(index.m_FullPath + i, l_errorCode);
+
+			if (AddIndexedFile(index, i))
+			{
+				AddChange(index, FileChangeType::Added, i);
+			}
+			else if (index.m_LastWriteTimes[i] != l_lastWriteTime)
+			{
+				AddChange(index, FileChangeType::Modified, i);
+			}
+
+			index.m_LastWriteTimes[i] = l_lastWriteTime;
+		}
+#endif
+	}
+
+	DirectoryIndex* FindDirectoryIndex(const char* directoryPath)
+	{
+		auto l_result = m_directoryIndices.find(resolvePath(directoryPath));
+
+		if (l_result != m_directoryIndices.end())
+		{
+			return l_result->second.get();
+		}
+
+		return nullptr;
+	}
+}
+
+Waveless::WsResult Waveless::IOService::indexDirectory(const char* directoryPath, const std::vector<std::string>& extensions)
+{
+	std::unique_lock<std::mutex> l_lock(m_directoryIndicesMutex);
+
+	auto& l_fullPath = resolvePath(directoryPath);
+
+	if (!fs::is_directory(l_fullPath))
+	{
+		Logger::Log(LogLevel::Error, "IOService: Can't find directory : ", directoryPath, "!");
+		return WsResult::FileNotFound;
+	}
+
+	auto& l_index = m_directoryIndices[l_fullPath];
+
+	if (!l_index)
+	{
+		l_index = std::make_unique<DirectoryIndex>();
+		l_index->m_FullPath = l_fullPath;
+
+		if (l_index->m_FullPath.back() != '/')
+		{
+			l_index->m_FullPath += "/";
+		}
+	}
+
+	l_index->m_Extensions = extensions;
+	l_index->m_PendingChanges.clear();
+	l_index->m_PendingChangedPaths.clear();
+
+	BuildIndex(*l_index);
+
+	return WsResult::Success;
+}
+
+const std::vector<std::string>& Waveless::IOService::getIndexedFilePaths(const char* directoryPath)
+{
+	static const std::vector<std::string> l_emptyResult;
+
+	{
+		std::unique_lock<std::mutex> l_lock(m_directoryIndicesMutex);
+
+		auto l_index = FindDirectoryIndex(directoryPath);
+
+		if (l_index)
+		{
+			return l_index->m_FilePaths;
+		}
+	}
+
+	if (indexDirectory(directoryPath) != WsResult::Success)
+	{
+		return l_emptyResult;
+	}
+
+	std::unique_lock<std::mutex> l_lock(m_directoryIndicesMutex);
+
+	return FindDirectoryIndex(directoryPath)->m_FilePaths;
+}
+
+Waveless::WsResult Waveless::IOService::pollDirectoryChanges(const char* directoryPath, std::vector<FileChange>& changes)
+{
+	std::unique_lock<std::mutex> l_lock(m_directoryIndicesMutex);
+
+	auto l_index = FindDirectoryIndex(directoryPath);
+
+	if (!l_index)
+	{
+		Logger::Log(LogLevel::Warning, "IOService: Directory ", directoryPath, " is not indexed.");
+		return WsResult::IDNotFound;
+	}
+
+	ProcessWatcherEvents(*l_index);
+
+	changes = std::move(l_index->m_PendingChanges);
+	l_index->m_PendingChanges.clear();
+	l_index->m_PendingChangedPaths.clear();
+
+	return WsResult::Success;
+}
+
+Waveless::IOService::FileView::~FileView()
+{
+	reset();
+}
+
+Waveless::IOService::FileView::FileView(FileView&& rhs) noexcept
+{
+	*this = std::move(rhs);
+}
+
+Waveless::IOService::FileView& Waveless::IOService::FileView::operator=(FileView&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		reset();
+
+		m_Data = rhs.m_Data;
+		m_Size = rhs.m_Size;
+		m_MappedAddress = rhs.m_MappedAddress;
+		m_PooledBuffer = rhs.m_PooledBuffer;
+
+		rhs.m_Data = nullptr;
+		rhs.m_Size = 0;
+		rhs.m_MappedAddress = nullptr;
+		rhs.m_PooledBuffer = nullptr;
+	}
+
+	return *this;
+}
+
+void Waveless::IOService::FileView::reset()
+{
+	if (m_MappedAddress)
+	{
+		UnmapFileContent(m_MappedAddress, m_Size);
+	}
+	if (m_PooledBuffer)
+	{
+		ReleaseBuffer(m_PooledBuffer);
+	}
+
+	m_Data = nullptr;
+	m_Size = 0;
+	m_MappedAddress = nullptr;
+	m_PooledBuffer = nullptr;
+}
+
+const std::string& Waveless::IOService::resolvePath(const char* filePath)
+{
+	auto l_hash = HashPath(filePath);
+
+	std::unique_lock<std::mutex> l_lock(m_resolvedPathsMutex);
+
+	auto l_range = m_resolvedPaths.equal_range(l_hash);
+
+	for (auto l_result = l_range.first; l_result != l_range.second; l_result++)
+	{
+		if (l_result->second.m_RelativePath == filePath)
+		{
+			return l_result->second.m_FullPath;
+		}
+	}
+
+	ResolvedPath l_resolvedPath;
+	l_resolvedPath.m_RelativePath = filePath;
+
+	std::error_code l_errorCode;
+	auto l_fullPath = fs::weakly_canonical(fs::path(getWorkingDirectory() + filePath), l_errorCode);
+	l_resolvedPath.m_FullPath = l_errorCode ? getWorkingDirectory() + filePath : l_fullPath.generic_string();
+
+	// A hash collision adds another entry under the same hash
+	auto l_entry = m_resolvedPaths.emplace(l_hash, std::move(l_resolvedPath));
+
+	return l_entry->second.m_FullPath;
+}
+
+Waveless::WsResult Waveless::IOService::mapFile(const char* filePath, FileView& result)
+{
+	result.reset();
+
+	auto& l_fullPath = resolvePath(filePath);
+
+	std::error_code l_errorCode;
+	auto l_size = (size_t)fs::file_size(l_fullPath, l_errorCode);
+
+	if (l_errorCode)
+	{
+		Logger::Log(LogLevel::Error, "IOService: Can't open file : ", filePath, "!");
+		return WsResult::FileNotFound;
+	}
+
+	if (l_size >= m_MinMappedFileSize)
+	{
+		if (!MapFileContent(l_fullPath, result.m_Data, result.m_Size, result.m_MappedAddress))
+		{
+			Logger::Log(LogLevel::Error, "IOService: Can't map file : ", filePath, "!");
+			return WsResult::Fail;
+		}
+
+		return WsResult::Success;
+	}
+
+	auto l_file = std::fopen(l_fullPath.c_str(), "rb");
+
+	if (!l_file)
+	{
+		Logger::Log(LogLevel::Error, "IOService: Can't open file : ", filePath, "!");
+		return WsResult::FileNotFound;
+	}
+
+	auto l_buffer = AcquireBuffer();
+	l_buffer->resize(l_size);
+	result.m_Size = std::fread(l_buffer->data(), 1, l_size, l_file);
+	result.m_Data = l_buffer->data();
+	result.m_PooledBuffer = l_buffer;
+
+	std::fclose(l_file);
+
+	return WsResult::Success;
 }
 
 Waveless::WsResult Waveless::IOService::loadFile(const char* filePath, std::vector<char>& content, IOMode openMode)
@@ -31,7 +987,7 @@ Waveless::WsResult Waveless::IOService::loadFile(const char* filePath, std::vect
 
 	std::ifstream l_file;
 
-	l_file.open((m_workingDir + filePath).c_str(), l_mode);
+	l_file.open(resolvePath(filePath).c_str(), l_mode);
 
 	if (!l_file.is_open())
 	{
@@ -68,7 +1024,7 @@ Waveless::WsResult Waveless::IOService::saveFile(const char* filePath, const std
 
 	std::ofstream l_file;
 
-	l_file.open((m_workingDir + filePath).c_str(), l_mode);
+	l_file.open(resolvePath(filePath).c_str(), l_mode);
 
 	if (!l_file.is_open())
 	{
@@ -85,14 +1041,20 @@ Waveless::WsResult Waveless::IOService::saveFile(const char* filePath, const std
 
 bool Waveless::IOService::isFileExist(const char* filePath)
 {
-	if (fs::exists(fs::path(m_workingDir + filePath)))
-	{
-		return true;
-	}
-	else
+	return IsPathExist(resolvePath(filePath));
+}
+
+uint64_t Waveless::IOService::getLastWriteTime(const char* filePath)
+{
+	std::error_code l_error;
+	auto l_time = fs::last_write_time(resolvePath(filePath), l_error);
+
+	if (l_error)
 	{
-		return false;
+		return 0;
 	}
+
+	return (uint64_t)l_time.time_since_epoch().count();
 }
 
 std::string Waveless::IOService::getFilePath(const char* filePath)
@@ -125,18 +1087,25 @@ std::vector<std::string> Waveless::IOService::getAllFilePaths(const char * dirct
 	auto l_fullPath = getWorkingDirectory() + dirctoryPath;
 
 	std::vector<std::string> l_result;
-	l_result.reserve(8192);
+
+	// The entries are always prefixed with the directory path, no need for fs::relative()
+	auto l_prefixLength = fs::path(l_fullPath).generic_string().size();
 
 	for (auto& p : fs::recursive_directory_iterator(l_fullPath))
 	{
 		if (!p.is_directory())
 		{
-			auto l_relativePath = std::filesystem::relative(p, l_fullPath);
-			l_result.emplace_back(l_relativePath.generic_string());
+			auto l_path = p.path().generic_string();
+			auto l_relativePath = l_path.substr(std::min(l_prefixLength, l_path.size()));
+
+			if (l_relativePath.size() && l_relativePath[0] == '/')
+			{
+				l_relativePath.erase(0, 1);
+			}
+
+			l_result.emplace_back(std::move(l_relativePath));
 		}
 	}
 
-	l_result.shrink_to_fit();
-
 	return l_result;
 }
\ No newline at end of file
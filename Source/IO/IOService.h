@@ -1,6 +1,7 @@
 #pragma once
 #include "../Core/stdafx.h"
 #include "../Core/Typedef.h"
+#include <string_view>
 
 namespace Waveless
 {
@@ -8,10 +9,56 @@ namespace Waveless
 	{
 		enum class IOMode { Text, Binary };
 
+		///
+		/// Read-only view of a whole file, backed by a memory mapping for large files or by a pooled buffer for small ones.
+		/// The content is released back when the view is reset or destroyed.
+		///
+		class FileView
+		{
+		public:
+			FileView() = default;
+			~FileView();
+
+			FileView(const FileView&) = delete;
+			FileView& operator=(const FileView&) = delete;
+			FileView(FileView&& rhs) noexcept;
+			FileView& operator=(FileView&& rhs) noexcept;
+
+			const char* data() const { return m_Data; }
+			size_t size() const { return m_Size; }
+			bool empty() const { return m_Size == 0; }
+			std::string_view view() const { return std::string_view(m_Data, m_Size); }
+
+			void reset();
+
+		private:
+			friend WsResult mapFile(const char* filePath, FileView& result);
+
+			const char* m_Data = nullptr;
+			size_t m_Size = 0;
+			void* m_MappedAddress = nullptr;
+			std::vector<char>* m_PooledBuffer = nullptr;
+		};
+
+		///
+		/// Map a file relative to the working directory without copying it into a new allocation.
+		///
+		WsResult mapFile(const char* filePath, FileView& result);
+
+		///
+		/// Resolve a path relative to the working directory to its canonical absolute path.
+		/// The result is cached for the lifetime of the process, the reference stays valid and a path resolved before doesn't allocate.
+		///
+		const std::string& resolvePath(const char* filePath);
+
 		WsResult loadFile(const char* filePath, std::vector<char>& content, IOMode openMode);
 		WsResult saveFile(const char* filePath, const std::vector<char>& content, IOMode saveMode);
 
 		bool isFileExist(const char* filePath);
+		///
+		/// Get the last write time of a file in file clock ticks, 0 if the file doesn't exist
+		///
+		uint64_t getLastWriteTime(const char* filePath);
 		std::string getFilePath(const char* filePath);
 		std::string getFileExtension(const char* filePath);
 		std::string getFileName(const char* filePath);
@@ -19,6 +66,34 @@ namespace Waveless
 
 		std::vector<std::string> getAllFilePaths(const char* dirctoryPath);
 
+		enum class FileChangeType { Added, Modified, Removed };
+
+		struct FileChange
+		{
+			FileChangeType m_Type;
+			std::string m_RelativePath;
+		};
+
+		///
+		/// Build a persistent index of all files under a directory, subdirectories are walked in parallel.
+		/// Only files with the given extensions (e.g. ".json") are indexed, empty means all files.
+		/// A file system watcher keeps the index up to date, see pollDirectoryChanges().
+		///
+		WsResult indexDirectory(const char* directoryPath, const std::vector<std::string>& extensions = {});
+
+		///
+		/// Get the indexed file paths relative to the directory, the directory is indexed first if necessary.
+		/// The result stays valid until the next indexDirectory() or pollDirectoryChanges() call on the same directory.
+		///
+		const std::vector<std::string>& getIndexedFilePaths(const char* directoryPath);
+
+		///
+		/// Apply the pending file system events to the index of a directory, and get what changed since the last call.
+		/// The cost is proportional to the changes, not to the size of the directory.
+		/// Platforms without a file system watcher walk the directory again instead, at most once per second.
+		///
+		WsResult pollDirectoryChanges(const char* directoryPath, std::vector<FileChange>& changes);
+
 		inline bool serialize(std::ostream& os, void* ptr, size_t size)
 		{
 			os.write((char*)ptr, size);
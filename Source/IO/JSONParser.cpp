@@ -5,18 +5,15 @@
 
 Waveless::WsResult Waveless::JSONParser::loadJsonDataFromDisk(const char* fileName, json & data)
 {
-	std::ifstream i;
+	IOService::FileView l_file;
 
-	i.open(IOService::getWorkingDirectory() + fileName);
-
-	if (!i.is_open())
+	if (IOService::mapFile(fileName, l_file) != WsResult::Success)
 	{
 		Logger::Log(LogLevel::Error, "JSONParser: Can't open JSON file : ", fileName, "!");
 		return WsResult::FileNotFound;
 	}
 
-	i >> data;
-	i.close();
+	data = json::parse(l_file.data(), l_file.data() + l_file.size());
 
 	Logger::Log(LogLevel::Verbose, "JSONParser: JSON file : ", fileName, " has been loaded.");
 
@@ -27,7 +24,7 @@ Waveless::WsResult Waveless::JSONParser::saveJsonDataToDisk(const char* fileName
 {
 	std::ofstream o;
 
-	o.open(IOService::getWorkingDirectory() + fileName, std::ios::out | std::ios::trunc);
+	o.open(IOService::resolvePath(fileName), std::ios::out | std::ios::trunc);
 
 	if (!o.is_open())
 	{
@@ -66,6 +66,15 @@ namespace Waveless
 		Logger::Log(LogLevel::Verbose, "MaxShortTermLoudness: ", (uint16_t)rhs.MaxShortTermLoudness);
 	}
 
+	void printDs64Chunk(ds64Chunk rhs)
+	{
+		Logger::Log(LogLevel::Verbose, "ChunkID: ", std::string(&rhs.ckID[0], sizeof(rhs.ckID)).c_str());
+		Logger::Log(LogLevel::Verbose, "ChunkSize: ", (uint32_t)rhs.ckSize);
+		Logger::Log(LogLevel::Verbose, "RIFFSize: ", (uint64_t)rhs.riffSize);
+		Logger::Log(LogLevel::Verbose, "DataSize: ", (uint64_t)rhs.dataSize);
+		Logger::Log(LogLevel::Verbose, "SampleCount: ", (uint64_t)rhs.sampleCount);
+	}
+
 	void printDataChunk(dataChunk rhs)
 	{
 		Logger::Log(LogLevel::Verbose, "ChunkID: ", std::string(&rhs.ckID[0], sizeof(rhs.ckID)).c_str());
@@ -78,6 +87,10 @@ namespace Waveless
 		{
 			printRIFFChunk(header->RIFFChunk);
 		}
+		if (header->ChunkValidities[6])
+		{
+			printDs64Chunk(header->ds64Chunk);
+		}
 		if (header->ChunkValidities[1])
 		{
 			printJunkChunk(header->JunkChunk);
@@ -103,7 +116,7 @@ namespace Waveless
 	void GetData(std::filebuf* pbuf, void* rhs, size_t size)
 	{
 		pbuf->sgetn(reinterpret_cast<char*>(rhs), size);
-		pbuf->pubseekoff(-(int32_t)size, std::ios_base::cur, std::ios_base::in | std::ios::binary);
+		pbuf->pubseekoff(-(std::streamoff)size, std::ios_base::cur, std::ios_base::in | std::ios::binary);
 	}
 
 	bool CheckChunkID(std::filebuf* pbuf, const char* ID)
@@ -127,6 +140,7 @@ namespace Waveless
 		if (!l_file.is_open())
 		{
 			Logger::Log(LogLevel::Error, "std::ifstream: can't open file ", path, "!");
+			return WavObject();
 		}
 
 		auto pbuf = l_file.rdbuf();
@@ -152,6 +166,22 @@ namespace Waveless
 
 		while (!l_getDataChunk)
 		{
+			std::size_t l_chunkStartPos = pbuf->pubseekoff(0, std::ios_base::cur, l_file.in);
+
+			if (l_chunkStartPos + 8 > l_size)
+			{
+				Logger::Log(LogLevel::Error, path, " has no data chunk!");
+				break;
+			}
+
+			// ds64 of RF64
+			if (!CheckChunkID(pbuf, "ds64"))
+			{
+				GetData(pbuf, &l_WavHeader.ds64Chunk, sizeof(l_WavHeader.ds64Chunk));
+				pbuf->pubseekoff(l_WavHeader.ds64Chunk.ckSize + 8, std::ios_base::cur, l_file.in);
+				l_WavHeader.ChunkValidities[6] = 1;
+			}
+
 			// JUNK without real junk data
 			if (!CheckChunkID(pbuf, "JUNK") || !CheckChunkID(pbuf, "junk"))
 			{
@@ -164,7 +194,7 @@ namespace Waveless
 			if (!CheckChunkID(pbuf, "fmt"))
 			{
 				pbuf->pubseekoff(4, std::ios_base::cur, l_file.in);
-				unsigned long l_fmtChuckSize;
+				uint32_t l_fmtChuckSize;
 				GetData(pbuf, &l_fmtChuckSize, sizeof(l_fmtChuckSize));
 
 				if (l_fmtChuckSize == 16)
@@ -224,16 +254,46 @@ namespace Waveless
 
 				l_getDataChunk = true;
 			}
+
+			// Skip the unknown chunks like LIST or cue
+			if (!l_getDataChunk && l_chunkStartPos == (std::size_t)pbuf->pubseekoff(0, std::ios_base::cur, l_file.in))
+			{
+				uint32_t l_unknownChunkSize = 0;
+				pbuf->pubseekoff(4, std::ios_base::cur, l_file.in);
+				GetData(pbuf, &l_unknownChunkSize, 4);
+				pbuf->pubseekoff(4 + l_unknownChunkSize + (l_unknownChunkSize & 1), std::ios_base::cur, l_file.in);
+			}
+		}
+
+		// The object without samples and with an invalid data chunk tells the caller the file is unusable
+		if (!l_getDataChunk)
+		{
+			WavObject l_result;
+			l_result.header = l_WavHeader;
+
+			return l_result;
+		}
+
+		// The real data size of RF64 is stored in ds64, the 32-bit field is kept as it is in the file
+		uint64_t l_dataSize = l_WavHeader.dataChunk.ckSize;
+
+		if (l_WavHeader.ChunkValidities[6] && l_WavHeader.dataChunk.ckSize == 0xFFFFFFFF)
+		{
+			l_dataSize = l_WavHeader.ds64Chunk.dataSize;
 		}
 
+		// A truncated file only has the samples up to its end
+		std::size_t l_dataStartPos = pbuf->pubseekoff(0, std::ios_base::cur, l_file.in);
+		l_dataSize = std::min<uint64_t>(l_dataSize, l_size > l_dataStartPos ? l_size - l_dataStartPos : 0);
+
 		WavObject l_result;
 		l_result.header = l_WavHeader;
 
 		// load sample
-		l_result.count = l_WavHeader.dataChunk.ckSize;
+		l_result.count = l_dataSize;
 		// @TODO: Memory pool for samples
-		auto l_samples = new char[l_result.count];
-		GetData(pbuf, &l_samples[0], l_result.count);
+		auto l_samples = new char[(size_t)l_result.count];
+		GetData(pbuf, &l_samples[0], (size_t)l_result.count);
 
 		l_result.samples = l_samples;
 
@@ -242,30 +302,53 @@ namespace Waveless
 		return l_result;
 	}
 
-	WavHeader WaveParser::GenerateWavHeader(unsigned short channels, unsigned long sampleRate, unsigned short bitDepth, unsigned long sampleCount)
+	WavHeader WaveParser::GenerateWavHeader(unsigned short channels, unsigned long sampleRate, unsigned short bitDepth, unsigned long long sampleCount, unsigned short formatTag, WavContainerType containerType)
 	{
 		auto l_bytesPerSample = bitDepth / 8;
+		auto l_dataSize = sampleCount * l_bytesPerSample;
+
+		// The 32-bit RIFF size can't hold the samples, only RF64 could
+		if (containerType == WavContainerType::RIFF && 36 + l_dataSize > 0xFFFFFFFF)
+		{
+			Logger::Log(LogLevel::Warning, "WaveParser: ", (uint64_t)l_dataSize, " bytes of samples don't fit in RIFF, RF64 is used instead.");
+			containerType = WavContainerType::RF64;
+		}
 
 		WavHeader l_header;
 		std::memcpy(l_header.RIFFChunk.ckID, "RIFF", 4);
-		l_header.RIFFChunk.ckSize = 44 + sampleCount * l_bytesPerSample;
+		l_header.RIFFChunk.ckSize = (uint32_t)(36 + l_dataSize);
 		std::memcpy(l_header.RIFFChunk.RIFFType, "WAVE", 4);
 		l_header.ChunkValidities[0] = 1;
 
 		std::memcpy(l_header.fmtChunk.ckID, "fmt ", 4);
 		l_header.fmtChunk.ckSize = 16;
-		l_header.fmtChunk.wFormatTag = 1;
+		l_header.fmtChunk.wFormatTag = formatTag;
 		l_header.fmtChunk.nChannels = channels;
-		l_header.fmtChunk.nSamplesPerSec = sampleRate * channels;
+		l_header.fmtChunk.nSamplesPerSec = sampleRate;
 		l_header.fmtChunk.nAvgBytesPerSec = sampleRate * channels * l_bytesPerSample;
 		l_header.fmtChunk.nBlockAlign = channels * l_bytesPerSample;
 		l_header.fmtChunk.wBitsPerSample = bitDepth;
 		l_header.ChunkValidities[2] = 1;
 
 		std::memcpy(l_header.dataChunk.ckID, "data", 4);
-		l_header.dataChunk.ckSize = sampleCount * l_bytesPerSample;
+		l_header.dataChunk.ckSize = (uint32_t)l_dataSize;
 		l_header.ChunkValidities[5] = 1;
 
+		if (containerType == WavContainerType::RF64)
+		{
+			// RIFF and data sizes are moved to ds64, the 32-bit fields are set to -1
+			std::memcpy(l_header.RIFFChunk.ckID, "RF64", 4);
+			l_header.RIFFChunk.ckSize = 0xFFFFFFFF;
+
+			std::memcpy(l_header.ds64Chunk.ckID, "ds64", 4);
+			l_header.ds64Chunk.riffSize = 36 + sizeof(ds64Chunk) + l_dataSize;
+			l_header.ds64Chunk.dataSize = l_dataSize;
+			l_header.ds64Chunk.sampleCount = sampleCount / channels;
+			l_header.ChunkValidities[6] = 1;
+
+			l_header.dataChunk.ckSize = 0xFFFFFFFF;
+		}
+
 		return l_header;
 	}
 
@@ -274,8 +357,8 @@ namespace Waveless
 		WavObject l_result;
 
 		auto l_bytesPerSample = header.fmtChunk.wBitsPerSample / 8;
-		l_result.count = (int)x.size() * l_bytesPerSample;
-		auto l_samples = new char[l_result.count];
+		l_result.count = (uint64_t)x.size() * l_bytesPerSample;
+		auto l_samples = new char[(size_t)l_result.count];
 
 		for (size_t i = 0; i < x.size(); i++)
 		{
@@ -324,6 +407,210 @@ namespace Waveless
 		return l_result;
 	}
 
+	unsigned short GetFormatCode(const WavHeader& header)
+	{
+		// WAVE_FORMAT_EXTENSIBLE stores the real format code in the first two bytes of the sub-format GUID
+		if (header.fmtChunk.wFormatTag == 0xFFFE)
+		{
+			unsigned short l_formatCode;
+			std::memcpy(&l_formatCode, &header.fmtChunk.SubFormat[0], sizeof(l_formatCode));
+			return l_formatCode;
+		}
+
+		return header.fmtChunk.wFormatTag;
+	}
+
+	template<class T>
+	WsResult WaveParser::DecodePCM(const WavObject& wavObject, std::vector<T>& x)
+	{
+		auto l_formatCode = GetFormatCode(wavObject.header);
+		auto l_bytesPerSample = wavObject.header.fmtChunk.wBitsPerSample / 8;
+
+		if (!l_bytesPerSample)
+		{
+			return WsResult::NotCompatible;
+		}
+
+		auto l_sampleCount = (size_t)wavObject.count / l_bytesPerSample;
+		x.resize(l_sampleCount);
+
+		auto l_samples = reinterpret_cast<const unsigned char*>(wavObject.samples);
+
+		if (l_formatCode == 1)
+		{
+			switch (l_bytesPerSample)
+			{
+			case 1:
+				// 8-bit PCM is unsigned
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					x[i] = (T)(((double)l_samples[i] - 128.0) / 128.0);
+				}
+				break;
+			case 2:
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					int16_t l_sample;
+					std::memcpy(&l_sample, &l_samples[i * 2], 2);
+					x[i] = (T)((double)l_sample / 32768.0);
+				}
+				break;
+			case 3:
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					auto l_sampleOrig = &l_samples[i * 3];
+					int32_t l_sample = (int32_t)((uint32_t)l_sampleOrig[0] << 8 | (uint32_t)l_sampleOrig[1] << 16 | (uint32_t)l_sampleOrig[2] << 24) >> 8;
+					x[i] = (T)((double)l_sample / 8388608.0);
+				}
+				break;
+			case 4:
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					int32_t l_sample;
+					std::memcpy(&l_sample, &l_samples[i * 4], 4);
+					x[i] = (T)((double)l_sample / 2147483648.0);
+				}
+				break;
+			default:
+				return WsResult::NotCompatible;
+			}
+		}
+		else if (l_formatCode == 3)
+		{
+			if (l_bytesPerSample == 4)
+			{
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					float l_sample;
+					std::memcpy(&l_sample, &l_samples[i * 4], 4);
+					x[i] = (T)l_sample;
+				}
+			}
+			else if (l_bytesPerSample == 8)
+			{
+				if constexpr (std::is_same_v<T, double>)
+				{
+					std::memcpy(x.data(), l_samples, l_sampleCount * 8);
+				}
+				else
+				{
+					for (size_t i = 0; i < l_sampleCount; i++)
+					{
+						double l_sample;
+						std::memcpy(&l_sample, &l_samples[i * 8], 8);
+						x[i] = (T)l_sample;
+					}
+				}
+			}
+			else
+			{
+				return WsResult::NotCompatible;
+			}
+		}
+		else
+		{
+			Logger::Log(LogLevel::Warning, "WaveParser: Unsupported format code ", (uint32_t)l_formatCode);
+			return WsResult::NotCompatible;
+		}
+
+		return WsResult::Success;
+	}
+
+	template WsResult WaveParser::DecodePCM<float>(const WavObject&, std::vector<float>&);
+	template WsResult WaveParser::DecodePCM<double>(const WavObject&, std::vector<double>&);
+
+	WsResult WaveParser::GetSignalStatistics(const WavObject& wavObject, std::vector<SignalStatistics>& statistics)
+	{
+		auto l_formatCode = GetFormatCode(wavObject.header);
+		auto l_bytesPerSample = wavObject.header.fmtChunk.wBitsPerSample / 8;
+		auto l_channels = (size_t)wavObject.header.fmtChunk.nChannels;
+
+		if (!l_bytesPerSample || !l_channels)
+		{
+			return WsResult::NotCompatible;
+		}
+
+		SampleFormat l_format;
+
+		if (l_formatCode == 1 && l_bytesPerSample <= 4)
+		{
+			static const SampleFormat l_integerFormats[] = { SampleFormat::UInt8, SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32 };
+			l_format = l_integerFormats[l_bytesPerSample - 1];
+		}
+		else if (l_formatCode == 3 && (l_bytesPerSample == 4 || l_bytesPerSample == 8))
+		{
+			l_format = l_bytesPerSample == 4 ? SampleFormat::Float32 : SampleFormat::Float64;
+		}
+		else
+		{
+			Logger::Log(LogLevel::Warning, "WaveParser: Unsupported format code ", (uint32_t)l_formatCode, " of ", (uint32_t)wavObject.header.fmtChunk.wBitsPerSample, " bits");
+			return WsResult::NotCompatible;
+		}
+
+		auto l_frameCount = (size_t)wavObject.count / (l_bytesPerSample * l_channels);
+
+		return DSP::GetSignalStatistics(wavObject.samples, l_frameCount, l_channels, l_format, statistics);
+	}
+
+	WsResult WaveParser::EncodePCM(const WavHeader& header, const std::vector<double>& x, WavObject& result)
+	{
+		auto l_formatCode = GetFormatCode(header);
+		auto l_bytesPerSample = header.fmtChunk.wBitsPerSample / 8;
+
+		if (!((l_formatCode == 1 && l_bytesPerSample >= 1 && l_bytesPerSample <= 4) || (l_formatCode == 3 && (l_bytesPerSample == 4 || l_bytesPerSample == 8))))
+		{
+			return WsResult::NotCompatible;
+		}
+
+		result.header = header;
+		result.count = (uint64_t)x.size() * l_bytesPerSample;
+		// @TODO: Memory pool for samples
+		result.samples = new char[(size_t)result.count];
+
+		auto l_samples = reinterpret_cast<unsigned char*>(result.samples);
+
+		if (l_formatCode == 3)
+		{
+			if (l_bytesPerSample == 4)
+			{
+				for (size_t i = 0; i < x.size(); i++)
+				{
+					auto l_sample = (float)x[i];
+					std::memcpy(&l_samples[i * 4], &l_sample, 4);
+				}
+			}
+			else
+			{
+				std::memcpy(l_samples, x.data(), x.size() * 8);
+			}
+
+			return WsResult::Success;
+		}
+
+		// Integer PCM, clamp and round to the nearest code
+		auto l_scale = std::pow(2.0, header.fmtChunk.wBitsPerSample - 1);
+
+		for (size_t i = 0; i < x.size(); i++)
+		{
+			auto l_sample = (int64_t)std::llround(x[i] * l_scale);
+			l_sample = std::clamp(l_sample, (int64_t)-l_scale, (int64_t)l_scale - 1);
+
+			if (l_bytesPerSample == 1)
+			{
+				l_samples[i] = (unsigned char)(l_sample + 128);
+			}
+			else
+			{
+				for (int j = 0; j < l_bytesPerSample; j++)
+				{
+					l_samples[i * l_bytesPerSample + j] = (unsigned char)((uint64_t)l_sample >> (8 * j));
+				}
+			}
+		}
+
+		return WsResult::Success;
+	}
+
 	Waveless::WsResult WaveParser::WriteFile(const char* path, const WavObject& wavObject)
 	{
 		std::ofstream l_file(path, std::ios::out | std::ios::ate | std::ios::binary);
@@ -337,6 +624,10 @@ namespace Waveless
 		{
 			l_file.write((char*)&wavObject.header.RIFFChunk, sizeof(wavObject.header.RIFFChunk));
 		}
+		if (wavObject.header.ChunkValidities[6])
+		{
+			l_file.write((char*)&wavObject.header.ds64Chunk, sizeof(wavObject.header.ds64Chunk));
+		}
 		if (wavObject.header.ChunkValidities[2])
 		{
 			l_file.write((char*)&wavObject.header.fmtChunk, wavObject.header.fmtChunk.ckSize + 8);
@@ -359,7 +650,7 @@ namespace Waveless
 			l_file.write((char*)&wavObject.header.dataChunk, sizeof(wavObject.header.dataChunk));
 		}
 
-		l_file.write((char*)&wavObject.samples[0], wavObject.count);
+		l_file.write(wavObject.samples, (std::streamsize)wavObject.count);
 
 		l_file.close();
 
@@ -2,6 +2,7 @@
 #include "../Core/stdafx.h"
 #include "../Core/Typedef.h"
 #include "../Core/Math.h"
+#include "../Core/DSP.h"
 
 namespace Waveless
 {
@@ -10,20 +11,37 @@ namespace Waveless
 		Standard, NonPCM, Extensible, BWF
 	};
 
+	enum class WavContainerType
+	{
+		RIFF, RF64
+	};
+
 #pragma pack (push, 1)
 	struct RIFFChunk
 	{
 		char                ckID[4]; // "RIFF" string
-		unsigned long       ckSize = 0; // RIFF Chunk Size
+		uint32_t            ckSize = 0; // RIFF Chunk Size
 		char                RIFFType[4]; // "WAVE" string
 	};
 #pragma pack(pop)
 
+#pragma pack (push, 1)
+	struct ds64Chunk
+	{
+		char                ckID[4]; // "ds64" string
+		uint32_t            ckSize = 28; // Size of the ds64 chunk
+		uint64_t            riffSize = 0; // Size of the RF64 chunk
+		uint64_t            dataSize = 0; // Size of the data chunk
+		uint64_t            sampleCount = 0; // Sample count of the fact chunk
+		uint32_t            tableLength = 0; // Number of valid entries in the optional chunk size table
+	};
+#pragma pack(pop)
+
 #pragma pack (push, 1)
 	struct JunkChunk
 	{
 		char ckID[4]; // "JUNK" or "junk" string
-		unsigned long ckSize = 0; // This must be at least 28 if the chunk is intended as a place-holder for a "ds64" chunk.
+		uint32_t ckSize = 0; // This must be at least 28 if the chunk is intended as a place-holder for a "ds64" chunk.
 		//char chunkData[] // dummy bytes
 	};
 #pragma pack(pop)
@@ -33,11 +51,11 @@ namespace Waveless
 	{
 		// Standard
 		char                ckID[4];         // "fmt" string
-		unsigned long       ckSize = 0;  // Size of the fmt chunk
+		uint32_t            ckSize = 0;  // Size of the fmt chunk
 		unsigned short      wFormatTag;    // Audio format 1=PCM,6=mulaw,7=alaw, 257=IBM Mu-Law, 258=IBM A-Law, 259=ADPCM
 		unsigned short      nChannels;      // Number of channels 1=Mono 2=Stereo
-		unsigned long       nSamplesPerSec;  // Sampling Frequency in Hz
-		unsigned long       nAvgBytesPerSec;    // bytes per second
+		uint32_t            nSamplesPerSec;  // Sampling Frequency in Hz
+		uint32_t            nAvgBytesPerSec;    // bytes per second
 		unsigned short      nBlockAlign;     // 2=16-bit mono, 4=16-bit stereo
 		unsigned short      wBitsPerSample;  // Number of bits per sample
 
@@ -46,7 +64,7 @@ namespace Waveless
 
 		// Extensible
 		unsigned short      wValidBitsPerSample;
-		unsigned long       dwChannelMask; // Speaker position mask
+		uint32_t            dwChannelMask; // Speaker position mask
 		char                SubFormat[16]; // GUID (first two bytes are the data format code)
 	};
 #pragma pack(pop)
@@ -55,8 +73,8 @@ namespace Waveless
 	struct factChunk
 	{
 		char                ckID[4]; // "fact" string
-		unsigned long       ckSize;  //
-		unsigned long       dwSampleLength;
+		uint32_t            ckSize;  //
+		uint32_t            dwSampleLength;
 	};
 #pragma pack(pop)
 
@@ -64,14 +82,14 @@ namespace Waveless
 	struct bextChunk
 	{
 		char                ckID[4]; // "bext" string
-		unsigned long       ckSize = 0; // Size of the bext chunk
+		uint32_t            ckSize = 0; // Size of the bext chunk
 		char                Description[256]; //ASCII : Description of the sound sequence
 		char                Originator[32]; //ASCII : Name of the originator
 		char                OriginatorReference[32]; //ASCII : Reference of the originator
 		char                OriginationDate[10]; //ASCII : yyyy:mm:dd
 		char                OriginationTime[8]; //ASCII : hh:mm:ss
-		unsigned long       TimeReferenceLow; //First sample count since midnight, low word
-		unsigned long       TimeReferenceHigh; //First sample count since midnight, high word
+		uint32_t            TimeReferenceLow; //First sample count since midnight, low word
+		uint32_t            TimeReferenceHigh; //First sample count since midnight, high word
 		unsigned short      Version; //Version of the BWF; unsigned binary number
 		char                UMID[64]; // Binary byte of SMPTE UMID
 		unsigned short      LoudnessValue; //unsigned short : Integrated Loudness Value of the file in LUFS (multiplied by 100)
@@ -88,7 +106,7 @@ namespace Waveless
 	struct dataChunk
 	{
 		char                ckID[4]; // "data" string
-		unsigned long       ckSize = 0;  // Sampled data length
+		uint32_t            ckSize = 0;  // Sampled data length
 	};
 #pragma pack(pop)
 
@@ -100,14 +118,16 @@ namespace Waveless
 		factChunk factChunk;
 		bextChunk bextChunk;
 		dataChunk dataChunk;
-		int ChunkValidities[6] = { 0 };
+		ds64Chunk ds64Chunk;
+		int ChunkValidities[7] = { 0 };
 	};
 
 	struct WavObject
 	{
 		WavHeader header;
-		char* samples;
-		int count;
+		char* samples = nullptr;
+		// The byte count of the samples, larger than 4 GiB for RF64
+		uint64_t count = 0;
 	};
 
 	class WaveParser
@@ -118,9 +138,32 @@ namespace Waveless
 
 		static WavObject LoadFile(const char* path);
 
-		static WavHeader GenerateWavHeader(unsigned short channels, unsigned long sampleRate, unsigned short bitDepth, unsigned long sampleCount);
+		///
+		/// Generate a header for interleaved samples, sampleCount is the total sample count of all channels.
+		/// formatTag is 1 for integer PCM and 3 for IEEE float.
+		/// A RIFF header is promoted to RF64 when the samples are larger than its 32-bit sizes could hold.
+		///
+		static WavHeader GenerateWavHeader(unsigned short channels, unsigned long sampleRate, unsigned short bitDepth, unsigned long long sampleCount, unsigned short formatTag = 1, WavContainerType containerType = WavContainerType::RIFF);
 		static WavObject GenerateWavObject(const WavHeader& header, const ComplexArray& x);
 		static ComplexArray GenerateComplexArray(const WavObject& wavObject);
+
+		///
+		/// Decode the interleaved raw samples to normalized [-1.0, 1.0] values.
+		/// 8/16/24/32 bit integer PCM and 32/64 bit IEEE float are supported.
+		///
+		template<class T>
+		static WsResult DecodePCM(const WavObject& wavObject, std::vector<T>& x);
+
+		///
+		/// Encode the interleaved normalized [-1.0, 1.0] values to raw samples of the header's sample format.
+		///
+		static WsResult EncodePCM(const WavHeader& header, const std::vector<double>& x, WavObject& result);
+
+		///
+		/// Measure every channel of the raw samples without decoding them to a buffer, the formats of DecodePCM are supported
+		///
+		static WsResult GetSignalStatistics(const WavObject& wavObject, std::vector<SignalStatistics>& statistics);
+
 		static WsResult WriteFile(const char* path, const WavObject& wavObject);
 		static WsResult WriteFile(const char* path, const WavHeader& header, const ComplexArray& x);
 
@@ -1,6 +1,9 @@
 #include "AudioEngine.h"
 #include "../Core/Math.h"
 #include "../Core/Logger.h"
+#include "../Core/IIRFilter.h"
+#include "../Core/GainProcessor.h"
+#include "../Core/Resampler.h"
 
 #define DR_FLAC_IMPLEMENTATION
 #include "../../GitSubmodules/miniaudio/extras/dr_flac.h"  /* Enables FLAC decoding. */
@@ -23,17 +26,23 @@ namespace Waveless
 	struct EventPrototype : public PlayableObject
 	{
 		WavObject* wavObject;
+		// The interleaved samples converted to the device sample rate, empty if the file is at the device sample rate
+		std::vector<float> resampledSamples;
 	};
 
 	struct EventInstance : public PlayableObject
 	{
 		ma_decoder decoder;
 		ma_event stopEvent;
-		float sampleStateLPF[8] = { 0 };
-		float sampleStateHPF[8] = { 0 };
+		GainProcessorF gainProcessor;
+		IIRFilterF filterLPF;
+		IIRFilterF filterHPF;
 		float gain = 0.0f;
 		float cutOffFreqLPF = 0.0f;
 		float cutOffFreqHPF = 0.0f;
+		// The cut-off frequencies the filters are set up with
+		float activeCutOffFreqLPF = 0.0f;
+		float activeCutOffFreqHPF = 0.0f;
 	};
 
 	std::unordered_map<uint64_t, EventPrototype> g_eventPrototypes;
@@ -46,101 +55,30 @@ namespace Waveless
 	ma_event terminateEvent;
 	const int sizeOfTempBuffer = 4096;
 
-	ma_uint32 gain(ma_uint32 channels, float gain, float* pOutput, ma_uint32 frameCount)
+	ma_uint32 gain(float gain, GainProcessorF& gainProcessor, float* pOutput, ma_uint32 frameCount)
 	{
-		for (ma_uint32 i = 0; i < frameCount; ++i)
-		{
-			for (ma_uint32 j = 0; j < channels; ++j)
-			{
-				pOutput[i * channels + j] *= (float)Math::DB2LinearMag(gain);
-			}
-		}
-
-		return frameCount;
-	}
-
-	ma_uint32 low_pass_filter(ma_uint32 channels, float cutoffFreq, ma_uint32 sampleRate, float* pSampleState, float* pOutput, ma_uint32 frameCount)
-	{
-		auto th = 2.0f * PI<float> * cutoffFreq / (float)sampleRate;
-		auto g = cosf(th) / (1.0f + sinf(th));
-		auto a0 = (1.0f - g) / 2.0f;
-		auto a1 = (1.0f - g) / 2.0f;
-		auto b1 = -g;
-
-		float temp[sizeOfTempBuffer];
-
-		// First frame
-		// Y0 = a0 * X0 + a1 * X-1 - b1 * Y-1
-		for (ma_uint32 i = 0; i < channels; ++i)
-		{
-			temp[i] = a0 * pOutput[i] + pSampleState[i];
-		}
-
-		// Yn = a0 * Xn + a1 * Xn-1 - b1 * Yn-1
-		for (ma_uint32 i = 1; i < frameCount; ++i)
-		{
-			for (ma_uint32 j = 0; j < channels; ++j)
-			{
-				temp[i * channels + j] = a0 * pOutput[i * channels + j] + a1 * pOutput[(i - 1) * channels + j] - b1 * temp[(i - 1) * channels + j];
-			}
-		}
-
-		// Save a1 * XN - b1 * YN of last frame
-		for (ma_uint32 i = 0; i < channels; ++i)
-		{
-			auto XN = pOutput[frameCount * channels - channels + i];
-			auto YN = temp[frameCount * channels - channels + i];
-			pSampleState[i] = a1 * XN - b1 * YN;
-		}
-
-		// Save Yn
-		for (ma_uint32 i = 0; i < frameCount * channels; ++i)
-		{
-			pOutput[i] = temp[i];
-		}
+		// Converted to linear only when the level changed, then ramped across the block
+		gainProcessor.SetGainLevel(gain);
+		gainProcessor.Process(pOutput, frameCount, deviceDecoderConfig.channels);
 
 		return frameCount;
 	}
 
-	ma_uint32 high_pass_filter(ma_uint32 channels, float cutoffFreq, ma_uint32 sampleRate, float* pSampleState, float* pOutput, ma_uint32 frameCount)
+	ma_uint32 apply_filter(FilterType filterType, float cutOffFreq, float& activeCutOffFreq, IIRFilterF& filter, float* pOutput, ma_uint32 frameCount)
 	{
-		auto th = 2.0f * PI<float> * cutoffFreq / (float)sampleRate;
-		auto g = cosf(th) / (1.0f + sinf(th));
-		auto a0 = (1.0f + g) / 2.0f;
-		auto a1 = -((1.0f + g) / 2.0f);
-		auto b1 = -g;
-
-		float temp[sizeOfTempBuffer];
-
-		// First frame
-		// Y0 = a0 * X0 + a1 * X-1 - b1 * Y-1
-		for (ma_uint32 i = 0; i < channels; ++i)
-		{
-			temp[i] = a0 * pOutput[i] + pSampleState[i];
-		}
-
-		// Yn = a0 * Xn + a1 * Xn-1 - b1 * Yn-1
-		for (ma_uint32 i = 1; i < frameCount; ++i)
+		// Only recompute the coefficients when the parameter changed, the state is kept so there is no click.
+		// An invalid parameter is tried once and the previous coefficients are kept
+		if (cutOffFreq != activeCutOffFreq)
 		{
-			for (ma_uint32 j = 0; j < channels; ++j)
-			{
-				temp[i * channels + j] = a0 * pOutput[i * channels + j] + a1 * pOutput[(i - 1) * channels + j] - b1 * temp[(i - 1) * channels + j];
-			}
-		}
+			FilterDesc l_filterDesc;
+			l_filterDesc.m_FilterType = filterType;
+			l_filterDesc.m_Frequency = cutOffFreq;
 
-		// Save a1 * XN - b1 * YN of last frame
-		for (ma_uint32 i = 0; i < channels; ++i)
-		{
-			auto XN = pOutput[frameCount * channels - channels + i];
-			auto YN = temp[frameCount * channels - channels + i];
-			pSampleState[i] = a1 * XN - b1 * YN;
+			filter.Setup(l_filterDesc, deviceDecoderConfig.sampleRate, deviceDecoderConfig.channels);
+			activeCutOffFreq = cutOffFreq;
 		}
 
-		// Save Yn
-		for (ma_uint32 i = 0; i < frameCount * channels; ++i)
-		{
-			pOutput[i] = temp[i];
-		}
+		filter.Process(pOutput, frameCount);
 
 		return frameCount;
 	}
@@ -172,18 +110,18 @@ namespace Waveless
 				break;
 			}
 
-			if (eventInstance->gain != 0.0f)
+			if (eventInstance->gain != 0.0f || eventInstance->gainProcessor.GetGain() != 1.0f)
 			{
-				gain(deviceDecoderConfig.channels, eventInstance->gain, temp, framesToReadThisIteration);
+				gain(eventInstance->gain, eventInstance->gainProcessor, temp, framesReadThisIteration);
 			}
 
 			if (eventInstance->cutOffFreqLPF != 0.0f)
 			{
-				low_pass_filter(deviceDecoderConfig.channels, eventInstance->cutOffFreqLPF, deviceDecoderConfig.sampleRate, eventInstance->sampleStateLPF, temp, framesToReadThisIteration);
+				apply_filter(FilterType::LowPass, eventInstance->cutOffFreqLPF, eventInstance->activeCutOffFreqLPF, eventInstance->filterLPF, temp, framesReadThisIteration);
 			}
 			if (eventInstance->cutOffFreqHPF != 0.0f)
 			{
-				high_pass_filter(deviceDecoderConfig.channels, eventInstance->cutOffFreqHPF, deviceDecoderConfig.sampleRate, eventInstance->sampleStateHPF, temp, framesToReadThisIteration);
+				apply_filter(FilterType::HighPass, eventInstance->cutOffFreqHPF, eventInstance->activeCutOffFreqHPF, eventInstance->filterHPF, temp, framesReadThisIteration);
 			}
 
 			/* Mix the frames together. */
@@ -276,8 +214,18 @@ namespace Waveless
 
 		l_eventInstance->UUID = l_UUID;
 		l_eventInstance->decoderConfig = l_eventPrototype->decoderConfig;
+		l_eventInstance->gainProcessor.Setup(deviceDecoderConfig.sampleRate);
+
+		auto l_samples = (const void*)l_eventPrototype->wavObject->samples;
+		auto l_sampleSize = (size_t)l_eventPrototype->wavObject->count;
+
+		if (!l_eventPrototype->resampledSamples.empty())
+		{
+			l_samples = l_eventPrototype->resampledSamples.data();
+			l_sampleSize = l_eventPrototype->resampledSamples.size() * sizeof(float);
+		}
 
-		if (ma_decoder_init_memory_raw(l_eventPrototype->wavObject->samples, l_eventPrototype->wavObject->count, &l_eventInstance->decoderConfig, &deviceDecoderConfig, &l_eventInstance->decoder) != MA_SUCCESS)
+		if (ma_decoder_init_memory_raw(l_samples, l_sampleSize, &l_eventInstance->decoderConfig, &deviceDecoderConfig, &l_eventInstance->decoder) != MA_SUCCESS)
 		{
 			Logger::Log(LogLevel::Error, "Failed to init decoder.");
 		}
@@ -343,8 +291,31 @@ namespace Waveless
 				wavObject.header.fmtChunk.nSamplesPerSec
 			);
 
-			g_eventPrototypes.emplace(l_UUID, l_eventPrototype);
-			g_registeredEventPrototypes.emplace(l_eventPrototype.wavObject, l_UUID);
+			// Converted once here instead of by a converter of every voice in the callback, in the float of the device
+			if (wavObject.header.fmtChunk.nSamplesPerSec != deviceDecoderConfig.sampleRate)
+			{
+				std::vector<float> l_samples;
+				ResamplerF l_resampler;
+				size_t l_channels = wavObject.header.fmtChunk.nChannels;
+
+				if (WaveParser::DecodePCM(wavObject, l_samples) == WsResult::Success
+					&& l_resampler.Setup(wavObject.header.fmtChunk.nSamplesPerSec, deviceDecoderConfig.sampleRate, l_channels) == WsResult::Success)
+				{
+					l_resampler.Render(l_samples.data(), l_samples.size() / l_channels, l_eventPrototype.resampledSamples);
+					l_eventPrototype.decoderConfig = ma_decoder_config_init(ma_format_f32, (ma_uint32)l_channels, deviceDecoderConfig.sampleRate);
+
+					// The voices only read the resampled samples, the source ones are released
+					auto& l_source = const_cast<WavObject&>(wavObject);
+					delete[] l_source.samples;
+					l_source.samples = nullptr;
+					l_source.count = 0;
+				}
+			}
+
+			auto l_wavObject = l_eventPrototype.wavObject;
+
+			g_eventPrototypes.emplace(l_UUID, std::move(l_eventPrototype));
+			g_registeredEventPrototypes.emplace(l_wavObject, l_UUID);
 
 			return l_UUID;
 		}
@@ -32,7 +32,8 @@ namespace Waveless
 		static WsResult Terminate();
 
 		///
-		/// Add an event prototype from a wave object
+		/// Add an event prototype from a wave object.
+		/// When its sample rate isn't the device's, the samples are resampled once and the raw samples of the wave object are released
 		///
 		static uint64_t AddEventPrototype(const WavObject& wavObject);
 
@@ -18,13 +18,12 @@ namespace Waveless
 
 		for (size_t i = 0; i < rhs.size(); i++)
 		{
-			l_real[i] = Math::Linear2dBMag(rhs[i].real());
+			l_real[i] = rhs[i].real();
+			l_imagine[i] = rhs[i].imag();
 		}
 
-		for (size_t i = 0; i < rhs.size(); i++)
-		{
-			l_imagine[i] = Math::Linear2dBMag(rhs[i].imag());
-		}
+		Math::Linear2dBMag(l_real.data(), l_real.data(), l_real.size());
+		Math::Linear2dBMag(l_imagine.data(), l_imagine.data(), l_imagine.size());
 	}
 
 	void Plotter::Plot(const FreqBinArray & rhs)
@@ -0,0 +1,173 @@
+#include "Test.h"
+#include "../Core/Convolver.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::ConvolverTestNS
+{
+	const size_t m_ChannelCount = 2;
+
+	template<class T>
+	std::vector<T> GenerateNoise(size_t count, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<double> l_distribution(-1.0, 1.0);
+		std::vector<T> l_result(count);
+
+		for (auto& i : l_result)
+		{
+			i = (T)l_distribution(generator);
+		}
+
+		return l_result;
+	}
+
+	// The sum of products by the definition in double, read every stride elements of x for one channel of interleaved frames
+	template<class T>
+	std::vector<double> DirectConvolve(const T* x, size_t xCount, const T* h, size_t hCount, size_t stride = 1)
+	{
+		std::vector<double> l_result(xCount + hCount - 1, 0.0);
+
+		for (size_t n = 0; n < xCount; n++)
+		{
+			for (size_t k = 0; k < hCount; k++)
+			{
+				l_result[n + k] += (double)x[n * stride] * (double)h[k];
+			}
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestMath(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		std::mt19937 l_generator(1);
+
+		// Lengths around the block sizes of the FFT method, and kernels longer than the signal
+		std::pair<size_t, size_t> l_sizes[] = { { 1, 1 }, { 5, 3 }, { 100, 7 }, { 1000, 1000 }, { 4097, 300 }, { 7, 5000 }, { 20000, 33 } };
+
+		for (auto& l_size : l_sizes)
+		{
+			auto l_x = GenerateNoise<T>(l_size.first, l_generator);
+			auto l_h = GenerateNoise<T>(l_size.second, l_generator);
+			auto l_reference = DirectConvolve(l_x.data(), l_x.size(), l_h.data(), l_h.size());
+
+			auto l_testCase = std::string("Convolve<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " " + std::to_string(l_size.first) + " * " + std::to_string(l_size.second);
+
+			// The rounding grows with the square root of the sum length
+			auto l_tolerance = tolerance * std::sqrt((double)std::min(l_size.first, l_size.second));
+
+			for (auto l_method : { ConvolutionMethod::Direct, ConvolutionMethod::FFT })
+			{
+				std::vector<T> l_y;
+				Math::Convolve(l_x.data(), l_x.size(), l_h.data(), l_h.size(), l_y, l_method);
+
+				auto l_methodName = l_method == ConvolutionMethod::Direct ? " direct" : " FFT";
+				Check((l_testCase + l_methodName + " size").c_str(), l_y.size() == l_reference.size());
+				CheckError((l_testCase + l_methodName).c_str(), GetMaxError(l_y.data(), l_reference.data(), std::min(l_y.size(), l_reference.size())), l_tolerance);
+			}
+		}
+
+		// The peak of the cross-correlation is at the delay between the signals
+		auto l_y = GenerateNoise<T>(4800, l_generator);
+		std::vector<T> l_x(1234, T(0));
+		l_x.insert(l_x.end(), l_y.begin(), l_y.end());
+
+		std::vector<T> l_r;
+		Math::CrossCorrelate(l_x.data(), l_x.size(), l_y.data(), l_y.size(), l_r);
+		auto l_lag = (ptrdiff_t)(std::max_element(l_r.begin(), l_r.end()) - l_r.begin()) - (ptrdiff_t)(l_y.size() - 1);
+
+		Check((std::string("CrossCorrelate<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " finds the delay").c_str(), l_lag == 1234);
+	}
+
+	template<class T>
+	void TestStreaming(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		std::mt19937 l_generator(2);
+		const size_t l_frameCount = 8000;
+
+		auto l_in = GenerateNoise<T>(l_frameCount * m_ChannelCount, l_generator);
+
+		for (size_t l_blockSize : { 64, 512 })
+		{
+			// Shorter than a block, exactly a block and several partitions
+			for (size_t l_irCount : { 1, 100, 512, 3000 })
+			{
+				// Two filters share the input, the second one is half as long
+				auto l_ir = GenerateNoise<T>(l_irCount, l_generator);
+				auto l_ir2 = GenerateNoise<T>(l_irCount / 2 + 1, l_generator);
+				const T* l_irs[] = { l_ir.data(), nullptr };
+
+				ConvolverT<T> l_convolver;
+				l_convolver.Setup(l_irs, 2, l_irCount, m_ChannelCount, l_blockSize);
+				l_convolver.SetImpulseResponse(1, l_ir2.data(), l_ir2.size());
+
+				std::vector<T> l_out(l_in.size());
+				std::vector<T> l_out2(l_in.size());
+				T* l_outputs[] = { l_out.data(), l_out2.data() };
+
+				// Calls of varying sizes, most of them don't end on a block
+				for (size_t i = 0; i < l_frameCount;)
+				{
+					auto l_count = std::min(l_frameCount - i, 1 + (i * 7) % 333);
+					T* l_blockOutputs[] = { l_outputs[0] + i * m_ChannelCount, l_outputs[1] + i * m_ChannelCount };
+					l_convolver.Process(&l_in[i * m_ChannelCount], l_blockOutputs, l_count, 0, 2);
+					i += l_count;
+				}
+
+				auto l_testCase = std::string("Convolver<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " block " + std::to_string(l_blockSize) + " IR " + std::to_string(l_irCount);
+				auto l_tolerance = tolerance * std::sqrt((double)l_irCount);
+				double l_error = 0.0;
+
+				for (size_t j = 0; j < m_ChannelCount; j++)
+				{
+					auto l_reference = DirectConvolve(&l_in[j], l_frameCount, l_ir.data(), l_ir.size(), m_ChannelCount);
+					auto l_reference2 = DirectConvolve(&l_in[j], l_frameCount, l_ir2.data(), l_ir2.size(), m_ChannelCount);
+
+					// The output is delayed by the block size
+					for (size_t i = l_blockSize; i < l_frameCount; i++)
+					{
+						l_error = std::max(l_error, std::abs((double)l_out[i * m_ChannelCount + j] - l_reference[i - l_blockSize]));
+						l_error = std::max(l_error, std::abs((double)l_out2[i * m_ChannelCount + j] - l_reference2[i - l_blockSize]));
+					}
+				}
+
+				CheckError(l_testCase.c_str(), l_error, l_tolerance);
+			}
+		}
+	}
+
+	// Processing before a successful Setup() or with filters that don't exist returns without touching the outputs
+	void TestInvalidCalls()
+	{
+		std::vector<float> l_in(100 * m_ChannelCount, 1.0f);
+		std::vector<float> l_out(l_in.size(), 2.0f);
+		float* l_outputs[] = { l_out.data(), l_out.data() };
+
+		ConvolverF l_convolver;
+		l_convolver.Process(l_in.data(), l_out.data(), 100);
+
+		float l_ir[] = { 1.0f, 0.5f };
+		const float* l_irs[] = { l_ir, l_ir };
+		l_convolver.Setup(l_irs, 2, 2, m_ChannelCount, 64);
+		l_convolver.Process(l_in.data(), l_outputs, 100, 1, 2);
+		l_convolver.Process(l_in.data(), l_outputs, 100, 3, 0);
+
+		Check("Convolver invalid calls leave the outputs", std::all_of(l_out.begin(), l_out.end(), [](float x) { return x == 2.0f; }));
+	}
+}
+
+using namespace Waveless::Test::ConvolverTestNS;
+
+void Test::TestConvolver()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		TestMath<float>("float", instructionSet, 1e-5);
+		TestMath<double>("double", instructionSet, 1e-13);
+		TestStreaming<float>("float", instructionSet, 1e-5);
+		TestStreaming<double>("double", instructionSet, 1e-13);
+	});
+
+	TestInvalidCalls();
+}
\ No newline at end of file
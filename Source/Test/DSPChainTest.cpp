@@ -0,0 +1,81 @@
+#include "Test.h"
+#include "../Core/DSPChain.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::DSPChainTestNS
+{
+	const double m_SampleRate = 48000.0;
+
+	template<class T>
+	ComplexArrayT<T> GenerateNoise(size_t count)
+	{
+		std::mt19937 l_generator(6);
+		std::uniform_real_distribution<double> l_distribution(-1.0, 1.0);
+		ComplexArrayT<T> l_result(count);
+
+		for (auto& i : l_result)
+		{
+			i = (T)l_distribution(l_generator);
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestComposition(const char* typeName, InstructionSet instructionSet, size_t N, double tolerance)
+	{
+		auto l_testCase = std::string("DSPChain<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " size " + std::to_string(N);
+		auto l_x = GenerateNoise<T>(N);
+
+		// The stages one function at a time, every filter with its own pair of transforms
+		auto l_reference = DSP::Gain(DSP::HPF(DSP::Gain(DSP::LPF(DSP::Gain(l_x, -3.0), m_SampleRate, 5000.0), 4.0), m_SampleRate, 300.0), 1.5);
+
+		// A time domain stage on both sides and a scalar gain between the spectral stages, so one pair of transforms
+		auto l_chain = MakeDSPChain(DSPStage::Gain<T>(-3.0), DSPStage::LPF<T>(5000.0), DSPStage::Gain<T>(4.0), DSPStage::HPF<T>(300.0), DSPStage::Gain<T>(1.5));
+		auto l_y = l_chain.Process(l_x, m_SampleRate);
+
+		Check((l_testCase + " size").c_str(), l_y.size() == N);
+		CheckError((l_testCase + " against the stages one at a time").c_str(), GetMaxError(&l_y[0], &l_reference[0], N), tolerance);
+
+		// Appending the stages composes the same chain
+		auto l_appended = MakeDSPChain(DSPStage::Gain<T>(-3.0)).Then(DSPStage::LPF<T>(5000.0), DSPStage::Gain<T>(4.0)).Then(DSPStage::HPF<T>(300.0), DSPStage::Gain<T>(1.5));
+		auto l_appendedY = l_appended.Process(l_x, m_SampleRate);
+
+		CheckError((l_testCase + " appended with Then").c_str(), GetMaxError(&l_appendedY[0], &l_y[0], N), 0.0);
+
+		// In place
+		auto l_inPlace = l_x;
+		l_chain.Process(l_inPlace, l_inPlace, m_SampleRate);
+
+		CheckError((l_testCase + " in place").c_str(), GetMaxError(&l_inPlace[0], &l_y[0], N), 0.0);
+
+		// Without a spectral stage the samples aren't transformed at all
+		auto l_gains = MakeDSPChain(DSPStage::Gain<T>(-3.0), DSPStage::Gain<T>(4.0));
+		auto l_gainsY = l_gains.Process(l_x, m_SampleRate);
+		auto l_gainsReference = DSP::Gain(DSP::Gain(l_x, -3.0), 4.0);
+
+		CheckError((l_testCase + " time domain stages only").c_str(), GetMaxError(&l_gainsY[0], &l_gainsReference[0], N), 0.0);
+	}
+}
+
+using namespace Waveless::Test::DSPChainTestNS;
+
+void Test::TestDSPChain()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		// A power of two and a mixed radix size
+		for (size_t N : { 4096, 4800 })
+		{
+			TestComposition<float>("float", instructionSet, N, 1e-5);
+			TestComposition<double>("double", instructionSet, N, 1e-12);
+		}
+	});
+
+	// An empty signal runs no transform
+	ComplexArray l_empty;
+	auto l_emptyY = MakeDSPChain(DSPStage::LPF<double>(5000.0)).Process(l_empty, m_SampleRate);
+
+	Check("DSPChain empty signal", l_emptyY.size() == 0);
+}
\ No newline at end of file
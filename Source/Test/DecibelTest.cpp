@@ -0,0 +1,132 @@
+#include "Test.h"
+#include "../Core/Math.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::DecibelTestNS
+{
+	// The tails of every kernel width, and more than a batch block
+	const size_t m_Counts[] = { 1, 7, 33, 4099 };
+
+	// count values spread evenly over [first, last]
+	template<class T>
+	std::vector<T> GenerateRange(double first, double last, size_t count)
+	{
+		std::vector<T> l_result(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			l_result[i] = (T)(first + (last - first) * (double)i / (double)std::max(count - 1, size_t(1)));
+		}
+
+		return l_result;
+	}
+
+	// The largest error of dB = scale * log10(linear) against the exact logarithm in long double, relative to the dB.
+	// Below a decade the rounding of the linear values alone is a few ulps of the scale, so the error is relative to it there
+	template<class T>
+	long double GetError(const std::vector<T>& linear, const std::vector<T>& dB, long double scale)
+	{
+		long double l_result = 0.0l;
+
+		for (size_t i = 0; i < linear.size(); i++)
+		{
+			auto l_reference = scale * std::log10((long double)linear[i]);
+			l_result = std::max(l_result, std::abs((long double)dB[i] - l_reference) / std::max(std::abs(l_reference), scale));
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestRange(const char* typeName, InstructionSet instructionSet)
+	{
+		auto l_testCase = std::string("<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		// The documented bound is a few ulps of the dB, about 1e-4 dB for float and 1e-12 dB for double at the ends of the range
+		const double l_tolerance = 4.0 * std::numeric_limits<T>::epsilon();
+		const auto l_minLog = std::log10((double)std::numeric_limits<T>::min());
+		const auto l_maxLog = std::log10((double)std::numeric_limits<T>::max());
+
+		for (auto l_count : m_Counts)
+		{
+			auto l_countCase = l_testCase + " count " + std::to_string(l_count);
+
+			// Every exponent of the normal values
+			auto l_linear = GenerateRange<T>(0.0, 1.0, l_count);
+
+			for (auto& i : l_linear)
+			{
+				i = std::min((T)std::pow(10.0, l_minLog + (l_maxLog - l_minLog) * (double)i), std::numeric_limits<T>::max());
+			}
+
+			std::vector<T> l_dBAmp(l_count);
+			std::vector<T> l_dBMag(l_count);
+
+			Math::Linear2dBAmp(l_linear.data(), l_dBAmp.data(), l_count);
+			Math::Linear2dBMag(l_linear.data(), l_dBMag.data(), l_count);
+
+			CheckError(("Linear2dBAmp" + l_countCase).c_str(), (double)GetError(l_linear, l_dBAmp, 20.0l), l_tolerance);
+			CheckError(("Linear2dBMag" + l_countCase).c_str(), (double)GetError(l_linear, l_dBMag, 10.0l), l_tolerance);
+
+			// The dB of every exponent, short of the ends where the rounding of the result could overflow or lose bits to a denormal, in place
+			auto l_ampIn = GenerateRange<T>(20.0 * l_minLog + 0.01, 20.0 * l_maxLog - 0.01, l_count);
+			auto l_magIn = GenerateRange<T>(10.0 * l_minLog + 0.01, 10.0 * l_maxLog - 0.01, l_count);
+			auto l_amp = l_ampIn;
+			auto l_mag = l_magIn;
+
+			Math::DB2LinearAmp(l_amp.data(), l_amp.data(), l_count);
+			Math::DB2LinearMag(l_mag.data(), l_mag.data(), l_count);
+
+			CheckError(("DB2LinearAmp" + l_countCase).c_str(), (double)GetError(l_amp, l_ampIn, 20.0l), l_tolerance);
+			CheckError(("DB2LinearMag" + l_countCase).c_str(), (double)GetError(l_mag, l_magIn, 10.0l), l_tolerance);
+		}
+
+		// The values out of the range of the approximations fall back to the exact functions, at every position of a kernel call
+		const T l_inf = std::numeric_limits<T>::infinity();
+		const T l_NaN = std::numeric_limits<T>::quiet_NaN();
+		const T l_denormal = std::numeric_limits<T>::denorm_min() * T(3);
+
+		std::vector<T> l_special = { T(0), T(-1), l_denormal, l_inf, -l_inf, l_NaN, T(1), T(10) };
+		std::vector<T> l_specialExpected = { -l_inf, l_NaN, T(20) * std::log10(l_denormal), l_inf, l_NaN, l_NaN, T(0), T(20) };
+		std::vector<T> l_underOverflow = { T(-1e5), T(1e5), -l_inf, l_inf, l_NaN, T(0), T(-20), T(40) };
+		std::vector<T> l_underOverflowExpected = { T(0), l_inf, T(0), l_inf, l_NaN, T(1), T(0.1), T(100) };
+
+		bool l_isEqual = true;
+
+		auto l_isSame = [](T lhs, T rhs)
+		{
+			return (std::isnan(lhs) && std::isnan(rhs)) || lhs == rhs || std::abs(lhs - rhs) <= std::abs(rhs) * T(1e-5);
+		};
+
+		for (size_t l_offset = 0; l_offset < 16; l_offset++)
+		{
+			for (size_t i = 0; i < l_special.size(); i++)
+			{
+				std::vector<T> l_in(l_offset + l_special.size() + 16, T(1));
+				std::vector<T> l_out(l_in.size());
+
+				l_in[l_offset + i] = l_special[i];
+				Math::Linear2dBAmp(l_in.data(), l_out.data(), l_in.size());
+				l_isEqual = l_isEqual && l_isSame(l_out[l_offset + i], l_specialExpected[i]);
+
+				l_in[l_offset + i] = l_underOverflow[i];
+				Math::DB2LinearAmp(l_in.data(), l_out.data(), l_in.size());
+				l_isEqual = l_isEqual && l_isSame(l_out[l_offset + i], l_underOverflowExpected[i]);
+			}
+		}
+
+		Check(("Batch dB" + l_testCase + " values out of range").c_str(), l_isEqual);
+	}
+}
+
+using namespace Waveless::Test::DecibelTestNS;
+
+void Test::TestDecibels()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		TestRange<float>("float", instructionSet);
+		TestRange<double>("double", instructionSet);
+	});
+}
\ No newline at end of file
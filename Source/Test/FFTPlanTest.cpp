@@ -0,0 +1,111 @@
+#include "Test.h"
+#include "../Core/FFTPlan.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::FFTPlanTestNS
+{
+	// Mixed radix sizes, primes over 13 run Bluestein's algorithm
+	const size_t m_Sizes[] = { 1, 2, 3, 5, 8, 12, 16, 17, 64, 97, 128, 360, 1024, 4096 };
+
+	std::vector<ComplexT<double>> GenerateSignal(size_t N, bool isReal)
+	{
+		std::vector<ComplexT<double>> l_result(N);
+
+		for (size_t i = 0; i < N; i++)
+		{
+			auto l_re = std::sin(0.37 * (double)i) + 0.25 * std::cos(1.91 * (double)i);
+			auto l_im = isReal ? 0.0 : std::cos(0.53 * (double)i) - 0.5;
+			l_result[i] = ComplexT<double>(l_re, l_im);
+		}
+
+		return l_result;
+	}
+
+	// The error relative to the largest bin, a plan is fine when it's a few ulps of log2(N) operations
+	double GetRelativeError(const std::vector<ComplexT<double>>& reference, double error)
+	{
+		double l_peak = 0.0;
+
+		for (auto& i : reference)
+		{
+			l_peak = std::max(l_peak, std::abs(i));
+		}
+
+		return l_peak > 0.0 ? error / l_peak : error;
+	}
+
+	template<class T>
+	void TestComplex(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		for (auto N : m_Sizes)
+		{
+			auto l_signal = GenerateSignal(N, false);
+			auto l_reference = DirectDFT(l_signal);
+
+			std::vector<ComplexT<T>> l_in(N);
+			std::vector<ComplexT<T>> l_out(N);
+			std::vector<ComplexT<T>> l_roundTrip(N);
+
+			for (size_t i = 0; i < N; i++)
+			{
+				l_in[i] = ComplexT<T>(l_signal[i]);
+			}
+
+			auto l_plan = FFTPlanT<T>::Get(N);
+			std::vector<ComplexT<T>> l_scratch(l_plan->GetScratchSize());
+
+			l_plan->Forward(l_in.data(), l_out.data(), l_scratch.data());
+			l_plan->Inverse(l_out.data(), l_roundTrip.data(), l_scratch.data());
+
+			auto l_testCase = std::string("FFTPlan<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " N = " + std::to_string(N);
+
+			CheckError((l_testCase + " forward").c_str(), GetRelativeError(l_reference, GetMaxError(l_out.data(), l_reference.data(), N)), tolerance);
+			CheckError((l_testCase + " round trip").c_str(), GetRelativeError(l_signal, GetMaxError(l_roundTrip.data(), l_in.data(), N)), tolerance);
+		}
+	}
+
+	template<class T>
+	void TestReal(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		for (auto N : m_Sizes)
+		{
+			auto l_signal = GenerateSignal(N, true);
+			auto l_reference = DirectDFT(l_signal);
+
+			auto l_plan = RealFFTPlanT<T>::Get(N);
+			auto l_binCount = l_plan->GetBinCount();
+
+			std::vector<T> l_in(N);
+			std::vector<ComplexT<T>> l_out(l_binCount);
+			std::vector<T> l_roundTrip(N);
+			std::vector<ComplexT<T>> l_scratch(l_plan->GetScratchSize());
+
+			for (size_t i = 0; i < N; i++)
+			{
+				l_in[i] = (T)l_signal[i].real();
+			}
+
+			l_plan->Forward(l_in.data(), l_out.data(), l_scratch.data());
+			l_plan->Inverse(l_out.data(), l_roundTrip.data(), l_scratch.data());
+
+			auto l_testCase = std::string("RealFFTPlan<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " N = " + std::to_string(N);
+
+			CheckError((l_testCase + " forward").c_str(), GetRelativeError(l_reference, GetMaxError(l_out.data(), l_reference.data(), l_binCount)), tolerance);
+			CheckError((l_testCase + " round trip").c_str(), GetRelativeError(l_signal, GetMaxError(l_roundTrip.data(), l_in.data(), N)), tolerance);
+		}
+	}
+}
+
+using namespace Waveless::Test::FFTPlanTestNS;
+
+void Test::TestFFTPlans()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		TestComplex<float>("float", instructionSet, 1e-5);
+		TestComplex<double>("double", instructionSet, 1e-13);
+		TestReal<float>("float", instructionSet, 1e-5);
+		TestReal<double>("double", instructionSet, 1e-13);
+	});
+}
\ No newline at end of file
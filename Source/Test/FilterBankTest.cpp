@@ -0,0 +1,136 @@
+#include "Test.h"
+#include "../Core/FilterBank.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::FilterBankTestNS
+{
+	const double m_SampleRate = 48000.0;
+	const size_t m_ChannelCount = 2;
+	const size_t m_FrameCount = 16384;
+
+	// Process an impulse on every channel in calls of varying sizes
+	template<class T, class ProcessFunction>
+	std::vector<T> ProcessImpulse(ProcessFunction process)
+	{
+		std::vector<T> l_impulse(m_FrameCount * m_ChannelCount, T(0));
+		std::fill(l_impulse.begin(), l_impulse.begin() + m_ChannelCount, T(1));
+
+		for (size_t i = 0; i < m_FrameCount;)
+		{
+			auto l_count = std::min(m_FrameCount - i, 1 + (i * 7) % 333);
+			process(&l_impulse[i * m_ChannelCount], i, l_count);
+			i += l_count;
+		}
+
+		return l_impulse;
+	}
+
+	// The magnitude at the frequency f of the impulse response read every m_ChannelCount samples
+	template<class T>
+	double GetMagnitude(const T* impulseResponse, double f)
+	{
+		ComplexT<double> l_sum(0.0, 0.0);
+		auto l_omega = 2.0 * PI<double> * f / m_SampleRate;
+
+		for (size_t i = 0; i < m_FrameCount; i++)
+		{
+			l_sum += (double)impulseResponse[i * m_ChannelCount] * std::polar(1.0, -l_omega * (double)i);
+		}
+
+		return std::abs(l_sum);
+	}
+
+	template<class T>
+	void TestBands(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		const double l_crossovers[] = { 100.0, 1000.0, 8000.0 };
+
+		FilterBankT<T> l_filterBank;
+		l_filterBank.Setup(m_SampleRate, l_crossovers, 3, m_ChannelCount);
+
+		auto l_bandCount = l_filterBank.GetBandCount();
+		auto l_latency = l_filterBank.GetLatency();
+
+		Check((std::string("FilterBank<") + typeName + "> impulse responses fit the test signal").c_str(), l_latency + l_filterBank.GetFilterLength() < m_FrameCount);
+
+		std::vector<std::vector<T>> l_bands(l_bandCount, std::vector<T>(m_FrameCount * m_ChannelCount));
+
+		ProcessImpulse<T>([&](const T* in, size_t frame, size_t frameCount)
+		{
+			std::vector<T*> l_outputs;
+
+			for (auto& i : l_bands)
+			{
+				l_outputs.emplace_back(&i[frame * m_ChannelCount]);
+			}
+
+			l_filterBank.ProcessBands(in, l_outputs.data(), frameCount);
+		});
+
+		auto l_testCase = std::string("FilterBank<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		// The bands sum to the impulse delayed by the latency
+		std::vector<T> l_sum(m_FrameCount * m_ChannelCount, T(0));
+		std::vector<T> l_delayedImpulse(m_FrameCount * m_ChannelCount, T(0));
+		std::fill(l_delayedImpulse.begin() + l_latency * m_ChannelCount, l_delayedImpulse.begin() + (l_latency + 1) * m_ChannelCount, T(1));
+
+		for (auto& i : l_bands)
+		{
+			for (size_t j = 0; j < l_sum.size(); j++)
+			{
+				l_sum[j] += i[j];
+			}
+		}
+
+		CheckError((l_testCase + " sum of the bands").c_str(), GetMaxError(l_sum.data(), l_delayedImpulse.data(), l_sum.size()), tolerance);
+
+		// Each band follows its target magnitude in the passband, the crossfades and the stopband.
+		// The window smooths the target over a few bins, which is the largest deviation on the crossfade of the lowest crossover
+		const double l_frequencies[] = { 30.0, 100.0, 300.0, 1000.0, 3000.0, 8000.0, 16000.0 };
+		double l_magnitudeError = 0.0;
+
+		for (size_t k = 0; k < l_bandCount; k++)
+		{
+			for (auto f : l_frequencies)
+			{
+				l_magnitudeError = std::max(l_magnitudeError, std::abs(GetMagnitude(l_bands[k].data(), f) - l_filterBank.GetBandResponse(k, f)));
+			}
+		}
+
+		CheckError((l_testCase + " band magnitudes").c_str(), l_magnitudeError, 0.01);
+
+		// The gain curve is the sum of the bands weighted by their gains
+		const double l_gainLevels[] = { 6.0, -3.0, 0.0, -12.0 };
+		l_filterBank.SetBandGains(l_gainLevels);
+		l_filterBank.Reset();
+
+		auto l_curve = ProcessImpulse<T>([&](T* x, size_t, size_t frameCount)
+		{
+			l_filterBank.Process(x, x, frameCount);
+		});
+
+		std::vector<double> l_weightedSum(l_curve.size(), 0.0);
+
+		for (size_t k = 0; k < l_bandCount; k++)
+		{
+			for (size_t j = 0; j < l_weightedSum.size(); j++)
+			{
+				l_weightedSum[j] += Math::DB2LinearAmp(l_gainLevels[k]) * (double)l_bands[k][j];
+			}
+		}
+
+		CheckError((l_testCase + " gain curve").c_str(), GetMaxError(l_curve.data(), l_weightedSum.data(), l_curve.size()), tolerance);
+	}
+}
+
+using namespace Waveless::Test::FilterBankTestNS;
+
+void Test::TestFilterBank()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		TestBands<float>("float", instructionSet, 1e-5);
+		TestBands<double>("double", instructionSet, 1e-12);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "Test.h"
+#include "../Core/GainProcessor.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::GainProcessorTestNS
+{
+	const double m_SampleRate = 48000.0;
+	// 480 frames at 48 kHz
+	const double m_RampTime = 0.01;
+	const size_t m_RampFrames = 480;
+	const size_t m_ChannelCount = 2;
+
+	// The gains applied to frameCount frames of ones, processed in blocks of blockSize frames
+	std::vector<double> GetGains(GainProcessor& gainProcessor, size_t frameCount, size_t blockSize)
+	{
+		std::vector<double> l_samples(frameCount * m_ChannelCount, 1.0);
+
+		for (size_t i = 0; i < frameCount; i += blockSize)
+		{
+			gainProcessor.Process(&l_samples[i * m_ChannelCount], std::min(blockSize, frameCount - i), m_ChannelCount);
+		}
+
+		std::vector<double> l_result(frameCount);
+
+		for (size_t i = 0; i < frameCount; i++)
+		{
+			l_result[i] = l_samples[i * m_ChannelCount];
+
+			for (size_t j = 1; j < m_ChannelCount; j++)
+			{
+				if (l_samples[i * m_ChannelCount + j] != l_result[i])
+				{
+					l_result[i] = NAN;
+				}
+			}
+		}
+
+		return l_result;
+	}
+
+	// The largest change of the gain between two frames, from the gain before the first one
+	double GetMaxJump(double gain, const std::vector<double>& gains)
+	{
+		double l_result = 0.0;
+
+		for (auto i : gains)
+		{
+			l_result = std::max(l_result, std::abs(i - gain));
+			gain = i;
+		}
+
+		return l_result;
+	}
+
+	void TestRamp(const char* rampName, GainRamp gainRamp)
+	{
+		auto l_testCase = std::string("GainProcessor ") + rampName;
+		auto l_target = Math::DB2LinearAmp(-6.0);
+
+		GainProcessor l_gainProcessor;
+		l_gainProcessor.Setup(m_SampleRate, m_RampTime, gainRamp);
+		l_gainProcessor.SetGainLevel(-6.0);
+
+		// Blocks that don't divide the ramp, so it's cut between the calls
+		auto l_gains = GetGains(l_gainProcessor, 2 * m_RampFrames, 97);
+
+		std::vector<double> l_reference(2 * m_RampFrames, l_target);
+
+		for (size_t i = 0; i < m_RampFrames; i++)
+		{
+			auto l_position = (double)(i + 1) / (double)m_RampFrames;
+			l_reference[i] = gainRamp == GainRamp::Linear ? 1.0 + (l_target - 1.0) * l_position : std::pow(l_target, l_position);
+		}
+
+		CheckError((l_testCase + " ramp").c_str(), GetMaxError(l_gains.data(), l_reference.data(), l_gains.size()), 1e-12);
+		Check((l_testCase + " reaches the target").c_str(), !l_gainProcessor.IsRamping() && l_gainProcessor.GetGain() == l_target);
+
+		// A change in the middle of a ramp starts from the gain reached so far
+		l_gainProcessor.SetGainLevel(0.0);
+		auto l_first = GetGains(l_gainProcessor, m_RampFrames / 2, 31);
+		auto l_gain = l_gainProcessor.GetGain();
+		l_gainProcessor.SetGainLevel(-12.0);
+		auto l_second = GetGains(l_gainProcessor, 2 * m_RampFrames, 64);
+
+		// The steepest step of a ramp from -6 dB to 0 dB or from there to -12 dB
+		auto l_maxStep = gainRamp == GainRamp::Linear ? 1.0 / (double)m_RampFrames : std::abs(1.0 - std::pow(Math::DB2LinearAmp(-12.0), 1.0 / (double)m_RampFrames));
+
+		CheckError((l_testCase + " continuity").c_str(), std::max(GetMaxJump(l_target, l_first), GetMaxJump(l_gain, l_second)), l_maxStep + 1e-12);
+		Check((l_testCase + " reaches the changed target").c_str(), l_second.back() == Math::DB2LinearAmp(-12.0));
+	}
+}
+
+using namespace Waveless::Test::GainProcessorTestNS;
+
+void Test::TestGainProcessor()
+{
+	TestRamp("linear", GainRamp::Linear);
+	TestRamp("exponential", GainRamp::Exponential);
+
+	GainProcessor l_gainProcessor;
+	l_gainProcessor.Setup(m_SampleRate, m_RampTime);
+	l_gainProcessor.SetGainLevel(0.0);
+
+	auto l_gains = GetGains(l_gainProcessor, m_RampFrames, m_RampFrames);
+	std::vector<double> l_ones(m_RampFrames, 1.0);
+
+	Check("GainProcessor starts at 0 dB without a ramp", !l_gainProcessor.IsRamping() && GetMaxError(l_gains.data(), l_ones.data(), m_RampFrames) == 0.0);
+}
\ No newline at end of file
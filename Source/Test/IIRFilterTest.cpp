@@ -0,0 +1,163 @@
+#include "Test.h"
+#include "../Core/IIRFilter.h"
+#include "../Core/DSPChain.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::IIRFilterTestNS
+{
+	const double m_SampleRate = 48000.0;
+	// Long enough for the responses around 1 kHz to decay under the precision of double
+	const size_t m_ResponseSize = 8192;
+	const size_t m_ChannelCount = 2;
+
+	// The impulse response of every channel, processed in blocks that don't divide the size to cross the calls with a state
+	template<class T>
+	std::vector<T> GetImpulseResponse(const FilterDesc& filterDesc)
+	{
+		IIRFilterT<T> l_filter;
+		l_filter.Setup(filterDesc, m_SampleRate, m_ChannelCount);
+
+		std::vector<T> l_result(m_ResponseSize * m_ChannelCount, T(0));
+		std::fill(l_result.begin(), l_result.begin() + m_ChannelCount, T(1));
+
+		for (size_t i = 0; i < m_ResponseSize; i += 100)
+		{
+			l_filter.Process(&l_result[i * m_ChannelCount], std::min(m_ResponseSize - i, size_t(100)));
+		}
+
+		return l_result;
+	}
+
+	// The gain in dB at the frequency f, by the DTFT of the impulse response of the first channel
+	double GetGainLevel(const std::vector<double>& impulseResponse, double f)
+	{
+		ComplexT<double> l_sum(0.0, 0.0);
+		auto l_omega = 2.0 * PI<double> * f / m_SampleRate;
+
+		for (size_t i = 0; i < m_ResponseSize; i++)
+		{
+			l_sum += impulseResponse[i * m_ChannelCount] * std::polar(1.0, -l_omega * (double)i);
+		}
+
+		return 20.0 * std::log10(std::abs(l_sum));
+	}
+
+	// The IIR stages of a chain keep their state, a signal processed in blocks is the same as processed at once
+	void TestChainBlocks()
+	{
+		FilterDesc l_LPFDesc;
+		l_LPFDesc.m_FilterType = FilterType::LowPass;
+		l_LPFDesc.m_Frequency = 5000.0;
+		l_LPFDesc.m_Order = 4;
+
+		FilterDesc l_HPFDesc;
+		l_HPFDesc.m_FilterType = FilterType::HighPass;
+		l_HPFDesc.m_Frequency = 300.0;
+		l_HPFDesc.m_Order = 3;
+
+		std::mt19937 l_generator(5);
+		std::uniform_real_distribution<double> l_distribution(-1.0, 1.0);
+		std::vector<ComplexT<double>> l_x(m_ResponseSize);
+
+		for (auto& i : l_x)
+		{
+			i = l_distribution(l_generator);
+		}
+
+		auto l_chain = MakeDSPChain(DSPStage::Gain<double>(-6.0), DSPStage::IIR<double>(l_LPFDesc), DSPStage::IIR<double>(l_HPFDesc));
+		auto l_blockChain = l_chain;
+
+		std::vector<ComplexT<double>> l_y(l_x.size());
+		l_chain.Process(l_x.data(), l_y.data(), l_x.size(), m_SampleRate);
+
+		// Blocks of varying sizes, most of them don't end on the 256 samples of the stage
+		std::vector<ComplexT<double>> l_blockY(l_x.size());
+
+		for (size_t i = 0; i < l_x.size();)
+		{
+			auto l_count = std::min(l_x.size() - i, 1 + (i * 7) % 333);
+			l_blockChain.Process(&l_x[i], &l_blockY[i], l_count, m_SampleRate);
+			i += l_count;
+		}
+
+		CheckError("DSPChain IIR stages in blocks against at once", GetMaxError(l_blockY.data(), l_y.data(), l_y.size()), 1e-12);
+
+		// The same filters streamed directly
+		IIRFilter l_LPF;
+		IIRFilter l_HPF;
+		l_LPF.Setup(l_LPFDesc, m_SampleRate);
+		l_HPF.Setup(l_HPFDesc, m_SampleRate);
+
+		std::vector<double> l_reference(l_x.size());
+
+		for (size_t i = 0; i < l_x.size(); i++)
+		{
+			l_reference[i] = Math::DB2LinearAmp(-6.0) * l_x[i].real();
+		}
+
+		l_LPF.Process(l_reference.data(), l_reference.size());
+		l_HPF.Process(l_reference.data(), l_reference.size());
+
+		CheckError("DSPChain IIR stages against IIRFilter", GetMaxError(l_y.data(), l_reference.data(), l_y.size()), 1e-12);
+	}
+}
+
+using namespace Waveless::Test::IIRFilterTestNS;
+
+void Test::TestIIRFilters()
+{
+	const char* l_typeNames[] = { "LowPass", "HighPass", "BandPass", "Notch", "Peak", "LowShelf", "HighShelf" };
+
+	for (auto l_type = (int)FilterType::LowPass; l_type <= (int)FilterType::HighShelf; l_type++)
+	{
+		for (size_t l_order = 1; l_order <= 4; l_order++)
+		{
+			FilterDesc l_filterDesc;
+			l_filterDesc.m_FilterType = (FilterType)l_type;
+			l_filterDesc.m_Frequency = 1000.0;
+			l_filterDesc.m_Order = l_order;
+			l_filterDesc.m_Q = 1.0;
+			l_filterDesc.m_GainLevel = 6.0;
+
+			auto l_testCase = std::string("IIRFilter ") + l_typeNames[l_type] + " order " + std::to_string(l_order);
+
+			l_filterDesc.m_Topology = FilterTopology::Biquad;
+			auto l_biquad = GetImpulseResponse<double>(l_filterDesc);
+			auto l_biquadF = GetImpulseResponse<float>(l_filterDesc);
+
+			l_filterDesc.m_Topology = FilterTopology::SVF;
+			auto l_SVF = GetImpulseResponse<double>(l_filterDesc);
+
+			// Both topologies discretize the same analog prototype, so the responses are the same up to rounding
+			CheckError((l_testCase + " SVF against biquad").c_str(), GetMaxError(l_SVF.data(), l_biquad.data(), l_biquad.size()), 1e-12);
+			CheckError((l_testCase + " float against double").c_str(), GetMaxError(l_biquadF.data(), l_biquad.data(), l_biquad.size()), 1e-5);
+
+			// The gains the descriptor asks for
+			switch (l_filterDesc.m_FilterType)
+			{
+			case FilterType::LowPass:
+			case FilterType::HighPass:
+				CheckError((l_testCase + " -3 dB at the cut-off").c_str(), std::abs(GetGainLevel(l_biquad, 1000.0) + 10.0 * std::log10(2.0)), 1e-6);
+				break;
+			case FilterType::BandPass:
+				CheckError((l_testCase + " 0 dB at the center").c_str(), std::abs(GetGainLevel(l_biquad, 1000.0)), 1e-6);
+				break;
+			case FilterType::Peak:
+				CheckError((l_testCase + " gain at the center").c_str(), std::abs(GetGainLevel(l_biquad, 1000.0) - 6.0), 1e-6);
+				break;
+			case FilterType::LowShelf:
+				CheckError((l_testCase + " gain at DC").c_str(), std::abs(GetGainLevel(l_biquad, 0.0) - 6.0), 1e-6);
+				break;
+			case FilterType::HighShelf:
+				CheckError((l_testCase + " gain at Nyquist").c_str(), std::abs(GetGainLevel(l_biquad, m_SampleRate / 2.0) - 6.0), 1e-6);
+				break;
+			default:
+				Check((l_testCase + " rejects the center").c_str(), GetGainLevel(l_biquad, 1000.0) < -100.0);
+				break;
+			}
+		}
+	}
+
+	TestChainBlocks();
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "Test.h"
+#include "../Core/OscillatorBank.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::OscillatorBankTestNS
+{
+	const double m_SampleRate = 48000.0;
+	// 10 seconds, thousands of resyncs
+	const size_t m_FrameCount = 480000;
+
+	// A partial by the definition, the phase is accumulated in long double and every ramp is linear in the frequency and the amplitude
+	struct Partial
+	{
+		long double m_Phase = 0.0l;
+		long double m_Frequency = 0.0l;
+		long double m_Amplitude = 0.0l;
+		long double m_FrequencyStep = 0.0l;
+		long double m_AmplitudeStep = 0.0l;
+		long double m_TargetFrequency = 0.0l;
+		long double m_TargetAmplitude = 0.0l;
+		size_t m_RampFramesLeft = 0;
+
+		long double Next()
+		{
+			auto l_result = m_Amplitude * std::sin(m_Phase);
+
+			m_Phase += 2.0l * PI<long double> * m_Frequency / (long double)m_SampleRate;
+			m_Phase -= 2.0l * PI<long double> * std::floor(m_Phase / (2.0l * PI<long double>));
+
+			if (m_RampFramesLeft)
+			{
+				m_Frequency += m_FrequencyStep;
+				m_Amplitude += m_AmplitudeStep;
+
+				if (!--m_RampFramesLeft)
+				{
+					m_Frequency = m_TargetFrequency;
+					m_Amplitude = m_TargetAmplitude;
+				}
+			}
+
+			return l_result;
+		}
+
+		void Ramp(long double frequency, long double amplitude, size_t rampFrames)
+		{
+			m_FrequencyStep = (frequency - m_Frequency) / (long double)rampFrames;
+			m_AmplitudeStep = (amplitude - m_Amplitude) / (long double)rampFrames;
+			m_TargetFrequency = frequency;
+			m_TargetAmplitude = amplitude;
+			m_RampFramesLeft = rampFrames;
+		}
+	};
+
+	// Render in calls of varying sizes that don't line up with the blocks nor the resyncs, ramp is called at the frame rampFrame
+	template<class T, class RampFunction>
+	std::vector<T> Render(OscillatorBankT<T>& bank, size_t rampFrame, RampFunction ramp)
+	{
+		std::vector<T> l_result(m_FrameCount);
+
+		for (size_t i = 0; i < m_FrameCount;)
+		{
+			auto l_count = std::min(m_FrameCount - i, 1 + (i * 7) % 333);
+
+			if (i == rampFrame)
+			{
+				ramp();
+			}
+			else if (i < rampFrame && rampFrame < i + l_count)
+			{
+				l_count = rampFrame - i;
+			}
+
+			bank.Process(&l_result[i], l_count);
+			i += l_count;
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestPartials(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		auto l_testCase = std::string("OscillatorBank<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		// More partials than the lanes of a kernel, up to the Nyquist frequency
+		const size_t l_partialCount = 21;
+		const size_t l_rampFrame = 100000;
+		const size_t l_rampFrames = 50000;
+
+		OscillatorBankT<T> l_bank;
+		l_bank.Setup(m_SampleRate, l_partialCount);
+
+		std::vector<Partial> l_partials(l_partialCount);
+
+		for (size_t i = 0; i < l_partialCount; i++)
+		{
+			auto l_frequency = 20.0 + 1151.3 * (double)i;
+			auto l_amplitude = 1.0 / (double)(i + 1);
+			auto l_phase = 0.37 * (double)i;
+
+			l_bank.SetPartial(i, l_frequency, l_amplitude, l_phase);
+			l_partials[i].m_Frequency = l_frequency;
+			l_partials[i].m_Amplitude = l_amplitude;
+			l_partials[i].m_Phase = l_phase;
+		}
+
+		// Every other partial glides to another frequency and amplitude in the middle of the signal
+		auto l_ramp = [&](auto& partials, auto ramp)
+		{
+			for (size_t i = 0; i < l_partialCount; i += 2)
+			{
+				ramp(partials, i, 12000.0 - 500.0 * (double)i, 0.5 / (double)(i + 1), l_rampFrames + 1000 * i);
+			}
+		};
+
+		auto l_out = Render(l_bank, l_rampFrame, [&]()
+		{
+			l_ramp(l_bank, [](OscillatorBankT<T>& bank, size_t i, double f, double a, size_t rampFrames) { bank.RampPartial(i, f, a, rampFrames); });
+		});
+
+		double l_steadyError = 0.0;
+		double l_rampError = 0.0;
+
+		for (size_t n = 0; n < m_FrameCount; n++)
+		{
+			if (n == l_rampFrame)
+			{
+				l_ramp(l_partials, [](std::vector<Partial>& partials, size_t i, double f, double a, size_t rampFrames) { partials[i].Ramp(f, a, rampFrames); });
+			}
+
+			long double l_reference = 0.0l;
+
+			for (auto& i : l_partials)
+			{
+				l_reference += i.Next();
+			}
+
+			auto l_error = (double)std::abs((long double)l_out[n] - l_reference);
+			auto& l_maxError = n < l_rampFrame ? l_steadyError : l_rampError;
+			l_maxError = std::max(l_maxError, l_error);
+		}
+
+		CheckError((l_testCase + " steady partials").c_str(), l_steadyError, tolerance);
+		CheckError((l_testCase + " ramps").c_str(), l_rampError, tolerance);
+
+		// The invalid partials are rejected, and accumulate adds to the output
+		Check((l_testCase + " partial out of range").c_str(), l_bank.SetPartial(l_partialCount, 100.0, 1.0) == WsResult::Fail && l_bank.RampPartial(l_partialCount, 100.0, 1.0, 10) == WsResult::Fail);
+
+		OscillatorBankT<T> l_single;
+		l_single.Setup(m_SampleRate, 1);
+		l_single.SetPartial(0, 1000.0, 0.5);
+
+		std::vector<T> l_accumulated(1000, T(1));
+		l_single.Process(l_accumulated.data(), l_accumulated.size(), true);
+
+		double l_accumulateError = 0.0;
+
+		for (size_t n = 0; n < l_accumulated.size(); n++)
+		{
+			l_accumulateError = std::max(l_accumulateError, std::abs((double)l_accumulated[n] - 1.0 - 0.5 * std::sin(2.0 * PI<double> * 1000.0 * (double)n / m_SampleRate)));
+		}
+
+		CheckError((l_testCase + " accumulate").c_str(), l_accumulateError, tolerance);
+	}
+}
+
+using namespace Waveless::Test::OscillatorBankTestNS;
+
+void Test::TestOscillatorBank()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		// The phasors drift for at most a resync interval. In double the rounding of the rotations per sample adds up over the 10 seconds
+		TestPartials<float>("float", instructionSet, 1e-4);
+		TestPartials<double>("double", instructionSet, 1e-9);
+	});
+}
\ No newline at end of file
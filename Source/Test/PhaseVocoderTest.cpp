@@ -0,0 +1,216 @@
+#include "Test.h"
+#include "../Core/PhaseVocoder.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::PhaseVocoderTestNS
+{
+	const double m_SampleRate = 48000.0;
+	const size_t m_SampleCount = 48000;
+	const size_t m_WindowSize = 2048;
+	const double m_Amplitude = 0.5;
+
+	template<class T>
+	std::vector<T> GenerateTone(double frequency, size_t count)
+	{
+		std::vector<T> l_result(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			l_result[i] = (T)(m_Amplitude * std::sin(2.0 * PI<double> * frequency * (double)i / m_SampleRate));
+		}
+
+		return l_result;
+	}
+
+	// The frequency of a tone from the times of its rising zero crossings in [begin, end), interpolated between the samples
+	template<class T>
+	double GetFrequency(const std::vector<T>& x, size_t begin, size_t end)
+	{
+		double l_first = -1.0;
+		double l_last = -1.0;
+		size_t l_cycleCount = 0;
+
+		for (size_t i = begin + 1; i < end; i++)
+		{
+			if (x[i - 1] < T(0) && x[i] >= T(0))
+			{
+				auto l_time = (double)(i - 1) + (double)x[i - 1] / (double)(x[i - 1] - x[i]);
+
+				if (l_first < 0.0)
+				{
+					l_first = l_time;
+				}
+				else
+				{
+					l_cycleCount++;
+				}
+
+				l_last = l_time;
+			}
+		}
+
+		return l_cycleCount ? (double)l_cycleCount * m_SampleRate / (l_last - l_first) : 0.0;
+	}
+
+	// The amplitude of x at the frequency f over [begin, begin + count) with a Hann window
+	template<class T>
+	double GetAmplitude(const std::vector<T>& x, size_t begin, size_t count, double f)
+	{
+		ComplexT<double> l_sum(0.0, 0.0);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto l_window = 0.5 - 0.5 * std::cos(2.0 * PI<double> * (double)i / (double)count);
+			l_sum += l_window * (double)x[begin + i] * std::polar(1.0, -2.0 * PI<double> * f * (double)i / m_SampleRate);
+		}
+
+		return 4.0 * std::abs(l_sum) / (double)count;
+	}
+
+	// Stream the input in pushes and pulls of sizes that don't line up with each other nor with the hops
+	template<class T>
+	std::vector<T> Stream(PhaseVocoderT<T>& phaseVocoder, const std::vector<T>& in)
+	{
+		size_t l_pushed = 0;
+		std::vector<T> l_block(777);
+		std::vector<T> l_result;
+
+		phaseVocoder.Reset();
+
+		while (true)
+		{
+			if (l_pushed < in.size())
+			{
+				auto l_count = std::min(in.size() - l_pushed, size_t(1000));
+				phaseVocoder.Push(&in[l_pushed], l_count);
+				l_pushed += l_count;
+
+				if (l_pushed == in.size())
+				{
+					phaseVocoder.Flush();
+				}
+			}
+
+			auto l_pulled = phaseVocoder.Pull(l_block.data(), l_block.size());
+			l_result.insert(l_result.end(), l_block.begin(), l_block.begin() + l_pulled);
+
+			if (l_pushed == in.size() && !l_pulled)
+			{
+				return l_result;
+			}
+		}
+	}
+
+	template<class T>
+	void TestStretches(const char* typeName, InstructionSet instructionSet, double identityTolerance, double tolerance)
+	{
+		auto l_testCase = std::string("PhaseVocoder<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		// Noise has no stable partials, without a stretch nor a shift the frames still overlap-add to the input
+		std::mt19937 l_generator(4);
+		std::uniform_real_distribution<double> l_distribution(-1.0, 1.0);
+		std::vector<T> l_noise(m_SampleCount);
+
+		for (auto& i : l_noise)
+		{
+			i = (T)l_distribution(l_generator);
+		}
+
+		PhaseVocoderDesc l_desc;
+		l_desc.m_WindowDesc = { WindowType::Hann, m_WindowSize, 0 };
+
+		PhaseVocoderT<T> l_phaseVocoder;
+		l_phaseVocoder.Setup(l_desc);
+
+		std::vector<T> l_out;
+		l_phaseVocoder.Render(l_noise.data(), l_noise.size(), l_out);
+
+		Check((l_testCase + " identity length").c_str(), l_out.size() == l_noise.size());
+		CheckError((l_testCase + " identity").c_str(), GetMaxError(l_out.data(), l_noise.data(), std::min(l_out.size(), l_noise.size())), identityTolerance);
+
+		// The output length follows the stretch, and a tone keeps its frequency and amplitude
+		const double l_frequency = 440.0;
+		auto l_tone = GenerateTone<T>(l_frequency, m_SampleCount);
+
+		for (auto l_timeStretch : { 0.5, 0.8, 1.5, 2.0 })
+		{
+			auto l_stretchCase = l_testCase + " stretch " + std::to_string(l_timeStretch);
+
+			l_phaseVocoder.SetTimeStretch(l_timeStretch);
+			l_phaseVocoder.Render(l_tone.data(), l_tone.size(), l_out);
+			auto l_streamed = Stream(l_phaseVocoder, l_tone);
+
+			Check((l_stretchCase + " length").c_str(), l_out.size() == (size_t)std::llround((double)m_SampleCount * l_timeStretch));
+			Check((l_stretchCase + " streamed length").c_str(), l_streamed.size() >= l_out.size());
+			CheckError((l_stretchCase + " streaming against Render").c_str(), GetMaxError(l_streamed.data(), l_out.data(), std::min(l_streamed.size(), l_out.size())), tolerance);
+
+			// Away from the edges of the signal
+			auto l_begin = m_WindowSize;
+			auto l_end = l_out.size() - m_WindowSize;
+
+			CheckError((l_stretchCase + " frequency").c_str(), std::abs(GetFrequency(l_out, l_begin, l_end) / l_frequency - 1.0), 1e-3);
+			CheckError((l_stretchCase + " amplitude").c_str(), std::abs(GetAmplitude(l_out, l_begin, l_end - l_begin, l_frequency) / m_Amplitude - 1.0), 0.02);
+		}
+	}
+
+	template<class T>
+	void TestPitchShifts(const char* typeName, InstructionSet instructionSet)
+	{
+		auto l_testCase = std::string("PhaseVocoder<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		PhaseVocoderDesc l_desc;
+		l_desc.m_WindowDesc = { WindowType::Hann, m_WindowSize, 0 };
+
+		PhaseVocoderT<T> l_phaseVocoder;
+		l_phaseVocoder.Setup(l_desc);
+
+		// The length only follows the stretch, the frequency only follows the shift
+		const double l_frequency = 440.0;
+		auto l_tone = GenerateTone<T>(l_frequency, m_SampleCount);
+		std::vector<T> l_out;
+
+		for (auto l_pitchShift : { -12.0, -5.0, 7.0, 12.0, 24.0 })
+		{
+			for (auto l_timeStretch : { 1.0, 1.5 })
+			{
+				auto l_shiftCase = l_testCase + " shift " + std::to_string(l_pitchShift) + " stretch " + std::to_string(l_timeStretch);
+				auto l_shiftedFrequency = l_frequency * std::pow(2.0, l_pitchShift / 12.0);
+
+				l_phaseVocoder.SetTimeStretch(l_timeStretch);
+				l_phaseVocoder.SetPitchShift(l_pitchShift);
+				l_phaseVocoder.Render(l_tone.data(), l_tone.size(), l_out);
+
+				auto l_begin = m_WindowSize;
+				auto l_end = l_out.size() - m_WindowSize;
+
+				Check((l_shiftCase + " length").c_str(), l_out.size() == (size_t)std::llround((double)m_SampleCount * l_timeStretch));
+				CheckError((l_shiftCase + " frequency").c_str(), std::abs(GetFrequency(l_out, l_begin, l_end) / l_shiftedFrequency - 1.0), 1e-3);
+				CheckError((l_shiftCase + " amplitude").c_str(), std::abs(GetAmplitude(l_out, l_begin, l_end - l_begin, l_shiftedFrequency) / m_Amplitude - 1.0), 0.02);
+			}
+		}
+
+		// A tone shifted above the Nyquist frequency is removed instead of folded back, 15 kHz up an octave would alias to 18 kHz
+		auto l_high = GenerateTone<T>(15000.0, m_SampleCount);
+
+		l_phaseVocoder.SetTimeStretch(1.0);
+		l_phaseVocoder.SetPitchShift(12.0);
+		l_phaseVocoder.Render(l_high.data(), l_high.size(), l_out);
+
+		CheckError((l_testCase + " no alias above Nyquist").c_str(), GetAmplitude(l_out, m_WindowSize, l_out.size() - 2 * m_WindowSize, 18000.0) / m_Amplitude, 1e-3);
+	}
+}
+
+using namespace Waveless::Test::PhaseVocoderTestNS;
+
+void Test::TestPhaseVocoder()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		// The synthesis phases are advanced by the instantaneous frequencies times the hop, which loses about hop * epsilon radians
+		TestStretches<float>("float", instructionSet, 1e-3, 1e-5);
+		TestStretches<double>("double", instructionSet, 1e-10, 1e-12);
+		TestPitchShifts<float>("float", instructionSet);
+		TestPitchShifts<double>("double", instructionSet);
+	});
+}
\ No newline at end of file
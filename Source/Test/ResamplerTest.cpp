@@ -0,0 +1,107 @@
+#include "Test.h"
+#include "../Core/Resampler.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::ResamplerTestNS
+{
+	const size_t m_ChannelCount = 2;
+	const double m_Amplitude = 0.5;
+
+	// Exact ratios with few and many phases, an interpolated ratio and a downsampling one
+	const std::pair<double, double> m_SampleRates[] = { { 44100.0, 48000.0 }, { 48000.0, 44100.0 }, { 44100.0, 44100.0 * 1.0001 }, { 48000.0, 16000.0 } };
+
+	// Stream the input in pushes and pulls of sizes that don't line up with each other nor with the taps
+	template<class T>
+	std::vector<T> Stream(ResamplerT<T>& resampler, const std::vector<T>& in)
+	{
+		auto l_frameCount = in.size() / m_ChannelCount;
+		size_t l_pushed = 0;
+		std::vector<T> l_block(333 * m_ChannelCount);
+		std::vector<T> l_result;
+
+		while (true)
+		{
+			if (l_pushed < l_frameCount)
+			{
+				auto l_count = std::min(l_frameCount - l_pushed, size_t(1000));
+				resampler.Push(&in[l_pushed * m_ChannelCount], l_count);
+				l_pushed += l_count;
+
+				if (l_pushed == l_frameCount)
+				{
+					resampler.Flush();
+				}
+			}
+
+			auto l_pulled = resampler.Pull(l_block.data(), 333);
+			l_result.insert(l_result.end(), l_block.begin(), l_block.begin() + l_pulled * m_ChannelCount);
+
+			if (l_pushed == l_frameCount && !l_pulled)
+			{
+				return l_result;
+			}
+		}
+	}
+
+	template<class T>
+	void TestSampleRates(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		for (auto& l_sampleRates : m_SampleRates)
+		{
+			auto l_source = l_sampleRates.first;
+			auto l_target = l_sampleRates.second;
+
+			ResamplerT<T> l_resampler;
+			l_resampler.Setup(l_source, l_target, m_ChannelCount, ResamplerQuality::High);
+
+			// A quarter of a second of a tone in the passband of both rates, the channels are out of phase
+			auto l_frequency = 0.2 * std::min(l_source, l_target);
+			auto l_frameCount = (size_t)l_source / 4;
+			std::vector<T> l_in(l_frameCount * m_ChannelCount);
+
+			for (size_t i = 0; i < l_frameCount; i++)
+			{
+				auto l_sample = (T)(m_Amplitude * std::sin(2.0 * PI<double> * l_frequency * (double)i / l_source));
+				l_in[i * m_ChannelCount] = l_sample;
+				l_in[i * m_ChannelCount + 1] = -l_sample;
+			}
+
+			std::vector<T> l_rendered;
+			l_resampler.Render(l_in.data(), l_frameCount, l_rendered);
+			auto l_outputFrameCount = l_resampler.GetOutputFrameCount(l_frameCount);
+
+			l_resampler.Reset();
+			auto l_streamed = Stream(l_resampler, l_in);
+
+			auto l_testCase = std::string("Resampler<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet) + " " + std::to_string((int)l_source) + " to " + std::to_string((int)l_target);
+
+			Check((l_testCase + " output frame count").c_str(), l_rendered.size() == l_outputFrameCount * m_ChannelCount && l_streamed.size() == l_rendered.size());
+			CheckError((l_testCase + " streaming against Render").c_str(), GetMaxError(l_streamed.data(), l_rendered.data(), std::min(l_streamed.size(), l_rendered.size())), tolerance);
+
+			// Away from the edges the tone is the same at the target rate, within the 80 dB of the filter
+			std::vector<T> l_reference(l_rendered.size());
+
+			for (size_t i = 0; i < l_reference.size() / m_ChannelCount; i++)
+			{
+				auto l_sample = (T)(m_Amplitude * std::sin(2.0 * PI<double> * l_frequency * (double)i / l_target));
+				l_reference[i * m_ChannelCount] = l_sample;
+				l_reference[i * m_ChannelCount + 1] = -l_sample;
+			}
+
+			auto l_begin = l_reference.size() / 8 / m_ChannelCount * m_ChannelCount;
+			CheckError((l_testCase + " passband tone").c_str(), GetMaxError(&l_rendered[l_begin], &l_reference[l_begin], l_reference.size() - 2 * l_begin), m_Amplitude * std::pow(10.0, -75.0 / 20.0));
+		}
+	}
+}
+
+using namespace Waveless::Test::ResamplerTestNS;
+
+void Test::TestResampler()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		TestSampleRates<float>("float", instructionSet, 1e-6);
+		TestSampleRates<double>("double", instructionSet, 1e-12);
+	});
+}
\ No newline at end of file
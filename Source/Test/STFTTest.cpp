@@ -0,0 +1,105 @@
+#include "Test.h"
+#include "../Core/STFT.h"
+#include "../Core/Math.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::STFTTestNS
+{
+	template<class T>
+	void TestRoundTrip(const char* typeName, const char* windowName, WindowDesc windowDesc, double tolerance)
+	{
+		STFTT<T> l_STFT(windowDesc);
+
+		// Not a multiple of the hop, so the last frame is cut by the end of the signal
+		ComplexArrayT<T> l_signal(5000);
+
+		for (size_t i = 0; i < l_signal.size(); i++)
+		{
+			l_signal[i] = ComplexT<T>((T)(std::sin(0.01 * (double)i) + 0.5), (T)std::cos(0.003 * (double)i));
+		}
+
+		auto l_testCase = std::string("STFT<") + typeName + "> " + windowName + " window " + std::to_string(l_STFT.GetWindowSize()) + " hop " + std::to_string(l_STFT.GetHopSize());
+
+		auto l_frames = l_STFT.Analyze(l_signal);
+		auto l_result = l_STFT.Synthesize(l_frames, l_signal.size());
+
+		Check((l_testCase + " frame count").c_str(), l_frames.size() == l_STFT.GetFrameCount(l_signal.size()));
+		CheckError((l_testCase + " round trip").c_str(), GetMaxError(&l_result[0], &l_signal[0], l_signal.size()), tolerance);
+
+		// The parallel frame matrix should give the same samples as the frame vectors
+		auto l_frameCount = l_STFT.GetFrameCount(l_signal.size());
+		std::vector<ComplexT<T>> l_matrix(l_frameCount * l_STFT.GetWindowSize());
+		ComplexArrayT<T> l_matrixResult(l_signal.size());
+
+		l_STFT.AnalyzeFrames(&l_signal[0], l_signal.size(), l_matrix.data());
+		l_STFT.SynthesizeFrames(l_matrix.data(), l_frameCount, &l_matrixResult[0], l_signal.size());
+
+		CheckError((l_testCase + " frame matrix round trip").c_str(), GetMaxError(&l_matrixResult[0], &l_result[0], l_signal.size()), tolerance);
+	}
+
+	// Math::FFT and its inverses on signals shorter than, as long as and longer than the window.
+	// With the hop equal to the window, a signal of the window size is a single windowed frame, which IFFT shouldn't take for a padded one
+	template<class T>
+	void TestMathRoundTrip(const char* typeName, size_t hopSize, double tolerance)
+	{
+		// The Hamming window has no zero, every sample is recovered even without an overlap
+		WindowDesc l_windowDesc = { WindowType::Hamming, 1024, hopSize };
+
+		for (size_t l_sampleCount : { 10, 1024, 3000 })
+		{
+			ComplexArrayT<T> l_signal(l_sampleCount);
+
+			for (size_t i = 0; i < l_sampleCount; i++)
+			{
+				l_signal[i] = (T)(std::sin(0.01 * (double)i) + 0.5);
+			}
+
+			auto l_testCase = std::string("Math<") + typeName + "> hop " + std::to_string(hopSize) + " signal " + std::to_string(l_sampleCount);
+
+			auto l_X = Math::FFT(l_signal, l_windowDesc);
+			auto l_x = Math::IFFT(l_X, l_windowDesc);
+
+			Check((l_testCase + " IFFT size").c_str(), l_x.size() >= l_sampleCount);
+			CheckError((l_testCase + " FFT round trip").c_str(), GetMaxError(&l_x[0], &l_signal[0], std::min(l_x.size(), l_sampleCount)), tolerance);
+
+			auto l_synth = Math::Synth(Math::FreqDomainSeries2FreqBin(l_X, 48000.0), l_windowDesc);
+
+			Check((l_testCase + " Synth size").c_str(), l_synth.size() >= l_sampleCount);
+			CheckError((l_testCase + " Synth round trip").c_str(), GetMaxError(&l_synth[0], &l_signal[0], std::min(l_synth.size(), l_sampleCount)), tolerance);
+		}
+
+		// Frames of different sizes can't be overlap-added
+		ComplexArrayT<T> l_signal(ComplexT<T>(1), 3000);
+		auto l_bins = Math::FreqDomainSeries2FreqBin(Math::FFT(l_signal, l_windowDesc), 48000.0);
+		l_bins.back().m_FreqBinArray.pop_back();
+
+		Check((std::string("Math<") + typeName + "> Synth rejects frames of mismatched sizes").c_str(), Math::Synth(l_bins, l_windowDesc).size() == 0);
+	}
+}
+
+using namespace Waveless::Test::STFTTestNS;
+
+void Test::TestSTFT()
+{
+	std::pair<WindowType, const char*> l_windows[] = { { WindowType::Hann, "Hann" }, { WindowType::BlackmanHarris, "BlackmanHarris" } };
+
+	for (auto& l_window : l_windows)
+	{
+		for (size_t l_hopSize : { 128, 256, 512 })
+		{
+			WindowDesc l_windowDesc = { l_window.first, 1024, l_hopSize };
+			TestRoundTrip<float>("float", l_window.second, l_windowDesc, 1e-5);
+			TestRoundTrip<double>("double", l_window.second, l_windowDesc, 1e-12);
+		}
+	}
+
+	for (size_t l_hopSize : { 256, 1024 })
+	{
+		TestMathRoundTrip<float>("float", l_hopSize, 1e-5);
+		TestMathRoundTrip<double>("double", l_hopSize, 1e-12);
+	}
+
+	STFT l_STFT({ WindowType::Hann, 1024, 256 });
+	Check("STFT of an empty signal has no frame", l_STFT.Analyze(ComplexArray()).empty());
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "Test.h"
+#include "../Core/DSP.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::SignalStatisticsTestNS
+{
+	const size_t m_SampleSizes[] = { 1, 2, 3, 4, 4, 8 };
+	const char* m_FormatNames[] = { "UInt8", "Int16", "Int24", "Int32", "Float32", "Float64" };
+
+	// Quantize x to the format at sample, and return the normalized value that's stored
+	double Encode(double x, SampleFormat format, unsigned char* sample)
+	{
+		switch (format)
+		{
+		case SampleFormat::UInt8:
+		{
+			auto l_code = std::clamp(std::lround(x * 128.0), -128l, 127l);
+			sample[0] = (unsigned char)(l_code + 128);
+			return (double)l_code / 128.0;
+		}
+		case SampleFormat::Int16:
+		{
+			auto l_code = (int16_t)std::clamp(std::lround(x * 32768.0), -32768l, 32767l);
+			std::memcpy(sample, &l_code, 2);
+			return (double)l_code / 32768.0;
+		}
+		case SampleFormat::Int24:
+		{
+			auto l_code = (int32_t)std::clamp(std::lround(x * 8388608.0), -8388608l, 8388607l);
+			sample[0] = (unsigned char)l_code;
+			sample[1] = (unsigned char)(l_code >> 8);
+			sample[2] = (unsigned char)(l_code >> 16);
+			return (double)l_code / 8388608.0;
+		}
+		case SampleFormat::Int32:
+		{
+			auto l_code = (int32_t)std::clamp(std::llround(x * 2147483648.0), -2147483648ll, 2147483647ll);
+			std::memcpy(sample, &l_code, 4);
+			return (double)l_code / 2147483648.0;
+		}
+		case SampleFormat::Float32:
+		{
+			auto l_value = (float)x;
+			std::memcpy(sample, &l_value, 4);
+			return (double)l_value;
+		}
+		default:
+			std::memcpy(sample, &x, 8);
+			return x;
+		}
+	}
+
+	// The statistics of one channel by the definitions
+	SignalStatistics GetReference(const std::vector<double>& samples, size_t channels, size_t channel, SampleFormat format)
+	{
+		const double l_clipLevels[] = { 127.0 / 128.0, 32767.0 / 32768.0, 8388607.0 / 8388608.0, 2147483647.0 / 2147483648.0, 1.0, 1.0 };
+
+		SignalStatistics l_result;
+		l_result.m_SampleCount = samples.size() / channels;
+
+		double l_sum = 0.0;
+		double l_squareSum = 0.0;
+		size_t l_zeroCrossingCount = 0;
+
+		for (size_t i = 0; i < l_result.m_SampleCount; i++)
+		{
+			auto l_sample = samples[i * channels + channel];
+			l_result.m_Peak = std::max(l_result.m_Peak, std::abs(l_sample));
+			l_sum += l_sample;
+			l_squareSum += l_sample * l_sample;
+			l_result.m_ClippedSampleCount += std::abs(l_sample) >= l_clipLevels[(int)format];
+
+			if (i && std::signbit(l_sample) != std::signbit(samples[(i - 1) * channels + channel]))
+			{
+				l_zeroCrossingCount++;
+			}
+		}
+
+		if (l_result.m_SampleCount)
+		{
+			l_result.m_RMS = std::sqrt(l_squareSum / (double)l_result.m_SampleCount);
+			l_result.m_DCOffset = l_sum / (double)l_result.m_SampleCount;
+			l_result.m_CrestFactor = l_result.m_RMS > 0.0 ? l_result.m_Peak / l_result.m_RMS : 0.0;
+		}
+
+		if (l_result.m_SampleCount > 1)
+		{
+			l_result.m_ZeroCrossingRate = (double)l_zeroCrossingCount / (double)(l_result.m_SampleCount - 1);
+		}
+
+		return l_result;
+	}
+
+	bool IsEqual(double lhs, double rhs, double tolerance)
+	{
+		return (std::isnan(lhs) && std::isnan(rhs)) || std::abs(lhs - rhs) <= tolerance;
+	}
+
+	bool IsEqual(const SignalStatistics& lhs, const SignalStatistics& rhs, double tolerance)
+	{
+		return lhs.m_SampleCount == rhs.m_SampleCount
+			&& lhs.m_Peak == rhs.m_Peak
+			&& lhs.m_ClippedSampleCount == rhs.m_ClippedSampleCount
+			&& IsEqual(lhs.m_ZeroCrossingRate, rhs.m_ZeroCrossingRate, 1e-15)
+			&& IsEqual(lhs.m_RMS, rhs.m_RMS, tolerance)
+			&& IsEqual(lhs.m_DCOffset, rhs.m_DCOffset, tolerance)
+			&& IsEqual(lhs.m_CrestFactor, rhs.m_CrestFactor, tolerance);
+	}
+
+	// NaNs in the first channel of a float signal, after its peak and at every position of a kernel call, are left out of the peak and the clipped samples
+	template<class T>
+	void TestNaN(SampleFormat format, size_t frameCount)
+	{
+		const size_t l_channelCount = 2;
+		std::vector<T> l_raw(frameCount * l_channelCount);
+		std::vector<double> l_samples(l_raw.size());
+
+		for (size_t i = 0; i < l_raw.size(); i++)
+		{
+			l_raw[i] = (T)(1.2 * std::sin(0.013 * (double)i));
+
+			// A NaN right after the clipped peaks, where a vector maximum would drop the peak before it
+			if (i % l_channelCount == 0 && (i / l_channelCount) % 17 == 9)
+			{
+				l_raw[i] = std::numeric_limits<T>::quiet_NaN();
+			}
+
+			l_samples[i] = (double)l_raw[i];
+		}
+
+		l_raw[0] = std::numeric_limits<T>::quiet_NaN();
+		l_samples[0] = (double)l_raw[0];
+
+		auto l_testCase = std::string("GetSignalStatistics NaN ") + m_FormatNames[(int)format] + " frames " + std::to_string(frameCount);
+
+		ForEachInstructionSet([&](InstructionSet instructionSet)
+		{
+			std::vector<SignalStatistics> l_statistics;
+			auto l_result = DSP::GetSignalStatistics(l_raw.data(), frameCount, l_channelCount, format, l_statistics);
+
+			bool l_isEqual = l_result == WsResult::Success && l_statistics.size() == l_channelCount && std::isnan(l_statistics[0].m_RMS);
+
+			for (size_t j = 0; l_isEqual && j < l_channelCount; j++)
+			{
+				l_isEqual = IsEqual(l_statistics[j], GetReference(l_samples, l_channelCount, j, format), 1e-12);
+			}
+
+			Check((l_testCase + " " + SIMD::GetInstructionSetName(instructionSet)).c_str(), l_isEqual);
+		});
+	}
+}
+
+using namespace Waveless::Test::SignalStatisticsTestNS;
+
+void Test::TestSignalStatistics()
+{
+	std::mt19937 l_generator(1);
+	std::uniform_real_distribution<double> l_distribution(-0.025, 0.025);
+
+	for (auto l_format = (int)SampleFormat::UInt8; l_format <= (int)SampleFormat::Float64; l_format++)
+	{
+		for (size_t l_channelCount : { 1, 2, 5 })
+		{
+			// The tails of every vector width, and a signal long enough to be split across the workers
+			for (size_t l_frameCount : { 0, 1, 7, 1000, 3001, 200003 })
+			{
+				// A sine that clips on its peaks, with noise so the zero crossings aren't regular
+				auto l_sampleCount = l_frameCount * l_channelCount;
+				std::vector<unsigned char> l_raw(l_sampleCount * m_SampleSizes[l_format]);
+				std::vector<double> l_samples(l_sampleCount);
+
+				for (size_t i = 0; i < l_sampleCount; i++)
+				{
+					auto l_x = 1.2 * std::sin(0.013 * (double)i) + l_distribution(l_generator);
+					l_samples[i] = Encode(l_x, (SampleFormat)l_format, &l_raw[i * m_SampleSizes[l_format]]);
+				}
+
+				std::vector<SignalStatistics> l_scalar;
+				auto l_testCase = std::string("GetSignalStatistics ") + m_FormatNames[l_format] + " channels " + std::to_string(l_channelCount) + " frames " + std::to_string(l_frameCount);
+
+				ForEachInstructionSet([&](InstructionSet instructionSet)
+				{
+					std::vector<SignalStatistics> l_statistics;
+					auto l_result = DSP::GetSignalStatistics(l_raw.data(), l_frameCount, l_channelCount, (SampleFormat)l_format, l_statistics);
+
+					bool l_isEqual = l_result == WsResult::Success && l_statistics.size() == l_channelCount;
+
+					for (size_t j = 0; l_isEqual && j < l_channelCount; j++)
+					{
+						l_isEqual = IsEqual(l_statistics[j], GetReference(l_samples, l_channelCount, j, (SampleFormat)l_format), 1e-12);
+
+						// The vectorized kernels only reorder the sums of the scalar one
+						if (instructionSet != InstructionSet::Scalar)
+						{
+							l_isEqual = l_isEqual && IsEqual(l_statistics[j], l_scalar[j], 1e-12);
+						}
+					}
+
+					if (instructionSet == InstructionSet::Scalar)
+					{
+						l_scalar = l_statistics;
+					}
+
+					Check((l_testCase + " " + SIMD::GetInstructionSetName(instructionSet)).c_str(), l_isEqual);
+				});
+			}
+		}
+	}
+
+	// The tails and the vectors, and a signal split across the workers
+	for (size_t l_frameCount : { 7, 1000, 200003 })
+	{
+		TestNaN<float>(SampleFormat::Float32, l_frameCount);
+		TestNaN<double>(SampleFormat::Float64, l_frameCount);
+	}
+}
\ No newline at end of file
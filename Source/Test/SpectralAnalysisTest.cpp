@@ -0,0 +1,136 @@
+#include "Test.h"
+#include "../Core/SlidingDFT.h"
+
+using namespace Waveless;
+
+namespace Waveless::Test::SpectralAnalysisTestNS
+{
+	const double m_SampleRate = 48000.0;
+	// 100 cycles of 1 kHz
+	const size_t m_WindowSize = 4800;
+
+	// The DFT of x at the frequency f by the definition
+	template<class T>
+	ComplexT<double> GetBin(const T* x, size_t count, double f)
+	{
+		ComplexT<double> l_result(0.0, 0.0);
+
+		for (size_t n = 0; n < count; n++)
+		{
+			// The phase is wrapped in the cycles before it's scaled, so it stays exact over long windows
+			auto l_cycles = f * (double)n / m_SampleRate;
+			l_result += (double)x[n] * std::polar(1.0, -2.0 * PI<double> * (l_cycles - std::floor(l_cycles)));
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestBins(const char* typeName, InstructionSet instructionSet, double tolerance)
+	{
+		std::mt19937 l_generator(3);
+		std::uniform_real_distribution<double> l_distribution(-1.0, 1.0);
+
+		// DC, Nyquist, the bins of the window and frequencies between them, more than the lanes of a kernel call
+		std::vector<double> l_frequencies = { 0.0, m_SampleRate / 2.0 };
+
+		for (size_t k = 1; k < 40; k++)
+		{
+			l_frequencies.emplace_back(k % 2 ? (double)k * m_SampleRate / (double)m_WindowSize : (double)k * 237.13);
+		}
+
+		auto l_testCase = std::string("<") + typeName + "> " + SIMD::GetInstructionSetName(instructionSet);
+
+		// Goertzel on noise against the definition, and against the DFT at the bins of the window
+		std::vector<T> l_x(m_WindowSize);
+
+		for (auto& i : l_x)
+		{
+			i = (T)l_distribution(l_generator);
+		}
+
+		std::vector<ComplexT<T>> l_X(l_frequencies.size());
+		Math::Goertzel(l_x.data(), l_x.size(), l_frequencies.data(), l_frequencies.size(), m_SampleRate, l_X.data());
+
+		std::vector<ComplexT<double>> l_reference(l_frequencies.size());
+
+		for (size_t k = 0; k < l_frequencies.size(); k++)
+		{
+			l_reference[k] = GetBin(l_x.data(), l_x.size(), l_frequencies[k]);
+		}
+
+		CheckError(("Goertzel" + l_testCase).c_str(), GetMaxError(l_X.data(), l_reference.data(), l_X.size()), tolerance);
+
+		std::vector<ComplexT<double>> l_signal(l_x.begin(), l_x.end());
+		auto l_DFT = DirectDFT(l_signal);
+		double l_DFTError = 0.0;
+
+		for (size_t k = 0; k < l_frequencies.size(); k++)
+		{
+			auto l_bin = l_frequencies[k] * (double)m_WindowSize / m_SampleRate;
+
+			if (l_bin == std::floor(l_bin))
+			{
+				l_DFTError = std::max(l_DFTError, std::abs(ComplexT<double>(l_X[k]) - l_DFT[(size_t)l_bin]));
+			}
+		}
+
+		CheckError(("Goertzel" + l_testCase + " against the DFT bins").c_str(), l_DFTError, tolerance);
+
+		// The sliding DFT after 10 seconds of a tone in noise, in blocks across the kernel calls, should be the DFT of the last window
+		auto l_sampleCount = 10 * (size_t)m_SampleRate;
+		std::vector<T> l_y(l_sampleCount);
+
+		for (size_t i = 0; i < l_sampleCount; i++)
+		{
+			// 1 kHz is 48 samples per cycle
+			l_y[i] = (T)(0.5 * std::sin(2.0 * PI<double> * (double)(i % 48) / 48.0) + 0.1 * l_distribution(l_generator));
+		}
+
+		SlidingDFTT<T> l_slidingDFT;
+		l_slidingDFT.Setup(m_SampleRate, m_WindowSize, l_frequencies.data(), l_frequencies.size());
+
+		for (size_t i = 0; i < l_sampleCount;)
+		{
+			auto l_count = std::min(l_sampleCount - i, 1000 + i % 777);
+			l_slidingDFT.Process(&l_y[i], l_count);
+			i += l_count;
+		}
+
+		auto l_window = &l_y[l_sampleCount - m_WindowSize];
+		double l_slidingError = 0.0;
+
+		for (size_t k = 0; k < l_frequencies.size(); k++)
+		{
+			l_slidingError = std::max(l_slidingError, std::abs(ComplexT<double>(l_slidingDFT.GetBin(k)) - GetBin(l_window, m_WindowSize, l_frequencies[k])));
+		}
+
+		CheckError(("SlidingDFT" + l_testCase + " after 10 s").c_str(), l_slidingError, tolerance);
+
+		// 1 kHz is the bin 100, the noise leaves about 0.1 / sqrt(window size) on it
+		double l_frequency = 1000.0;
+		SlidingDFTT<T> l_tone;
+		l_tone.Setup(m_SampleRate, m_WindowSize, &l_frequency, 1);
+		l_tone.Process(l_y.data(), l_sampleCount);
+
+		CheckError(("SlidingDFT" + l_testCase + " amplitude of a tone").c_str(), std::abs((double)l_tone.GetAmplitude(0) - 0.5), 0.01);
+
+		// Processing before Setup() returns instead of spinning on an empty window
+		SlidingDFTT<T> l_unconfigured;
+		l_unconfigured.Process(l_y.data(), 100);
+
+		Check(("SlidingDFT" + l_testCase + " without Setup").c_str(), !l_unconfigured.GetWindowSize() && !l_unconfigured.GetFrequencyCount());
+	}
+}
+
+using namespace Waveless::Test::SpectralAnalysisTestNS;
+
+void Test::TestSpectralAnalysis()
+{
+	ForEachInstructionSet([](InstructionSet instructionSet)
+	{
+		// The bins are sums of thousands of samples, and the recursion is the most sensitive at DC and Nyquist
+		TestBins<float>("float", instructionSet, 1e-4);
+		TestBins<double>("double", instructionSet, 1e-8);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Test.h"
+#include "../Core/Logger.h"
+
+namespace Waveless::Test::TestNS
+{
+	size_t m_FailureCount = 0;
+}
+
+using namespace Waveless;
+using namespace Waveless::Test::TestNS;
+
+void Test::CheckError(const char* testCase, double error, double tolerance)
+{
+	if (error <= tolerance)
+	{
+		Logger::Log(LogLevel::Success, testCase, ": error ", error);
+		return;
+	}
+
+	Logger::Log(LogLevel::Error, testCase, ": error ", error, " is larger than ", tolerance, "!");
+	m_FailureCount++;
+}
+
+void Test::Check(const char* testCase, bool condition)
+{
+	if (condition)
+	{
+		Logger::Log(LogLevel::Success, testCase);
+		return;
+	}
+
+	Logger::Log(LogLevel::Error, testCase, " failed!");
+	m_FailureCount++;
+}
+
+size_t Test::GetFailureCount()
+{
+	return m_FailureCount;
+}
+
+void Test::ForEachInstructionSet(const std::function<void(InstructionSet instructionSet)>& body)
+{
+	auto l_supported = SIMD::GetSupportedInstructionSet();
+
+	for (auto i = (int)InstructionSet::Scalar; i <= (int)l_supported; i++)
+	{
+		auto l_instructionSet = (InstructionSet)i;
+		SIMD::SetInstructionSet(l_instructionSet);
+		body(l_instructionSet);
+	}
+
+	SIMD::SetInstructionSet(l_supported);
+}
+
+std::vector<ComplexT<double>> Test::DirectDFT(const std::vector<ComplexT<double>>& x, bool inverse)
+{
+	auto N = x.size();
+	auto l_sign = inverse ? 1.0 : -1.0;
+	std::vector<ComplexT<double>> l_result(N);
+
+	for (size_t k = 0; k < N; k++)
+	{
+		ComplexT<double> l_sum(0.0, 0.0);
+
+		for (size_t n = 0; n < N; n++)
+		{
+			// k * n mod N keeps the argument small, the phase is exact for every size
+			auto l_phase = l_sign * 2.0 * PI<double> * (double)((k * n) % N) / (double)N;
+			l_sum += x[n] * ComplexT<double>(std::cos(l_phase), std::sin(l_phase));
+		}
+
+		l_result[k] = inverse ? l_sum / (double)N : l_sum;
+	}
+
+	return l_result;
+}
\ No newline at end of file
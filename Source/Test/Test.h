@@ -0,0 +1,69 @@
+#pragma once
+#include "../Core/stdafx.h"
+#include "../Core/Math.h"
+#include "../Core/SIMD.h"
+#include <functional>
+
+namespace Waveless::Test
+{
+	///
+	/// Log the error of a test case, a failure is counted when it's larger than the tolerance or NaN
+	///
+	void CheckError(const char* testCase, double error, double tolerance);
+
+	///
+	/// Log a test case, a failure is counted when the condition is false
+	///
+	void Check(const char* testCase, bool condition);
+
+	size_t GetFailureCount();
+
+	///
+	/// Run the test body once for every instruction set up to the supported one, the supported one is restored afterwards
+	///
+	void ForEachInstructionSet(const std::function<void(InstructionSet instructionSet)>& body);
+
+	///
+	/// The DFT of x by the definition, summed in double precision, inverse is normalized by 1 / N
+	///
+	std::vector<ComplexT<double>> DirectDFT(const std::vector<ComplexT<double>>& x, bool inverse = false);
+
+	///
+	/// The largest |lhs[i] - rhs[i]| over count real or complex values, NaN if one of them is NaN
+	///
+	template<class L, class R>
+	double GetMaxError(const L* lhs, const R* rhs, size_t count)
+	{
+		double l_result = 0.0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto l_error = std::abs(ComplexT<double>(lhs[i]) - ComplexT<double>(rhs[i]));
+
+			if (std::isnan(l_error))
+			{
+				return l_error;
+			}
+
+			l_result = std::max(l_result, l_error);
+		}
+
+		return l_result;
+	}
+
+	// The behavior tests, every one checks a processor against a reference implementation
+	void TestFFTPlans();
+	void TestSTFT();
+	void TestIIRFilters();
+	void TestGainProcessor();
+	void TestResampler();
+	void TestConvolver();
+	void TestSpectralAnalysis();
+	void TestSignalStatistics();
+	void TestFilterBank();
+	void TestPhaseVocoder();
+	void TestDSPChain();
+	void TestDecibels();
+	void TestOscillatorBank();
+	void TestWindowBank();
+}
\ No newline at end of file
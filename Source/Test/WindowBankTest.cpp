@@ -0,0 +1,107 @@
+#include "Test.h"
+#include "../Core/WindowBank.h"
+#include <thread>
+
+using namespace Waveless;
+
+namespace Waveless::Test::WindowBankTestNS
+{
+	const char* m_WindowTypeNames[] = { "Rectangular", "Hann", "Hamming", "Blackman", "Nuttall", "BlackmanNuttall", "BlackmanHarris" };
+
+	// The coefficients a0 to a3 of w = a0 - a1 * cos(x) + a2 * cos(2x) - a3 * cos(3x)
+	const double m_Coefficients[][4] =
+	{
+		{ 1.0, 0.0, 0.0, 0.0 },
+		{ 0.5, 0.5, 0.0, 0.0 },
+		{ 0.53836, 0.46164, 0.0, 0.0 },
+		{ 0.42659, 0.49656, 0.076849, 0.0 },
+		{ 0.355768, 0.487396, 0.144232, 0.012604 },
+		{ 0.3635819, 0.4891775, 0.1365995, 0.0106411 },
+		{ 0.35875, 0.48829, 0.14128, 0.01168 }
+	};
+
+	// The window by the definition, with std::cos in long double
+	std::vector<long double> GetReference(const WindowDesc& windowDesc)
+	{
+		auto N = windowDesc.m_WindowSize;
+		auto l_period = windowDesc.m_WindowSymmetry == WindowSymmetry::Periodic ? (long double)N : (long double)(N - 1);
+		auto& a = m_Coefficients[(int)windowDesc.m_WindowType];
+		std::vector<long double> l_result(N, 1.0l);
+
+		for (size_t i = 0; N > 1 && i < N; i++)
+		{
+			auto x = 2.0l * PI<long double> * (long double)i / l_period;
+			l_result[i] = a[0] - a[1] * std::cos(x) + a[2] * std::cos(2.0l * x) - a[3] * std::cos(3.0l * x);
+		}
+
+		return l_result;
+	}
+
+	template<class T>
+	void TestWindows(const char* typeName, double tolerance)
+	{
+		// The table sizes up to the largest one, and sizes that fall back to std::cos
+		const size_t l_sizes[] = { 1, 2, 64, 1024, WindowBank::m_MaxTableSize, 2 * WindowBank::m_MaxTableSize, 1000, 4801 };
+
+		for (auto l_windowType = (int)WindowType::Rectangular; l_windowType <= (int)WindowType::BlackmanHarris; l_windowType++)
+		{
+			double l_error = 0.0;
+
+			for (auto l_symmetry : { WindowSymmetry::Periodic, WindowSymmetry::Symmetric })
+			{
+				for (auto l_size : l_sizes)
+				{
+					WindowDesc l_windowDesc = { (WindowType)l_windowType, l_size, 0, l_symmetry };
+
+					auto& l_window = WindowBank::Get<T>(l_windowDesc);
+					auto l_reference = GetReference(l_windowDesc);
+
+					l_error = l_window.size() == l_size ? std::max(l_error, GetMaxError(l_window.data(), l_reference.data(), l_size)) : 1.0;
+				}
+			}
+
+			CheckError((std::string("WindowBank<") + typeName + "> " + m_WindowTypeNames[l_windowType]).c_str(), l_error, tolerance);
+		}
+	}
+
+	void TestCache()
+	{
+		WindowDesc l_hann = { WindowType::Hann, 2048 };
+		WindowDesc l_symmetric = { WindowType::Hann, 2048, 0, WindowSymmetry::Symmetric };
+		WindowDesc l_hopped = { WindowType::Hann, 2048, 256 };
+
+		// A later request returns the same window whatever the hop size, the other descriptions and precisions have their own
+		auto l_window = &WindowBank::Get<double>(l_hann);
+
+		Check("WindowBank returns the cached window", &WindowBank::Get<double>(l_hann) == l_window && &WindowBank::Get<double>(l_hopped) == l_window);
+		Check("WindowBank keeps the symmetries apart", &WindowBank::Get<double>(l_symmetric) != l_window && WindowBank::Get<double>(l_symmetric) != *l_window);
+		Check("WindowBank keeps the precisions apart", (const void*)&WindowBank::Get<float>(l_hann) != (const void*)l_window);
+
+		// The threads racing on the first request of a window all get the one that's kept
+		WindowDesc l_new = { WindowType::BlackmanHarris, 12345 };
+		std::vector<const std::vector<double>*> l_results(8);
+		std::vector<std::thread> l_threads;
+
+		for (auto& i : l_results)
+		{
+			l_threads.emplace_back([&i, &l_new]() { i = &WindowBank::Get<double>(l_new); });
+		}
+
+		for (auto& i : l_threads)
+		{
+			i.join();
+		}
+
+		Check("WindowBank concurrent first requests", std::all_of(l_results.begin(), l_results.end(), [&](auto i) { return i == &WindowBank::Get<double>(l_new); }));
+	}
+}
+
+using namespace Waveless::Test::WindowBankTestNS;
+
+void Test::TestWindowBank()
+{
+	// The table is summed from a Taylor series at compile time, within a few ulps of std::cos
+	TestWindows<float>("float", 1e-7);
+	TestWindows<double>("double", 1e-15);
+	TestCache();
+}
\ No newline at end of file
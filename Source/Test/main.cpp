@@ -1,9 +1,10 @@
 #pragma once
 #include "../IO/WaveParser.h"
 #include "../Core/Math.h"
-#include "../Core/DSP.h"
+#include "../Core/DSPChain.h"
 #include "../Runtime/Plotter.h"
 #include "../Runtime/AudioEngine.h"
+#include "Test.h"
 
 using namespace Waveless;
 
@@ -49,9 +50,18 @@ void testOfflineFeatures()
 	auto signal_3_bin = Math::FreqDomainSeries2FreqBin(signal_3_FFT, l_sampleRate);
 
 	// test case : DSP
-	auto l_sampleProcessed = DSP::Gain(signal_3, -4.5);
-	l_sampleProcessed = DSP::LPF(l_sampleProcessed, l_sampleRate, 5000.0);
-	l_sampleProcessed = DSP::HPF(l_sampleProcessed, l_sampleRate, 300.0);
+	FilterDesc l_LPFDesc;
+	l_LPFDesc.m_FilterType = FilterType::LowPass;
+	l_LPFDesc.m_Frequency = 5000.0;
+	l_LPFDesc.m_Order = 4;
+
+	FilterDesc l_HPFDesc;
+	l_HPFDesc.m_FilterType = FilterType::HighPass;
+	l_HPFDesc.m_Frequency = 300.0;
+	l_HPFDesc.m_Order = 4;
+
+	auto l_chain = MakeDSPChain(DSPStage::Gain<double>(-4.5), DSPStage::IIR<double>(l_LPFDesc), DSPStage::IIR<double>(l_HPFDesc));
+	auto l_sampleProcessed = l_chain.Process(signal_3, l_sampleRate);
 
 	// test case : write to new wave file
 	WaveParser::WriteFile("..//..//Asset//test_Sinusoid_Processed.wav", l_wavObject.header, l_sampleProcessed);
@@ -96,5 +106,20 @@ int main()
 	//testOfflineFeatures();
 	//testRealTimeFeatures();
 
-	return 0;
+	Test::TestFFTPlans();
+	Test::TestSTFT();
+	Test::TestIIRFilters();
+	Test::TestGainProcessor();
+	Test::TestResampler();
+	Test::TestConvolver();
+	Test::TestSpectralAnalysis();
+	Test::TestSignalStatistics();
+	Test::TestFilterBank();
+	Test::TestPhaseVocoder();
+	Test::TestDSPChain();
+	Test::TestDecibels();
+	Test::TestOscillatorBank();
+	Test::TestWindowBank();
+
+	return Test::GetFailureCount() ? 1 : 0;
 }
\ No newline at end of file